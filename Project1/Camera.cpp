@@ -47,6 +47,12 @@ void Camera::ProcessMouseScroll(float yoffset) {
     Zoom = std::max(1.0f, std::min(Zoom, 45.0f));
 }
 
+void Camera::SetOrientation(float yaw, float pitch) {
+    Yaw = yaw;
+    Pitch = pitch;
+    updateCameraVectors();
+}
+
 void Camera::updateCameraVectors() {
     glm::vec3 front;
     front.x = cos(glm::radians(Yaw)) * cos(glm::radians(Pitch));
@@ -35,6 +35,9 @@ public:
 
     void ProcessMouseScroll(float yoffset);
 
+    // senaryolu kamera (tur kaydı) için açıları doğrudan ayarla
+    void SetOrientation(float yaw, float pitch);
+
 private:
     void updateCameraVectors();
 }; 
\ No newline at end of file
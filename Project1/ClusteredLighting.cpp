@@ -0,0 +1,279 @@
+#include "ClusteredLighting.h"
+#include "SimdCullerKernels.h"
+#include "JobSystem.h"
+#include "Shader.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cfloat>
+
+#if SIMD_CULLER_X86
+#include <emmintrin.h>
+#endif
+
+namespace {
+    GLuint CreateBufferTexture(GLuint& buffer, GLenum format) {
+        GLuint texture = 0;
+        glGenBuffers(1, &buffer);
+        glBindBuffer(GL_TEXTURE_BUFFER, buffer);
+        glBufferData(GL_TEXTURE_BUFFER, 16, nullptr, GL_STREAM_DRAW);
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_BUFFER, texture);
+        glTexBuffer(GL_TEXTURE_BUFFER, format, buffer);
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+        glBindBuffer(GL_TEXTURE_BUFFER, 0);
+        return texture;
+    }
+
+    void UploadBufferData(GLuint buffer, const void* data, size_t bytes) {
+        // boş buffer texture'a bağlanamıyor, en az bir eleman
+        glBindBuffer(GL_TEXTURE_BUFFER, buffer);
+        glBufferData(GL_TEXTURE_BUFFER, std::max<size_t>(bytes, 16), nullptr, GL_STREAM_DRAW);
+        if (bytes > 0) {
+            glBufferSubData(GL_TEXTURE_BUFFER, 0, bytes, data);
+        }
+    }
+}
+
+ClusteredLighting::ClusteredLighting()
+    : boundsMinX(CLUSTER_COUNT), boundsMinY(CLUSTER_COUNT), boundsMinZ(CLUSTER_COUNT),
+    boundsMaxX(CLUSTER_COUNT), boundsMaxY(CLUSTER_COUNT), boundsMaxZ(CLUSTER_COUNT),
+    clusterLights(CLUSTER_COUNT), gridData(CLUSTER_COUNT * 2, 0) {
+    lightDataTexture = CreateBufferTexture(lightDataBuffer, GL_RGBA32F);
+    gridTexture = CreateBufferTexture(gridBuffer, GL_RG32UI);
+    indexTexture = CreateBufferTexture(indexBuffer, GL_R32UI);
+}
+
+ClusteredLighting::~ClusteredLighting() {
+    glDeleteTextures(1, &lightDataTexture);
+    glDeleteTextures(1, &gridTexture);
+    glDeleteTextures(1, &indexTexture);
+    glDeleteBuffers(1, &lightDataBuffer);
+    glDeleteBuffers(1, &gridBuffer);
+    glDeleteBuffers(1, &indexBuffer);
+}
+
+void ClusteredLighting::RebuildClusterBounds(const glm::mat4& projection, int width, int height) {
+    // perspektif matrisinden near/far
+    nearPlane = projection[3][2] / (projection[2][2] - 1.0f);
+    farPlane = projection[3][2] / (projection[2][2] + 1.0f);
+
+    // karo köşelerinden geçen ışınlar (near düzleminde, view uzayı)
+    glm::mat4 inverseProjection = glm::inverse(projection);
+    std::vector<glm::vec3> cornerRays((CLUSTERS_X + 1) * (CLUSTERS_Y + 1));
+    for (int y = 0; y <= CLUSTERS_Y; ++y) {
+        for (int x = 0; x <= CLUSTERS_X; ++x) {
+            glm::vec4 ndc(2.0f * x / CLUSTERS_X - 1.0f, 2.0f * y / CLUSTERS_Y - 1.0f, -1.0f, 1.0f);
+            glm::vec4 point = inverseProjection * ndc;
+            glm::vec3 viewPoint = glm::vec3(point) / point.w;
+            cornerRays[y * (CLUSTERS_X + 1) + x] = viewPoint / -viewPoint.z; // derinlik 1'deki nokta
+        }
+    }
+
+    // üstel dilimler: uzak dilimler kalın, yakınlar ince
+    float logRatio = std::log(farPlane / nearPlane);
+    for (int z = 0; z < CLUSTERS_Z; ++z) {
+        float sliceNear = nearPlane * std::exp(logRatio * z / CLUSTERS_Z);
+        float sliceFar = nearPlane * std::exp(logRatio * (z + 1) / CLUSTERS_Z);
+        for (int y = 0; y < CLUSTERS_Y; ++y) {
+            for (int x = 0; x < CLUSTERS_X; ++x) {
+                glm::vec3 minimum(FLT_MAX);
+                glm::vec3 maximum(-FLT_MAX);
+                for (int corner = 0; corner < 4; ++corner) {
+                    const glm::vec3& ray = cornerRays[(y + (corner >> 1)) * (CLUSTERS_X + 1) + x + (corner & 1)];
+                    for (float depth : { sliceNear, sliceFar }) {
+                        minimum = glm::min(minimum, ray * depth);
+                        maximum = glm::max(maximum, ray * depth);
+                    }
+                }
+                size_t index = x + y * CLUSTERS_X + z * CLUSTERS_X * CLUSTERS_Y;
+                boundsMinX[index] = minimum.x;
+                boundsMinY[index] = minimum.y;
+                boundsMinZ[index] = minimum.z;
+                boundsMaxX[index] = maximum.x;
+                boundsMaxY[index] = maximum.y;
+                boundsMaxZ[index] = maximum.z;
+            }
+        }
+    }
+
+    boundsProjection = projection;
+    boundsWidth = width;
+    boundsHeight = height;
+}
+
+int ClusteredLighting::DepthToSlice(float depth) const {
+    // fragment shader ile aynı formül
+    float slice = std::log(std::max(depth, nearPlane)) * shaderParams.depth.z + shaderParams.depth.w;
+    return std::clamp(static_cast<int>(std::floor(slice)), 0, CLUSTERS_Z - 1);
+}
+
+void ClusteredLighting::Update(const std::vector<Light>& lights, size_t first, const glm::mat4& view,
+    const glm::mat4& projection) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    GLint viewport[4] = { 0, 0, 0, 0 };
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    if (projection != boundsProjection || viewport[2] != boundsWidth || viewport[3] != boundsHeight) {
+        RebuildClusterBounds(projection, viewport[2], viewport[3]);
+    }
+    float logRatio = std::log(farPlane / nearPlane);
+    shaderParams.depth = glm::vec4(nearPlane, farPlane, CLUSTERS_Z / logRatio, -CLUSTERS_Z * std::log(nearPlane) / logRatio);
+    shaderParams.viewport = glm::vec4(viewport[0], viewport[1],
+        static_cast<float>(viewport[2]) / CLUSTERS_X, static_cast<float>(viewport[3]) / CLUSTERS_Y);
+
+    // ışık verisi ve view uzayındaki hacimler
+    size_t lightCount = lights.size() > first ? lights.size() - first : 0;
+    lightData.resize(lightCount * 16);
+    volumes.clear();
+    for (size_t i = 0; i < lightCount; ++i) {
+        const Light& light = lights[first + i];
+        LightBuffer::PackLight(light, &lightData[i * 16]);
+
+        LightVolume volume;
+        volume.lightIndex = static_cast<uint32_t>(i);
+        volume.tileX0 = 0;
+        volume.tileX1 = CLUSTERS_X - 1;
+        volume.tileY0 = 0;
+        volume.tileY1 = CLUSTERS_Y - 1;
+        if (light.GetType() == Light::Type::DIRECTIONAL) {
+            // yönlü ışık her kümede
+            volume.center = glm::vec3(0.0f);
+            volume.radius = FLT_MAX;
+            volume.minDepth = 0.0f;
+            volume.maxDepth = FLT_MAX;
+            volumes.push_back(volume);
+            continue;
+        }
+
+        // spot ışıklar da menzil küresiyle (ambient terimi koniyle sınırlı değil)
+        volume.center = glm::vec3(view * glm::vec4(light.GetPosition(), 1.0f));
+        volume.radius = light.GetRange();
+        volume.minDepth = -volume.center.z - volume.radius;
+        volume.maxDepth = -volume.center.z + volume.radius;
+        if (volume.maxDepth < nearPlane || volume.minDepth > farPlane) {
+            continue;
+        }
+
+        if (volume.minDepth > nearPlane) {
+            // kürenin kutusunun köşeleri ekrana izdüşürülüyor (kutu küreyi kapsadığı için güvenli)
+            glm::vec2 ndcMin(FLT_MAX);
+            glm::vec2 ndcMax(-FLT_MAX);
+            for (int corner = 0; corner < 8; ++corner) {
+                glm::vec3 offset((corner & 1) ? volume.radius : -volume.radius,
+                    (corner & 2) ? volume.radius : -volume.radius, (corner & 4) ? volume.radius : -volume.radius);
+                glm::vec4 clip = projection * glm::vec4(volume.center + offset, 1.0f);
+                glm::vec2 ndc = glm::vec2(clip) / clip.w;
+                ndcMin = glm::min(ndcMin, ndc);
+                ndcMax = glm::max(ndcMax, ndc);
+            }
+            if (ndcMax.x < -1.0f || ndcMin.x > 1.0f || ndcMax.y < -1.0f || ndcMin.y > 1.0f) {
+                continue; // ekran dışında
+            }
+            volume.tileX0 = std::clamp(static_cast<int>(std::floor((ndcMin.x * 0.5f + 0.5f) * CLUSTERS_X)), 0, CLUSTERS_X - 1);
+            volume.tileX1 = std::clamp(static_cast<int>(std::floor((ndcMax.x * 0.5f + 0.5f) * CLUSTERS_X)), 0, CLUSTERS_X - 1);
+            volume.tileY0 = std::clamp(static_cast<int>(std::floor((ndcMin.y * 0.5f + 0.5f) * CLUSTERS_Y)), 0, CLUSTERS_Y - 1);
+            volume.tileY1 = std::clamp(static_cast<int>(std::floor((ndcMax.y * 0.5f + 0.5f) * CLUSTERS_Y)), 0, CLUSTERS_Y - 1);
+        }
+        volumes.push_back(volume);
+    }
+
+    // dilimler birbirinden bağımsız, her iş kendi dilimindeki kümelere yazıyor
+    JobSystem::GetInstance().ParallelFor(CLUSTERS_Z, 1, [this](size_t begin, size_t end) {
+        AssignSlices(begin, end);
+    });
+
+    // küme listeleri tek index listesine
+    indexData.clear();
+    stats = Stats();
+    stats.lights = lightCount;
+    for (int cluster = 0; cluster < CLUSTER_COUNT; ++cluster) {
+        const std::vector<uint32_t>& list = clusterLights[cluster];
+        gridData[cluster * 2] = static_cast<uint32_t>(indexData.size());
+        gridData[cluster * 2 + 1] = static_cast<uint32_t>(list.size());
+        indexData.insert(indexData.end(), list.begin(), list.end());
+        if (!list.empty()) {
+            stats.activeClusters++;
+            stats.maxLightsPerCluster = std::max(stats.maxLightsPerCluster, list.size());
+        }
+    }
+    stats.lightIndices = indexData.size();
+
+    UploadBufferData(lightDataBuffer, lightData.data(), lightData.size() * sizeof(float));
+    UploadBufferData(gridBuffer, gridData.data(), gridData.size() * sizeof(uint32_t));
+    UploadBufferData(indexBuffer, indexData.data(), indexData.size() * sizeof(uint32_t));
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+    stats.assignMs = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - start).count();
+}
+
+void ClusteredLighting::AssignSlices(size_t sliceBegin, size_t sliceEnd) {
+    for (size_t z = sliceBegin; z < sliceEnd; ++z) {
+        size_t sliceOffset = z * CLUSTERS_X * CLUSTERS_Y;
+        for (size_t cluster = sliceOffset; cluster < sliceOffset + CLUSTERS_X * CLUSTERS_Y; ++cluster) {
+            clusterLights[cluster].clear();
+        }
+
+        for (const LightVolume& volume : volumes) {
+            if (DepthToSlice(volume.minDepth) > static_cast<int>(z) || DepthToSlice(volume.maxDepth) < static_cast<int>(z)) {
+                continue;
+            }
+            if (volume.radius == FLT_MAX) {
+                for (size_t cluster = sliceOffset; cluster < sliceOffset + CLUSTERS_X * CLUSTERS_Y; ++cluster) {
+                    clusterLights[cluster].push_back(volume.lightIndex);
+                }
+                continue;
+            }
+
+            float radiusSquared = volume.radius * volume.radius;
+            for (int y = volume.tileY0; y <= volume.tileY1; ++y) {
+                size_t rowOffset = sliceOffset + y * CLUSTERS_X;
+                int x = volume.tileX0;
+#if SIMD_CULLER_X86
+                // küre - kutu mesafesi, 4 küme birden
+                __m128 centerX = _mm_set1_ps(volume.center.x);
+                __m128 centerY = _mm_set1_ps(volume.center.y);
+                __m128 centerZ = _mm_set1_ps(volume.center.z);
+                __m128 radius2 = _mm_set1_ps(radiusSquared);
+                __m128 zero = _mm_setzero_ps();
+                for (; x + 3 <= volume.tileX1; x += 4) {
+                    size_t index = rowOffset + x;
+                    __m128 dx = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(&boundsMinX[index]), centerX),
+                        _mm_sub_ps(centerX, _mm_loadu_ps(&boundsMaxX[index]))), zero);
+                    __m128 dy = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(&boundsMinY[index]), centerY),
+                        _mm_sub_ps(centerY, _mm_loadu_ps(&boundsMaxY[index]))), zero);
+                    __m128 dz = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(&boundsMinZ[index]), centerZ),
+                        _mm_sub_ps(centerZ, _mm_loadu_ps(&boundsMaxZ[index]))), zero);
+                    __m128 distance2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+                    int mask = _mm_movemask_ps(_mm_cmple_ps(distance2, radius2));
+                    for (int lane = 0; lane < 4; ++lane) {
+                        if (mask & (1 << lane)) {
+                            clusterLights[index + lane].push_back(volume.lightIndex);
+                        }
+                    }
+                }
+#endif
+                for (; x <= volume.tileX1; ++x) {
+                    size_t index = rowOffset + x;
+                    float dx = std::max(std::max(boundsMinX[index] - volume.center.x, volume.center.x - boundsMaxX[index]), 0.0f);
+                    float dy = std::max(std::max(boundsMinY[index] - volume.center.y, volume.center.y - boundsMaxY[index]), 0.0f);
+                    float dz = std::max(std::max(boundsMinZ[index] - volume.center.z, volume.center.z - boundsMaxZ[index]), 0.0f);
+                    if (dx * dx + dy * dy + dz * dz <= radiusSquared) {
+                        clusterLights[index].push_back(volume.lightIndex);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void ClusteredLighting::Bind() const {
+    glActiveTexture(GL_TEXTURE0 + Shader::CLUSTER_LIGHT_UNIT);
+    glBindTexture(GL_TEXTURE_BUFFER, lightDataTexture);
+    glActiveTexture(GL_TEXTURE0 + Shader::CLUSTER_GRID_UNIT);
+    glBindTexture(GL_TEXTURE_BUFFER, gridTexture);
+    glActiveTexture(GL_TEXTURE0 + Shader::CLUSTER_INDEX_UNIT);
+    glBindTexture(GL_TEXTURE_BUFFER, indexTexture);
+    glActiveTexture(GL_TEXTURE0);
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "Light.h"
+#include "LightBuffer.h"
+
+// Kümelenmiş (clustered) forward aydınlatma
+// görüş frustumu ekranda 16x9 karoya, derinlikte 24 üstel dilime bölünüyor. Nokta/spot ışıkların
+// menzil küreleri CPU'da kümelerin view uzayı kutularıyla test ediliyor (dilimler worker threadlerde,
+// kutu testi SSE2 ile 4 küme birden). Sonuç texture bufferlara yazılıyor (GL 3.3, SSBO gerekmiyor):
+// ışık verisi (4 x RGBA32F), küme başına (offset, sayı) ve ışık index listesi.
+// fragmentShader.glsl LightBlock'taki parametrelerle kendi kümesini bulup sadece o ışıkları dolaşıyor
+class ClusteredLighting {
+public:
+    static constexpr int CLUSTERS_X = 16; // fragmentShader.glsl CLUSTERS_* ile aynı
+    static constexpr int CLUSTERS_Y = 9;
+    static constexpr int CLUSTERS_Z = 24;
+    static constexpr int CLUSTER_COUNT = CLUSTERS_X * CLUSTERS_Y * CLUSTERS_Z;
+
+    // shader'ın kümeyi bulması için gerekenler: depth = near, far, dilim ölçeği, dilim kayması (log),
+    // viewport = x, y, karo genişliği, karo yüksekliği (piksel)
+    using ShaderParams = LightBuffer::ClusterParams;
+
+    struct Stats {
+        size_t lights = 0;
+        size_t lightIndices = 0;      // tüm kümelerdeki toplam ışık referansı
+        size_t activeClusters = 0;    // en az bir ışığı olan
+        size_t maxLightsPerCluster = 0;
+        double assignMs = 0.0;        // CPU atama + yükleme
+    };
+
+    ClusteredLighting();
+    ~ClusteredLighting();
+
+    // lights[first..] kümelere dağıtılıp yükleniyor, viewport o an bağlı olan
+    void Update(const std::vector<Light>& lights, size_t first, const glm::mat4& view, const glm::mat4& projection);
+    // texture bufferlar Shader::CLUSTER_*_UNIT birimlerine bağlanıyor
+    void Bind() const;
+
+    const ShaderParams& GetShaderParams() const { return shaderParams; }
+    const Stats& GetStats() const { return stats; }
+
+private:
+    // view uzayında ışığın menzil küresi ve kapladığı karo aralığı
+    struct LightVolume {
+        uint32_t lightIndex; // ışık verisindeki sırası
+        glm::vec3 center;
+        float radius;
+        float minDepth; // pozitif view derinliği
+        float maxDepth;
+        int tileX0, tileX1, tileY0, tileY1;
+    };
+
+    void RebuildClusterBounds(const glm::mat4& projection, int width, int height);
+    void AssignSlices(size_t sliceBegin, size_t sliceEnd);
+    int DepthToSlice(float depth) const;
+
+    // küme kutuları SoA, index = x + y * CLUSTERS_X + z * CLUSTERS_X * CLUSTERS_Y
+    std::vector<float> boundsMinX, boundsMinY, boundsMinZ;
+    std::vector<float> boundsMaxX, boundsMaxY, boundsMaxZ;
+    glm::mat4 boundsProjection = glm::mat4(0.0f);
+    int boundsWidth = 0;
+    int boundsHeight = 0;
+    float nearPlane = 0.1f;
+    float farPlane = 100.0f;
+
+    std::vector<LightVolume> volumes;
+    std::vector<std::vector<uint32_t>> clusterLights; // küme başına ışık indexleri
+    std::vector<uint32_t> gridData;    // küme başına offset, sayı
+    std::vector<uint32_t> indexData;
+    std::vector<float> lightData;
+
+    GLuint lightDataBuffer = 0;
+    GLuint lightDataTexture = 0;
+    GLuint gridBuffer = 0;
+    GLuint gridTexture = 0;
+    GLuint indexBuffer = 0;
+    GLuint indexTexture = 0;
+
+    ShaderParams shaderParams;
+    Stats stats;
+};
@@ -0,0 +1,136 @@
+#include "CubemapCapture.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+CubemapCapture::CubemapCapture() {
+    layeredShader = std::make_unique<Shader>("shaders/vertexShader.glsl", "shaders/fragmentShader.glsl",
+        "#define CUBEMAP_LAYERED\n", 0, "shaders/cubemapGeometry.glsl");
+    equirectShader = std::make_unique<Shader>("shaders/upscaleVertex.glsl", "shaders/equirectFragment.glsl");
+    glGenVertexArrays(1, &fullscreenVao);
+}
+
+CubemapCapture::~CubemapCapture() {
+    DestroyTargets();
+    glDeleteVertexArrays(1, &fullscreenVao);
+}
+
+bool CubemapCapture::EnsureTargets(int faceSize) {
+    if (framebuffer != 0 && faceSize == stats.faceSize) {
+        return true;
+    }
+    DestroyTargets();
+
+    // panoramaya bilineer okunuyor, yüz kenarları GL_TEXTURE_CUBE_MAP_SEAMLESS ile komşu yüzden
+    glGenTextures(1, &colorCube);
+    glBindTexture(GL_TEXTURE_CUBE_MAP, colorCube);
+    for (int face = 0; face < 6; ++face) {
+        glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, 0, GL_RGBA8, faceSize, faceSize, 0,
+            GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    }
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+
+    // katmanlı framebuffer'da tüm eklentiler katmanlı olmalı, derinlik de küp
+    glGenTextures(1, &depthCube);
+    glBindTexture(GL_TEXTURE_CUBE_MAP, depthCube);
+    for (int face = 0; face < 6; ++face) {
+        glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, 0, GL_DEPTH_COMPONENT24, faceSize, faceSize, 0,
+            GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+    }
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, colorCube, 0);
+    glFramebufferTexture(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, depthCube, 0);
+    bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(previousFramebuffer));
+
+    if (!complete) {
+        std::cerr << "Hata: kup harita hedefi olusturulamadi (" << faceSize << "x" << faceSize << ")" << std::endl;
+        DestroyTargets();
+        return false;
+    }
+    stats.faceSize = faceSize;
+    return true;
+}
+
+void CubemapCapture::DestroyTargets() {
+    glDeleteFramebuffers(1, &framebuffer);
+    glDeleteTextures(1, &colorCube);
+    glDeleteTextures(1, &depthCube);
+    framebuffer = 0;
+    colorCube = 0;
+    depthCube = 0;
+    stats.faceSize = 0;
+}
+
+bool CubemapCapture::BeginCube(const glm::vec3& center) {
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+    glGetIntegerv(GL_VIEWPORT, previousViewport);
+
+    int faceSize = std::max(64, previousViewport[3] / 2);
+    if (!EnsureTargets(faceSize)) {
+        return false;
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glViewport(0, 0, faceSize, faceSize);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    // küp texture yüz düzeni: yukarı vektörleri -y (yan yüzler) ve ±z, texture() ile örneklenince düz çıkıyor
+    static const glm::vec3 directions[6] = {
+        glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(-1.0f, 0.0f, 0.0f),
+        glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f),
+        glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 0.0f, -1.0f)
+    };
+    static const glm::vec3 ups[6] = {
+        glm::vec3(0.0f, -1.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f),
+        glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 0.0f, -1.0f),
+        glm::vec3(0.0f, -1.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f)
+    };
+    glm::mat4 projection = glm::perspective(glm::radians(90.0f), 1.0f, NEAR_PLANE, FAR_PLANE);
+    layeredShader->use();
+    for (int face = 0; face < 6; ++face) {
+        glm::mat4 view = glm::lookAt(center, center + directions[face], ups[face]);
+        layeredShader->setMat4("faceViewProjection[" + std::to_string(face) + "]", projection * view);
+    }
+    return true;
+}
+
+void CubemapCapture::EndCube() {
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(previousFramebuffer));
+    glViewport(previousViewport[0], previousViewport[1], previousViewport[2], previousViewport[3]);
+
+    // tam ekran üçgen, panoramanın derinliği yok
+    GLboolean depthTest = glIsEnabled(GL_DEPTH_TEST);
+    GLboolean blend = glIsEnabled(GL_BLEND);
+    GLboolean cullFace = glIsEnabled(GL_CULL_FACE);
+    GLboolean seamless = glIsEnabled(GL_TEXTURE_CUBE_MAP_SEAMLESS);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_BLEND);
+    glDisable(GL_CULL_FACE);
+    glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
+
+    equirectShader->use();
+    equirectShader->setInt("environment", 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_CUBE_MAP, colorCube);
+    glBindVertexArray(fullscreenVao);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glBindVertexArray(0);
+    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+
+    if (depthTest) glEnable(GL_DEPTH_TEST);
+    if (blend) glEnable(GL_BLEND);
+    if (cullFace) glEnable(GL_CULL_FACE);
+    if (!seamless) glDisable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
+    stats.captures++;
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <memory>
+#include "Shader.h"
+
+// Küp harita yakalama (eser panoramaları): bir noktadan altı yüz tek geçişte çiziliyor. Katmanlı framebuffer'a
+// (küp renk + küp derinlik) objenin shader'ının CUBEMAP_LAYERED varyantıyla, geometry shader her üçgeni gl_Layer ile
+// görünür olduğu yüzlere dağıtıyor; yüz başına ayrı çizim çağrısı ya da culling yok. Sonra küp tam ekran üçgenle
+// equirectangular panoramaya (genişlik = 2 x yükseklik) o an bağlı hedefe yeniden izdüşürülüyor.
+// Kullanım (SceneManager::DrawPanorama): BeginCube -> objeler GetLayeredShader ile -> EndCube
+class CubemapCapture {
+public:
+    struct Stats {
+        int faceSize = 0;
+        size_t captures = 0;
+    };
+
+    CubemapCapture();
+    ~CubemapCapture();
+
+    // o an bağlı hedef ve viewport saklanıyor, yüz boyu viewport yüksekliğinin yarısı (ekvatorda piksel yoğunluğu aynı).
+    // Küp hedefi bağlanıp temizleniyor, yüz matrisleri katmanlı shader'a yazılıyor
+    bool BeginCube(const glm::vec3& center);
+    // saklanan hedefe dönülüyor, küp equirectangular olarak viewport'a çiziliyor
+    void EndCube();
+
+    const Shader& GetLayeredShader() const { return *layeredShader; }
+    // yüzlerin uzak düzlemi, birleşik culling kutusunun yarı kenarı
+    float GetFarPlane() const { return FAR_PLANE; }
+    const Stats& GetStats() const { return stats; }
+
+private:
+    static constexpr float NEAR_PLANE = 0.1f;
+    static constexpr float FAR_PLANE = 100.0f; // ana kameranın projeksiyonuyla aynı
+
+    bool EnsureTargets(int faceSize);
+    void DestroyTargets();
+
+    Stats stats;
+    std::unique_ptr<Shader> layeredShader;
+    std::unique_ptr<Shader> equirectShader;
+    GLuint fullscreenVao = 0;
+
+    GLuint framebuffer = 0;
+    GLuint colorCube = 0;
+    GLuint depthCube = 0;
+
+    GLint previousFramebuffer = 0;
+    GLint previousViewport[4] = { 0, 0, 0, 0 };
+};
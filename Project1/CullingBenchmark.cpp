@@ -0,0 +1,249 @@
+#include "CullingBenchmark.h"
+#include "Frustum.h"
+#include "GpuCuller.h"
+#include "SceneBVH.h"
+#include "SimdCuller.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <chrono>
+#include <random>
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+
+namespace {
+    // ana kamerayla aynı projeksiyon, orijinden -Z'ye bakıyor
+    Frustum MakeBenchmarkFrustum() {
+        glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        glm::mat4 projection = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+        Frustum frustum;
+        frustum.Update(view, projection);
+        return frustum;
+    }
+}
+
+std::vector<CullingBenchmark::Result> CullingBenchmark::Run() {
+    std::vector<Result> results;
+    const size_t counts[] = { 1000, 10000, 100000 };
+
+    std::cout << "---- Culling benchmark (" << ITERATIONS << " tekrar ortalamasi) ----" << std::endl;
+    std::cout << std::setw(8) << "obje" << std::setw(12) << "CPU ms";
+    for (int isa = 0; isa < 4; ++isa) {
+        std::cout << std::setw(10) << SimdCuller::GetIsaName(static_cast<SimdCuller::Isa>(isa));
+    }
+    std::cout << std::setw(15) << "GPU gonder ms" << std::setw(16) << "GPU compute ms" << std::setw(10) << "gorunen" << std::endl;
+
+    for (size_t count : counts) {
+        Result result = RunSingle(count);
+        results.push_back(result);
+
+        std::cout << std::fixed << std::setprecision(3)
+            << std::setw(8) << result.objectCount
+            << std::setw(12) << result.cpuMs;
+        for (double simdMs : result.simdMs) {
+            std::cout << std::setw(10) << simdMs;
+        }
+        std::cout << std::setw(15) << result.gpuSubmitMs
+            << std::setw(16) << result.gpuDispatchMs
+            << std::setw(10) << result.cpuVisible;
+        if (result.simdVisible != result.cpuVisible) {
+            std::cout << "  (SIMD farkli: " << result.simdVisible << ")";
+        }
+        if (result.gpuDispatchMs >= 0.0 && result.gpuVisible != result.cpuVisible) {
+            std::cout << "  (GPU farkli: " << result.gpuVisible << ")";
+        }
+        std::cout << std::endl;
+    }
+    return results;
+}
+
+CullingBenchmark::Result CullingBenchmark::RunSingle(size_t objectCount) {
+    Result result;
+    result.objectCount = objectCount;
+
+    Frustum frustum = MakeBenchmarkFrustum();
+
+    // müze ölçeğinde dağınık objeler, yaklaşık yarısı kameranın önünde
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> radius(0.2f, 2.0f);
+
+    const GLuint BUCKETS = 8;
+    std::vector<GpuCuller::CullInput> inputs(objectCount);
+    std::vector<DrawElementsIndirectCommand> commands(objectCount);
+    std::vector<GLuint> bucketOffsets(BUCKETS);
+    for (size_t i = 0; i < objectCount; ++i) {
+        // bucketlar ardışık olmalı
+        GLuint bucket = static_cast<GLuint>(i * BUCKETS / objectCount);
+        inputs[i].sphere = glm::vec4(position(rng), position(rng), position(rng), radius(rng));
+        inputs[i].bucket = glm::uvec4(bucket, 0, 0, 0);
+        commands[i] = { 36, 1, 0, 0, static_cast<GLuint>(i) };
+    }
+    for (GLuint b = 0; b < BUCKETS; ++b) {
+        bucketOffsets[b] = static_cast<GLuint>(b * objectCount / BUCKETS);
+    }
+
+    // CPU
+    auto cpuStart = std::chrono::high_resolution_clock::now();
+    for (int it = 0; it < ITERATIONS; ++it) {
+        size_t visible = 0;
+        for (const auto& input : inputs) {
+            if (frustum.IsSphereVisible(glm::vec3(input.sphere), input.sphere.w)) {
+                visible++;
+            }
+        }
+        result.cpuVisible = visible;
+    }
+    result.cpuMs = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - cpuStart).count() / ITERATIONS;
+
+    // SoA + SIMD, CPU'nun desteklediği her yol ayrı ölçülüyor
+    SphereSoA spheres;
+    spheres.Reserve(objectCount);
+    for (const auto& input : inputs) {
+        spheres.Add(glm::vec3(input.sphere), input.sphere.w);
+    }
+    std::vector<uint64_t> visibleBits;
+    for (int isaIndex = 0; isaIndex < 4; ++isaIndex) {
+        SimdCuller::Isa isa = static_cast<SimdCuller::Isa>(isaIndex);
+        if (!SimdCuller::IsIsaSupported(isa)) {
+            continue;
+        }
+        auto simdStart = std::chrono::high_resolution_clock::now();
+        for (int it = 0; it < ITERATIONS; ++it) {
+            result.simdVisible = SimdCuller::CullSpheres(isa, frustum, spheres, visibleBits);
+        }
+        result.simdMs[isaIndex] = std::chrono::duration<double, std::milli>(
+            std::chrono::high_resolution_clock::now() - simdStart).count() / ITERATIONS;
+        if (result.simdVisible != result.cpuVisible) {
+            break;
+        }
+    }
+
+    if (!GpuCuller::IsSupported()) {
+        return result;
+    }
+
+    // GPU, ilk çağrı shader derleme ve buffer ayırma için ısınma
+    GpuCuller culler;
+    culler.Cull(frustum.GetPlanes(), commands, inputs, bucketOffsets);
+    glFinish();
+
+    GLuint query = 0;
+    glGenQueries(1, &query);
+    double submitTotal = 0.0;
+    double dispatchTotal = 0.0;
+    for (int it = 0; it < ITERATIONS; ++it) {
+        auto submitStart = std::chrono::high_resolution_clock::now();
+        glBeginQuery(GL_TIME_ELAPSED, query);
+        culler.Cull(frustum.GetPlanes(), commands, inputs, bucketOffsets);
+        glEndQuery(GL_TIME_ELAPSED);
+        submitTotal += std::chrono::duration<double, std::milli>(
+            std::chrono::high_resolution_clock::now() - submitStart).count();
+
+        GLuint64 elapsed = 0;
+        glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsed);
+        dispatchTotal += elapsed / 1.0e6;
+    }
+    glDeleteQueries(1, &query);
+
+    result.gpuSubmitMs = submitTotal / ITERATIONS;
+    result.gpuDispatchMs = dispatchTotal / ITERATIONS;
+    result.gpuVisible = culler.ReadVisibleCountNow();
+    return result;
+}
+
+std::vector<CullingBenchmark::BVHResult> CullingBenchmark::RunBVHScaling() {
+    std::vector<BVHResult> results;
+    const size_t counts[] = { 100, 1000, 10000, 100000 };
+
+    std::cout << "---- BVH olcekleme (" << ITERATIONS << " tekrar ortalamasi) ----" << std::endl;
+    std::cout << std::setw(8) << "obje" << std::setw(12) << "dogrusal ms" << std::setw(10) << "BVH ms"
+        << std::setw(11) << "kurma ms" << std::setw(10) << "refit ms" << std::setw(10) << "gorunen"
+        << std::setw(8) << "dugum" << std::endl;
+
+    for (size_t count : counts) {
+        BVHResult result = RunBVHSingle(count);
+        results.push_back(result);
+
+        std::cout << std::fixed << std::setprecision(3)
+            << std::setw(8) << result.objectCount
+            << std::setw(12) << result.linearMs
+            << std::setw(10) << result.bvhMs
+            << std::setw(11) << result.buildMs
+            << std::setw(10) << result.refitMs
+            << std::setw(10) << result.visible
+            << std::setw(8) << result.nodesVisited << std::endl;
+    }
+    return results;
+}
+
+CullingBenchmark::BVHResult CullingBenchmark::RunBVHSingle(size_t objectCount) {
+    BVHResult result;
+    result.objectCount = objectCount;
+
+    // m² başına ~0.25 obje, alan obje sayısıyla büyüyor; kamera ortada göz hizasında
+    float halfSize = std::sqrt(static_cast<float>(objectCount));
+    glm::vec3 eye(0.0f, 1.7f, 0.0f);
+    glm::mat4 view = glm::lookAt(eye, eye + glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    glm::mat4 projection = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+    Frustum frustum;
+    frustum.Update(view, projection);
+
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> position(-halfSize, halfSize);
+    std::uniform_real_distribution<float> height(0.0f, 3.0f);
+    std::uniform_real_distribution<float> extent(0.1f, 1.0f);
+
+    std::vector<SceneBVH::Item> items(objectCount);
+    for (size_t i = 0; i < objectCount; ++i) {
+        glm::vec3 center(position(rng), height(rng), position(rng));
+        glm::vec3 half(extent(rng), extent(rng), extent(rng));
+        items[i] = { center - half, center + half, static_cast<uint32_t>(i), 0 };
+    }
+
+    // doğrusal
+    auto linearStart = std::chrono::high_resolution_clock::now();
+    for (int it = 0; it < ITERATIONS; ++it) {
+        size_t visible = 0;
+        for (const auto& item : items) {
+            unsigned int planeMask = 0x3Fu;
+            if (frustum.ClassifyAABB(item.min, item.max, planeMask) != Frustum::Visibility::Outside) {
+                visible++;
+            }
+        }
+        result.visible = visible;
+    }
+    result.linearMs = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - linearStart).count() / ITERATIONS;
+
+    SceneBVH bvh;
+    auto buildStart = std::chrono::high_resolution_clock::now();
+    bvh.Build(items);
+    result.buildMs = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - buildStart).count();
+
+    auto refitStart = std::chrono::high_resolution_clock::now();
+    for (int it = 0; it < ITERATIONS; ++it) {
+        bvh.Refit();
+    }
+    result.refitMs = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - refitStart).count() / ITERATIONS;
+
+    std::vector<uint32_t> visibleItems;
+    visibleItems.reserve(objectCount);
+    auto bvhStart = std::chrono::high_resolution_clock::now();
+    for (int it = 0; it < ITERATIONS; ++it) {
+        visibleItems.clear();
+        SceneBVH::CullStats stats;
+        bvh.Cull(frustum, visibleItems, &stats);
+        result.nodesVisited = stats.nodesVisited;
+    }
+    result.bvhMs = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - bvhStart).count() / ITERATIONS;
+
+    if (visibleItems.size() != result.visible) {
+        std::cerr << "BVH sonucu dogrusal testten farkli: " << visibleItems.size()
+            << " / " << result.visible << std::endl;
+    }
+    return result;
+}
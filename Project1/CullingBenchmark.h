@@ -0,0 +1,43 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+
+// CPU ve GPU frustum culling karşılaştırması
+// sabit bir kamera ve sabit seed ile rastgele küreler üretiliyor ki sonuçlar tekrar edilebilsin
+// Render Ayarlari penceresindeki butondan çalıştırılıyor, sonuçlar konsola da yazılıyor
+class CullingBenchmark {
+public:
+    struct Result {
+        size_t objectCount = 0;
+        double cpuMs = 0.0;           // Frustum::IsSphereVisible döngüsü
+        double simdMs[4] = { -1.0, -1.0, -1.0, -1.0 }; // SimdCuller, Isa sırasıyla (desteklenmiyorsa -1)
+        size_t simdVisible = 0;
+        double gpuSubmitMs = -1.0;    // upload + dispatch CPU süresi (compute yoksa -1)
+        double gpuDispatchMs = -1.0;  // timer query ile ölçülen compute süresi
+        size_t cpuVisible = 0;
+        size_t gpuVisible = 0;
+    };
+
+    struct BVHResult {
+        size_t objectCount = 0;
+        double linearMs = 0.0;  // her kutu tek tek ClassifyAABB
+        double bvhMs = 0.0;     // SceneBVH::Cull
+        double buildMs = 0.0;
+        double refitMs = 0.0;
+        size_t visible = 0;
+        size_t nodesVisited = 0;
+    };
+
+    // 1k, 10k ve 100k obje için çalıştırır, GL context aktif olmalı
+    static std::vector<Result> Run();
+
+    // BVH'nin obje sayısıyla ölçeklenmesi: 100..100k, yoğunluk sabit tutuluyor
+    // (sahne büyüdükçe kameranın gördüğü kısım aynı kalıyor), GL gerekmiyor
+    static std::vector<BVHResult> RunBVHScaling();
+
+private:
+    static Result RunSingle(size_t objectCount);
+    static BVHResult RunBVHSingle(size_t objectCount);
+
+    static constexpr int ITERATIONS = 10;
+};
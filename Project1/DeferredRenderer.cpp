@@ -0,0 +1,265 @@
+#include "DeferredRenderer.h"
+#include "GeometryPool.h"
+#include "ShaderSetup.h"
+#include <glm/gtc/constants.hpp>
+#include <iostream>
+
+DeferredRenderer::DeferredRenderer() {
+    gbufferShader = std::make_unique<Shader>("shaders/vertexShader.glsl", "shaders/fragmentShader.glsl", "#define GBUFFER\n");
+    lightShader = std::make_unique<Shader>("shaders/deferredLightVertex.glsl", "shaders/deferredLightFragment.glsl");
+    resolveShader = std::make_unique<Shader>("shaders/deferredLightVertex.glsl", "shaders/deferredResolveFragment.glsl");
+
+    CreateLightVolume();
+    glGenVertexArrays(1, &fullscreenVao);
+    std::cout << "Deferred renderer hazir" << std::endl;
+}
+
+DeferredRenderer::~DeferredRenderer() {
+    DestroyTargets();
+    glDeleteVertexArrays(1, &sphereVao);
+    glDeleteBuffers(1, &sphereVbo);
+    glDeleteBuffers(1, &sphereEbo);
+    glDeleteVertexArrays(1, &fullscreenVao);
+}
+
+void DeferredRenderer::CreateLightVolume() {
+    std::vector<float> vertices;
+    std::vector<unsigned int> indices;
+    for (int ring = 0; ring <= SPHERE_RINGS; ++ring) {
+        float theta = glm::pi<float>() * ring / SPHERE_RINGS;
+        for (int segment = 0; segment <= SPHERE_SEGMENTS; ++segment) {
+            float phi = glm::two_pi<float>() * segment / SPHERE_SEGMENTS;
+            vertices.push_back(std::sin(theta) * std::cos(phi));
+            vertices.push_back(std::cos(theta));
+            vertices.push_back(std::sin(theta) * std::sin(phi));
+        }
+    }
+    // dışarıdan bakınca saat yönünün tersi (ön yüz)
+    for (int ring = 0; ring < SPHERE_RINGS; ++ring) {
+        for (int segment = 0; segment < SPHERE_SEGMENTS; ++segment) {
+            unsigned int current = ring * (SPHERE_SEGMENTS + 1) + segment;
+            unsigned int below = current + SPHERE_SEGMENTS + 1;
+            indices.insert(indices.end(), { current, current + 1, below });
+            indices.insert(indices.end(), { current + 1, below + 1, below });
+        }
+    }
+    sphereIndexCount = static_cast<GLsizei>(indices.size());
+
+    // çokgen yüzler gerçek kürenin içinde kalmasın diye köşeler dışarı itiliyor
+    sphereScale = 1.0f / (std::cos(glm::pi<float>() / SPHERE_SEGMENTS) * std::cos(glm::pi<float>() / SPHERE_RINGS));
+
+    glGenVertexArrays(1, &sphereVao);
+    glGenBuffers(1, &sphereVbo);
+    glGenBuffers(1, &sphereEbo);
+    glBindVertexArray(sphereVao);
+    glBindBuffer(GL_ARRAY_BUFFER, sphereVbo);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, sphereEbo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+    glBindVertexArray(0);
+}
+
+static GLuint CreateTargetTexture(GLint internalFormat, GLenum format, GLenum type, int width, int height) {
+    GLuint texture = 0;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, format, type, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    return texture;
+}
+
+bool DeferredRenderer::EnsureTargets(int width, int height) {
+    if (gbufferFbo != 0 && width == targetWidth && height == targetHeight) {
+        return true;
+    }
+    DestroyTargets();
+    if (width <= 0 || height <= 0) {
+        return false;
+    }
+
+    albedoTexture = CreateTargetTexture(GL_RGBA16F, GL_RGBA, GL_HALF_FLOAT, width, height);
+    normalTexture = CreateTargetTexture(GL_RGBA16, GL_RGBA, GL_UNSIGNED_SHORT, width, height);
+    depthTexture = CreateTargetTexture(GL_DEPTH_COMPONENT24, GL_DEPTH_COMPONENT, GL_UNSIGNED_INT, width, height);
+    lightTexture = CreateTargetTexture(GL_RGBA16F, GL_RGBA, GL_HALF_FLOAT, width, height);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glGenFramebuffers(1, &gbufferFbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, gbufferFbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, albedoTexture, 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, normalTexture, 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depthTexture, 0);
+    const GLenum drawBuffers[2] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
+    glDrawBuffers(2, drawBuffers);
+    bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+
+    // ışık bufferı derinlik okumuyor, derinlik shaderda G-buffer'dan okunuyor
+    glGenFramebuffers(1, &lightFbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, lightFbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, lightTexture, 0);
+    complete = complete && glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    if (!complete) {
+        std::cerr << "Hata: deferred G-buffer olusturulamadi (" << width << "x" << height << ")" << std::endl;
+        DestroyTargets();
+        return false;
+    }
+
+    targetWidth = width;
+    targetHeight = height;
+    return true;
+}
+
+void DeferredRenderer::DestroyTargets() {
+    glDeleteFramebuffers(1, &gbufferFbo);
+    glDeleteFramebuffers(1, &lightFbo);
+    glDeleteTextures(1, &albedoTexture);
+    glDeleteTextures(1, &normalTexture);
+    glDeleteTextures(1, &depthTexture);
+    glDeleteTextures(1, &lightTexture);
+    gbufferFbo = lightFbo = 0;
+    albedoTexture = normalTexture = depthTexture = lightTexture = 0;
+    targetWidth = targetHeight = 0;
+}
+
+void DeferredRenderer::Render(const std::vector<MuseumObject*>& objects, const std::vector<Light>& lights,
+    const glm::mat4& view, const glm::mat4& projection, const glm::vec3& viewPos) {
+    PollQueries();
+
+    GLint targetFramebuffer = 0;
+    GLint viewport[4] = { 0, 0, 0, 0 };
+    GLfloat clearColor[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &targetFramebuffer);
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    glGetFloatv(GL_COLOR_CLEAR_VALUE, clearColor);
+    if (!EnsureTargets(viewport[2], viewport[3])) {
+        return;
+    }
+    glViewport(0, 0, targetWidth, targetHeight);
+
+    geometryTimer.Begin();
+    GeometryPass(objects, view, projection, viewPos);
+    geometryTimer.End();
+    lightingTimer.Begin();
+    LightingPass(lights, projection * view, viewPos);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(targetFramebuffer));
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+    ResolvePass(viewport[0], viewport[1]);
+    glClearColor(clearColor[0], clearColor[1], clearColor[2], clearColor[3]);
+    lightingTimer.End();
+}
+
+void DeferredRenderer::GeometryPass(const std::vector<MuseumObject*>& objects, const glm::mat4& view,
+    const glm::mat4& projection, const glm::vec3& viewPos) {
+    glBindFramebuffer(GL_FRAMEBUFFER, gbufferFbo);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    glEnable(GL_DEPTH_TEST);
+    glDepthFunc(GL_LESS);
+    glDepthMask(GL_TRUE);
+
+    gbufferShader->use();
+    gbufferShader->setInt("diffuseMap", 0);
+    for (MuseumObject* object : objects) {
+        object->DrawGBuffer(*gbufferShader, view, projection, viewPos);
+    }
+    stats.objects = objects.size();
+}
+
+void DeferredRenderer::LightingPass(const std::vector<Light>& lights, const glm::mat4& viewProjection,
+    const glm::vec3& viewPos) {
+    glBindFramebuffer(GL_FRAMEBUFFER, lightFbo);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    // ışıklar toplanıyor, derinlik testi yok (menzil dışı pikseller shaderda 0 dönüyor)
+    glDisable(GL_DEPTH_TEST);
+    glDepthMask(GL_FALSE);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE);
+    // küre uzak düzlemi aşsa da kırpılmasın
+    glEnable(GL_DEPTH_CLAMP);
+    glEnable(GL_CULL_FACE);
+    glCullFace(GL_FRONT);
+
+    lightShader->use();
+    lightShader->setInt("gAlbedo", 0);
+    lightShader->setInt("gNormal", 1);
+    lightShader->setInt("gDepth", 2);
+    lightShader->setMat4("viewProjection", viewProjection);
+    lightShader->setMat4("inverseViewProjection", glm::inverse(viewProjection));
+    lightShader->setVec3("viewPos", viewPos);
+    lightShader->setIVec2("viewportOrigin", glm::ivec2(0, 0));
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, albedoTexture);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, normalTexture);
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_2D, depthTexture);
+
+    stats.volumeLights = 0;
+    stats.fullscreenLights = 0;
+    for (const Light& light : lights) {
+        ShaderSetup::SetupLight(*lightShader, light);
+        if (light.GetType() == Light::Type::DIRECTIONAL) {
+            // arka yüz ayıklaması tam ekran üçgeni etkilemesin
+            glDisable(GL_CULL_FACE);
+            lightShader->setBool("fullscreen", true);
+            glBindVertexArray(fullscreenVao);
+            glDrawArrays(GL_TRIANGLES, 0, 3);
+            glEnable(GL_CULL_FACE);
+            stats.fullscreenLights++;
+        }
+        else {
+            // sadece arka yüzler: kamera kürenin içinde de olsa her piksel bir kere
+            lightShader->setBool("fullscreen", false);
+            lightShader->setVec3("volumeCenter", light.GetPosition());
+            lightShader->setFloat("volumeRadius", light.GetRange() * sphereScale);
+            glBindVertexArray(sphereVao);
+            glDrawElements(GL_TRIANGLES, sphereIndexCount, GL_UNSIGNED_INT, 0);
+            stats.volumeLights++;
+        }
+    }
+    glBindVertexArray(0);
+
+    glCullFace(GL_BACK);
+    glDisable(GL_CULL_FACE);
+    glDisable(GL_DEPTH_CLAMP);
+    glDisable(GL_BLEND);
+}
+
+void DeferredRenderer::ResolvePass(int originX, int originY) {
+    // hedefin rengi ve derinliği yazılıyor, arka plan pikselleri olduğu gibi kalıyor
+    glEnable(GL_DEPTH_TEST);
+    glDepthFunc(GL_ALWAYS);
+    glDepthMask(GL_TRUE);
+
+    resolveShader->use();
+    resolveShader->setBool("fullscreen", true);
+    resolveShader->setInt("gAlbedo", 0);
+    resolveShader->setInt("gDepth", 2);
+    resolveShader->setInt("lightAccumulation", 3);
+    resolveShader->setIVec2("viewportOrigin", glm::ivec2(originX, originY));
+    glActiveTexture(GL_TEXTURE3);
+    glBindTexture(GL_TEXTURE_2D, lightTexture);
+    glBindVertexArray(fullscreenVao);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glBindVertexArray(0);
+
+    for (int unit = 3; unit >= 0; --unit) {
+        glActiveTexture(GL_TEXTURE0 + unit);
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+    glDepthFunc(GL_LESS);
+}
+
+void DeferredRenderer::PollQueries() {
+    geometryTimer.Poll([this](const GpuTimer::Result& result) { GpuTimer::Smooth(stats.geometryMs, result.ms); });
+    lightingTimer.Poll([this](const GpuTimer::Result& result) { GpuTimer::Smooth(stats.lightingMs, result.ms); });
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+#include "MuseumObject.h"
+#include "Light.h"
+#include "Shader.h"
+#include "GpuTimer.h"
+
+// Deferred shading yolu (forward'a alternatif)
+// G-buffer geçişi: albedo + parlaklık çarpanı (RGBA16F), oktahedral normal + roughness/metallic (RGBA16),
+// derinlik (dünya konumu bundan geri hesaplanıyor). Materyal kodu fragmentShader.glsl'in GBUFFER varyantı.
+// Işık geçişi: her ışık sadece ekranda kapladığı yerde hesaplanıyor, nokta ve spot ışıklar menzil
+// küresinin arka yüzleriyle (kamera içerideyken de tek kat), yönlü ışıklar tam ekran üçgenle.
+// BRDF forward yolla aynı (brdf.glsl), sonuç HDR bufferında toplanıp resolve'da tonemap ediliyor.
+// Çizim o an bağlı framebuffer'a ve viewport'a yapılıyor, resolve hedefin derinliğini de dolduruyor
+class DeferredRenderer {
+public:
+    struct Stats {
+        size_t objects = 0;
+        size_t volumeLights = 0;     // küre ile çizilen nokta/spot ışık
+        size_t fullscreenLights = 0; // yönlü ışık
+        double geometryMs = -1.0;    // G-buffer geçişinin GPU süresi
+        double lightingMs = -1.0;    // ışık + resolve geçişi
+    };
+
+    // forward/deferred karşılaştırması (SceneManager::RunLightingBenchmark)
+    struct BenchmarkResult {
+        size_t lightCount = 0;
+        double forwardMs = 0.0;  // müze objelerinin GPU süresi, frame ortalaması
+        double clusteredMs = 0.0; // kümelenmiş forward
+        double deferredMs = 0.0;
+    };
+
+    DeferredRenderer();
+    ~DeferredRenderer();
+
+    void Render(const std::vector<MuseumObject*>& objects, const std::vector<Light>& lights,
+        const glm::mat4& view, const glm::mat4& projection, const glm::vec3& viewPos);
+
+    const Stats& GetStats() const { return stats; }
+
+private:
+    static constexpr int SPHERE_RINGS = 12;
+    static constexpr int SPHERE_SEGMENTS = 16;
+
+    bool EnsureTargets(int width, int height);
+    void DestroyTargets();
+    void CreateLightVolume();
+    void PollQueries();
+
+    void GeometryPass(const std::vector<MuseumObject*>& objects, const glm::mat4& view,
+        const glm::mat4& projection, const glm::vec3& viewPos);
+    void LightingPass(const std::vector<Light>& lights, const glm::mat4& viewProjection, const glm::vec3& viewPos);
+    void ResolvePass(int originX, int originY);
+
+    std::unique_ptr<Shader> gbufferShader;
+    std::unique_ptr<Shader> lightShader;
+    std::unique_ptr<Shader> resolveShader;
+
+    GLuint gbufferFbo = 0;
+    GLuint albedoTexture = 0;
+    GLuint normalTexture = 0;
+    GLuint depthTexture = 0;
+    GLuint lightFbo = 0;
+    GLuint lightTexture = 0;
+    int targetWidth = 0;
+    int targetHeight = 0;
+
+    // birim küre, menzili kesin kapsasın diye köşe yarıçapı biraz büyük
+    GLuint sphereVao = 0;
+    GLuint sphereVbo = 0;
+    GLuint sphereEbo = 0;
+    GLsizei sphereIndexCount = 0;
+    float sphereScale = 1.0f;
+    GLuint fullscreenVao = 0;
+
+    GpuTimer geometryTimer;
+    GpuTimer lightingTimer; // ışık birikimi + resolve
+
+    Stats stats;
+};
@@ -0,0 +1,84 @@
+#include "DepthPrepass.h"
+#include "GLExtensions.h"
+#include <iostream>
+
+DepthPrepass::DepthPrepass() {
+    depthShader = std::make_unique<Shader>("shaders/depthPrepassVertex.glsl", "shaders/depthPrepassFragment.glsl");
+    stats.pipelineStatistics = GLExtensions::HasPipelineStatistics();
+    invocationTarget = stats.pipelineStatistics ? GL_FRAGMENT_SHADER_INVOCATIONS : GL_SAMPLES_PASSED;
+    prepassTimer = std::make_unique<GpuTimer>();
+    colorTimer = std::make_unique<GpuTimer>(invocationTarget);
+    std::cout << "Derinlik on gecisi hazir (" << (stats.pipelineStatistics ? "fragment shader cagrisi" : "sample sayisi")
+        << " olculuyor)" << std::endl;
+}
+
+bool DepthPrepass::BeginFrame(bool enabled) {
+    frame++;
+    PollQueries();
+
+    // kapalıyken her frame karşılaştırma değerini ölçüyor, açıkken ara sıra
+    if (enabled && frame % BASELINE_INTERVAL == 0) {
+        baselineRequested = true;
+    }
+    measuringThisFrame = colorTimer->CanBegin();
+    bool baselineFrame = !enabled || (baselineRequested && measuringThisFrame);
+    if (enabled && baselineFrame) {
+        baselineRequested = false;
+    }
+
+    activeThisFrame = !baselineFrame;
+    colorPassMeasured = false;
+    return activeThisFrame;
+}
+
+void DepthPrepass::DrawDepth(const std::vector<MuseumObject*>& objects, const glm::mat4& view, const glm::mat4& projection) {
+    prepassTimer->Begin();
+
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    glDepthFunc(GL_LESS);
+    glDepthMask(GL_TRUE);
+
+    depthShader->use();
+    depthShader->setMat4("view", view);
+    depthShader->setMat4("projection", projection);
+    for (MuseumObject* object : objects) {
+        object->DrawDepth(*depthShader);
+    }
+
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+
+    prepassTimer->End();
+}
+
+void DepthPrepass::BeginColorPass(bool measure) {
+    if (activeThisFrame) {
+        // derinlik zaten son haliyle bufferda, sadece en öndeki yüzey geçiyor
+        glDepthFunc(GL_EQUAL);
+        glDepthMask(GL_FALSE);
+    }
+
+    colorPassMeasured = measure && measuringThisFrame && colorTimer->Begin(activeThisFrame ? 1.0f : 0.0f);
+}
+
+void DepthPrepass::EndColorPass() {
+    if (activeThisFrame) {
+        glDepthFunc(GL_LESS);
+        glDepthMask(GL_TRUE);
+    }
+
+    if (colorPassMeasured) {
+        colorTimer->End();
+    }
+}
+
+void DepthPrepass::PollQueries() {
+    prepassTimer->Poll([this](const GpuTimer::Result& result) {
+        GpuTimer::Smooth(stats.prepassMs, result.ms);
+    });
+    colorTimer->Poll([this](const GpuTimer::Result& result) {
+        bool withPrepass = result.tag != 0.0f;
+        GpuTimer::Smooth(withPrepass ? stats.colorPassMs : stats.baselineColorPassMs, result.ms);
+        GpuTimer::Smooth(withPrepass ? stats.colorInvocations : stats.baselineInvocations,
+            static_cast<double>(result.count));
+    });
+}
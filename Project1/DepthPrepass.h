@@ -0,0 +1,60 @@
+#pragma once
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include "MuseumObject.h"
+#include "Shader.h"
+#include "GpuTimer.h"
+
+// Derinlik ön geçişi (depth pre-pass)
+// görünür objeler önce sadece konum akışı ve boş bir shader ile derinliğe yazılıyor,
+// ardından renk geçişi GL_EQUAL testiyle ve derinlik yazmadan çiziliyor.
+// Böylece PBR fragment shader'ı her pikselde sadece en öndeki yüzey için çalışıyor.
+// Kazancı göstermek için renk geçişinin GPU süresi ve fragment shader çağrı sayısı
+// (GL 4.6 / ARB_pipeline_statistics_query, yoksa geçen sample sayısı) ölçülüyor,
+// açıkken ara sıra bir frame ön geçişsiz çizilip karşılaştırma değeri tazeleniyor
+// Kullanım (her frame): BeginFrame -> (true ise) DrawDepth -> BeginColorPass -> çizim -> EndColorPass
+class DepthPrepass {
+public:
+    struct Stats {
+        double prepassMs = -1.0;          // ön geçişin GPU süresi
+        double colorPassMs = -1.0;        // ön geçişli renk geçişi
+        double baselineColorPassMs = -1.0; // ön geçişsiz renk geçişi
+        double colorInvocations = -1.0;    // ön geçişli fragment shader çağrısı (frame başına)
+        double baselineInvocations = -1.0;
+        bool pipelineStatistics = false;   // false ise sayılar GL_SAMPLES_PASSED
+    };
+
+    DepthPrepass();
+
+    // bu frame ön geçiş yapılacaksa true (kapalıyken ya da ölçüm frame'inde false)
+    bool BeginFrame(bool enabled);
+    void DrawDepth(const std::vector<MuseumObject*>& objects, const glm::mat4& view, const glm::mat4& projection);
+
+    // measure false ise sorgu açılmıyor (ör. occlusion query'leri aynı hedefi kullanırken)
+    void BeginColorPass(bool measure);
+    void EndColorPass();
+
+    const Stats& GetStats() const { return stats; }
+
+private:
+    static constexpr size_t BASELINE_INTERVAL = 120;  // açıkken bu kadar frame'de bir ön geçişsiz ölçüm
+
+    void PollQueries();
+
+    std::unique_ptr<Shader> depthShader;
+    std::unique_ptr<GpuTimer> prepassTimer;
+    // fragment shader çağrısını da sayıyor, tag 1 ön geçişli renk geçişi
+    std::unique_ptr<GpuTimer> colorTimer;
+    GLenum invocationTarget = GL_SAMPLES_PASSED;
+
+    size_t frame = 0;
+    bool baselineRequested = false;
+    bool activeThisFrame = false;
+    bool measuringThisFrame = false; // renk geçişi bu frame ölçülebilir (halkada yer var)
+    bool colorPassMeasured = false;
+
+    Stats stats;
+};
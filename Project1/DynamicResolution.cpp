@@ -0,0 +1,179 @@
+#include "DynamicResolution.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+DynamicResolution::DynamicResolution() {
+    upscaleShader = std::make_unique<Shader>("shaders/upscaleVertex.glsl", "shaders/upscaleFragment.glsl");
+    glGenVertexArrays(1, &fullscreenVao);
+}
+
+DynamicResolution::~DynamicResolution() {
+    DestroyTargets();
+    glDeleteVertexArrays(1, &fullscreenVao);
+}
+
+void DynamicResolution::SetSettings(const Settings& newSettings) {
+    settings = newSettings;
+    settings.minScale = glm::clamp(settings.minScale, 0.25f, 1.0f);
+    settings.maxScale = glm::clamp(settings.maxScale, settings.minScale, 1.0f);
+    settings.fixedScale = glm::clamp(settings.fixedScale, 0.25f, 1.0f);
+    settings.hysteresis = glm::clamp(settings.hysteresis, 0.0f, 0.9f);
+    settings.targetMs = std::max(settings.targetMs, 0.1f);
+}
+
+bool DynamicResolution::EnsureTargets(int width, int height) {
+    if (framebuffer != 0 && width == targetWidth && height == targetHeight) {
+        return true;
+    }
+    DestroyTargets();
+
+    // büyütmede bilineer okunuyor, kenarda komşu piksel tekrar ediyor
+    glGenTextures(1, &colorTexture);
+    glBindTexture(GL_TEXTURE_2D, colorTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glGenRenderbuffers(1, &depthRenderbuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthRenderbuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colorTexture, 0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthRenderbuffer);
+    bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    if (!complete) {
+        std::cerr << "Hata: dinamik cozunurluk hedefi olusturulamadi (" << width << "x" << height << ")" << std::endl;
+        DestroyTargets();
+        return false;
+    }
+    targetWidth = width;
+    targetHeight = height;
+    return true;
+}
+
+void DynamicResolution::DestroyTargets() {
+    glDeleteFramebuffers(1, &framebuffer);
+    glDeleteTextures(1, &colorTexture);
+    glDeleteRenderbuffers(1, &depthRenderbuffer);
+    framebuffer = 0;
+    colorTexture = 0;
+    depthRenderbuffer = 0;
+    targetWidth = targetHeight = 0;
+}
+
+void DynamicResolution::BeginFrame(int windowWidth, int windowHeight) {
+    PollQueries();
+
+    float frameScale = settings.enabled ? scale : settings.fixedScale;
+    stats.outputWidth = windowWidth;
+    stats.outputHeight = windowHeight;
+    stats.offscreen = frameScale < 1.0f && windowWidth > 0 && windowHeight > 0 &&
+        EnsureTargets(windowWidth, windowHeight);
+    if (!stats.offscreen) {
+        // tam ölçekte ara hedef yok, büyütme geçişinin maliyeti de yok
+        frameScale = 1.0f;
+        if (!settings.enabled && framebuffer != 0) {
+            DestroyTargets();
+        }
+    }
+    stats.scale = frameScale;
+    stats.renderWidth = std::max(1, static_cast<int>(std::lround(windowWidth * frameScale)));
+    stats.renderHeight = std::max(1, static_cast<int>(std::lround(windowHeight * frameScale)));
+
+    glBindFramebuffer(GL_FRAMEBUFFER, stats.offscreen ? framebuffer : 0);
+    glViewport(0, 0, stats.renderWidth, stats.renderHeight);
+
+    sceneTimer.Begin(frameScale);
+}
+
+void DynamicResolution::EndFrame() {
+    sceneTimer.End();
+
+    if (stats.offscreen) {
+        upscaleTimer.Begin();
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glViewport(0, 0, stats.outputWidth, stats.outputHeight);
+
+        // tam ekran üçgen, sahnenin derinliği pencereye taşınmıyor (ImGui derinlik kullanmıyor)
+        GLboolean depthTest = glIsEnabled(GL_DEPTH_TEST);
+        GLboolean blend = glIsEnabled(GL_BLEND);
+        GLboolean cullFace = glIsEnabled(GL_CULL_FACE);
+        glDisable(GL_DEPTH_TEST);
+        glDisable(GL_BLEND);
+        glDisable(GL_CULL_FACE);
+
+        upscaleShader->use();
+        upscaleShader->setInt("sceneColor", 0);
+        // kullanılan bölge texture koordinatında ve kaynak texel boyu
+        upscaleShader->setVec2("sourceScale", glm::vec2(static_cast<float>(stats.renderWidth) / targetWidth,
+            static_cast<float>(stats.renderHeight) / targetHeight));
+        upscaleShader->setVec2("sourceTexel", glm::vec2(1.0f / targetWidth, 1.0f / targetHeight));
+        upscaleShader->setFloat("sharpness", settings.sharpness);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, colorTexture);
+        glBindVertexArray(fullscreenVao);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        glBindVertexArray(0);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        if (depthTest) glEnable(GL_DEPTH_TEST);
+        if (blend) glEnable(GL_BLEND);
+        if (cullFace) glEnable(GL_CULL_FACE);
+        upscaleTimer.End();
+    }
+}
+
+void DynamicResolution::PollQueries() {
+    upscaleTimer.Poll([this](const GpuTimer::Result& result) {
+        GpuTimer::Smooth(stats.upscaleMs, result.ms, UPSCALE_SMOOTHING);
+    });
+    sceneTimer.Poll([this](const GpuTimer::Result& result) {
+        // ölçek değişmeden önce çizilmiş frame'ler yeni ölçeğin süresine karışmasın
+        float currentScale = settings.enabled ? scale : settings.fixedScale;
+        if (result.tag != currentScale && !(currentScale >= 1.0f && result.tag >= 1.0f)) {
+            return;
+        }
+        GpuTimer::Smooth(stats.sceneMs, result.ms, SCENE_SMOOTHING);
+        if (settings.enabled) {
+            UpdateScale(stats.sceneMs);
+        }
+    });
+}
+
+void DynamicResolution::UpdateScale(double sceneMs) {
+    if (cooldown > 0) {
+        cooldown--;
+        return;
+    }
+
+    float upper = settings.targetMs * (1.0f + settings.hysteresis);
+    float lower = settings.targetMs * (1.0f - settings.hysteresis);
+    bool tooSlow = sceneMs > upper && scale > settings.minScale;
+    bool tooFast = sceneMs < lower && scale < settings.maxScale;
+    if (!tooSlow && !tooFast) {
+        // ayarlar değiştiyse sınırların dışında kalmasın
+        scale = glm::clamp(scale, settings.minScale, settings.maxScale);
+        return;
+    }
+
+    // süre piksel sayısıyla (ölçeğin karesi) orantılı kabul ediliyor, adım sınırlı ve yüzdeye yuvarlanıyor
+    float desired = scale * std::sqrt(settings.targetMs / static_cast<float>(std::max(sceneMs, 0.01)));
+    desired = glm::clamp(desired, scale - MAX_SCALE_STEP, scale + MAX_SCALE_STEP);
+    desired = glm::clamp(std::round(desired * 100.0f) / 100.0f, settings.minScale, settings.maxScale);
+    if (desired == scale) {
+        return;
+    }
+    scale = desired;
+    stats.sceneMs = -1.0;
+    stats.scaleChanges++;
+    cooldown = COOLDOWN_FRAMES;
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <memory>
+#include "Shader.h"
+#include "GpuTimer.h"
+
+// Dinamik çözünürlük: sahne pencere yerine ekran dışı bir hedefe, eksen başına minScale-maxScale oranında çiziliyor,
+// sonra keskinleştirerek pencereye büyütülüyor (ImGui bundan sonra doğal çözünürlükte).
+// Hedef pencere boyunda bir kere ayrılıyor, küçük çözünürlükte sadece sol alt köşesi kullanılıyor (ölçek değişince
+// yeniden ayırma yok). Ölçek sahne geçişinin GPU süresinden (timestamp sorguları, birkaç frame gecikmeli) ayarlanıyor:
+// süre hedefin hysteresis bandı dışına çıkınca piksel sayısıyla orantılı varsayılarak yeni ölçek seçiliyor.
+// Kullanım (her frame): BeginFrame -> sahne -> EndFrame (büyütme) -> ImGui
+class DynamicResolution {
+public:
+    struct Settings {
+        bool enabled = true;        // kapalıyken ölçek fixedScale, 1 ise doğrudan pencereye çiziliyor
+        float targetMs = 14.0f;     // sahne geçişinin GPU süresi hedefi (60 Hz vsync için pay bırakıldı)
+        float hysteresis = 0.15f;   // hedefin bu oranı kadar altı/üstü bant, içindeyken ölçek değişmiyor
+        float minScale = 0.5f;
+        float maxScale = 1.0f;
+        float fixedScale = 1.0f;
+        float sharpness = 0.5f;     // 0 ise sadece bilineer büyütme
+    };
+
+    struct Stats {
+        float scale = 1.0f;
+        int renderWidth = 0;
+        int renderHeight = 0;
+        int outputWidth = 0;
+        int outputHeight = 0;
+        double sceneMs = -1.0;       // bu ölçekteki yumuşatılmış GPU süresi
+        double upscaleMs = -1.0;     // büyütme + keskinleştirme geçişi
+        size_t scaleChanges = 0;
+        bool offscreen = false;      // bu frame ekran dışı hedef kullanıldı
+    };
+
+    DynamicResolution();
+    ~DynamicResolution();
+
+    // pencerenin framebuffer boyu; ekran dışı hedef bağlanıp viewport ayarlanıyor (ölçek 1 ve kapalıysa pencere)
+    void BeginFrame(int windowWidth, int windowHeight);
+    // sahne bitti: pencereye büyütülüyor, framebuffer 0 ve tam viewport geri geliyor
+    void EndFrame();
+
+    void SetSettings(const Settings& newSettings);
+    const Settings& GetSettings() const { return settings; }
+    const Stats& GetStats() const { return stats; }
+
+private:
+    static constexpr float MAX_SCALE_STEP = 0.1f; // tek ayarda en fazla
+    static constexpr int COOLDOWN_FRAMES = 6;     // ölçek değişince yeni süreler oturana kadar
+    // sahne süresi ölçeği sürüyor, yük değişimine birkaç frame'de tepki versin diye daha az yumuşatılıyor
+    // (ölçek değişince zaten sıfırlanıyor); büyütme süresi sadece gösterim için
+    static constexpr double SCENE_SMOOTHING = 0.2;
+    static constexpr double UPSCALE_SMOOTHING = GpuTimer::DEFAULT_SMOOTHING;
+
+    bool EnsureTargets(int width, int height);
+    void DestroyTargets();
+    void PollQueries();
+    void UpdateScale(double sceneMs);
+
+    Settings settings;
+    Stats stats;
+    float scale = 1.0f;
+    int cooldown = 0;
+
+    GLuint framebuffer = 0;
+    GLuint colorTexture = 0;
+    GLuint depthRenderbuffer = 0;
+    int targetWidth = 0;
+    int targetHeight = 0;
+
+    std::unique_ptr<Shader> upscaleShader;
+    GLuint fullscreenVao = 0;
+    GpuTimer sceneTimer;   // tag frame'in çizildiği ölçek
+    GpuTimer upscaleTimer; // sadece ekran dışı hedefli frame'lerde
+};
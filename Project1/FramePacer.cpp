@@ -0,0 +1,107 @@
+#include "FramePacer.h"
+#include <algorithm>
+
+FramePacer::FramePacer() {
+    windowStart = glfwGetTime();
+}
+
+void FramePacer::SetSettings(const Settings& newSettings) {
+    settings = newSettings;
+    settings.maxFps = std::max(settings.maxFps, 0);
+    settings.activeSeconds = std::clamp(settings.activeSeconds, 0.0f, 10.0f);
+    settings.idleWaitSeconds = std::clamp(settings.idleWaitSeconds, 0.05f, 5.0f);
+    // ayar değişikliğinin kendisi de görünsün
+    redrawRequested = true;
+}
+
+void FramePacer::NotifyInput() {
+    lastActivity = glfwGetTime();
+}
+
+void FramePacer::RequestRedraw() {
+    redrawRequested = true;
+}
+
+void FramePacer::WatchValues(const std::vector<float>& values) {
+    if (values != watchedValues) {
+        watchedValues = values;
+        lastActivity = glfwGetTime();
+    }
+}
+
+bool FramePacer::ShouldRender() {
+    double now = glfwGetTime();
+    bool render = !settings.renderOnDemand || redrawRequested || now - lastActivity < settings.activeSeconds;
+    redrawRequested = false;
+    stats.idle = !render;
+    if (render) {
+        frameStart = now;
+    }
+    else {
+        stats.skippedFrames++;
+        windowSkipped++;
+    }
+    return render;
+}
+
+void FramePacer::BeginFrame() {
+    PollQueries();
+    frameTimer.Begin();
+}
+
+void FramePacer::EndFrame() {
+    frameTimer.End();
+    // swap (vsync beklemesi) ve frame sınırı beklemesi hariç
+    busySeconds += glfwGetTime() - frameStart;
+    stats.renderedFrames++;
+    windowRendered++;
+}
+
+void FramePacer::PollQueries() {
+    frameTimer.Poll([this](const GpuTimer::Result& result) { GpuTimer::Smooth(stats.gpuFrameMs, result.ms); });
+}
+
+bool FramePacer::WaitForNextFrame() {
+    double now = glfwGetTime();
+    bool idleWait = settings.renderOnDemand && !redrawRequested && now - lastActivity >= settings.activeSeconds;
+    if (idleWait) {
+        // olay gelirse callback'ler NotifyInput ile uyandırıyor, gelmezse zaman aşımında durum yeniden kontrol
+        glfwWaitEventsTimeout(settings.idleWaitSeconds);
+    }
+    else if (settings.maxFps > 0 && !stats.idle) {
+        // erken dönen beklemeler (fare hareketi) sınırı bozmasın diye son tarihe kadar tekrar
+        double deadline = frameStart + 1.0 / settings.maxFps;
+        if (now < deadline) {
+            while (now < deadline) {
+                glfwWaitEventsTimeout(deadline - now);
+                now = glfwGetTime();
+            }
+        }
+        else {
+            glfwPollEvents();
+        }
+    }
+    else {
+        glfwPollEvents();
+    }
+
+    UpdateStats(glfwGetTime());
+    return idleWait;
+}
+
+void FramePacer::UpdateStats(double now) {
+    double elapsed = now - windowStart;
+    if (elapsed < STATS_WINDOW) {
+        return;
+    }
+    stats.renderedFps = windowRendered / elapsed;
+    stats.wakeupsPerSecond = windowSkipped / elapsed;
+    stats.cpuBusy = std::min(1.0, busySeconds / elapsed);
+    // ölçülmeyen frame'ler ölçülenlerin ortalamasıyla sayılıyor
+    stats.gpuBusy = stats.gpuFrameMs < 0.0 ? 0.0 : std::min(1.0, windowRendered * stats.gpuFrameMs / 1000.0 / elapsed);
+
+    windowStart = now;
+    busySeconds = 0.0;
+    windowRendered = 0;
+    windowSkipped = 0;
+}
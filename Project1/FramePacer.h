@@ -0,0 +1,79 @@
+#pragma once
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <cstddef>
+#include <vector>
+#include "GpuTimer.h"
+
+// İsteğe bağlı çizim: kiosk başında kimse yokken sahne değişmiyor, frame çizmek boşa CPU/GPU/güç.
+// Frame sadece girdi geldiğinde (main'in callback'leri), izlenen durum değiştiğinde (kamera, robot, ışıklar)
+// ya da biri RequestRedraw dediğinde (pencere yeniden çizim, ImGui'de aktif widget, yükleme bitti vs) çiziliyor.
+// Son değişiklikten sonra activeSeconds boyunca çizmeye devam ediliyor (ImGui hover/tooltip, dinamik çözünürlük
+// oturması), sonra döngü glfwWaitEventsTimeout'ta bekliyor. Aktifken frame hızı maxFps ile sınırlanıyor
+// (bekleme sırasında olaylar işleniyor).
+// Kullanım (her döngü): girdi -> WatchValues -> ShouldRender ise BeginFrame -> çizim -> EndFrame -> swap -> WaitForNextFrame
+class FramePacer {
+public:
+    struct Settings {
+        bool renderOnDemand = true;    // kapalıyken her döngüde çiziliyor (eski davranış)
+        int maxFps = 60;               // aktifken üst sınır, 0 sınırsız (vsync açıksa zaten ekran hızı)
+        float activeSeconds = 1.0f;    // son değişiklikten sonra çizmeye devam
+        float idleWaitSeconds = 0.5f;  // boştayken en uzun bekleme, uyanınca durum tekrar kontrol ediliyor
+    };
+
+    // son ölçüm penceresi (STATS_WINDOW saniye) üzerinden
+    struct Stats {
+        bool idle = false;             // son döngü çizmeden bekledi
+        double renderedFps = 0.0;
+        double wakeupsPerSecond = 0.0; // çizmeden uyanılan döngüler
+        double cpuBusy = 0.0;          // ana thread'in frame hazırlamakla geçirdiği süre oranı (0-1), swap/bekleme hariç
+        double gpuBusy = 0.0;          // frame'lerin GPU süresi / duvar saati (0-1)
+        double gpuFrameMs = -1.0;      // yumuşatılmış frame başı GPU süresi
+        size_t renderedFrames = 0;     // toplam
+        size_t skippedFrames = 0;
+    };
+
+    FramePacer();
+
+    // main'in glfw callback'lerinden, ImGui'nin de tepki vermesi için birkaç frame çiziliyor
+    void NotifyInput();
+    // girdi dışı sebepler (pencere yeniden çizimi, yükleme bitti, ayar değişti)
+    void RequestRedraw();
+    // izlenen durumun değerleri, bir önceki döngüdekinden farklıysa çiziliyor
+    void WatchValues(const std::vector<float>& values);
+
+    // bu döngüde çizilmeli mi, değilse WaitForNextFrame ile beklenip döngü atlanıyor
+    bool ShouldRender();
+    // frame'in GPU süresi için timestamp (sahne + ImGui, swap hariç)
+    void BeginFrame();
+    void EndFrame();
+    // aktifken frame sınırına kadar, boştayken olay gelene ya da idleWaitSeconds dolana kadar olayları bekleyerek
+    // işliyor. Boşta beklediyse true (uzun beklemeden sonra deltaTime sıfırlanmalı)
+    bool WaitForNextFrame();
+
+    void SetSettings(const Settings& newSettings);
+    const Settings& GetSettings() const { return settings; }
+    const Stats& GetStats() const { return stats; }
+
+private:
+    static constexpr double STATS_WINDOW = 2.0;
+
+    void PollQueries();
+    void UpdateStats(double now);
+
+    Settings settings;
+    Stats stats;
+
+    double lastActivity = -1.0e9; // son girdi/değişiklik (glfwGetTime)
+    bool redrawRequested = true;  // ilk frame her zaman
+    std::vector<float> watchedValues;
+    double frameStart = 0.0;
+
+    GpuTimer frameTimer;
+
+    // ölçüm penceresi
+    double windowStart = 0.0;
+    double busySeconds = 0.0;
+    size_t windowRendered = 0;
+    size_t windowSkipped = 0;
+};
@@ -2,6 +2,18 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <array>
+#include <cmath>
+#include <cstddef>
+
+// ShowFrustumControls'ta gösterilen sayaçlar, her frame sıfırlanıyor
+struct FrustumCullStats {
+    size_t objectsTested = 0;
+    size_t objectsCulled = 0;
+    size_t meshesTested = 0;
+    size_t meshesCulledBySphere = 0;
+    size_t meshesCulledByBox = 0;
+    size_t coherenceHits = 0; // ilk denenen (önceki frame'in) düzlemde elenenler
+};
 
 class Frustum {
 public:
@@ -77,21 +89,93 @@ public:
         return true;
     }
 
+    // Sınıflandırma: küre testi ucuz, sadece kesişen durumda kutu testine geçiliyor
+    enum class Visibility { Outside, Intersect, Inside };
+
+    // planeHint: son elendiği düzlem, önce o deneniyor (frameler arası tutarlılık)
+    // elenirse planeHint elendiği düzlem oluyor
+    Visibility ClassifySphere(const glm::vec3& center, float radius, int& planeHint) const {
+        Visibility result = Visibility::Inside;
+        for (int n = 0; n < 6; ++n) {
+            int i = (n == 0) ? planeHint : (n <= planeHint ? n - 1 : n);
+            float distance = glm::dot(glm::vec3(planes[i]), center) + planes[i].w;
+            if (distance < -radius) {
+                planeHint = i;
+                return Visibility::Outside;
+            }
+            if (distance < radius) {
+                result = Visibility::Intersect;
+            }
+        }
+        return result;
+    }
+
     // Bir (Axis-Aligned Bounding Box) görüş alanı içinde olup olmadığını kontrol et
     //bu ksıım daha maliyetli dikdörtgenler için verimli  
-   /* bool IsAABBVisible(const glm::vec3& min, const glm::vec3& max) const {
-        for (const auto& plane : planes) {
+    bool IsAABBVisible(const glm::vec3& min, const glm::vec3& max) const {
+        int planeHint = 0;
+        return IsAABBVisible(min, max, planeHint);
+    }
+
+    bool IsAABBVisible(const glm::vec3& min, const glm::vec3& max, int& planeHint) const {
+        for (int n = 0; n < 6; ++n) {
+            int i = (n == 0) ? planeHint : (n <= planeHint ? n - 1 : n);
+            const glm::vec4& plane = planes[i];
+            // düzlem normali yönündeki en uzak köşe (p-vertex)
             glm::vec3 p(
                 plane.x > 0 ? max.x : min.x,
                 plane.y > 0 ? max.y : min.y,
                 plane.z > 0 ? max.z : min.z
             );
             if (glm::dot(glm::vec3(plane), p) + plane.w < 0) {
+                planeHint = i;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // hiyerarşik culling için: planeMask'te biti açık düzlemler test ediliyor,
+    // kutunun tamamen içinde kaldığı düzlemlerin biti kapatılıyor (çocuklar tekrar test etmesin)
+    Visibility ClassifyAABB(const glm::vec3& min, const glm::vec3& max, unsigned int& planeMask) const {
+        for (int i = 0; i < 6; ++i) {
+            if ((planeMask & (1u << i)) == 0) {
+                continue;
+            }
+            const glm::vec4& plane = planes[i];
+            glm::vec3 normal(plane);
+            glm::vec3 p(plane.x > 0 ? max.x : min.x, plane.y > 0 ? max.y : min.y, plane.z > 0 ? max.z : min.z);
+            if (glm::dot(normal, p) + plane.w < 0) {
+                return Visibility::Outside;
+            }
+            // en yakın köşe (n-vertex) de içerideyse bu düzlem artık gereksiz
+            glm::vec3 n(plane.x > 0 ? min.x : max.x, plane.y > 0 ? min.y : max.y, plane.z > 0 ? min.z : max.z);
+            if (glm::dot(normal, n) + plane.w >= 0) {
+                planeMask &= ~(1u << i);
+            }
+        }
+        return planeMask == 0 ? Visibility::Inside : Visibility::Intersect;
+    }
+
+    // döndürülmüş kutu: halfAxes model matrisinin sütunları * yarım boyutlar
+    bool IsOBBVisible(const glm::vec3& center, const glm::vec3 halfAxes[3], int& planeHint) const {
+        for (int n = 0; n < 6; ++n) {
+            int i = (n == 0) ? planeHint : (n <= planeHint ? n - 1 : n);
+            glm::vec3 normal(planes[i]);
+            // kutunun düzlem normali üzerindeki izdüşüm yarıçapı
+            float radius = std::abs(glm::dot(normal, halfAxes[0])) +
+                std::abs(glm::dot(normal, halfAxes[1])) +
+                std::abs(glm::dot(normal, halfAxes[2]));
+            if (glm::dot(normal, center) + planes[i].w < -radius) {
+                planeHint = i;
                 return false;
             }
         }
         return true;
-    }*/
+    }
+
+    // GPU culling için düzlemleri shadera göndermek gerekiyor
+    const std::array<glm::vec4, 6>& GetPlanes() const { return planes; }
 
 private:
     // Düzlem denklemleri (ax + by + cz + d = 0)
@@ -0,0 +1,60 @@
+#include "GLExtensions.h"
+#include <iostream>
+
+PFNGLMULTIDRAWELEMENTSINDIRECTPROC_EXT GLExtensions::MultiDrawElementsIndirect = nullptr;
+PFNGLDISPATCHCOMPUTEPROC_EXT GLExtensions::DispatchCompute = nullptr;
+PFNGLMEMORYBARRIERPROC_EXT GLExtensions::MemoryBarrier = nullptr;
+PFNGLCLEARBUFFERDATAPROC_EXT GLExtensions::ClearBufferData = nullptr;
+PFNGLMULTIDRAWELEMENTSINDIRECTCOUNTPROC_EXT GLExtensions::MultiDrawElementsIndirectCount = nullptr;
+
+int GLExtensions::majorVersion = 0;
+int GLExtensions::minorVersion = 0;
+bool GLExtensions::hasConservativeOcclusion = false;
+bool GLExtensions::hasPipelineStatistics = false;
+
+void GLExtensions::Load(GLADloadproc loader) {
+    glGetIntegerv(GL_MAJOR_VERSION, &majorVersion);
+    glGetIntegerv(GL_MINOR_VERSION, &minorVersion);
+
+    if (IsVersionAtLeast(4, 3)) {
+        MultiDrawElementsIndirect = reinterpret_cast<PFNGLMULTIDRAWELEMENTSINDIRECTPROC_EXT>(
+            loader("glMultiDrawElementsIndirect"));
+        DispatchCompute = reinterpret_cast<PFNGLDISPATCHCOMPUTEPROC_EXT>(loader("glDispatchCompute"));
+        MemoryBarrier = reinterpret_cast<PFNGLMEMORYBARRIERPROC_EXT>(loader("glMemoryBarrier"));
+        ClearBufferData = reinterpret_cast<PFNGLCLEARBUFFERDATAPROC_EXT>(loader("glClearBufferData"));
+    }
+
+    if (IsVersionAtLeast(4, 6)) {
+        MultiDrawElementsIndirectCount = reinterpret_cast<PFNGLMULTIDRAWELEMENTSINDIRECTCOUNTPROC_EXT>(
+            loader("glMultiDrawElementsIndirectCount"));
+    }
+    else if (IsVersionAtLeast(4, 3) && HasExtension("GL_ARB_indirect_parameters")) {
+        MultiDrawElementsIndirectCount = reinterpret_cast<PFNGLMULTIDRAWELEMENTSINDIRECTCOUNTPROC_EXT>(
+            loader("glMultiDrawElementsIndirectCountARB"));
+    }
+
+    hasConservativeOcclusion = IsVersionAtLeast(4, 3) || HasExtension("GL_ARB_ES3_compatibility");
+    hasPipelineStatistics = IsVersionAtLeast(4, 6) || HasExtension("GL_ARB_pipeline_statistics_query");
+
+    std::cout << "GL surumu: " << majorVersion << "." << minorVersion
+        << " | Multi-draw indirect: " << (HasMultiDrawIndirect() ? "Var" : "Yok (3.3 yolu kullanilacak)")
+        << " | Compute: " << (HasComputeShaders() ? "Var" : "Yok")
+        << " | Indirect count: " << (HasIndirectCount() ? "Var" : "Yok")
+        << std::endl;
+}
+
+bool GLExtensions::IsVersionAtLeast(int major, int minor) {
+    return majorVersion > major || (majorVersion == major && minorVersion >= minor);
+}
+
+bool GLExtensions::HasExtension(const std::string& name) {
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; ++i) {
+        const char* extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+        if (extension && name == extension) {
+            return true;
+        }
+    }
+    return false;
+}
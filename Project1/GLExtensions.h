@@ -0,0 +1,89 @@
+#pragma once
+#include <glad/glad.h>
+#include <string>
+
+// glad sadece GL 3.3 icin uretildi, 4.3+ fonksiyonlari burdan elle yukluyoruz
+// context 3.3 istenmis olsa bile surucu genelde daha yuksek surum veriyor,
+// o yuzden calisma aninda kontrol edip uygun yolu seciyoruz
+
+#ifndef GL_DRAW_INDIRECT_BUFFER
+#define GL_DRAW_INDIRECT_BUFFER 0x8F3F
+#endif
+#ifndef GL_SHADER_STORAGE_BUFFER
+#define GL_SHADER_STORAGE_BUFFER 0x90D2
+#endif
+#ifndef GL_COMPUTE_SHADER
+#define GL_COMPUTE_SHADER 0x91B9
+#endif
+#ifndef GL_SHADER_STORAGE_BARRIER_BIT
+#define GL_SHADER_STORAGE_BARRIER_BIT 0x00002000
+#endif
+#ifndef GL_COMMAND_BARRIER_BIT
+#define GL_COMMAND_BARRIER_BIT 0x00000040
+#endif
+#ifndef GL_ANY_SAMPLES_PASSED_CONSERVATIVE
+#define GL_ANY_SAMPLES_PASSED_CONSERVATIVE 0x8D6A
+#endif
+#ifndef GL_PARAMETER_BUFFER
+#define GL_PARAMETER_BUFFER 0x80EE
+#endif
+#ifndef GL_FRAGMENT_SHADER_INVOCATIONS
+#define GL_FRAGMENT_SHADER_INVOCATIONS 0x82F4
+#endif
+
+typedef void (APIENTRYP PFNGLMULTIDRAWELEMENTSINDIRECTPROC_EXT)(GLenum mode, GLenum type,
+    const void* indirect, GLsizei drawcount, GLsizei stride);
+
+typedef void (APIENTRYP PFNGLDISPATCHCOMPUTEPROC_EXT)(GLuint numGroupsX, GLuint numGroupsY, GLuint numGroupsZ);
+typedef void (APIENTRYP PFNGLMEMORYBARRIERPROC_EXT)(GLbitfield barriers);
+typedef void (APIENTRYP PFNGLCLEARBUFFERDATAPROC_EXT)(GLenum target, GLenum internalformat,
+    GLenum format, GLenum type, const void* data);
+typedef void (APIENTRYP PFNGLMULTIDRAWELEMENTSINDIRECTCOUNTPROC_EXT)(GLenum mode, GLenum type,
+    const void* indirect, GLintptr drawcount, GLsizei maxdrawcount, GLsizei stride);
+
+// glMultiDrawElementsIndirect icin komut yapisi (GL spec ile ayni sira)
+struct DrawElementsIndirectCommand {
+    GLuint count;
+    GLuint instanceCount;
+    GLuint firstIndex;
+    GLint baseVertex;
+    GLuint baseInstance;
+};
+
+class GLExtensions {
+public:
+    // glad yuklendikten sonra bir kere cagrilmali
+    static void Load(GLADloadproc loader);
+
+    static int GetMajorVersion() { return majorVersion; }
+    static int GetMinorVersion() { return minorVersion; }
+    static bool IsVersionAtLeast(int major, int minor);
+    static bool HasExtension(const std::string& name);
+
+    // GL 4.3: SSBO + glMultiDrawElementsIndirect
+    static bool HasMultiDrawIndirect() { return MultiDrawElementsIndirect != nullptr; }
+
+    // GL 4.3: compute shader (GPU culling)
+    static bool HasComputeShaders() { return DispatchCompute != nullptr && MemoryBarrier != nullptr && ClearBufferData != nullptr; }
+    // GL 4.6 ya da ARB_indirect_parameters: cizim sayisini GPU'daki bufferdan okuma
+    static bool HasIndirectCount() { return MultiDrawElementsIndirectCount != nullptr; }
+    // GL 4.3 ya da ARB_ES3_compatibility: hassasiyet yerine hız isteyen occlusion query
+    // yoksa normal GL_ANY_SAMPLES_PASSED kullanılıyor
+    static GLenum GetOcclusionQueryTarget() {
+        return hasConservativeOcclusion ? GL_ANY_SAMPLES_PASSED_CONSERVATIVE : GL_ANY_SAMPLES_PASSED;
+    }
+    // GL 4.6 ya da ARB_pipeline_statistics_query: fragment shader çağrı sayısı
+    static bool HasPipelineStatistics() { return hasPipelineStatistics; }
+
+    static PFNGLMULTIDRAWELEMENTSINDIRECTPROC_EXT MultiDrawElementsIndirect;
+    static PFNGLDISPATCHCOMPUTEPROC_EXT DispatchCompute;
+    static PFNGLMEMORYBARRIERPROC_EXT MemoryBarrier;
+    static PFNGLCLEARBUFFERDATAPROC_EXT ClearBufferData;
+    static PFNGLMULTIDRAWELEMENTSINDIRECTCOUNTPROC_EXT MultiDrawElementsIndirectCount;
+
+private:
+    static int majorVersion;
+    static int minorVersion;
+    static bool hasConservativeOcclusion;
+    static bool hasPipelineStatistics;
+};
@@ -0,0 +1,386 @@
+#include "GeometryPool.h"
+#include <iostream>
+#include <algorithm>
+
+// ---------------- FreeListAllocator ----------------
+
+FreeListAllocator::FreeListAllocator(size_t capacity)
+    : capacity(capacity), used(0) {
+    if (capacity > 0) {
+        freeBlocks.push_back({ 0, capacity });
+    }
+}
+
+size_t FreeListAllocator::Allocate(size_t size) {
+    if (size == 0) {
+        return INVALID_OFFSET;
+    }
+
+    for (auto it = freeBlocks.begin(); it != freeBlocks.end(); ++it) {
+        if (it->size < size) {
+            continue;
+        }
+
+        size_t offset = it->offset;
+        if (it->size == size) {
+            freeBlocks.erase(it);
+        }
+        else {
+            it->offset += size;
+            it->size -= size;
+        }
+        used += size;
+        return offset;
+    }
+    return INVALID_OFFSET;
+}
+
+void FreeListAllocator::Free(size_t offset, size_t size) {
+    if (offset == INVALID_OFFSET || size == 0) {
+        return;
+    }
+
+    // sıralı listede yerini bul
+    auto it = std::lower_bound(freeBlocks.begin(), freeBlocks.end(), offset,
+        [](const Block& block, size_t value) { return block.offset < value; });
+    it = freeBlocks.insert(it, { offset, size });
+    used -= size;
+
+    // sağdaki blokla birleştir
+    auto next = it + 1;
+    if (next != freeBlocks.end() && it->offset + it->size == next->offset) {
+        it->size += next->size;
+        freeBlocks.erase(next);
+    }
+
+    // soldaki blokla birleştir
+    if (it != freeBlocks.begin()) {
+        auto prev = it - 1;
+        if (prev->offset + prev->size == it->offset) {
+            prev->size += it->size;
+            freeBlocks.erase(it);
+        }
+    }
+}
+
+void FreeListAllocator::Grow(size_t newCapacity) {
+    if (newCapacity <= capacity) {
+        return;
+    }
+
+    size_t extra = newCapacity - capacity;
+    if (!freeBlocks.empty() && freeBlocks.back().offset + freeBlocks.back().size == capacity) {
+        freeBlocks.back().size += extra;
+    }
+    else {
+        freeBlocks.push_back({ capacity, extra });
+    }
+    capacity = newCapacity;
+}
+
+size_t FreeListAllocator::GetLargestFreeBlock() const {
+    size_t largest = 0;
+    for (const auto& block : freeBlocks) {
+        largest = std::max(largest, block.size);
+    }
+    return largest;
+}
+
+// ---------------- GeometryPool ----------------
+
+GeometryPool::GeometryPool() = default;
+
+GeometryPool::~GeometryPool() = default;
+
+void GeometryPool::Release() {
+    if (vao != 0) {
+        glDeleteVertexArrays(1, &vao);
+        glDeleteBuffers(1, &vbo);
+        glDeleteBuffers(1, &ebo);
+        glDeleteVertexArrays(1, &positionVao);
+        glDeleteBuffers(1, &positionVbo);
+        glDeleteBuffers(1, &lightmapUvVbo);
+        glDeleteBuffers(1, &occlusionVbo);
+        vao = vbo = ebo = positionVao = positionVbo = lightmapUvVbo = occlusionVbo = 0;
+        bufferGeneration++; // yeniden oluşturulursa dış VAO'lar eski bufferları tutmasın
+    }
+    if (drawIdBuffer != 0) {
+        glDeleteBuffers(1, &drawIdBuffer);
+        drawIdBuffer = 0;
+        drawIdCapacity = 0;
+    }
+}
+
+void GeometryPool::EnsureCreated() {
+    if (vao != 0) {
+        return;
+    }
+
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &vbo);
+    glGenBuffers(1, &ebo);
+    glGenVertexArrays(1, &positionVao);
+    glGenBuffers(1, &positionVbo);
+    glGenBuffers(1, &lightmapUvVbo);
+    glGenBuffers(1, &occlusionVbo);
+
+    // ilk kapasiteyi ayır, yetmezse GrowBuffer ikiye katlıyor
+    glBindBuffer(GL_COPY_WRITE_BUFFER, vbo);
+    glBufferData(GL_COPY_WRITE_BUFFER, INITIAL_VERTEX_CAPACITY * VERTEX_SIZE, nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, positionVbo);
+    glBufferData(GL_COPY_WRITE_BUFFER, INITIAL_VERTEX_CAPACITY * POSITION_SIZE, nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, lightmapUvVbo);
+    glBufferData(GL_COPY_WRITE_BUFFER, INITIAL_VERTEX_CAPACITY * LIGHTMAP_UV_SIZE, nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, occlusionVbo);
+    glBufferData(GL_COPY_WRITE_BUFFER, INITIAL_VERTEX_CAPACITY * OCCLUSION_SIZE, nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, ebo);
+    glBufferData(GL_COPY_WRITE_BUFFER, INITIAL_INDEX_CAPACITY * sizeof(GLuint), nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    vertexAllocator = FreeListAllocator(INITIAL_VERTEX_CAPACITY);
+    indexAllocator = FreeListAllocator(INITIAL_INDEX_CAPACITY);
+
+    SetupVertexFormat();
+    std::cout << "Geometri havuzu olusturuldu" << std::endl;
+}
+
+void GeometryPool::SetupVertexFormat() {
+    glBindVertexArray(vao);
+    SetupVertexAttributes();
+
+    if (drawIdBuffer != 0) {
+        glBindBuffer(GL_ARRAY_BUFFER, drawIdBuffer);
+        glVertexAttribIPointer(6, 1, GL_UNSIGNED_INT, sizeof(GLuint), (void*)0);
+        glVertexAttribDivisor(6, 1);
+        glEnableVertexAttribArray(6);
+    }
+
+    // konum akışı: derinlik ön geçişi diğer attributeları hiç okumuyor
+    glBindVertexArray(positionVao);
+    glBindBuffer(GL_ARRAY_BUFFER, positionVbo);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, static_cast<GLsizei>(POSITION_SIZE), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void GeometryPool::SetupVertexAttributes() const {
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+
+    const GLsizei stride = static_cast<GLsizei>(VERTEX_SIZE);
+
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
+    glEnableVertexAttribArray(0);
+
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (void*)(3 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, (void*)(6 * sizeof(float)));
+    glEnableVertexAttribArray(2);
+
+    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, stride, (void*)(8 * sizeof(float)));
+    glEnableVertexAttribArray(3);
+
+    glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, stride, (void*)(11 * sizeof(float)));
+    glEnableVertexAttribArray(4);
+
+    // normalize edilmiş byte, shader 0-1 float okuyor
+    glBindBuffer(GL_ARRAY_BUFFER, occlusionVbo);
+    glVertexAttribPointer(5, 1, GL_UNSIGNED_BYTE, GL_TRUE, static_cast<GLsizei>(OCCLUSION_SIZE), (void*)0);
+    glEnableVertexAttribArray(5);
+
+    glBindBuffer(GL_ARRAY_BUFFER, lightmapUvVbo);
+    glVertexAttribPointer(12, 2, GL_FLOAT, GL_FALSE, static_cast<GLsizei>(LIGHTMAP_UV_SIZE), (void*)0);
+    glEnableVertexAttribArray(12);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+}
+
+bool GeometryPool::GrowBuffer(GLenum target, GLuint& buffer, FreeListAllocator& allocator,
+    size_t elementSize, size_t minCapacity) {
+
+    size_t oldCapacity = allocator.GetCapacity();
+    size_t newCapacity = std::max(oldCapacity * 2, minCapacity);
+
+    if (!CopyToLargerBuffer(buffer, oldCapacity * elementSize, newCapacity * elementSize)) {
+        return false;
+    }
+    // konum, lightmap UV ve AO akışları vertex bufferıyla aynı kapasitede tutuluyor
+    if (target == GL_ARRAY_BUFFER &&
+        (!CopyToLargerBuffer(positionVbo, oldCapacity * POSITION_SIZE, newCapacity * POSITION_SIZE) ||
+        !CopyToLargerBuffer(lightmapUvVbo, oldCapacity * LIGHTMAP_UV_SIZE, newCapacity * LIGHTMAP_UV_SIZE) ||
+        !CopyToLargerBuffer(occlusionVbo, oldCapacity * OCCLUSION_SIZE, newCapacity * OCCLUSION_SIZE))) {
+        return false;
+    }
+    allocator.Grow(newCapacity);
+    bufferGeneration++;
+
+    // VAO yeni bufferları görsün
+    SetupVertexFormat();
+
+    std::cout << "Geometri havuzu buyutuldu (" << (target == GL_ARRAY_BUFFER ? "vertex" : "index")
+        << "): " << oldCapacity << " -> " << newCapacity << std::endl;
+    return true;
+}
+
+bool GeometryPool::CopyToLargerBuffer(GLuint& buffer, size_t oldBytes, size_t newBytes) {
+    GLuint newBuffer = 0;
+    glGenBuffers(1, &newBuffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, newBuffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, newBytes, nullptr, GL_STATIC_DRAW);
+    if (glGetError() == GL_OUT_OF_MEMORY) {
+        std::cerr << "Geometri havuzu buyutulemedi (bellek yetersiz)" << std::endl;
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        glDeleteBuffers(1, &newBuffer);
+        return false;
+    }
+
+    // eski veriyi GPU üzerinde kopyala, CPU'ya geri okumaya gerek yok
+    glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, oldBytes);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    glDeleteBuffers(1, &buffer);
+    buffer = newBuffer;
+    return true;
+}
+
+bool GeometryPool::Allocate(const std::vector<float>& vertices, const std::vector<unsigned int>& indices,
+    GeometryRange& range, const std::vector<float>* lightmapUVs, const std::vector<unsigned char>* occlusion) {
+
+    if (vertices.empty() || indices.empty() || vertices.size() % VERTEX_FLOATS != 0 ||
+        (lightmapUVs && lightmapUVs->size() != vertices.size() / VERTEX_FLOATS * 2) ||
+        (occlusion && occlusion->size() != vertices.size() / VERTEX_FLOATS)) {
+        std::cerr << "Geometri havuzu: gecersiz mesh verisi" << std::endl;
+        return false;
+    }
+
+    EnsureCreated();
+
+    size_t vertexCount = vertices.size() / VERTEX_FLOATS;
+    size_t indexCount = indices.size();
+
+    size_t vertexOffset = vertexAllocator.Allocate(vertexCount);
+    if (vertexOffset == FreeListAllocator::INVALID_OFFSET) {
+        if (!GrowBuffer(GL_ARRAY_BUFFER, vbo, vertexAllocator, VERTEX_SIZE,
+            vertexAllocator.GetCapacity() + vertexCount)) {
+            return false;
+        }
+        vertexOffset = vertexAllocator.Allocate(vertexCount);
+    }
+
+    size_t indexOffset = indexAllocator.Allocate(indexCount);
+    if (indexOffset == FreeListAllocator::INVALID_OFFSET) {
+        if (!GrowBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo, indexAllocator, sizeof(GLuint),
+            indexAllocator.GetCapacity() + indexCount)) {
+            vertexAllocator.Free(vertexOffset, vertexCount);
+            return false;
+        }
+        indexOffset = indexAllocator.Allocate(indexCount);
+    }
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, vbo);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, vertexOffset * VERTEX_SIZE,
+        vertexCount * VERTEX_SIZE, vertices.data());
+
+    std::vector<float> positions(vertexCount * 3);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        positions[v * 3 + 0] = vertices[v * VERTEX_FLOATS + 0];
+        positions[v * 3 + 1] = vertices[v * VERTEX_FLOATS + 1];
+        positions[v * 3 + 2] = vertices[v * VERTEX_FLOATS + 2];
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, positionVbo);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, vertexOffset * POSITION_SIZE,
+        vertexCount * POSITION_SIZE, positions.data());
+    // lightmap'i olmayan meshlerde shader -1'e bakıp normal aydınlatmayı kullanıyor
+    std::vector<float> noLightmap;
+    if (!lightmapUVs) {
+        noLightmap.assign(vertexCount * 2, -1.0f);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, lightmapUvVbo);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, vertexOffset * LIGHTMAP_UV_SIZE,
+        vertexCount * LIGHTMAP_UV_SIZE, lightmapUVs ? lightmapUVs->data() : noLightmap.data());
+    // AO'su olmayan meshler tamamen açık
+    std::vector<unsigned char> noOcclusion;
+    if (!occlusion) {
+        noOcclusion.assign(vertexCount, 255);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, occlusionVbo);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, vertexOffset * OCCLUSION_SIZE,
+        vertexCount * OCCLUSION_SIZE, occlusion ? occlusion->data() : noOcclusion.data());
+    glBindBuffer(GL_COPY_WRITE_BUFFER, ebo);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, indexOffset * sizeof(GLuint),
+        indexCount * sizeof(GLuint), indices.data());
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    range.vertexOffset = vertexOffset;
+    range.vertexCount = vertexCount;
+    range.indexOffset = indexOffset;
+    range.indexCount = indexCount;
+    allocationCount++;
+    return true;
+}
+
+void GeometryPool::Free(GeometryRange& range) {
+    if (!range.IsValid()) {
+        return;
+    }
+
+    vertexAllocator.Free(range.vertexOffset, range.vertexCount);
+    indexAllocator.Free(range.indexOffset, range.indexCount);
+    allocationCount--;
+
+    range = GeometryRange();
+}
+
+void GeometryPool::EnsureDrawIdCapacity(size_t count) {
+    if (count <= drawIdCapacity) {
+        return;
+    }
+
+    EnsureCreated();
+
+    size_t newCapacity = std::max<size_t>(1024, drawIdCapacity);
+    while (newCapacity < count) {
+        newCapacity *= 2;
+    }
+
+    std::vector<GLuint> ids(newCapacity);
+    for (size_t i = 0; i < newCapacity; ++i) {
+        ids[i] = static_cast<GLuint>(i);
+    }
+
+    if (drawIdBuffer == 0) {
+        glGenBuffers(1, &drawIdBuffer);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, drawIdBuffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, newCapacity * sizeof(GLuint), ids.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    drawIdCapacity = newCapacity;
+
+    SetupVertexFormat();
+}
+
+void GeometryPool::Bind() const {
+    glBindVertexArray(vao);
+}
+
+void GeometryPool::BindPositionOnly() const {
+    glBindVertexArray(positionVao);
+}
+
+void GeometryPool::Unbind() const {
+    glBindVertexArray(0);
+}
+
+void GeometryPool::Draw(const GeometryRange& range) const {
+    if (!range.IsValid()) {
+        return;
+    }
+
+    glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(range.indexCount), GL_UNSIGNED_INT,
+        (void*)(range.indexOffset * sizeof(GLuint)), static_cast<GLint>(range.vertexOffset));
+}
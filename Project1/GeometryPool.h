@@ -0,0 +1,135 @@
+#pragma once
+#include <glad/glad.h>
+#include <vector>
+#include <cstddef>
+
+// Büyük bir buffer içinden alt bölgeler ayırmak için free-list allocator
+// birimler eleman sayısıdır (vertex ya da index), byte değil
+class FreeListAllocator {
+public:
+    static constexpr size_t INVALID_OFFSET = static_cast<size_t>(-1);
+
+    explicit FreeListAllocator(size_t capacity = 0);
+
+    // ilk uyan boş bloğu kullanır, yer yoksa INVALID_OFFSET döner
+    size_t Allocate(size_t size);
+    // komşu boş bloklarla birleştirerek geri verir
+    void Free(size_t offset, size_t size);
+    // buffer büyütüldüğünde yeni alanı boş listeye ekler
+    void Grow(size_t newCapacity);
+
+    size_t GetCapacity() const { return capacity; }
+    size_t GetUsed() const { return used; }
+    size_t GetFreeBlockCount() const { return freeBlocks.size(); }
+    size_t GetLargestFreeBlock() const;
+
+private:
+    struct Block {
+        size_t offset;
+        size_t size;
+    };
+
+    std::vector<Block> freeBlocks; // offset'e göre sıralı tutuluyor
+    size_t capacity;
+    size_t used;
+};
+
+// Bir meshin ortak bufferlardaki yeri
+struct GeometryRange {
+    size_t vertexOffset = FreeListAllocator::INVALID_OFFSET; // vertex cinsinden (base vertex)
+    size_t vertexCount = 0;
+    size_t indexOffset = FreeListAllocator::INVALID_OFFSET;  // index cinsinden
+    size_t indexCount = 0;
+
+    bool IsValid() const {
+        return vertexOffset != FreeListAllocator::INVALID_OFFSET &&
+            indexOffset != FreeListAllocator::INVALID_OFFSET;
+    }
+};
+
+// Tüm statik meshler tek bir VBO/EBO çiftinden yer alıyor
+// her mesh kendi VAO'sunu bağlamak yerine tek VAO ile glDrawElementsBaseVertex çağrılıyor
+class GeometryPool {
+public:
+    // MuseumObject vertex formatı: pos(3) normal(3) uv(2) tangent(3) bitangent(3)
+    static constexpr int VERTEX_FLOATS = 14;
+    static constexpr size_t VERTEX_SIZE = VERTEX_FLOATS * sizeof(float);
+    // derinlik ön geçişi için ayrı, sıkı paketli konum akışı (aynı vertex offsetleri)
+    static constexpr size_t POSITION_SIZE = 3 * sizeof(float);
+    // lightmap için ikinci UV kanalı da ayrı akışta (location 12), lightmap'i olmayan vertexlerde -1
+    static constexpr size_t LIGHTMAP_UV_SIZE = 2 * sizeof(float);
+    // vertex AO'su (VertexOcclusion) vertex başına 1 byte, location 5, bake edilmemiş vertexlerde 255
+    static constexpr size_t OCCLUSION_SIZE = sizeof(unsigned char);
+
+    static GeometryPool& GetInstance() {
+        static GeometryPool instance;
+        return instance;
+    }
+
+    // GL nesnelerini siliyor, main'in temizliğinde pencere (context) kapanmadan çağrılmalı.
+    // Singleton statik yıkımda GL'e dokunmuyor; sonradan yıkılan objelerin Free'si sadece allocator'ı güncelliyor
+    void Release();
+
+    // lightmapUVs verilirse vertex başına 2 float, occlusion verilirse vertex başına 1 byte olmalı
+    bool Allocate(const std::vector<float>& vertices, const std::vector<unsigned int>& indices,
+        GeometryRange& range, const std::vector<float>* lightmapUVs = nullptr,
+        const std::vector<unsigned char>* occlusion = nullptr);
+    void Free(GeometryRange& range);
+
+    // çizimden önce bir kere bind edilmesi yeterli
+    void Bind() const;
+    void Unbind() const;
+    void Draw(const GeometryRange& range) const;
+    // sadece konum (location 0) + EBO bağlı VAO, Draw aynen kullanılabiliyor
+    void BindPositionOnly() const;
+
+    // multi-draw indirect için 0..n-1 sıralı draw id akışı (location 6, divisor 1)
+    // baseInstance = draw indexi verilerek shader her çizimin verisini bulabiliyor
+    void EnsureDrawIdCapacity(size_t count);
+
+    // başka bir VAO (ör. instancing) havuzun vertex formatını kullanmak isterse
+    // o VAO bağlıyken çağrılmalı, pos/normal/uv/tangent/bitangent (0-4), AO (5), lightmap UV (12) + EBO bağlanıyor
+    void SetupVertexAttributes() const;
+    // buffer büyüyünce (yeniden oluşturulunca) artıyor, dış VAO'lar buna bakarak yenileniyor
+    size_t GetBufferGeneration() const { return bufferGeneration; }
+
+    GLuint GetVAO() const { return vao; }
+    GLuint GetVertexBuffer() const { return vbo; }
+    GLuint GetIndexBuffer() const { return ebo; }
+
+    // debug bilgileri
+    size_t GetVertexCapacity() const { return vertexAllocator.GetCapacity(); }
+    size_t GetVertexUsed() const { return vertexAllocator.GetUsed(); }
+    size_t GetIndexCapacity() const { return indexAllocator.GetCapacity(); }
+    size_t GetIndexUsed() const { return indexAllocator.GetUsed(); }
+    size_t GetAllocationCount() const { return allocationCount; }
+
+private:
+    GeometryPool();
+    ~GeometryPool();
+    GeometryPool(const GeometryPool&) = delete;
+    GeometryPool& operator=(const GeometryPool&) = delete;
+
+    static constexpr size_t INITIAL_VERTEX_CAPACITY = 1 << 16;
+    static constexpr size_t INITIAL_INDEX_CAPACITY = 1 << 18;
+
+    void EnsureCreated();
+    void SetupVertexFormat();
+    bool GrowBuffer(GLenum target, GLuint& buffer, FreeListAllocator& allocator,
+        size_t elementSize, size_t minCapacity);
+    static bool CopyToLargerBuffer(GLuint& buffer, size_t oldBytes, size_t newBytes);
+
+    GLuint vao = 0;
+    GLuint vbo = 0;
+    GLuint ebo = 0;
+    GLuint positionVao = 0;
+    GLuint positionVbo = 0;
+    GLuint lightmapUvVbo = 0;
+    GLuint occlusionVbo = 0;
+    GLuint drawIdBuffer = 0;
+    size_t drawIdCapacity = 0;
+    FreeListAllocator vertexAllocator;
+    FreeListAllocator indexAllocator;
+    size_t allocationCount = 0;
+    size_t bufferGeneration = 0;
+};
@@ -0,0 +1,179 @@
+#include "GpuCuller.h"
+#include <iostream>
+#include <numeric>
+
+namespace {
+    // kapasite yetiyorsa orphan + sub data, yetmiyorsa büyüt
+    void UploadStorage(GLuint buffer, size_t& capacity, const void* data, size_t size) {
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+        if (size > capacity) {
+            capacity = size * 2;
+        }
+        glBufferData(GL_SHADER_STORAGE_BUFFER, capacity, nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, size, data);
+    }
+
+    // sadece GPU'nun yazdığı bufferlar, içerik korunmuyor
+    void ReserveStorage(GLuint buffer, size_t& capacity, size_t size) {
+        if (size <= capacity) {
+            return;
+        }
+        capacity = size * 2;
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, capacity, nullptr, GL_DYNAMIC_COPY);
+    }
+}
+
+GpuCuller::GpuCuller() {
+    computeShader = std::make_unique<Shader>("shaders/cullCompute.glsl");
+
+    glGenBuffers(1, &inputCommandBuffer);
+    glGenBuffers(1, &cullInputBuffer);
+    glGenBuffers(1, &bucketOffsetBuffer);
+    glGenBuffers(1, &outputCommandBuffer);
+    glGenBuffers(1, &countBuffer);
+    glGenBuffers(1, &readbackBuffer);
+
+    std::cout << "GPU culling hazir (indirect count: "
+        << (GLExtensions::HasIndirectCount() ? "var" : "yok") << ")" << std::endl;
+}
+
+GpuCuller::~GpuCuller() {
+    if (readbackFence) {
+        glDeleteSync(readbackFence);
+    }
+    glDeleteBuffers(1, &inputCommandBuffer);
+    glDeleteBuffers(1, &cullInputBuffer);
+    glDeleteBuffers(1, &bucketOffsetBuffer);
+    glDeleteBuffers(1, &outputCommandBuffer);
+    glDeleteBuffers(1, &countBuffer);
+    glDeleteBuffers(1, &readbackBuffer);
+}
+
+void GpuCuller::Cull(const std::array<glm::vec4, 6>& planes,
+    const std::vector<DrawElementsIndirectCommand>& commands,
+    const std::vector<CullInput>& inputs,
+    const std::vector<GLuint>& bucketOffsets) {
+
+    PollReadback();
+
+    bucketStart = bucketOffsets;
+    bucketCount = bucketOffsets.size();
+    lastTestedCount = commands.size();
+    if (commands.empty() || bucketCount == 0) {
+        return;
+    }
+
+    UploadStorage(inputCommandBuffer, inputCommandCapacity,
+        commands.data(), commands.size() * sizeof(DrawElementsIndirectCommand));
+    UploadStorage(cullInputBuffer, cullInputCapacity,
+        inputs.data(), inputs.size() * sizeof(CullInput));
+    UploadStorage(bucketOffsetBuffer, bucketOffsetCapacity,
+        bucketOffsets.data(), bucketOffsets.size() * sizeof(GLuint));
+
+    size_t outputSize = commands.size() * sizeof(DrawElementsIndirectCommand);
+    ReserveStorage(outputCommandBuffer, outputCommandCapacity, outputSize);
+    ReserveStorage(countBuffer, countCapacity, bucketCount * sizeof(GLuint));
+
+    // sayaçlar her frame sıfırdan başlıyor
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, countBuffer);
+    GLExtensions::ClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+    if (!GLExtensions::HasIndirectCount()) {
+        // sayı okunamıyorsa bucketın tamamı çizilecek, boş kalan slotlar instanceCount = 0 olmalı
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, outputCommandBuffer);
+        GLExtensions::ClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+    }
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, inputCommandBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, cullInputBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, bucketOffsetBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, outputCommandBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 6, countBuffer);
+
+    computeShader->use();
+    computeShader->setVec4Array("frustumPlanes", planes.data(), 6);
+    computeShader->setUInt("drawCount", static_cast<GLuint>(commands.size()));
+
+    GLuint groups = static_cast<GLuint>((commands.size() + 63) / 64);
+    GLExtensions::DispatchCompute(groups, 1, 1);
+
+    // sonraki indirect çizim ve SSBO okumaları compute yazmalarını görmeli
+    GLExtensions::MemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+
+    // UI için görünen sayısını arka planda kopyala, önceki okuma bitmediyse bekleme
+    if (!readbackFence) {
+        glBindBuffer(GL_COPY_READ_BUFFER, countBuffer);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, readbackBuffer);
+        glBufferData(GL_COPY_WRITE_BUFFER, bucketCount * sizeof(GLuint), nullptr, GL_STREAM_READ);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, bucketCount * sizeof(GLuint));
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        readbackFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+}
+
+void GpuCuller::PollReadback() {
+    if (!readbackFence) {
+        return;
+    }
+
+    GLenum state = glClientWaitSync(readbackFence, 0, 0);
+    if (state != GL_ALREADY_SIGNALED && state != GL_CONDITION_SATISFIED) {
+        return;
+    }
+    glDeleteSync(readbackFence);
+    readbackFence = nullptr;
+
+    GLint size = 0;
+    glBindBuffer(GL_COPY_READ_BUFFER, readbackBuffer);
+    glGetBufferParameteriv(GL_COPY_READ_BUFFER, GL_BUFFER_SIZE, &size);
+    std::vector<GLuint> counts(size / sizeof(GLuint));
+    if (!counts.empty()) {
+        glGetBufferSubData(GL_COPY_READ_BUFFER, 0, counts.size() * sizeof(GLuint), counts.data());
+    }
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    lastVisibleCount = std::accumulate(counts.begin(), counts.end(), size_t(0));
+}
+
+size_t GpuCuller::ReadVisibleCountNow() const {
+    if (bucketCount == 0) {
+        return 0;
+    }
+
+    std::vector<GLuint> counts(bucketCount);
+    glBindBuffer(GL_COPY_READ_BUFFER, countBuffer);
+    glGetBufferSubData(GL_COPY_READ_BUFFER, 0, counts.size() * sizeof(GLuint), counts.data());
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    return std::accumulate(counts.begin(), counts.end(), size_t(0));
+}
+
+void GpuCuller::BindForDraw() const {
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, outputCommandBuffer);
+    if (GLExtensions::HasIndirectCount()) {
+        glBindBuffer(GL_PARAMETER_BUFFER, countBuffer);
+    }
+}
+
+void GpuCuller::UnbindForDraw() const {
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    if (GLExtensions::HasIndirectCount()) {
+        glBindBuffer(GL_PARAMETER_BUFFER, 0);
+    }
+}
+
+void GpuCuller::DrawBucket(size_t bucketIndex, size_t bucketSize) const {
+    if (bucketIndex >= bucketCount || bucketSize == 0) {
+        return;
+    }
+
+    const void* offset = (void*)(bucketStart[bucketIndex] * sizeof(DrawElementsIndirectCommand));
+    if (GLExtensions::HasIndirectCount()) {
+        GLExtensions::MultiDrawElementsIndirectCount(GL_TRIANGLES, GL_UNSIGNED_INT, offset,
+            static_cast<GLintptr>(bucketIndex * sizeof(GLuint)), static_cast<GLsizei>(bucketSize), 0);
+    }
+    else {
+        GLExtensions::MultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, offset,
+            static_cast<GLsizei>(bucketSize), 0);
+    }
+}
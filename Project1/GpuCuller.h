@@ -0,0 +1,69 @@
+#pragma once
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <array>
+#include <vector>
+#include <memory>
+#include "GLExtensions.h"
+#include "Shader.h"
+
+// Compute shader ile frustum culling (GL 4.3+)
+// CPU tüm çizim komutlarını yüklüyor, GPU görünenleri bucket bölgelerine sıkıştırıp
+// indirect komut bufferına yazıyor. Böylece CPU hangi objenin göründüğünü hiç bilmiyor.
+// Bucket başına görünen sayısı da bufferda, indirect count varsa doğrudan oradan okunuyor,
+// yoksa boş kalan komutlar instanceCount = 0 ile çiziliyor (hiçbir şey üretmiyor)
+class GpuCuller {
+public:
+    // cullCompute.glsl CullInput ile aynı düzen
+    struct CullInput {
+        glm::vec4 sphere;  // xyz: dünya merkezi, w: yarıçap
+        glm::uvec4 bucket; // x: bucket indexi
+    };
+
+    GpuCuller();
+    ~GpuCuller();
+
+    static bool IsSupported() { return GLExtensions::HasComputeShaders(); }
+
+    // commands bucket sırasıyla ardışık olmalı, bucketOffsets[i] = i. bucketın ilk komutu
+    void Cull(const std::array<glm::vec4, 6>& planes,
+        const std::vector<DrawElementsIndirectCommand>& commands,
+        const std::vector<CullInput>& inputs,
+        const std::vector<GLuint>& bucketOffsets);
+
+    // Cull'dan sonra çizim için komut bufferını bağla, VAO ve shader hazır olmalı
+    void BindForDraw() const;
+    void UnbindForDraw() const;
+    // bucketın görünen komutlarını çiz, bucketSize CPU tarafındaki toplam komut sayısı
+    void DrawBucket(size_t bucketIndex, size_t bucketSize) const;
+
+    // birkaç frame gecikmeli görünen sayısı (fence ile, pipeline durmuyor)
+    size_t GetLastVisibleCount() const { return lastVisibleCount; }
+    size_t GetLastTestedCount() const { return lastTestedCount; }
+    // pipeline'ı durdurarak hemen okur, sadece benchmark için
+    size_t ReadVisibleCountNow() const;
+
+private:
+    void PollReadback();
+
+    std::unique_ptr<Shader> computeShader;
+
+    GLuint inputCommandBuffer = 0;
+    GLuint cullInputBuffer = 0;
+    GLuint bucketOffsetBuffer = 0;
+    GLuint outputCommandBuffer = 0;
+    GLuint countBuffer = 0;
+    GLuint readbackBuffer = 0;
+    GLsync readbackFence = nullptr;
+
+    size_t inputCommandCapacity = 0;
+    size_t cullInputCapacity = 0;
+    size_t bucketOffsetCapacity = 0;
+    size_t outputCommandCapacity = 0;
+    size_t countCapacity = 0;
+
+    std::vector<GLuint> bucketStart; // DrawBucket için CPU kopyası
+    size_t bucketCount = 0;
+    size_t lastTestedCount = 0;
+    size_t lastVisibleCount = 0;
+};
@@ -0,0 +1,78 @@
+#include "GpuTimer.h"
+
+GpuTimer::GpuTimer(GLenum counterTarget) : counterTarget(counterTarget) {
+    for (auto& slot : slots) {
+        glGenQueries(1, &slot.start);
+        glGenQueries(1, &slot.end);
+        if (counterTarget != 0) {
+            glGenQueries(1, &slot.counter);
+        }
+    }
+}
+
+GpuTimer::~GpuTimer() {
+    for (auto& slot : slots) {
+        glDeleteQueries(1, &slot.start);
+        glDeleteQueries(1, &slot.end);
+        if (slot.counter != 0) {
+            glDeleteQueries(1, &slot.counter);
+        }
+    }
+}
+
+bool GpuTimer::Begin(float tag) {
+    Slot& slot = slots[slotIndex];
+    measuring = !slot.pending;
+    if (!measuring) {
+        return false;
+    }
+    slot.tag = tag;
+    glQueryCounter(slot.start, GL_TIMESTAMP);
+    if (counterTarget != 0) {
+        glBeginQuery(counterTarget, slot.counter);
+    }
+    return true;
+}
+
+void GpuTimer::End() {
+    if (!measuring) {
+        return;
+    }
+    Slot& slot = slots[slotIndex];
+    if (counterTarget != 0) {
+        glEndQuery(counterTarget);
+    }
+    glQueryCounter(slot.end, GL_TIMESTAMP);
+    slot.pending = true;
+    slotIndex = (slotIndex + 1) % QUERY_FRAMES;
+    measuring = false;
+}
+
+void GpuTimer::Poll(const std::function<void(const Result&)>& onResult) {
+    // slotIndex en eski ölçüm, sıra yumuşatma için önemli
+    for (int offset = 0; offset < QUERY_FRAMES; ++offset) {
+        Slot& slot = slots[(slotIndex + offset) % QUERY_FRAMES];
+        if (!slot.pending) {
+            continue;
+        }
+        // bitiş damgası aralıktaki tüm komutlardan sonra yazılıyor, o hazırsa hepsi hazır
+        GLint available = 0;
+        glGetQueryObjectiv(slot.end, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            continue;
+        }
+        slot.pending = false;
+
+        GLuint64 start = 0;
+        GLuint64 end = 0;
+        glGetQueryObjectui64v(slot.start, GL_QUERY_RESULT, &start);
+        glGetQueryObjectui64v(slot.end, GL_QUERY_RESULT, &end);
+        Result result;
+        result.ms = (end - start) / 1.0e6;
+        result.tag = slot.tag;
+        if (counterTarget != 0) {
+            glGetQueryObjectui64v(slot.counter, GL_QUERY_RESULT, &result.count);
+        }
+        onResult(result);
+    }
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <glad/glad.h>
+#include <functional>
+
+// GPU süre ölçümü: her ölçüm başında ve sonunda timestamp sorgusu (GL_TIME_ELAPSED'in aksine iç içe ölçümler
+// birbirini engellemiyor). Sonuçlar QUERY_FRAMES'lik halkadan birkaç frame gecikmeli okunuyor, CPU hiç beklemiyor;
+// halkanın sıradaki elemanı hala bekliyorsa (GPU geride) o frame ölçülmüyor.
+// counterTarget verilirse (ör. GL_SAMPLES_PASSED) aynı aralıkta o sorgu da açılıyor, sonucu ölçümle geliyor.
+// Kullanım (her frame): Poll -> Begin -> geçiş -> End
+class GpuTimer {
+public:
+    struct Result {
+        double ms = 0.0;
+        GLuint64 count = 0; // counterTarget sorgusunun sonucu
+        float tag = 0.0f;   // Begin'e verilen değer (ölçüm hangi modda/ölçekte yapıldı)
+    };
+
+    static constexpr int QUERY_FRAMES = 4;
+    static constexpr double DEFAULT_SMOOTHING = 0.1;
+
+    explicit GpuTimer(GLenum counterTarget = 0);
+    ~GpuTimer();
+    GpuTimer(const GpuTimer&) = delete;
+    GpuTimer& operator=(const GpuTimer&) = delete;
+
+    // sıradaki eleman boşsa ölçüm başlıyor, değilse false (End de bir şey yapmıyor)
+    bool Begin(float tag = 0.0f);
+    void End();
+    bool CanBegin() const { return !slots[slotIndex].pending; }
+    bool IsMeasuring() const { return measuring; }
+
+    // hazır olan ölçümler eskiden yeniye onResult'a
+    void Poll(const std::function<void(const Result&)>& onResult);
+
+    // gösterilen süreler titremesin diye yumuşatılıyor, target < 0 ise henüz değer yok
+    static void Smooth(double& target, double value, double factor = DEFAULT_SMOOTHING) {
+        target = target < 0.0 ? value : target * (1.0 - factor) + value * factor;
+    }
+
+private:
+    struct Slot {
+        GLuint start = 0;
+        GLuint end = 0;
+        GLuint counter = 0;
+        float tag = 0.0f;
+        bool pending = false;
+    };
+
+    GLenum counterTarget = 0;
+    Slot slots[QUERY_FRAMES];
+    int slotIndex = 0;
+    bool measuring = false;
+};
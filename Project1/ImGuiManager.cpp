@@ -2,6 +2,9 @@
 #include "SceneManager.h"
 #include "MuseumObject.h"
 #include "InputManager.h"
+#include "GeometryPool.h"
+#include "GLExtensions.h"
+#include "SimdCuller.h"
 #include <iostream>
 
 // Static üye değişkeni tanımlama
@@ -110,6 +113,7 @@ void ImGuiManager::Render(const SceneManager& sceneManager) {
             ImGui::MenuItem("Isik Kontrolu", NULL, &showLightControls);
             ImGui::MenuItem("Kamera Kontrolu", NULL, &showCameraControls);
             ImGui::MenuItem("Frustum Kontrolu", NULL, &showFrustumControls);
+            ImGui::MenuItem("Render Ayarlari", NULL, &showRenderSettings);
             ImGui::MenuItem("Genel Ayarlar", NULL, &showSettings);
             ImGui::MenuItem("Yardim", NULL, &showHelp);
             ImGui::MenuItem("Debug Bilgileri", NULL, &showDebugInfo);
@@ -134,6 +138,11 @@ void ImGuiManager::Render(const SceneManager& sceneManager) {
         ShowFrustumControls(const_cast<SceneManager&>(sceneManager));
     }
 
+    // render yolu ayarlari
+    if (showRenderSettings) {
+        ShowRenderSettings(const_cast<SceneManager&>(sceneManager));
+    }
+
     // rbt kontrolleri
     if (showRobotControls) {
         ShowRobotControls();
@@ -200,6 +209,14 @@ void ImGuiManager::ShowDebugWindow(float fps, const glm::vec3& cameraPos, bool i
     ImGui::Text("Pozisyon: (%.1f, %.1f, %.1f)", 
         robotPosition.x, robotPosition.y, robotPosition.z);
     ImGui::Text("Kol Açisi: %.1f°", robotArmAngle);
+
+    // ortak geometri havuzunun doluluk durumu
+    const GeometryPool& geometryPool = GeometryPool::GetInstance();
+    ImGui::Separator();
+    ImGui::Text("Geometri Havuzu:");
+    ImGui::Text("Vertex: %zu / %zu", geometryPool.GetVertexUsed(), geometryPool.GetVertexCapacity());
+    ImGui::Text("Index: %zu / %zu", geometryPool.GetIndexUsed(), geometryPool.GetIndexCapacity());
+    ImGui::Text("Mesh sayisi: %zu", geometryPool.GetAllocationCount());
     ImGui::End();
 }
 // light kontrollerinde atama problemi var öfd
@@ -299,5 +316,693 @@ void ImGuiManager::ShowFrustumControls(SceneManager& sceneManager) {
     ImGui::Text("- GPU kullanimi azalir");
     ImGui::Text("- FPS artisini saglar");
 
+    // son frame'in sayaçları (GPU culling açıkken CPU testi yapılmıyor)
+    ImGui::Separator();
+    const FrustumCullStats& stats = sceneManager.GetCullStats();
+    ImGui::Text("Obje: %zu / %zu elendi", stats.objectsCulled, stats.objectsTested);
+    size_t meshesCulled = stats.meshesCulledBySphere + stats.meshesCulledByBox;
+    ImGui::Text("Mesh: %zu / %zu elendi", meshesCulled, stats.meshesTested);
+    ImGui::Text("- Kure testi: %zu", stats.meshesCulledBySphere);
+    ImGui::Text("- AABB/OBB testi: %zu", stats.meshesCulledByBox);
+    ImGui::Text("- Onceki frame duzleminde elenen: %zu", stats.coherenceHits);
+
+    // donanım occlusion query
+    ImGui::Separator();
+    bool useOcclusion = sceneManager.IsOcclusionCullingEnabled();
+    if (ImGui::Checkbox("Occlusion culling (query + conditional render)", &useOcclusion)) {
+        sceneManager.EnableOcclusionCulling(useOcclusion);
+    }
+    const OcclusionCuller* occlusionCuller = sceneManager.GetOcclusionCuller();
+    if (useOcclusion && occlusionCuller) {
+        const OcclusionCuller::Stats& occlusionStats = occlusionCuller->GetStats();
+        ImGui::Text("Gizli obje: %zu / %zu aday (%zu kosullu cizim)", occlusionStats.occluded,
+            occlusionStats.candidates, occlusionStats.conditionalDraws);
+        if (occlusionStats.candidatePassMs >= 0.0 && occlusionStats.baselinePassMs >= 0.0) {
+            ImGui::Text("Aday GPU suresi: %.3f ms (kosulsuz %.3f ms, kazanc %.3f ms)", occlusionStats.candidatePassMs,
+                occlusionStats.baselinePassMs, occlusionStats.baselinePassMs - occlusionStats.candidatePassMs);
+        }
+        else if (occlusionStats.candidatePassMs >= 0.0) {
+            ImGui::Text("Aday GPU suresi: %.3f ms (kosulsuz olcum bekleniyor)", occlusionStats.candidatePassMs);
+        }
+    }
+
+    // CPU yazılım occlusion
+    ImGui::Separator();
+    bool useSoftwareOcclusion = sceneManager.IsSoftwareOcclusionEnabled();
+    if (ImGui::Checkbox("Yazilim occlusion (CPU derinlik bufferi)", &useSoftwareOcclusion)) {
+        sceneManager.EnableSoftwareOcclusion(useSoftwareOcclusion);
+    }
+    SoftwareOcclusion* softwareOcclusion = sceneManager.GetSoftwareOcclusion();
+    if (useSoftwareOcclusion && softwareOcclusion) {
+        const SoftwareOcclusion::Stats& softwareStats = softwareOcclusion->GetStats();
+        ImGui::Text("Occluder: %zu ucgen (%zu ekranda)", softwareStats.occluderTriangles, softwareStats.rasterizedTriangles);
+        ImGui::Text("Gizli: %zu / %zu kutu", softwareStats.occludedBoxes, softwareStats.testedBoxes);
+        ImGui::Text("Rasterize: %.3f ms, test: %.3f ms", softwareStats.rasterMs, softwareStats.testMs);
+        ImGui::Checkbox("Derinlik bufferini goster", &showSoftwareOcclusionBuffer);
+        if (showSoftwareOcclusionBuffer) {
+            // buffer y yukarı, ImGui y aşağı
+            GLuint texture = softwareOcclusion->UpdateDebugTexture();
+            ImGui::Image((ImTextureID)(intptr_t)texture,
+                ImVec2(SoftwareOcclusion::WIDTH * 2.0f, SoftwareOcclusion::HEIGHT * 2.0f), ImVec2(0, 1), ImVec2(1, 0));
+        }
+    }
+
+    // meshlet (küme) culling
+    ImGui::Separator();
+    bool useClusters = sceneManager.IsClusterCullingEnabled();
+    if (ImGui::Checkbox("Kume (meshlet) culling", &useClusters)) {
+        sceneManager.EnableClusterCulling(useClusters);
+    }
+    bool useCones = sceneManager.IsClusterConeCullingEnabled();
+    if (ImGui::Checkbox("Arkasi donuk kumeleri ele (normal konisi)", &useCones)) {
+        sceneManager.EnableClusterConeCulling(useCones);
+    }
+    const ClusterCullStats& clusterStats = sceneManager.GetClusterStats();
+    ImGui::Text("Kume: %zu test, %zu frustum, %zu koni ile elendi", clusterStats.clustersTested,
+        clusterStats.culledByFrustum, clusterStats.culledByCone);
+    ImGui::Text("Ucgen: %zu / %zu gonderildi", clusterStats.trianglesSubmitted, clusterStats.trianglesTotal);
+
+    // BVH: kapalıysa her obje tek tek test ediliyor (GPU culling açıkken kullanılmıyor)
+    ImGui::Separator();
+    bool useBVH = sceneManager.IsBVHCullingEnabled();
+    if (ImGui::Checkbox("BVH ile culling", &useBVH)) {
+        sceneManager.EnableBVHCulling(useBVH);
+    }
+    const SceneBVH& bvh = sceneManager.GetBVH();
+    ImGui::Text("BVH: %zu dugum, %zu item, derinlik %d", bvh.GetNodeCount(), bvh.GetItemCount(), bvh.GetDepth());
+    if (useBVH) {
+        const SceneBVH::CullStats& bvhStats = sceneManager.GetBVHStats();
+        ImGui::Text("Ziyaret edilen dugum: %zu", bvhStats.nodesVisited);
+        ImGui::Text("Alt agac: %zu kabul, %zu red", bvhStats.subtreesAccepted, bvhStats.subtreesRejected);
+    }
+
+    if (ImGui::Button("BVH benchmark (100..100k)")) {
+        sceneManager.RunBVHBenchmark();
+    }
+    const auto& bvhResults = sceneManager.GetBVHBenchmarkResults();
+    if (!bvhResults.empty() && ImGui::BeginTable("bvhBenchmark", 5, ImGuiTableFlags_Borders)) {
+        ImGui::TableSetupColumn("Obje");
+        ImGui::TableSetupColumn("Dogrusal ms");
+        ImGui::TableSetupColumn("BVH ms");
+        ImGui::TableSetupColumn("Kurma ms");
+        ImGui::TableSetupColumn("Dugum");
+        ImGui::TableHeadersRow();
+        for (const auto& result : bvhResults) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::Text("%zu", result.objectCount);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", result.linearMs);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", result.bvhMs);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", result.buildMs);
+            ImGui::TableNextColumn(); ImGui::Text("%zu", result.nodesVisited);
+        }
+        ImGui::EndTable();
+    }
+
+    // önceden hesaplanmış görünürlük (PVS)
+    ImGui::Separator();
+    bool usePVS = sceneManager.IsPVSEnabled();
+    if (ImGui::Checkbox("PVS (onceden hesaplanmis gorunurluk)", &usePVS)) {
+        sceneManager.EnablePVS(usePVS);
+    }
+    const PotentiallyVisibleSet& pvs = sceneManager.GetPVS();
+    if (pvs.IsLoaded()) {
+        ImGui::Text("PVS: %zu hucre, %zu hedef, %zu byte", pvs.GetCellCount(), pvs.GetTargetCount(), pvs.GetCompressedBytes());
+        const PVSCullStats& pvsStats = sceneManager.GetPVSStats();
+        if (sceneManager.IsPVSActive()) {
+            ImGui::Text("Hucre %d: %zu obje, %zu mesh elendi", pvsStats.cell, pvsStats.objectsRejected, pvsStats.meshesRejected);
+        }
+        else {
+            ImGui::Text("Kamera hacmin disinda ya da sahne degismis");
+        }
+    }
+    else {
+        ImGui::Text("PVS yuklu degil");
+    }
+    ImGui::SliderFloat("Hucre boyu", &pvsCellSize, 1.0f, 10.0f, "%.1f");
+    ImGui::SliderInt("Baslangic ornegi", &pvsOriginSamples, 1, 32);
+    ImGui::SliderInt("Hedef ornegi", &pvsTargetSamples, 1, 64);
+    if (ImGui::Button("PVS bake et ve kaydet")) {
+        PotentiallyVisibleSet::BakeSettings settings;
+        settings.cellSize = pvsCellSize;
+        settings.originSamples = pvsOriginSamples;
+        settings.targetSamples = pvsTargetSamples;
+        sceneManager.BakePVS(settings);
+    }
+    if (pvs.GetBakeStats().cells > 0) {
+        const PotentiallyVisibleSet::BakeStats& bakeStats = pvs.GetBakeStats();
+        ImGui::Text("Son bake: %.0f ms, %zu isin, %zu gorunur cift", bakeStats.bakeMs, bakeStats.raysCast, bakeStats.visiblePairs);
+        ImGui::Text("Bitset: %zu -> %zu byte", bakeStats.rawBytes, bakeStats.compressedBytes);
+    }
+
     ImGui::End();
-} 
\ No newline at end of file
+} 
+
+void ImGuiManager::ShowRenderSettings(SceneManager& sceneManager) {
+    ImGui::Begin("Render Ayarlari", &showRenderSettings);
+
+    ImGui::Text("OpenGL: %d.%d", GLExtensions::GetMajorVersion(), GLExtensions::GetMinorVersion());
+    ImGui::Text("Cizim gonderme (CPU): %.3f ms", sceneManager.GetLastSubmitTimeMs());
+
+    // isteğe bağlı çizim: değişiklik yokken döngü bekliyor, aktifken frame sınırı
+    if (framePacer) {
+        ImGui::Separator();
+        FramePacer::Settings pacerSettings = framePacer->GetSettings();
+        bool pacerChanged = false;
+        pacerChanged |= ImGui::Checkbox("Sadece degisince ciz", &pacerSettings.renderOnDemand);
+        pacerChanged |= ImGui::SliderInt("FPS siniri (0 sinirsiz)", &pacerSettings.maxFps, 0, 240);
+        if (pacerSettings.renderOnDemand) {
+            pacerChanged |= ImGui::SliderFloat("Son degisiklikten sonra (s)", &pacerSettings.activeSeconds, 0.0f, 5.0f, "%.1f");
+            pacerChanged |= ImGui::SliderFloat("Bosta en uzun bekleme (s)", &pacerSettings.idleWaitSeconds, 0.05f, 5.0f, "%.2f");
+        }
+        if (pacerChanged) {
+            framePacer->SetSettings(pacerSettings);
+        }
+        const FramePacer::Stats& pacerStats = framePacer->GetStats();
+        ImGui::Text("Cizilen: %.1f frame/s, cizmeden uyanma: %.1f/s", pacerStats.renderedFps, pacerStats.wakeupsPerSecond);
+        ImGui::Text("Ana thread dolu: %.1f%%, GPU dolu: %.1f%% (frame %.2f ms)", pacerStats.cpuBusy * 100.0,
+            pacerStats.gpuBusy * 100.0, pacerStats.gpuFrameMs);
+        ImGui::Text("Toplam: %zu cizilen, %zu atlanan", pacerStats.renderedFrames, pacerStats.skippedFrames);
+    }
+
+    // dinamik çözünürlük: sahne GPU süresi hedefte kalacak şekilde küçültülüp büyütülüyor
+    if (dynamicResolution) {
+        ImGui::Separator();
+        DynamicResolution::Settings resolutionSettings = dynamicResolution->GetSettings();
+        bool resolutionChanged = false;
+        resolutionChanged |= ImGui::Checkbox("Dinamik cozunurluk", &resolutionSettings.enabled);
+        if (resolutionSettings.enabled) {
+            resolutionChanged |= ImGui::SliderFloat("Hedef sahne suresi (ms)", &resolutionSettings.targetMs, 2.0f, 40.0f, "%.1f");
+            resolutionChanged |= ImGui::SliderFloat("Hysteresis", &resolutionSettings.hysteresis, 0.0f, 0.5f, "%.2f");
+            resolutionChanged |= ImGui::SliderFloat("En dusuk olcek", &resolutionSettings.minScale, 0.25f, 1.0f, "%.2f");
+            resolutionChanged |= ImGui::SliderFloat("En yuksek olcek", &resolutionSettings.maxScale, 0.25f, 1.0f, "%.2f");
+        }
+        else {
+            resolutionChanged |= ImGui::SliderFloat("Sabit olcek", &resolutionSettings.fixedScale, 0.25f, 1.0f, "%.2f");
+        }
+        resolutionChanged |= ImGui::SliderFloat("Keskinlestirme", &resolutionSettings.sharpness, 0.0f, 1.0f, "%.2f");
+        if (resolutionChanged) {
+            dynamicResolution->SetSettings(resolutionSettings);
+        }
+        const DynamicResolution::Stats& resolutionStats = dynamicResolution->GetStats();
+        ImGui::Text("Sahne: %dx%d (%.0f%%), pencere %dx%d", resolutionStats.renderWidth, resolutionStats.renderHeight,
+            resolutionStats.scale * 100.0f, resolutionStats.outputWidth, resolutionStats.outputHeight);
+        if (resolutionStats.sceneMs >= 0.0) {
+            ImGui::Text("Sahne GPU: %.3f ms", resolutionStats.sceneMs);
+        }
+        if (resolutionStats.offscreen && resolutionStats.upscaleMs >= 0.0) {
+            ImGui::Text("Buyutme + keskinlestirme: %.3f ms", resolutionStats.upscaleMs);
+        }
+        ImGui::Text("Olcek degisimi: %zu", resolutionStats.scaleChanges);
+    }
+
+    // tur kaydı: yol ya da eser kareleri ekran dışında, PBO halkasıyla geri okunup threadlerde kodlanıyor
+    if (tourCapture) {
+        ImGui::Separator();
+        if (!tourCapture->IsActive()) {
+            ImGui::InputInt("Kayit genisligi", &tourCaptureSettings.width);
+            ImGui::InputInt("Kayit yuksekligi", &tourCaptureSettings.height);
+            ImGui::SliderFloat("Kayit FPS", &tourCaptureSettings.fps, 1.0f, 120.0f, "%.0f");
+            int captureFormat = tourCaptureSettings.format == TourCapture::Format::PNG ? 0 : 1;
+            ImGui::RadioButton("PNG", &captureFormat, 0);
+            ImGui::SameLine();
+            ImGui::RadioButton("YUV 4:2:0", &captureFormat, 1);
+            tourCaptureSettings.format = captureFormat == 0 ? TourCapture::Format::PNG : TourCapture::Format::YUV420;
+            ImGui::Text("Yol: %s", tourPath.c_str());
+            if (ImGui::Button("Turu kaydet") && tourCapture->LoadPath(tourPath)) {
+                tourCapture->Start(tourCaptureSettings);
+            }
+            ImGui::SameLine();
+            if (ImGui::Button("Eser kucuk resimleri")) {
+                tourCapture->SetArtifactShots(sceneManager.GetMuseumObjects());
+                tourCapture->Start(tourCaptureSettings);
+            }
+            ImGui::SameLine();
+            // genişlik yükseklikten hesaplanıyor (2:1)
+            if (ImGui::Button("Eser panoramalari")) {
+                tourCapture->SetArtifactShots(sceneManager.GetMuseumObjects(), true);
+                tourCapture->Start(tourCaptureSettings);
+            }
+        }
+        else if (ImGui::Button("Kaydi iptal et")) {
+            tourCapture->Cancel();
+        }
+        const TourCapture::Stats& captureStats = tourCapture->GetStats();
+        if (captureStats.totalFrames > 0) {
+            ImGui::Text("Kayit: %zu/%zu cizildi, %zu yazildi", captureStats.renderedFrames, captureStats.totalFrames,
+                captureStats.writtenFrames);
+            ImGui::Text("%.1f frame/s, geri okuma %.1f MB/s", captureStats.framesPerSecond, captureStats.readbackMBps);
+            ImGui::Text("Fence beklemesi: %zu, kodlayici beklemesi: %zu", captureStats.fenceStalls, captureStats.encoderStalls);
+        }
+        const CubemapCapture* cubemapCapture = sceneManager.GetCubemapCapture();
+        if (tourCapture->IsPanorama() && cubemapCapture) {
+            // birleşik culling'in sayaçları (kayıt sürerken frustum sayaçları da aynı)
+            const FrustumCullStats& panoramaCull = sceneManager.GetCullStats();
+            ImGui::Text("Kup yuzu: %dx%d, %zu panorama", cubemapCapture->GetStats().faceSize,
+                cubemapCapture->GetStats().faceSize, cubemapCapture->GetStats().captures);
+            ImGui::Text("Tek culling: %zu/%zu mesh elendi", panoramaCull.meshesCulledByBox + panoramaCull.meshesCulledBySphere,
+                panoramaCull.meshesTested);
+        }
+    }
+
+    // aydınlatma yolu: forward ya da deferred
+    ImGui::Separator();
+    int shadingMode = sceneManager.IsDeferredShadingEnabled() ? 1 : 0;
+    if (ImGui::RadioButton("Forward", &shadingMode, 0)) {
+        sceneManager.EnableDeferredShading(false);
+    }
+    ImGui::SameLine();
+    if (ImGui::RadioButton("Deferred", &shadingMode, 1)) {
+        sceneManager.EnableDeferredShading(true);
+    }
+    ImGui::Text("Isik sayisi: %d", sceneManager.GetLightCount());
+    if (ImGui::Button("Her esere spot isik ekle")) {
+        sceneManager.AddArtifactSpotLights();
+    }
+    bool useClusteredLighting = sceneManager.IsClusteredLightingEnabled();
+    if (ImGui::Checkbox("Kumelenmis forward isiklar (16x9x24)", &useClusteredLighting)) {
+        sceneManager.EnableClusteredLighting(useClusteredLighting);
+    }
+    const ClusteredLighting* clusteredLighting = sceneManager.GetClusteredLighting();
+    if (useClusteredLighting && clusteredLighting) {
+        const ClusteredLighting::Stats& clusterStats = clusteredLighting->GetStats();
+        ImGui::Text("Dolu kume: %zu / %d, kume basina en fazla %zu isik", clusterStats.activeClusters,
+            ClusteredLighting::CLUSTER_COUNT, clusterStats.maxLightsPerCluster);
+        ImGui::Text("Isik referansi: %zu, atama: %.3f ms", clusterStats.lightIndices, clusterStats.assignMs);
+    }
+    else if (sceneManager.GetLightCount() > LightBuffer::MAX_LIGHTS + 1) {
+        ImGui::TextWrapped("Kumeler kapaliyken forward yolda ilk %d isik kullaniliyor.", LightBuffer::MAX_LIGHTS + 1);
+    }
+    const DeferredRenderer* deferredRenderer = sceneManager.GetDeferredRenderer();
+    if (shadingMode == 1 && deferredRenderer) {
+        const DeferredRenderer::Stats& deferredStats = deferredRenderer->GetStats();
+        ImGui::Text("Isik hacmi: %zu, tam ekran: %zu", deferredStats.volumeLights, deferredStats.fullscreenLights);
+        if (deferredStats.geometryMs >= 0.0) {
+            ImGui::Text("G-buffer: %.3f ms, isik + resolve: %.3f ms", deferredStats.geometryMs, deferredStats.lightingMs);
+        }
+    }
+    if (ImGui::Button("Forward / kumelenmis / deferred benchmark (1, 16, 128 isik)")) {
+        sceneManager.RequestLightingBenchmark();
+    }
+    const auto& lightingResults = sceneManager.GetLightingBenchmarkResults();
+    if (!lightingResults.empty() && ImGui::BeginTable("lightingBenchmark", 4, ImGuiTableFlags_Borders)) {
+        ImGui::TableSetupColumn("Isik");
+        ImGui::TableSetupColumn("Forward ms");
+        ImGui::TableSetupColumn("Kumelenmis ms");
+        ImGui::TableSetupColumn("Deferred ms");
+        ImGui::TableHeadersRow();
+        for (const auto& result : lightingResults) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::Text("%zu", result.lightCount);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", result.forwardMs);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", result.clusteredMs);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", result.deferredMs);
+        }
+        ImGui::EndTable();
+    }
+
+    // statik kabuğun lightmap'i
+    ImGui::Separator();
+    bool useLightmap = sceneManager.IsLightmapEnabled();
+    if (ImGui::Checkbox("Lightmap (statik bina)", &useLightmap)) {
+        sceneManager.EnableLightmap(useLightmap);
+    }
+    ImGui::TextWrapped("Bake isiklarin en yuksek yogunluguyla; aciksa binada isiklar kamera yaklastikca yanmiyor "
+        "(sadece ana isigin yansimasi degisiyor).");
+    const Lightmap& lightmap = sceneManager.GetLightmap();
+    if (lightmap.IsLoaded()) {
+        ImGui::Text("Lightmap: %dx%d, %zu chart, %zu byte", lightmap.GetAtlasSize(), lightmap.GetAtlasSize(),
+            lightmap.GetChartCount(), lightmap.GetCompressedBytes());
+        if (shadingMode == 1) {
+            ImGui::TextWrapped("Deferred modda lightmap kullanilmiyor.");
+        }
+    }
+    else {
+        ImGui::Text("Lightmap yuklu degil");
+    }
+    ImGui::SliderInt("Atlas boyu", &lightmapAtlasSize, 256, 2048);
+    ImGui::SliderFloat("Texel / metre", &lightmapTexelsPerUnit, 1.0f, 16.0f, "%.1f");
+    ImGui::SliderInt("Dolayli isin (texel basina)", &lightmapIndirectSamples, 0, 256);
+    if (ImGui::Button("Lightmap bake et ve kaydet")) {
+        Lightmap::BakeSettings settings;
+        settings.atlasSize = lightmapAtlasSize;
+        settings.texelsPerUnit = lightmapTexelsPerUnit;
+        settings.indirectSamples = lightmapIndirectSamples;
+        sceneManager.BakeLightmap(settings);
+    }
+    if (lightmap.GetBakeStats().texels > 0) {
+        const Lightmap::BakeStats& bakeStats = lightmap.GetBakeStats();
+        ImGui::Text("Son bake: %.0f ms (acilim %.0f ms), %zu texel, %.1f texel/m", bakeStats.bakeMs, bakeStats.unwrapMs,
+            bakeStats.texels, bakeStats.texelsPerUnit);
+        ImGui::Text("%zu isin, %.2f M isin/sn (%zu thread)", bakeStats.raysCast, bakeStats.raysPerSecond / 1.0e6, bakeStats.threads);
+        ImGui::Text("Atlas: %zu -> %zu byte", bakeStats.rawBytes, bakeStats.compressedBytes);
+    }
+
+    // hareketli objelerin irradiance probları
+    ImGui::Separator();
+    bool useProbeVolume = sceneManager.IsProbeVolumeEnabled();
+    if (ImGui::Checkbox("Irradiance problari (hareketli objeler)", &useProbeVolume)) {
+        sceneManager.EnableProbeVolume(useProbeVolume);
+    }
+    const IrradianceVolume& irradianceVolume = sceneManager.GetIrradianceVolume();
+    if (irradianceVolume.IsLoaded()) {
+        glm::ivec3 probeResolution = irradianceVolume.GetResolution();
+        ImGui::Text("Problar: %dx%dx%d (%zu), %zu byte texture", probeResolution.x, probeResolution.y, probeResolution.z,
+            irradianceVolume.GetProbeCount(), irradianceVolume.GetTextureBytes());
+        if (shadingMode == 1) {
+            ImGui::TextWrapped("Deferred modda problar kullanilmiyor.");
+        }
+    }
+    else {
+        ImGui::Text("Problar yuklu degil");
+    }
+    ImGui::SliderFloat("Prob araligi (m)", &probeSpacing, 0.5f, 8.0f, "%.1f");
+    ImGui::SliderInt("Isin (prob basina)", &probeRays, 16, 1024);
+    if (ImGui::Button("Problari bake et ve kaydet")) {
+        IrradianceVolume::BakeSettings settings;
+        settings.probeSpacing = probeSpacing;
+        settings.raysPerProbe = probeRays;
+        sceneManager.BakeProbeVolume(settings);
+    }
+    if (irradianceVolume.GetBakeStats().probes > 0) {
+        const IrradianceVolume::BakeStats& probeStats = irradianceVolume.GetBakeStats();
+        ImGui::Text("Son bake: %.0f ms, %zu prob (%zu duvar icinde)", probeStats.bakeMs, probeStats.probes,
+            probeStats.invalidProbes);
+        ImGui::Text("%zu isin, %.2f M isin/sn (%zu thread)", probeStats.raysCast, probeStats.raysPerSecond / 1.0e6,
+            probeStats.threads);
+    }
+
+    // önbellekli gölge atlası
+    ImGui::Separator();
+    bool useShadows = sceneManager.IsShadowsEnabled();
+    if (ImGui::Checkbox("Golgeler (onbellekli atlas)", &useShadows)) {
+        sceneManager.EnableShadows(useShadows);
+    }
+    ShadowAtlas::Settings shadowSettings = sceneManager.GetShadowSettings();
+    bool shadowSettingsChanged = false;
+    const char* filterNames[] = { "Sert", "PCF 2x2 (donanim)", "PCF 3x3", "PCF 5x5" };
+    int filter = static_cast<int>(shadowSettings.filter);
+    if (ImGui::Combo("Filtre", &filter, filterNames, IM_ARRAYSIZE(filterNames))) {
+        shadowSettings.filter = static_cast<ShadowAtlas::Filter>(filter);
+        shadowSettingsChanged = true;
+    }
+    const char* tileSizeNames[] = { "256", "512", "1024" };
+    const int tileSizes[] = { 256, 512, 1024 };
+    int tileSizeIndex = shadowSettings.tileSize <= 256 ? 0 : (shadowSettings.tileSize <= 512 ? 1 : 2);
+    if (ImGui::Combo("Tile boyu", &tileSizeIndex, tileSizeNames, IM_ARRAYSIZE(tileSizeNames))) {
+        shadowSettings.tileSize = tileSizes[tileSizeIndex];
+        shadowSettingsChanged = true;
+    }
+    shadowSettingsChanged |= ImGui::SliderFloat("Normal bias (texel)", &shadowSettings.normalBias, 0.0f, 4.0f, "%.2f");
+    shadowSettingsChanged |= ImGui::SliderFloat("Spot onbellek payi (derece)", &shadowSettings.spotMarginDegrees, 0.0f, 30.0f, "%.0f");
+    if (shadowSettingsChanged) {
+        sceneManager.SetShadowSettings(shadowSettings);
+    }
+    if (ImGui::Button("Statik katmani yeniden ciz")) {
+        sceneManager.InvalidateShadows();
+    }
+    const ShadowAtlas* shadowAtlas = sceneManager.GetShadowAtlas();
+    if (shadingMode == 1) {
+        ImGui::TextWrapped("Deferred modda golgeler kullanilmiyor.");
+    }
+    else if (shadowAtlas && useShadows) {
+        const ShadowAtlas::Stats& shadowStats = shadowAtlas->GetStats();
+        ImGui::Text("Atlas: %dx%d, %zu byte, %zu isik / %zu tile", shadowAtlas->GetAtlasSize(), shadowAtlas->GetAtlasSize(),
+            shadowAtlas->GetTextureBytes(), shadowStats.shadowedLights, shadowStats.tiles);
+        ImGui::Text("Bu frame: %zu statik tile, %zu dinamik tile (%zu caster)", shadowStats.staticTilesRendered,
+            shadowStats.compositeTiles, shadowStats.dynamicCasterDraws);
+        ImGui::Text("Toplam statik cizim: %zu", shadowStats.staticRendersTotal);
+        if (shadowStats.gpuMs >= 0.0) {
+            ImGui::Text("Golge gecisi: %.3f ms GPU, %.3f ms CPU", shadowStats.gpuMs, shadowStats.cpuMs);
+        }
+    }
+
+    // derinlik ön geçişi
+    ImGui::Separator();
+    bool useDepthPrepass = sceneManager.IsDepthPrepassEnabled();
+    if (ImGui::Checkbox("Derinlik on gecisi (depth pre-pass)", &useDepthPrepass)) {
+        sceneManager.EnableDepthPrepass(useDepthPrepass);
+    }
+    const DepthPrepass* depthPrepass = sceneManager.GetDepthPrepass();
+    if (shadingMode == 1) {
+        ImGui::TextWrapped("Deferred modda on gecis kullanilmiyor.");
+    }
+    else if (depthPrepass) {
+        const DepthPrepass::Stats& prepassStats = depthPrepass->GetStats();
+        const char* counterName = prepassStats.pipelineStatistics ? "fragment shader cagrisi" : "sample";
+        if (useDepthPrepass && prepassStats.prepassMs >= 0.0 && prepassStats.colorPassMs >= 0.0) {
+            ImGui::Text("On gecis: %.3f ms, renk gecisi: %.3f ms", prepassStats.prepassMs, prepassStats.colorPassMs);
+        }
+        if (prepassStats.baselineColorPassMs >= 0.0) {
+            ImGui::Text("On gecissiz renk gecisi: %.3f ms", prepassStats.baselineColorPassMs);
+        }
+        if (useDepthPrepass && prepassStats.prepassMs >= 0.0 && prepassStats.colorPassMs >= 0.0 &&
+            prepassStats.baselineColorPassMs >= 0.0) {
+            ImGui::Text("Kazanc: %.3f ms", prepassStats.baselineColorPassMs - (prepassStats.prepassMs + prepassStats.colorPassMs));
+        }
+        if (useDepthPrepass && prepassStats.colorInvocations >= 0.0) {
+            ImGui::Text("%s: %.0f", counterName, prepassStats.colorInvocations);
+        }
+        if (prepassStats.baselineInvocations >= 0.0) {
+            ImGui::Text("%s (on gecissiz): %.0f", counterName, prepassStats.baselineInvocations);
+        }
+        if (sceneManager.IsOcclusionCullingEnabled()) {
+            ImGui::TextWrapped("Occlusion query acikken renk gecisi olculmuyor.");
+        }
+    }
+
+    // shading LOD: küçük/uzak meshlerde ucuz BRDF varyantları
+    ImGui::Separator();
+    bool useShadingLod = sceneManager.IsShadingLodEnabled();
+    if (ImGui::Checkbox("Shading LOD (kucuk/uzak meshler)", &useShadingLod)) {
+        sceneManager.EnableShadingLod(useShadingLod);
+    }
+    ShadingLod::Settings shadingLodSettings = sceneManager.GetShadingLodSettings();
+    bool shadingLodChanged = false;
+    shadingLodChanged |= ImGui::SliderFloat("Tam PBR esigi (piksel)", &shadingLodSettings.fullScreenSize, 16.0f, 512.0f, "%.0f");
+    shadingLodChanged |= ImGui::SliderFloat("Daginik esigi (piksel)", &shadingLodSettings.diffuseScreenSize, 0.0f, 256.0f, "%.0f");
+    shadingLodChanged |= ImGui::SliderFloat("Tam PBR uzakligi", &shadingLodSettings.fullDistance, 1.0f, 200.0f, "%.0f");
+    shadingLodChanged |= ImGui::SliderFloat("Daginik uzakligi", &shadingLodSettings.diffuseDistance, 1.0f, 400.0f, "%.0f");
+    const char* shadingLevelNames[] = { "Otomatik", "Tam PBR", "Blinn-Phong", "Sadece daginik" };
+    int forcedShadingLevel = shadingLodSettings.forcedLevel + 1;
+    if (ImGui::Combo("Seviye", &forcedShadingLevel, shadingLevelNames, IM_ARRAYSIZE(shadingLevelNames))) {
+        shadingLodSettings.forcedLevel = forcedShadingLevel - 1;
+        shadingLodChanged = true;
+    }
+    if (shadingLodChanged) {
+        sceneManager.SetShadingLodSettings(shadingLodSettings);
+    }
+    const ShadingLod* shadingLod = sceneManager.GetShadingLod();
+    if (shadingMode == 1) {
+        ImGui::TextWrapped("Deferred modda shading LOD kullanilmiyor.");
+    }
+    else if (sceneManager.IsIndirectDrawEnabled() && sceneManager.IsIndirectDrawSupported() &&
+        !sceneManager.IsOcclusionCullingEnabled()) {
+        ImGui::TextWrapped("Indirect yolda meshler tam PBR ile ciziliyor.");
+    }
+    else if (shadingLod && useShadingLod) {
+        const ShadingLod::Stats& shadingStats = shadingLod->GetStats();
+        ImGui::Text("Mesh: %zu tam, %zu Blinn-Phong, %zu daginik", shadingStats.meshes[0], shadingStats.meshes[1],
+            shadingStats.meshes[2]);
+    }
+    if (ImGui::Button("Shading LOD benchmark (bu kameradan)")) {
+        sceneManager.RequestShadingLodBenchmark();
+    }
+    const ShadingLod::BenchmarkResult& shadingResult = sceneManager.GetShadingLodBenchmarkResult();
+    if (shadingResult.valid && ImGui::BeginTable("shadingLodBenchmark", 4, ImGuiTableFlags_Borders)) {
+        ImGui::TableSetupColumn("Seviye");
+        ImGui::TableSetupColumn("GPU ms");
+        ImGui::TableSetupColumn("Ort. fark");
+        ImGui::TableSetupColumn("Degisen %");
+        ImGui::TableHeadersRow();
+        for (int mode = 0; mode <= ShadingLod::LEVEL_COUNT; ++mode) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::Text("%s", mode < ShadingLod::LEVEL_COUNT ? shadingLevelNames[mode + 1] : shadingLevelNames[0]);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", shadingResult.gpuMs[mode]);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f (max %d)", shadingResult.meanDiff[mode], shadingResult.maxDiff[mode]);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", shadingResult.changedPixels[mode] * 100.0);
+        }
+        ImGui::EndTable();
+        ImGui::Text("Otomatik: %zu tam, %zu Blinn-Phong, %zu daginik", shadingResult.autoMeshes[0],
+            shadingResult.autoMeshes[1], shadingResult.autoMeshes[2]);
+    }
+
+    // Multi-draw indirect (GL 4.3+), desteklenmiyorsa kutucuk pasif
+    ImGui::Separator();
+    bool indirectSupported = sceneManager.IsIndirectDrawSupported();
+    bool useIndirect = sceneManager.IsIndirectDrawEnabled();
+    if (!indirectSupported) {
+        ImGui::BeginDisabled();
+    }
+    if (ImGui::Checkbox("Multi-Draw Indirect (GL 4.3+)", &useIndirect)) {
+        sceneManager.EnableIndirectDraw(useIndirect);
+    }
+    if (!indirectSupported) {
+        ImGui::EndDisabled();
+        ImGui::TextWrapped("Bu surucu GL 4.3 desteklemiyor, klasik cizim yolu kullaniliyor.");
+    }
+
+    const IndirectRenderer* indirectRenderer = sceneManager.GetIndirectRenderer();
+    if (useIndirect && indirectRenderer) {
+        ImGui::Text("Mesh cizimi: %zu", indirectRenderer->GetDrawCount());
+        ImGui::Text("glMultiDrawElementsIndirect cagrisi: %zu", indirectRenderer->GetMultiDrawCallCount());
+        ImGui::Text("Materyal: %zu", indirectRenderer->GetMaterialCount());
+    }
+
+    // Culling: CPU (küre testi) ya da compute shader, GPU yolu indirect çizim gerektiriyor
+    ImGui::Separator();
+    bool gpuCullingSupported = sceneManager.IsGpuCullingSupported() && useIndirect;
+    int cullingMode = sceneManager.IsGpuCullingEnabled() ? 1 : 0;
+    if (!gpuCullingSupported) {
+        ImGui::BeginDisabled();
+    }
+    if (ImGui::RadioButton("CPU culling", &cullingMode, 0)) {
+        sceneManager.EnableGpuCulling(false);
+    }
+    ImGui::SameLine();
+    if (ImGui::RadioButton("GPU culling (compute)", &cullingMode, 1)) {
+        sceneManager.EnableGpuCulling(true);
+    }
+    if (!gpuCullingSupported) {
+        ImGui::EndDisabled();
+    }
+
+    const GpuCuller* gpuCuller = indirectRenderer ? indirectRenderer->GetGpuCuller() : nullptr;
+    if (gpuCullingSupported && cullingMode == 1 && gpuCuller) {
+        ImGui::Text("GPU: %zu / %zu gorunur", gpuCuller->GetLastVisibleCount(), gpuCuller->GetLastTestedCount());
+    }
+
+    // statik batch istatistikleri (chunk bazında culling)
+    size_t staticBatches = 0;
+    size_t visibleStaticBatches = 0;
+    for (MuseumObject* object : sceneManager.GetAllMuseumObjects()) {
+        if (object->IsStatic()) {
+            staticBatches += object->GetMeshes().size();
+            visibleStaticBatches += object->GetVisibleMeshCount();
+        }
+    }
+    if (staticBatches > 0) {
+        ImGui::Text("Statik batch: %zu / %zu cizildi", visibleStaticBatches, staticBatches);
+    }
+
+    // hardware instancing istatistikleri
+    ImGui::Separator();
+    const auto& instancedObjects = sceneManager.GetInstancedObjects();
+    if (instancedObjects.empty()) {
+        if (ImGui::Button("Depo salonunu yukle (5000 obje)")) {
+            sceneManager.LoadStorageHallScene();
+        }
+    }
+    else {
+        size_t totalInstances = 0;
+        size_t visibleInstances = 0;
+        size_t instancedDrawCalls = 0;
+        for (const auto& obj : instancedObjects) {
+            totalInstances += obj->GetInstanceCount();
+            visibleInstances += obj->GetVisibleInstanceCount();
+            instancedDrawCalls += obj->GetLastDrawCallCount();
+        }
+        ImGui::Text("Instanced kopya: %zu / %zu gorunur", visibleInstances, totalInstances);
+        ImGui::Text("Instanced cizim cagrisi: %zu", instancedDrawCalls);
+
+        // uzak kopyalar impostor (oktahedral görünüş atlası)
+        bool useImpostors = sceneManager.IsImpostorsEnabled();
+        if (ImGui::Checkbox("Impostor (uzak kopyalar)", &useImpostors)) {
+            sceneManager.EnableImpostors(useImpostors);
+        }
+        InstancedObject::LodParams impostorLod = sceneManager.GetImpostorLod();
+        bool impostorLodChanged = false;
+        impostorLodChanged |= ImGui::SliderFloat("Impostor esigi (piksel)", &impostorLod.screenSize, 8.0f, 256.0f, "%.0f");
+        impostorLodChanged |= ImGui::SliderFloat("Gecis bandi", &impostorLod.fadeBand, 0.0f, 1.0f, "%.2f");
+        const char* frameCountNames[] = { "4x4", "8x8", "12x12", "16x16" };
+        const int frameCounts[] = { 4, 8, 12, 16 };
+        int frameCountIndex = impostorLod.impostor.framesPerAxis <= 4 ? 0 : (impostorLod.impostor.framesPerAxis <= 8 ? 1 :
+            (impostorLod.impostor.framesPerAxis <= 12 ? 2 : 3));
+        if (ImGui::Combo("Gorunus", &frameCountIndex, frameCountNames, IM_ARRAYSIZE(frameCountNames))) {
+            impostorLod.impostor.framesPerAxis = frameCounts[frameCountIndex];
+            impostorLodChanged = true;
+        }
+        const char* frameSizeNames[] = { "32", "64", "128" };
+        const int frameSizes[] = { 32, 64, 128 };
+        int frameSizeIndex = impostorLod.impostor.frameSize <= 32 ? 0 : (impostorLod.impostor.frameSize <= 64 ? 1 : 2);
+        if (ImGui::Combo("Frame boyu", &frameSizeIndex, frameSizeNames, IM_ARRAYSIZE(frameSizeNames))) {
+            impostorLod.impostor.frameSize = frameSizes[frameSizeIndex];
+            impostorLodChanged = true;
+        }
+        if (impostorLodChanged) {
+            sceneManager.SetImpostorLod(impostorLod);
+        }
+        if (useImpostors) {
+            size_t impostorInstances = 0;
+            size_t fadingInstances = 0;
+            for (const auto& obj : instancedObjects) {
+                impostorInstances += obj->GetImpostorInstanceCount();
+                fadingInstances += obj->GetFadingInstanceCount();
+            }
+            ImGui::Text("Impostor: %zu kopya (%zu geciste)", impostorInstances, fadingInstances);
+            for (const auto& obj : instancedObjects) {
+                const Impostor* impostor = obj->GetImpostor();
+                if (impostor) {
+                    ImGui::Text("%s: %dx%d atlas, %.2f MB, %.1f ms", obj->GetName().c_str(), impostor->GetAtlasSize(),
+                        impostor->GetAtlasSize(), impostor->GetTextureBytes() / (1024.0 * 1024.0), impostor->GetBuildMs());
+                }
+            }
+        }
+        if (ImGui::Button("Impostor benchmark (bu kameradan)")) {
+            sceneManager.RequestImpostorBenchmark();
+        }
+        const Impostor::BenchmarkResult& impostorResult = sceneManager.GetImpostorBenchmarkResult();
+        if (impostorResult.visibleInstances > 0) {
+            ImGui::Text("%zu gorunur kopya: mesh %.3f ms, impostorlu %.3f ms", impostorResult.visibleInstances,
+                impostorResult.meshOnlyMs, impostorResult.impostorMs);
+            ImGui::Text("Impostorlu: %zu impostor, %zu mesh, atlaslar %.2f MB", impostorResult.impostorInstances,
+                impostorResult.meshInstances, impostorResult.textureBytes / (1024.0 * 1024.0));
+        }
+    }
+
+    ImGui::Separator();
+    // instance culling'in SIMD yolu, CPU'nun desteklemediği yollar seçilemiyor
+    int activeIsa = static_cast<int>(SimdCuller::GetActiveIsa());
+    for (int isa = 0; isa < 4; ++isa) {
+        SimdCuller::Isa option = static_cast<SimdCuller::Isa>(isa);
+        if (isa > 0) ImGui::SameLine();
+        if (!SimdCuller::IsIsaSupported(option)) {
+            ImGui::TextDisabled("%s", SimdCuller::GetIsaName(option));
+        }
+        else if (ImGui::RadioButton(SimdCuller::GetIsaName(option), activeIsa == isa)) {
+            SimdCuller::SetActiveIsa(option);
+        }
+    }
+
+    if (ImGui::Button("Culling benchmark (1k/10k/100k)")) {
+        sceneManager.RunCullingBenchmark();
+    }
+    const auto& benchmarkResults = sceneManager.GetCullingBenchmarkResults();
+    if (!benchmarkResults.empty() && ImGui::BeginTable("cullingBenchmark", 5, ImGuiTableFlags_Borders)) {
+        int bestIsa = static_cast<int>(SimdCuller::GetBestIsa());
+        ImGui::TableSetupColumn("Obje");
+        ImGui::TableSetupColumn("CPU ms");
+        ImGui::TableSetupColumn(SimdCuller::GetIsaName(SimdCuller::GetBestIsa()));
+        ImGui::TableSetupColumn("GPU gonder ms");
+        ImGui::TableSetupColumn("GPU compute ms");
+        ImGui::TableHeadersRow();
+        for (const auto& result : benchmarkResults) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::Text("%zu", result.objectCount);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", result.cpuMs);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", result.simdMs[bestIsa]);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", result.gpuSubmitMs);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", result.gpuDispatchMs);
+        }
+        ImGui::EndTable();
+    }
+
+    ImGui::End();
+}
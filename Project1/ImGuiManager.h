@@ -8,6 +8,9 @@
 #include "InputManager.h"
 #include <glm/glm.hpp>
 #include "Robot.h"
+#include "DynamicResolution.h"
+#include "FramePacer.h"
+#include "TourCapture.h"
 #include <string>
 #include <memory>
 #include <vector>
@@ -26,6 +29,22 @@ private:
 	bool showArtifactInfo = false;
 	bool showFrustumControls = false;
 	bool showLightWindow = false;
+	bool showRenderSettings = false;
+	bool showSoftwareOcclusionBuffer = false;
+	// PVS bake ayarları
+	float pvsCellSize = 4.0f;
+	int pvsOriginSamples = 8;
+	int pvsTargetSamples = 16;
+	// lightmap bake ayarları
+	int lightmapAtlasSize = 1024;
+	float lightmapTexelsPerUnit = 4.0f;
+	int lightmapIndirectSamples = 32;
+	// irradiance prob bake ayarları
+	float probeSpacing = 2.0f;
+	int probeRays = 128;
+	// tur kaydı ayarları
+	TourCapture::Settings tourCaptureSettings;
+	std::string tourPath = "models/museum/tour.txt";
 	// Singleton için private constructor
 	ImGuiManager(GLFWwindow* window);
 
@@ -50,6 +69,11 @@ private:
 	glm::vec3 robotPosition = glm::vec3(0.0f);
 	float robotArmAngle = 0.0f;
 
+	// main'in sahne hedefi, yoksa render ayarlarında gösterilmiyor
+	DynamicResolution* dynamicResolution = nullptr;
+	FramePacer* framePacer = nullptr;
+	TourCapture* tourCapture = nullptr;
+
 public:
 	// Singleton instance al
 	static ImGuiManager& GetInstance(GLFWwindow* window = nullptr);
@@ -67,6 +91,9 @@ public:
 	// ekrana çıktı bilgileri
 	void UpdateDebugInfo(float fps, const glm::vec3& cameraPos, bool isMouseLocked);
 	void UpdateRobotInfo(const glm::vec3& position, float armAngle);
+	void SetDynamicResolution(DynamicResolution* resolution) { dynamicResolution = resolution; }
+	void SetFramePacer(FramePacer* pacer) { framePacer = pacer; }
+	void SetTourCapture(TourCapture* capture) { tourCapture = capture; }
 	void UpdateArtifactInfo(const std::vector<std::shared_ptr<MuseumObject>>& objects, const glm::vec3& cameraPos);
 	void ToggleArtifactInfo() { showArtifactInfo = !showArtifactInfo; }
 	bool IsArtifactInfoVisible() const { return showArtifactInfo; }
@@ -81,4 +108,5 @@ private:
 	void ShowLightControls();
 	void ShowRobotControls();
 	void ShowFrustumControls(SceneManager& sceneManager);
+	void ShowRenderSettings(SceneManager& sceneManager);
 };
\ No newline at end of file
@@ -0,0 +1,236 @@
+#include "Impostor.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace {
+    const int DILATE_ITERATIONS = 2;
+
+    // shaders/impostor.glsl ImpostorFrameDirection ile aynı: y ekseni yukarı oktahedral açılım
+    glm::vec3 FrameDirection(const glm::vec2& grid) {
+        glm::vec2 f = grid * 2.0f - 1.0f;
+        glm::vec3 n(f.x, 1.0f - std::abs(f.x) - std::abs(f.y), f.y);
+        float t = glm::clamp(-n.y, 0.0f, 1.0f);
+        n.x += n.x >= 0.0f ? -t : t;
+        n.z += n.z >= 0.0f ? -t : t;
+        return glm::normalize(n);
+    }
+
+    GLuint CreateTargetTexture(GLint internalFormat, GLenum format, GLenum type, GLint filter, int size) {
+        GLuint texture = 0;
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, size, size, 0, format, type, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        return texture;
+    }
+}
+
+Impostor::~Impostor() {
+    Clear();
+}
+
+void Impostor::Clear() {
+    if (albedoTexture != 0) {
+        glDeleteTextures(1, &albedoTexture);
+        glDeleteTextures(1, &normalTexture);
+        glDeleteTextures(1, &depthTexture);
+        albedoTexture = normalTexture = depthTexture = 0;
+    }
+    atlasSize = 0;
+}
+
+bool Impostor::Build(MuseumObject& object, const Settings& newSettings) {
+    auto start = std::chrono::high_resolution_clock::now();
+    Clear();
+    if (object.GetMeshes().empty()) {
+        std::cerr << "Impostor: " << object.GetName() << " modelinde mesh yok" << std::endl;
+        return false;
+    }
+
+    settings = newSettings;
+    settings.framesPerAxis = std::max(settings.framesPerAxis, 2);
+    settings.frameSize = std::max(settings.frameSize, 8);
+    GLint maxTextureSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+    int size = settings.framesPerAxis * settings.frameSize;
+    if (size > maxTextureSize) {
+        std::cerr << "Impostor: atlas " << size << " piksel, GL siniri " << maxTextureSize << std::endl;
+        return false;
+    }
+
+    // culling ve LOD ile aynı küre
+    object.GetWorldBoundingSphere(center, radius);
+    if (radius <= 0.0f) {
+        std::cerr << "Impostor: " << object.GetName() << " sinirlari bos" << std::endl;
+        return false;
+    }
+
+    atlasSize = size;
+    albedoTexture = CreateTargetTexture(GL_RGBA16F, GL_RGBA, GL_HALF_FLOAT, GL_LINEAR, atlasSize);
+    normalTexture = CreateTargetTexture(GL_RGBA16, GL_RGBA, GL_UNSIGNED_SHORT, GL_LINEAR, atlasSize);
+    depthTexture = CreateTargetTexture(GL_DEPTH_COMPONENT24, GL_DEPTH_COMPONENT, GL_UNSIGNED_INT, GL_NEAREST, atlasSize);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    GLint previousFramebuffer = 0;
+    GLint previousViewport[4];
+    GLfloat previousClearColor[4];
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+    glGetIntegerv(GL_VIEWPORT, previousViewport);
+    glGetFloatv(GL_COLOR_CLEAR_VALUE, previousClearColor);
+    GLboolean cullFace = glIsEnabled(GL_CULL_FACE);
+    GLboolean blend = glIsEnabled(GL_BLEND);
+
+    GLuint framebuffer = 0;
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, albedoTexture, 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, normalTexture, 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depthTexture, 0);
+    const GLenum attachments[2] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
+    glDrawBuffers(2, attachments);
+
+    bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    if (complete) {
+        glDisable(GL_CULL_FACE);
+        glDisable(GL_BLEND);
+        glEnable(GL_DEPTH_TEST);
+        glDepthMask(GL_TRUE);
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        glViewport(0, 0, atlasSize, atlasSize);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        Shader captureShader("shaders/vertexShader.glsl", "shaders/fragmentShader.glsl", "#define GBUFFER\n");
+        captureShader.use();
+        captureShader.setInt("diffuseMap", 0);
+
+        // tüm meshler yakalanıyor, son frame'in culling sonucu değil
+        object.ResetMeshVisibility(true);
+        // ortografik kamera kürenin dışında, derinlik [r, 3r] aralığında (shader'daki yeniden kurulumla aynı)
+        glm::mat4 projection = glm::ortho(-radius, radius, -radius, radius, radius, 3.0f * radius);
+        float cells = static_cast<float>(settings.framesPerAxis - 1);
+        for (int y = 0; y < settings.framesPerAxis; ++y) {
+            for (int x = 0; x < settings.framesPerAxis; ++x) {
+                glm::vec3 direction = FrameDirection(glm::vec2(x, y) / cells);
+                glm::vec3 reference = std::abs(direction.y) > 0.999f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+                glm::vec3 eye = center + direction * (2.0f * radius);
+                glm::mat4 view = glm::lookAt(eye, center, reference);
+                glViewport(x * settings.frameSize, y * settings.frameSize, settings.frameSize, settings.frameSize);
+                object.DrawGBuffer(captureShader, view, projection, eye);
+            }
+        }
+    }
+    else {
+        std::cerr << "Impostor framebuffer'i eksik" << std::endl;
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, previousFramebuffer);
+    glDeleteFramebuffers(1, &framebuffer);
+    glViewport(previousViewport[0], previousViewport[1], previousViewport[2], previousViewport[3]);
+    glClearColor(previousClearColor[0], previousClearColor[1], previousClearColor[2], previousClearColor[3]);
+    if (cullFace) {
+        glEnable(GL_CULL_FACE);
+    }
+    if (blend) {
+        glEnable(GL_BLEND);
+    }
+    if (!complete) {
+        Clear();
+        return false;
+    }
+
+    DilateEmptyTexels(DILATE_ITERATIONS);
+
+    buildMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    std::cout << "Impostor: " << object.GetName() << " " << settings.framesPerAxis * settings.framesPerAxis
+        << " gorunus, " << atlasSize << "x" << atlasSize << ", " << GetTextureBytes() << " byte, "
+        << buildMs << " ms" << std::endl;
+    return true;
+}
+
+void Impostor::DilateEmptyTexels(int iterations) {
+    size_t texelCount = static_cast<size_t>(atlasSize) * atlasSize;
+    std::vector<float> depth(texelCount);
+    std::vector<float> albedo(texelCount * 4);
+    std::vector<float> normal(texelCount * 4);
+    glBindTexture(GL_TEXTURE_2D, depthTexture);
+    glGetTexImage(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT, GL_FLOAT, depth.data());
+    glBindTexture(GL_TEXTURE_2D, albedoTexture);
+    glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_FLOAT, albedo.data());
+    glBindTexture(GL_TEXTURE_2D, normalTexture);
+    glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_FLOAT, normal.data());
+
+    std::vector<unsigned char> filled(texelCount);
+    for (size_t i = 0; i < texelCount; ++i) {
+        filled[i] = depth[i] < 1.0f ? 1 : 0;
+    }
+
+    // her turda bir halka, frame sınırından karşıya geçmiyor
+    const int offsets[4][2] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+    std::vector<unsigned char> next = filled;
+    for (int iteration = 0; iteration < iterations; ++iteration) {
+        for (int y = 0; y < atlasSize; ++y) {
+            for (int x = 0; x < atlasSize; ++x) {
+                size_t index = static_cast<size_t>(y) * atlasSize + x;
+                if (filled[index]) {
+                    continue;
+                }
+                glm::vec4 albedoSum(0.0f);
+                glm::vec4 normalSum(0.0f);
+                int count = 0;
+                for (const auto& offset : offsets) {
+                    int nx = x + offset[0];
+                    int ny = y + offset[1];
+                    if (nx < 0 || ny < 0 || nx >= atlasSize || ny >= atlasSize ||
+                        nx / settings.frameSize != x / settings.frameSize || ny / settings.frameSize != y / settings.frameSize) {
+                        continue;
+                    }
+                    size_t neighbour = static_cast<size_t>(ny) * atlasSize + nx;
+                    if (!filled[neighbour]) {
+                        continue;
+                    }
+                    albedoSum += glm::vec4(albedo[neighbour * 4], albedo[neighbour * 4 + 1], albedo[neighbour * 4 + 2], albedo[neighbour * 4 + 3]);
+                    normalSum += glm::vec4(normal[neighbour * 4], normal[neighbour * 4 + 1], normal[neighbour * 4 + 2], normal[neighbour * 4 + 3]);
+                    count++;
+                }
+                if (count == 0) {
+                    continue;
+                }
+                for (int c = 0; c < 4; ++c) {
+                    albedo[index * 4 + c] = albedoSum[c] / count;
+                    normal[index * 4 + c] = normalSum[c] / count;
+                }
+                next[index] = 1;
+            }
+        }
+        filled = next;
+    }
+
+    glBindTexture(GL_TEXTURE_2D, albedoTexture);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, atlasSize, atlasSize, GL_RGBA, GL_FLOAT, albedo.data());
+    glBindTexture(GL_TEXTURE_2D, normalTexture);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, atlasSize, atlasSize, GL_RGBA, GL_FLOAT, normal.data());
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void Impostor::Bind(const Shader& shader) const {
+    shader.setVec4("impostorSphere", glm::vec4(center, radius));
+    shader.setInt("impostorGrid", settings.framesPerAxis);
+    glActiveTexture(GL_TEXTURE0 + Shader::IMPOSTOR_ALBEDO_UNIT);
+    glBindTexture(GL_TEXTURE_2D, albedoTexture);
+    glActiveTexture(GL_TEXTURE0 + Shader::IMPOSTOR_NORMAL_UNIT);
+    glBindTexture(GL_TEXTURE_2D, normalTexture);
+    glActiveTexture(GL_TEXTURE0 + Shader::IMPOSTOR_DEPTH_UNIT);
+    glBindTexture(GL_TEXTURE_2D, depthTexture);
+    glActiveTexture(GL_TEXTURE0);
+}
+
+size_t Impostor::GetTextureBytes() const {
+    return static_cast<size_t>(atlasSize) * atlasSize * (8 + 8 + 4);
+}
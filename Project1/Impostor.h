@@ -0,0 +1,60 @@
+#pragma once
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include "MuseumObject.h"
+#include "Shader.h"
+
+// Uzak kopyalar için oktahedral impostor
+// Model ilk kullanımda framesPerAxis x framesPerAxis yönden ortografik olarak atlasa çiziliyor
+// (yönler küreye oktahedral açılımla dağılıyor, ortası tepeden bakış). Yakalama deferred yolun G-buffer
+// varyantıyla: albedo, normal ve derinlik G-buffer ile aynı formatta, ışık hesabı çizimde forward shader'da yapılıyor.
+// Boş texeller komşularından dolduruluyor, bilineer örnekleme siluete siyah sızdırmasın
+class Impostor {
+public:
+    struct Settings {
+        int framesPerAxis = 8; // en az 2, toplam framesPerAxis^2 görünüş
+        int frameSize = 64;    // piksel, atlas framesPerAxis * frameSize
+    };
+
+    // SceneManager::RequestImpostorBenchmark: instanced kopyalar aynı kameradan impostorsuz ve impostorlu
+    struct BenchmarkResult {
+        size_t visibleInstances = 0;
+        size_t impostorInstances = 0;  // impostorlu ölçümde, geçiştekiler dahil
+        size_t meshInstances = 0;      // impostorlu ölçümde mesh olarak kalan
+        double meshOnlyMs = 0.0;       // GPU
+        double impostorMs = 0.0;
+        size_t textureBytes = 0;       // tüm impostor atlasları
+    };
+
+    Impostor() = default;
+    ~Impostor();
+    Impostor(const Impostor&) = delete;
+    Impostor& operator=(const Impostor&) = delete;
+
+    // objenin kendi matrisiyle (InstancedObject'te birim matris) çiziliyor, framebuffer ve viewport geri yükleniyor
+    bool Build(MuseumObject& object, const Settings& settings);
+    void Clear();
+    bool IsBuilt() const { return albedoTexture != 0; }
+
+    // Shader::IMPOSTOR_*_UNIT textureları ve impostorSphere/impostorGrid uniformları (shader bağlı olmalı)
+    void Bind(const Shader& shader) const;
+
+    const Settings& GetSettings() const { return settings; }
+    int GetAtlasSize() const { return atlasSize; }
+    size_t GetTextureBytes() const;   // albedo RGBA16F + normal RGBA16 + derinlik 24 bit
+    double GetBuildMs() const { return buildMs; }
+
+private:
+    // boş texellere (derinlik 1) dolu komşuların ortalaması, sadece albedo ve normal
+    void DilateEmptyTexels(int iterations);
+
+    Settings settings;
+    int atlasSize = 0;
+    glm::vec3 center = glm::vec3(0.0f);
+    float radius = 0.0f;
+    GLuint albedoTexture = 0;
+    GLuint normalTexture = 0;
+    GLuint depthTexture = 0;
+    double buildMs = 0.0;
+};
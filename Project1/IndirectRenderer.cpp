@@ -0,0 +1,225 @@
+#include "IndirectRenderer.h"
+#include "GeometryPool.h"
+#include "ResourceManager.h"
+#include "ShaderSetup.h"
+#include <iostream>
+#include <cstdint>
+
+IndirectRenderer::IndirectRenderer() {
+    // ana shaderin INDIRECT_DRAW varyanti, SSBO icin 430 gerekiyor
+    shader = std::make_unique<Shader>("shaders/vertexShader.glsl", "shaders/fragmentShader.glsl",
+        "#define INDIRECT_DRAW\n", 430);
+
+    glGenBuffers(1, &drawBuffer);
+    glGenBuffers(1, &materialBuffer);
+    glGenBuffers(1, &commandBuffer);
+
+    std::cout << "Multi-draw indirect yolu hazir" << std::endl;
+}
+
+IndirectRenderer::~IndirectRenderer() {
+    glDeleteBuffers(1, &drawBuffer);
+    glDeleteBuffers(1, &materialBuffer);
+    glDeleteBuffers(1, &commandBuffer);
+}
+
+void IndirectRenderer::BeginFrame() {
+    for (auto& bucket : buckets) {
+        bucket.commands.clear();
+        bucket.draws.clear();
+        bucket.bounds.clear();
+    }
+    materials.clear();
+    materialLookup.clear();
+    multiDrawCalls = 0;
+}
+
+GLuint IndirectRenderer::GetMaterialIndex(const MuseumObject::Material& material) {
+    auto it = materialLookup.find(&material);
+    if (it != materialLookup.end()) {
+        return it->second;
+    }
+
+    GpuMaterial gpuMaterial;
+    gpuMaterial.ambient = glm::vec4(material.ambient, material.opacity);
+    gpuMaterial.diffuse = glm::vec4(material.diffuse, material.brightness);
+    gpuMaterial.specular = glm::vec4(material.specular, material.shininess);
+
+    GLuint index = static_cast<GLuint>(materials.size());
+    materials.push_back(gpuMaterial);
+    materialLookup[&material] = index;
+    return index;
+}
+
+void IndirectRenderer::AddObject(const MuseumObject& object) {
+    glm::mat4 model = object.GetModelMatrix();
+    glm::mat4 normalMatrix = glm::mat4(glm::transpose(glm::inverse(glm::mat3(model))));
+
+    const auto& meshes = object.GetMeshes();
+    for (size_t meshIndex = 0; meshIndex < meshes.size(); ++meshIndex) {
+        const auto& mesh = meshes[meshIndex];
+        if (!mesh.geometry.IsValid() || !object.IsMeshVisible(meshIndex)) {
+            continue;
+        }
+
+        // GPU culling mesh bazında, statik batch chunkları ayrı ayrı elenebiliyor
+        glm::vec3 center;
+        float radius;
+        object.GetMeshWorldBoundingSphere(meshIndex, center, radius);
+
+        auto found = bucketLookup.find(mesh.material.diffuseMap);
+        size_t bucketIndex;
+        if (found == bucketLookup.end()) {
+            bucketIndex = buckets.size();
+            buckets.push_back(Bucket());
+            buckets.back().diffuseMap = mesh.material.diffuseMap;
+            bucketLookup[mesh.material.diffuseMap] = bucketIndex;
+        }
+        else {
+            bucketIndex = found->second;
+        }
+        Bucket& bucket = buckets[bucketIndex];
+
+        GpuDrawData draw;
+        draw.model = model;
+        draw.normalMatrix = normalMatrix;
+        draw.indices = glm::uvec4(GetMaterialIndex(mesh.material), 0, 0, 0);
+
+        DrawElementsIndirectCommand command;
+        command.count = static_cast<GLuint>(mesh.geometry.indexCount);
+        command.instanceCount = 1;
+        command.firstIndex = static_cast<GLuint>(mesh.geometry.indexOffset);
+        command.baseVertex = static_cast<GLint>(mesh.geometry.vertexOffset);
+        command.baseInstance = 0; // Submit'te global draw indexi yazılıyor
+
+        // küme culling yapıldıysa her görünür küme aralığı ayrı komut
+        const ClusterDrawList* clusters = object.GetClusterDrawList(meshIndex);
+        size_t rangeCount = clusters ? clusters->counts.size() : 1;
+        for (size_t range = 0; range < rangeCount; ++range) {
+            if (clusters) {
+                command.count = static_cast<GLuint>(clusters->counts[range]);
+                command.firstIndex = static_cast<GLuint>(reinterpret_cast<uintptr_t>(clusters->offsets[range]) / sizeof(GLuint));
+            }
+            bucket.commands.push_back(command);
+            bucket.draws.push_back(draw);
+            bucket.bounds.push_back(glm::vec4(center, radius));
+        }
+    }
+}
+
+void IndirectRenderer::UploadBuffer(GLenum target, GLuint buffer, size_t& capacity, const void* data, size_t size) {
+    glBindBuffer(target, buffer);
+    if (size > capacity) {
+        capacity = size * 2;
+    }
+    // orphan: GPU hala eski veriyi okuyorsa beklemeden yeni bellek al
+    glBufferData(target, capacity, nullptr, GL_STREAM_DRAW);
+    glBufferSubData(target, 0, size, data);
+}
+
+void IndirectRenderer::Submit(const glm::mat4& view, const glm::mat4& projection,
+    const glm::vec3& viewPos, const Light* light, const Frustum* gpuCullFrustum) {
+
+    bool useGpuCulling = gpuCullFrustum != nullptr && GpuCuller::IsSupported();
+
+    // bucketları ardışık hale getir, baseInstance = global draw indexi
+    commandUpload.clear();
+    drawUpload.clear();
+    cullUpload.clear();
+    bucketOffsets.clear();
+    for (size_t b = 0; b < buckets.size(); ++b) {
+        const Bucket& bucket = buckets[b];
+        bucketOffsets.push_back(static_cast<GLuint>(commandUpload.size()));
+        for (size_t i = 0; i < bucket.commands.size(); ++i) {
+            DrawElementsIndirectCommand command = bucket.commands[i];
+            command.baseInstance = static_cast<GLuint>(drawUpload.size());
+            commandUpload.push_back(command);
+            drawUpload.push_back(bucket.draws[i]);
+            if (useGpuCulling) {
+                cullUpload.push_back({ bucket.bounds[i], glm::uvec4(static_cast<GLuint>(b), 0, 0, 0) });
+            }
+        }
+    }
+
+    if (commandUpload.empty()) {
+        return;
+    }
+
+    UploadBuffer(GL_SHADER_STORAGE_BUFFER, drawBuffer, drawBufferCapacity,
+        drawUpload.data(), drawUpload.size() * sizeof(GpuDrawData));
+    UploadBuffer(GL_SHADER_STORAGE_BUFFER, materialBuffer, materialBufferCapacity,
+        materials.data(), materials.size() * sizeof(GpuMaterial));
+    if (useGpuCulling) {
+        if (!gpuCuller) {
+            gpuCuller = std::make_unique<GpuCuller>();
+        }
+        // komutlar compute pass'te süzülüp GpuCuller'ın çıkış bufferına yazılıyor
+        gpuCuller->Cull(gpuCullFrustum->GetPlanes(), commandUpload, cullUpload, bucketOffsets);
+    }
+    else {
+        UploadBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffer, commandBufferCapacity,
+            commandUpload.data(), commandUpload.size() * sizeof(DrawElementsIndirectCommand));
+    }
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    GeometryPool& geometryPool = GeometryPool::GetInstance();
+    geometryPool.EnsureDrawIdCapacity(drawUpload.size());
+
+    if (light != nullptr) {
+        ShaderSetup::SetupLight(*shader, *light);
+    }
+    shader->use();
+    shader->setMat4("view", view);
+    shader->setMat4("projection", projection);
+    shader->setVec3("viewPos", viewPos);
+    shader->setInt("diffuseMap", 0);
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, drawBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, materialBuffer);
+    if (useGpuCulling) {
+        gpuCuller->BindForDraw();
+    }
+    else {
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffer);
+    }
+
+    geometryPool.Bind();
+
+    size_t first = 0;
+    for (size_t b = 0; b < buckets.size(); ++b) {
+        const Bucket& bucket = buckets[b];
+        size_t count = bucket.commands.size();
+        if (count == 0) {
+            continue;
+        }
+
+        const Texture* texture = bucket.diffuseMap.empty()
+            ? nullptr : ResourceManager::GetInstance().GetTexture(bucket.diffuseMap);
+        if (texture) {
+            texture->Bind(0);
+        }
+        else {
+            glActiveTexture(GL_TEXTURE0);
+            glBindTexture(GL_TEXTURE_2D, 0);
+        }
+        shader->setBool("bucketHasDiffuseMap", texture != nullptr);
+
+        if (useGpuCulling) {
+            gpuCuller->DrawBucket(b, count);
+        }
+        else {
+            GLExtensions::MultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT,
+                (void*)(first * sizeof(DrawElementsIndirectCommand)), static_cast<GLsizei>(count), 0);
+        }
+        multiDrawCalls++;
+        first += count;
+    }
+
+    geometryPool.Unbind();
+    if (useGpuCulling) {
+        gpuCuller->UnbindForDraw();
+    }
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
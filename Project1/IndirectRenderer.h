@@ -0,0 +1,87 @@
+#pragma once
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <vector>
+#include <string>
+#include <memory>
+#include <unordered_map>
+#include "GLExtensions.h"
+#include "MuseumObject.h"
+#include "Light.h"
+#include "Shader.h"
+#include "Frustum.h"
+#include "GpuCuller.h"
+
+// GL 4.3+ icin multi-draw indirect cizim yolu
+// gorunur meshler diffuse texture'a gore bucketlara ayriliyor (texture = shader varyanti),
+// her bucket tek glMultiDrawElementsIndirect ile gonderiliyor
+// transform ve materyal indexleri SSBO'da, draw id base instance hilesi ile shadera geliyor
+// Submit'e frustum verilirse culling compute shaderda yapılıyor (GpuCuller), o zaman
+// AddObject'e görünürlüğe bakmadan tüm objeler eklenmeli
+class IndirectRenderer {
+public:
+    IndirectRenderer();
+    ~IndirectRenderer();
+
+    static bool IsSupported() { return GLExtensions::HasMultiDrawIndirect(); }
+
+    void BeginFrame();
+    void AddObject(const MuseumObject& object);
+    void Submit(const glm::mat4& view, const glm::mat4& projection,
+        const glm::vec3& viewPos, const Light* light, const Frustum* gpuCullFrustum = nullptr);
+
+    // debug bilgileri
+    size_t GetDrawCount() const { return drawUpload.size(); }
+    size_t GetMultiDrawCallCount() const { return multiDrawCalls; }
+    size_t GetMaterialCount() const { return materials.size(); }
+    const GpuCuller* GetGpuCuller() const { return gpuCuller.get(); }
+
+private:
+    // std430 düzeni ile birebir aynı olmalı (vertexShader.glsl DrawData)
+    struct GpuDrawData {
+        glm::mat4 model;
+        glm::mat4 normalMatrix;
+        glm::uvec4 indices; // x: materyal indexi
+    };
+
+    // fragmentShader.glsl PackedMaterial
+    struct GpuMaterial {
+        glm::vec4 ambient;  // w: opacity
+        glm::vec4 diffuse;  // w: brightness
+        glm::vec4 specular; // w: shininess
+    };
+
+    struct Bucket {
+        std::string diffuseMap;
+        std::vector<DrawElementsIndirectCommand> commands;
+        std::vector<GpuDrawData> draws;
+        std::vector<glm::vec4> bounds; // dünya uzayında bounding sphere (GPU culling)
+    };
+
+    GLuint GetMaterialIndex(const MuseumObject::Material& material);
+    void UploadBuffer(GLenum target, GLuint buffer, size_t& capacity, const void* data, size_t size);
+
+    std::unique_ptr<Shader> shader;
+    std::unique_ptr<GpuCuller> gpuCuller; // ilk GPU culling isteğinde oluşturuluyor
+
+    // bucketlar frameler arası korunuyor, sadece içleri temizleniyor (allocation olmasın diye)
+    std::vector<Bucket> buckets;
+    std::unordered_map<std::string, size_t> bucketLookup;
+
+    std::vector<GpuMaterial> materials;
+    std::unordered_map<const MuseumObject::Material*, GLuint> materialLookup;
+
+    std::vector<DrawElementsIndirectCommand> commandUpload;
+    std::vector<GpuDrawData> drawUpload;
+    std::vector<GpuCuller::CullInput> cullUpload;
+    std::vector<GLuint> bucketOffsets;
+
+    GLuint drawBuffer = 0;
+    GLuint materialBuffer = 0;
+    GLuint commandBuffer = 0;
+    size_t drawBufferCapacity = 0;
+    size_t materialBufferCapacity = 0;
+    size_t commandBufferCapacity = 0;
+
+    size_t multiDrawCalls = 0;
+};
@@ -0,0 +1,281 @@
+#include "InstancedObject.h"
+#include "GeometryPool.h"
+#include "ResourceManager.h"
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+
+InstancedObject::InstancedObject(const std::string& name, const std::string& modelPath)
+    : MuseumObject(name, "", modelPath, "", glm::vec3(0.0f), glm::vec3(1.0f), glm::vec3(0.0f)),
+    instancedShader("shaders/vertexShader.glsl", "shaders/fragmentShader.glsl", "#define INSTANCED\n"),
+    lodFadeShader("shaders/vertexShader.glsl", "shaders/fragmentShader.glsl", "#define INSTANCED\n#define LOD_FADE\n"),
+    impostorShader("shaders/impostorVertex.glsl", "shaders/fragmentShader.glsl", "#define INSTANCED\n#define IMPOSTOR\n") {
+
+    glGenVertexArrays(1, &instanceVAO);
+    glGenBuffers(1, &instanceVBO);
+    glGenVertexArrays(1, &impostorVAO);
+    glGenBuffers(1, &impostorVBO);
+    SetupImpostorVAO();
+}
+
+InstancedObject::~InstancedObject() {
+    glDeleteVertexArrays(1, &instanceVAO);
+    glDeleteBuffers(1, &instanceVBO);
+    glDeleteVertexArrays(1, &impostorVAO);
+    glDeleteBuffers(1, &impostorVBO);
+}
+
+void InstancedObject::AddInstance(const glm::vec3& position, const glm::vec3& scale,
+    const glm::vec3& rotation, const glm::vec4& tint) {
+
+    // MuseumObject::GetModelMatrix ile aynı sıra
+    glm::mat4 model = glm::mat4(1.0f);
+    model = glm::translate(model, position);
+    model = glm::rotate(model, glm::radians(rotation.x), glm::vec3(1.0f, 0.0f, 0.0f));
+    model = glm::rotate(model, glm::radians(rotation.y), glm::vec3(0.0f, 1.0f, 0.0f));
+    model = glm::rotate(model, glm::radians(rotation.z), glm::vec3(0.0f, 0.0f, 1.0f));
+    model = glm::scale(model, scale);
+
+    const BoundingBox& bounds = GetBoundingBox();
+    glm::vec3 localCenter = bounds.min + (bounds.max - bounds.min) * 0.5f;
+    float maxScale = std::max(std::max(scale.x, scale.y), scale.z);
+
+    InstanceData instance;
+    instance.model = model;
+    instance.tint = tint;
+    instances.push_back(instance);
+    instanceSpheres.Add(glm::vec3(model * glm::vec4(localCenter, 1.0f)), bounds.radius * maxScale);
+}
+
+void InstancedObject::ClearInstances() {
+    instances.clear();
+    instanceSpheres.Clear();
+    visibleInstances.clear();
+    fadingInstances.clear();
+    impostorInstances.clear();
+}
+
+void InstancedObject::CullInstances(const Frustum* frustum, const LodParams* lod) {
+    visibleInstances.clear();
+    fadingInstances.clear();
+    impostorInstances.clear();
+    visibleInstances.reserve(instances.size());
+
+    // impostor ilk kullanımda (ayarları değişince yeniden) yakalanıyor
+    if (lod && impostor && (impostor->GetSettings().framesPerAxis != lod->impostor.framesPerAxis ||
+        impostor->GetSettings().frameSize != lod->impostor.frameSize)) {
+        impostor.reset();
+        impostorFailed = false;
+    }
+    if (lod && !impostor && !impostorFailed && !instances.empty()) {
+        impostor = std::make_unique<Impostor>();
+        if (!impostor->Build(*this, lod->impostor)) {
+            impostor.reset();
+            impostorFailed = true;
+        }
+    }
+    if (!impostor || (lod && lod->pixelsPerUnit <= 0.0f)) {
+        lod = nullptr;
+    }
+
+    if (!frustum) {
+        if (!lod) {
+            visibleInstances = instances;
+            return;
+        }
+        for (size_t i = 0; i < instances.size(); ++i) {
+            AddVisibleInstance(i, lod);
+        }
+        return;
+    }
+
+    // tüm kürelere tek SIMD geçişi, sonra bitsetten görünenleri topla
+    SimdCuller::CullSpheres(*frustum, instanceSpheres, visibleBits);
+    for (size_t word = 0; word < visibleBits.size(); ++word) {
+        uint64_t bits = visibleBits[word];
+        for (size_t bit = 0; bits != 0; ++bit, bits >>= 1) {
+            if (bits & 1u) {
+                AddVisibleInstance(word * 64 + bit, lod);
+            }
+        }
+    }
+}
+
+void InstancedObject::AddVisibleInstance(size_t index, const LodParams* lod) {
+    if (!lod) {
+        visibleInstances.push_back(instances[index]);
+        return;
+    }
+
+    // bounding sphere'in ekrandaki çapı, kamera kürenin içindeyse mesh
+    glm::vec3 center(instanceSpheres.X()[index], instanceSpheres.Y()[index], instanceSpheres.Z()[index]);
+    float radius = instanceSpheres.R()[index];
+    float distance = glm::length(center - lod->cameraPosition);
+    float fadeEnd = lod->screenSize * (1.0f + lod->fadeBand);
+    if (distance <= radius || 2.0f * radius * lod->pixelsPerUnit >= fadeEnd * distance) {
+        visibleInstances.push_back(instances[index]);
+        return;
+    }
+
+    float screenSize = 2.0f * radius * lod->pixelsPerUnit / distance;
+    InstanceData instance = instances[index];
+    instance.tint.a = fadeEnd > lod->screenSize
+        ? glm::clamp((screenSize - lod->screenSize) / (fadeEnd - lod->screenSize), 0.0f, 1.0f) : 0.0f;
+    if (instance.tint.a > 0.0f) {
+        fadingInstances.push_back(instance);
+    }
+    impostorInstances.push_back(instance);
+}
+
+void InstancedObject::SetupInstanceVAO() {
+    GeometryPool& geometryPool = GeometryPool::GetInstance();
+
+    glBindVertexArray(instanceVAO);
+    geometryPool.SetupVertexAttributes();
+
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    const GLsizei stride = static_cast<GLsizei>(sizeof(InstanceData));
+    // mat4 dört ayrı vec4 attribute olarak geliyor
+    for (int column = 0; column < 4; ++column) {
+        glVertexAttribPointer(7 + column, 4, GL_FLOAT, GL_FALSE, stride,
+            (void*)(column * sizeof(glm::vec4)));
+        glVertexAttribDivisor(7 + column, 1);
+        glEnableVertexAttribArray(7 + column);
+    }
+    glVertexAttribPointer(11, 4, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(InstanceData, tint));
+    glVertexAttribDivisor(11, 1);
+    glEnableVertexAttribArray(11);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    vaoGeneration = geometryPool.GetBufferGeneration();
+}
+
+void InstancedObject::SetupImpostorVAO() {
+    // vertex bufferı yok, quad köşeleri gl_VertexID'den
+    glBindVertexArray(impostorVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, impostorVBO);
+    const GLsizei stride = static_cast<GLsizei>(sizeof(InstanceData));
+    for (int column = 0; column < 4; ++column) {
+        glVertexAttribPointer(7 + column, 4, GL_FLOAT, GL_FALSE, stride,
+            (void*)(column * sizeof(glm::vec4)));
+        glVertexAttribDivisor(7 + column, 1);
+        glEnableVertexAttribArray(7 + column);
+    }
+    glVertexAttribPointer(11, 4, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(InstanceData, tint));
+    glVertexAttribDivisor(11, 1);
+    glEnableVertexAttribArray(11);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void InstancedObject::Draw(const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix,
+    const glm::vec3& lightPos, const glm::vec3& viewPos) {
+
+    lastDrawCalls = 0;
+    if (meshes.empty()) {
+        return;
+    }
+
+    DrawMeshInstances(instancedShader, visibleInstances, viewMatrix, projectionMatrix, lightPos, viewPos);
+    DrawMeshInstances(lodFadeShader, fadingInstances, viewMatrix, projectionMatrix, lightPos, viewPos);
+    DrawImpostors(viewMatrix, projectionMatrix, lightPos, viewPos);
+}
+
+void InstancedObject::DrawMeshInstances(const Shader& shader, const std::vector<InstanceData>& drawInstances,
+    const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix, const glm::vec3& lightPos, const glm::vec3& viewPos) {
+
+    if (drawInstances.empty()) {
+        return;
+    }
+
+    GeometryPool& geometryPool = GeometryPool::GetInstance();
+    if (vaoGeneration != geometryPool.GetBufferGeneration()) {
+        SetupInstanceVAO();
+    }
+
+    // sıkıştırılmış kopyaları yükle, orphan ile GPU'yu beklemiyoruz
+    size_t size = drawInstances.size() * sizeof(InstanceData);
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    if (size > instanceBufferCapacity) {
+        instanceBufferCapacity = size * 2;
+    }
+    glBufferData(GL_ARRAY_BUFFER, instanceBufferCapacity, nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, size, drawInstances.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    shader.use();
+    shader.setMat4("view", viewMatrix);
+    shader.setMat4("projection", projectionMatrix);
+    shader.setVec3("viewPos", viewPos);
+    shader.setVec3("lightPos", lightPos);
+    shader.setInt("diffuseMap", 0);
+
+    glBindVertexArray(instanceVAO);
+    GLsizei instanceCount = static_cast<GLsizei>(drawInstances.size());
+
+    for (auto& mesh : meshes) {
+        if (!mesh.geometry.IsValid()) {
+            continue;
+        }
+
+        shader.setVec3("material.ambient", mesh.material.ambient);
+        shader.setVec3("material.diffuse", mesh.material.diffuse);
+        shader.setVec3("material.specular", mesh.material.specular);
+        shader.setFloat("material.shininess", mesh.material.shininess);
+        shader.setFloat("material.brightness", mesh.material.brightness);
+        shader.setFloat("material.opacity", mesh.material.opacity);
+
+        const Texture* texture = mesh.material.diffuseMap.empty()
+            ? nullptr : ResourceManager::GetInstance().GetTexture(mesh.material.diffuseMap);
+        if (texture) {
+            texture->Bind(0);
+        }
+        else {
+            glActiveTexture(GL_TEXTURE0);
+            glBindTexture(GL_TEXTURE_2D, 0);
+        }
+        shader.setBool("material.hasDiffuseMap", texture != nullptr);
+
+        glDrawElementsInstancedBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(mesh.geometry.indexCount),
+            GL_UNSIGNED_INT, (void*)(mesh.geometry.indexOffset * sizeof(GLuint)), instanceCount,
+            static_cast<GLint>(mesh.geometry.vertexOffset));
+        lastDrawCalls++;
+    }
+
+    glBindVertexArray(0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void InstancedObject::DrawImpostors(const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix,
+    const glm::vec3& lightPos, const glm::vec3& viewPos) {
+
+    if (impostorInstances.empty() || !impostor) {
+        return;
+    }
+
+    size_t size = impostorInstances.size() * sizeof(InstanceData);
+    glBindBuffer(GL_ARRAY_BUFFER, impostorVBO);
+    if (size > impostorBufferCapacity) {
+        impostorBufferCapacity = size * 2;
+    }
+    glBufferData(GL_ARRAY_BUFFER, impostorBufferCapacity, nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, size, impostorInstances.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    impostorShader.use();
+    impostorShader.setMat4("view", viewMatrix);
+    impostorShader.setMat4("projection", projectionMatrix);
+    impostorShader.setVec3("viewPos", viewPos);
+    impostorShader.setVec3("lightPos", lightPos);
+    impostorShader.setFloat("material.opacity", 1.0f);
+    impostor->Bind(impostorShader);
+
+    glBindVertexArray(impostorVAO);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(impostorInstances.size()));
+    lastDrawCalls++;
+    glBindVertexArray(0);
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include "MuseumObject.h"
+#include "Frustum.h"
+#include "SimdCuller.h"
+#include "Impostor.h"
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+#include <string>
+
+// Aynı modelin çok sayıda kopyası için (kaideler, bariyerler, depo rafları vs.)
+// model bir kere yükleniyor, kopya başına sadece matris + renk tonu tutuluyor
+// her frame görünür kopyalar sıkıştırılmış instance bufferına yazılıp
+// her mesh için tek glDrawElementsInstancedBaseVertex ile çiziliyor
+// ekranda küçük kalan kopyalar mesh yerine impostor (tek quad, tüm kopyalar tek çağrı) olarak çiziliyor
+class InstancedObject : public MuseumObject {
+public:
+    // uzak kopyaların impostor'a geçişi, CullInstances'a veriliyor
+    struct LodParams {
+        glm::vec3 cameraPosition = glm::vec3(0.0f);
+        float pixelsPerUnit = 0.0f;   // projection[1][1] * viewport yüksekliği / 2, 1 birim uzaklıkta
+        float screenSize = 48.0f;     // piksel, bounding sphere'in ekrandaki çapı bunun altındaysa sadece impostor
+        float fadeBand = 0.25f;       // eşiğin bu oranı kadar üstüne kadar mesh ve impostor dither ile karışıyor
+        Impostor::Settings impostor;  // ilk kullanımda yakalanırken, değişirse yeniden yakalanıyor
+    };
+
+    InstancedObject(const std::string& name, const std::string& modelPath);
+    ~InstancedObject();
+
+    void AddInstance(const glm::vec3& position, const glm::vec3& scale,
+        const glm::vec3& rotation, const glm::vec4& tint = glm::vec4(1.0f));
+    void ClearInstances();
+
+    // frustum nullptr ise tüm kopyalar çiziliyor, Draw'dan önce çağrılmalı
+    // lod verilirse görünür kopyalar ekrandaki boyutlarına göre mesh, geçiş ve impostor listelerine ayrılıyor
+    void CullInstances(const Frustum* frustum, const LodParams* lod = nullptr);
+
+    void Draw(const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix,
+        const glm::vec3& lightPos, const glm::vec3& viewPos) override;
+
+    const Shader& GetInstancedShader() const { return instancedShader; }
+    const Shader& GetLodFadeShader() const { return lodFadeShader; }
+    const Shader& GetImpostorShader() const { return impostorShader; }
+    const Impostor* GetImpostor() const { return impostor.get(); }
+
+    // debug bilgileri
+    size_t GetInstanceCount() const { return instances.size(); }
+    size_t GetVisibleInstanceCount() const { return visibleInstances.size() + impostorInstances.size(); }
+    size_t GetMeshInstanceCount() const { return visibleInstances.size() + fadingInstances.size(); }
+    size_t GetImpostorInstanceCount() const { return impostorInstances.size(); } // geçiştekiler dahil
+    size_t GetFadingInstanceCount() const { return fadingInstances.size(); }
+    size_t GetLastDrawCallCount() const { return lastDrawCalls; }
+
+private:
+    // vertexShader.glsl INSTANCED: location 7-10 matris, 11 renk tonu
+    struct InstanceData {
+        glm::mat4 model;
+        glm::vec4 tint;
+    };
+
+    void SetupInstanceVAO();
+    void SetupImpostorVAO();
+    void AddVisibleInstance(size_t index, const LodParams* lod);
+    // kopyaları instance bufferına yükleyip her meshi tek çağrıyla çiziyor
+    void DrawMeshInstances(const Shader& shader, const std::vector<InstanceData>& drawInstances,
+        const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix, const glm::vec3& lightPos, const glm::vec3& viewPos);
+    void DrawImpostors(const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix,
+        const glm::vec3& lightPos, const glm::vec3& viewPos);
+
+    Shader instancedShader;
+    Shader lodFadeShader;             // geçişteki meshler, impostor'un dolduracağı pikselleri atlıyor
+    Shader impostorShader;
+    std::vector<InstanceData> instances;
+    SphereSoA instanceSpheres;        // dünya uzayında bounding sphere'ler, instances ile aynı sıra
+    std::vector<uint64_t> visibleBits; // SimdCuller çıktısı
+    // her frame yeniden dolduruluyor, geçiştekilerin tint.a'sı meshin payı
+    std::vector<InstanceData> visibleInstances;
+    std::vector<InstanceData> fadingInstances;
+    std::vector<InstanceData> impostorInstances;
+
+    std::unique_ptr<Impostor> impostor;
+    bool impostorFailed = false;      // yakalanamadıysa tüm kopyalar mesh
+    GLuint impostorVAO = 0;
+    GLuint impostorVBO = 0;
+    size_t impostorBufferCapacity = 0;
+
+    GLuint instanceVAO = 0;
+    GLuint instanceVBO = 0;
+    size_t instanceBufferCapacity = 0;
+    size_t vaoGeneration = static_cast<size_t>(-1); // havuz büyürse VAO yenileniyor
+    size_t lastDrawCalls = 0;
+};
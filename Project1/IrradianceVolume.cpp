@@ -0,0 +1,395 @@
+#include "IrradianceVolume.h"
+#include "Lightmap.h"
+#include "TriangleBVH.h"
+#include "JobSystem.h"
+#include "GeometryPool.h"
+#include "Shader.h"
+#include <glm/gtc/packing.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+
+namespace {
+    const char PROBE_MAGIC[4] = { 'S', 'H', 'P', '1' };
+    const float MIN_TRIANGLE_AREA = 1e-8f;
+    const float RAY_OFFSET = 0.01f;         // Lightmap ile aynı
+    const float MAX_ALBEDO = 0.9f;
+    const float MAX_BACKFACE_RATIO = 0.25f; // üstü duvarın içinde sayılıyor
+    const float PI = 3.14159265f;
+
+    // bake sırasında statik üçgen (dünya uzayı)
+    struct ProbeTriangle {
+        glm::vec3 faceNormal;
+        glm::vec3 albedo;
+    };
+
+    // gerçel L2 küresel harmonik tabanı (fragmentShader.glsl sampleProbeIrradiance ile aynı sıra)
+    void EvaluateBasis(const glm::vec3& n, float* basis) {
+        basis[0] = 0.282095f;
+        basis[1] = 0.488603f * n.y;
+        basis[2] = 0.488603f * n.z;
+        basis[3] = 0.488603f * n.x;
+        basis[4] = 1.092548f * n.x * n.y;
+        basis[5] = 1.092548f * n.y * n.z;
+        basis[6] = 0.315392f * (3.0f * n.z * n.z - 1.0f);
+        basis[7] = 1.092548f * n.x * n.z;
+        basis[8] = 0.546274f * (n.x * n.x - n.y * n.y);
+    }
+
+    // kürede eşit dağılmış yönler (Fibonacci küresi), her prob aynı yönleri kullanıyor
+    std::vector<glm::vec3> SphereDirections(int count) {
+        const float goldenAngle = 2.39996323f;
+        std::vector<glm::vec3> directions;
+        directions.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            float z = 1.0f - 2.0f * (i + 0.5f) / count;
+            float radius = std::sqrt(std::max(0.0f, 1.0f - z * z));
+            float phi = i * goldenAngle;
+            directions.emplace_back(radius * std::cos(phi), radius * std::sin(phi), z);
+        }
+        return directions;
+    }
+
+    template <typename T>
+    void WriteValue(std::ofstream& file, const T& value) {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    bool ReadValue(std::ifstream& file, T& value) {
+        return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+    }
+}
+
+IrradianceVolume::~IrradianceVolume() {
+    Clear();
+}
+
+void IrradianceVolume::Clear() {
+    if (texture != 0) {
+        glDeleteTextures(1, &texture);
+        texture = 0;
+    }
+    coefficients.clear();
+    resolution = glm::ivec3(0);
+    volumeMin = glm::vec3(0.0f);
+    volumeSize = glm::vec3(0.0f);
+}
+
+bool IrradianceVolume::Bake(const std::vector<std::shared_ptr<MuseumObject>>& objects, const std::vector<Light>& lights,
+    const BakeSettings& settings) {
+    auto start = std::chrono::high_resolution_clock::now();
+    Clear();
+    bakeStats = BakeStats();
+
+    if (settings.probeSpacing <= 0.0f || settings.maxProbesPerAxis < 2 || settings.raysPerProbe < 16) {
+        std::cerr << "Irradiance volume bake: ayarlar gecersiz" << std::endl;
+        return false;
+    }
+
+    // ışığı yansıtan ve engelleyen yüzeyler: statik kabuk (lightmap'teki gibi)
+    const int stride = GeometryPool::VERTEX_FLOATS;
+    std::vector<ProbeTriangle> triangles;
+    std::vector<TriangleBVH::Triangle> bvhTriangles;
+    glm::vec3 sceneMin(FLT_MAX), sceneMax(-FLT_MAX);
+    for (const auto& object : objects) {
+        if (!object->IsStatic()) {
+            continue;
+        }
+        glm::mat4 model = object->GetModelMatrix();
+        glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(model)));
+        for (const auto& mesh : object->GetMeshes()) {
+            glm::vec3 albedo = glm::clamp(mesh.material.diffuse, glm::vec3(0.0f), glm::vec3(MAX_ALBEDO));
+            for (size_t t = 0; t + 2 < mesh.indices.size(); t += 3) {
+                glm::vec3 position[3];
+                glm::vec3 normalSum(0.0f);
+                for (int k = 0; k < 3; ++k) {
+                    const float* vertex = &mesh.vertices[mesh.indices[t + k] * stride];
+                    position[k] = glm::vec3(model * glm::vec4(vertex[0], vertex[1], vertex[2], 1.0f));
+                    normalSum += normalMatrix * glm::vec3(vertex[3], vertex[4], vertex[5]);
+                    sceneMin = glm::min(sceneMin, position[k]);
+                    sceneMax = glm::max(sceneMax, position[k]);
+                }
+                glm::vec3 e1 = position[1] - position[0];
+                glm::vec3 e2 = position[2] - position[0];
+                glm::vec3 cross = glm::cross(e1, e2);
+                if (0.5f * glm::length(cross) < MIN_TRIANGLE_AREA) {
+                    continue;
+                }
+                // sarım yönü modele göre değişebiliyor, yüz normali vertex normallerine çevriliyor
+                ProbeTriangle triangle;
+                triangle.faceNormal = glm::normalize(cross);
+                if (glm::dot(triangle.faceNormal, normalSum) < 0.0f) {
+                    triangle.faceNormal = -triangle.faceNormal;
+                }
+                triangle.albedo = albedo;
+                bvhTriangles.push_back({ position[0], e1, e2, static_cast<uint32_t>(triangles.size()) });
+                triangles.push_back(triangle);
+            }
+        }
+    }
+    if (triangles.empty()) {
+        std::cerr << "Irradiance volume bake: statik obje yok (MakeStatic)" << std::endl;
+        return false;
+    }
+
+    TriangleBVH bvh;
+    bvh.Build(std::move(bvhTriangles));
+    float sceneRadius = glm::length(sceneMax - sceneMin) + 1.0f;
+
+    // problar kutunun köşelerinden başlıyor, aralık kutuya tam bölünecek şekilde ayarlanıyor
+    volumeMin = sceneMin;
+    volumeSize = glm::max(sceneMax - sceneMin, glm::vec3(1e-3f));
+    for (int axis = 0; axis < 3; ++axis) {
+        int count = static_cast<int>(std::ceil(volumeSize[axis] / settings.probeSpacing)) + 1;
+        resolution[axis] = std::max(2, std::min(count, settings.maxProbesPerAxis));
+    }
+    glm::vec3 cellSize = volumeSize / glm::vec3(resolution - 1);
+    size_t probeCount = GetProbeCount();
+
+    // prob ışınları çarptığı yüzeyin doğrudan ışığını alıyor (tek sekme, lightmap'in dolaylı kısmıyla aynı)
+    auto traceStart = std::chrono::high_resolution_clock::now();
+    std::vector<glm::vec3> directions = SphereDirections(settings.raysPerProbe);
+    std::vector<float> directionBasis(directions.size() * SH_COEFFICIENTS);
+    for (size_t d = 0; d < directions.size(); ++d) {
+        EvaluateBasis(directions[d], &directionBasis[d * SH_COEFFICIENTS]);
+    }
+    // Monte Carlo ağırlığı (4pi / N) ve kosinüs konvolüsyonu (Ramamoorthi-Hanrahan A_l / pi),
+    // shader'ın albedo * irradiance'ı calculateLight'taki albedo * renk * NdotL ile aynı ölçekte olsun diye
+    const float bandScale[3] = { 1.0f, 2.0f / 3.0f, 0.25f };
+    const int coefficientBand[SH_COEFFICIENTS] = { 0, 1, 1, 1, 2, 2, 2, 2, 2 };
+    const float sampleWeight = 4.0f * PI / directions.size();
+
+    coefficients.assign(probeCount * SH_COEFFICIENTS, glm::vec3(0.0f));
+    std::vector<unsigned char> valid(probeCount, 1);
+    std::atomic<size_t> raysCast(0);
+    JobSystem::GetInstance().ParallelFor(probeCount, 4, [&](size_t begin, size_t end) {
+        size_t rays = 0;
+        for (size_t p = begin; p < end; ++p) {
+            int x = static_cast<int>(p % resolution.x);
+            int y = static_cast<int>((p / resolution.x) % resolution.y);
+            int z = static_cast<int>(p / (static_cast<size_t>(resolution.x) * resolution.y));
+            glm::vec3 origin = volumeMin + glm::vec3(x, y, z) * cellSize;
+            glm::vec3* probe = &coefficients[p * SH_COEFFICIENTS];
+
+            size_t backfaces = 0;
+            for (size_t d = 0; d < directions.size(); ++d) {
+                TriangleBVH::Hit hit;
+                rays++;
+                if (!bvh.Intersect(origin, directions[d] * sceneRadius, 0.0f, 1.0f, hit)) {
+                    continue; // iç mekan, gökyüzü yok
+                }
+                const ProbeTriangle& hitTriangle = triangles[hit.id];
+                if (glm::dot(hitTriangle.faceNormal, directions[d]) >= 0.0f) {
+                    backfaces++;
+                    continue;
+                }
+                glm::vec3 hitPoint = origin + directions[d] * (hit.t * sceneRadius) + hitTriangle.faceNormal * RAY_OFFSET;
+                glm::vec3 radiance = hitTriangle.albedo * Lightmap::DirectLight(hitPoint, hitTriangle.faceNormal, false,
+                    lights, settings.lightIntensity, bvh, sceneRadius, rays);
+                const float* basis = &directionBasis[d * SH_COEFFICIENTS];
+                for (int k = 0; k < SH_COEFFICIENTS; ++k) {
+                    probe[k] += radiance * basis[k];
+                }
+            }
+            if (backfaces > directions.size() * MAX_BACKFACE_RATIO) {
+                valid[p] = 0;
+                continue;
+            }
+            for (int k = 0; k < SH_COEFFICIENTS; ++k) {
+                probe[k] *= sampleWeight * bandScale[coefficientBand[k]];
+            }
+
+            // ışıkların ambient'i shader'daki gibi menzil içinde yönden bağımsız, sadece sabit katsayıya
+            glm::vec3 ambient(0.0f);
+            for (const Light& light : lights) {
+                if (light.GetType() != Light::Type::DIRECTIONAL &&
+                    glm::length(light.GetPosition() - origin) > light.GetRange()) {
+                    continue;
+                }
+                ambient += light.GetAmbientStrength() * light.GetColor();
+            }
+            probe[0] += ambient / 0.282095f;
+        }
+        raysCast += rays;
+    });
+    auto traceEnd = std::chrono::high_resolution_clock::now();
+
+    // duvarın içinde kalan problar geçerli komşularının ortalamasını alıyor, yoksa ışık sızdırıp karartıyorlar
+    for (size_t p = 0; p < probeCount; ++p) {
+        bakeStats.invalidProbes += valid[p] ? 0 : 1;
+    }
+    const glm::ivec3 neighbors[6] = { { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 } };
+    for (int pass = 0; pass < std::max(resolution.x, std::max(resolution.y, resolution.z)); ++pass) {
+        std::vector<unsigned char> filled(valid);
+        bool changed = false;
+        for (size_t p = 0; p < probeCount; ++p) {
+            if (valid[p]) {
+                continue;
+            }
+            glm::ivec3 cell(static_cast<int>(p % resolution.x), static_cast<int>((p / resolution.x) % resolution.y),
+                static_cast<int>(p / (static_cast<size_t>(resolution.x) * resolution.y)));
+            glm::vec3 sum[SH_COEFFICIENTS] = {};
+            int count = 0;
+            for (const glm::ivec3& offset : neighbors) {
+                glm::ivec3 neighbor = cell + offset;
+                if (glm::any(glm::lessThan(neighbor, glm::ivec3(0))) || glm::any(glm::greaterThanEqual(neighbor, resolution))) {
+                    continue;
+                }
+                size_t n = (static_cast<size_t>(neighbor.z) * resolution.y + neighbor.y) * resolution.x + neighbor.x;
+                if (!valid[n]) {
+                    continue;
+                }
+                for (int k = 0; k < SH_COEFFICIENTS; ++k) {
+                    sum[k] += coefficients[n * SH_COEFFICIENTS + k];
+                }
+                count++;
+            }
+            if (count > 0) {
+                for (int k = 0; k < SH_COEFFICIENTS; ++k) {
+                    coefficients[p * SH_COEFFICIENTS + k] = sum[k] / static_cast<float>(count);
+                }
+                filled[p] = 1;
+                changed = true;
+            }
+        }
+        valid.swap(filled);
+        if (!changed) {
+            break;
+        }
+    }
+
+    if (!CreateTexture()) {
+        Clear();
+        return false;
+    }
+
+    bakeStats.resolution = resolution;
+    bakeStats.probes = probeCount;
+    bakeStats.raysCast = raysCast;
+    bakeStats.traceMs = std::chrono::duration<double, std::milli>(traceEnd - traceStart).count();
+    bakeStats.raysPerSecond = bakeStats.traceMs > 0.0 ? bakeStats.raysCast / (bakeStats.traceMs / 1000.0) : 0.0;
+    bakeStats.threads = JobSystem::GetInstance().GetWorkerCount() + 1;
+    bakeStats.bakeMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+    std::cout << "Irradiance volume bake: " << resolution.x << "x" << resolution.y << "x" << resolution.z << " prob ("
+        << bakeStats.invalidProbes << " duvar icinde), " << bakeStats.raysCast << " isin, "
+        << bakeStats.raysPerSecond / 1.0e6 << " Misin/sn (" << bakeStats.threads << " thread), "
+        << GetMemoryBytes() << " byte CPU, " << GetTextureBytes() << " byte texture, " << bakeStats.bakeMs << " ms" << std::endl;
+    return true;
+}
+
+bool IrradianceVolume::Save(const std::string& path) const {
+    if (!IsLoaded()) {
+        std::cerr << "Irradiance volume kaydedilemedi: bake edilmemis" << std::endl;
+        return false;
+    }
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Irradiance volume dosyasi acilamadi: " << path << std::endl;
+        return false;
+    }
+
+    file.write(PROBE_MAGIC, sizeof(PROBE_MAGIC));
+    WriteValue(file, resolution);
+    WriteValue(file, volumeMin);
+    WriteValue(file, volumeSize);
+    file.write(reinterpret_cast<const char*>(coefficients.data()), coefficients.size() * sizeof(glm::vec3));
+
+    if (!file) {
+        std::cerr << "Irradiance volume dosyasi yazilamadi: " << path << std::endl;
+        return false;
+    }
+    std::cout << "Irradiance volume kaydedildi: " << path << std::endl;
+    return true;
+}
+
+bool IrradianceVolume::Load(const std::string& path) {
+    Clear();
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false; // bake edilmemiş sahne, hata değil
+    }
+
+    char magic[4];
+    bool ok = file.read(magic, sizeof(magic)) && std::equal(magic, magic + 4, PROBE_MAGIC) &&
+        ReadValue(file, resolution) && ReadValue(file, volumeMin) && ReadValue(file, volumeSize);
+    ok = ok && glm::all(glm::greaterThanEqual(resolution, glm::ivec3(2))) &&
+        glm::all(glm::lessThanEqual(resolution, glm::ivec3(256)));
+    if (ok) {
+        coefficients.resize(GetProbeCount() * SH_COEFFICIENTS);
+        ok = static_cast<bool>(file.read(reinterpret_cast<char*>(coefficients.data()), coefficients.size() * sizeof(glm::vec3)));
+    }
+    if (!ok) {
+        std::cerr << "Irradiance volume dosyasi gecersiz: " << path << std::endl;
+        Clear();
+        return false;
+    }
+
+    if (!CreateTexture()) {
+        Clear();
+        return false;
+    }
+    std::cout << "Irradiance volume yuklendi: " << path << " (" << resolution.x << "x" << resolution.y << "x"
+        << resolution.z << " prob, " << GetTextureBytes() << " byte)" << std::endl;
+    return true;
+}
+
+bool IrradianceVolume::CreateTexture() {
+    // katsayı k, z ekseninde [k * nz, (k + 1) * nz) dilimlerinde; shader z'yi blok içinde sıkıştırıyor
+    size_t probeCount = GetProbeCount();
+    std::vector<uint16_t> texels(probeCount * SH_COEFFICIENTS * 3);
+    for (size_t p = 0; p < probeCount; ++p) {
+        for (int k = 0; k < SH_COEFFICIENTS; ++k) {
+            const glm::vec3& value = coefficients[p * SH_COEFFICIENTS + k];
+            size_t texel = k * probeCount + p;
+            texels[texel * 3 + 0] = glm::packHalf1x16(value.r);
+            texels[texel * 3 + 1] = glm::packHalf1x16(value.g);
+            texels[texel * 3 + 2] = glm::packHalf1x16(value.b);
+        }
+    }
+
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_3D, texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 2);
+    glTexImage3D(GL_TEXTURE_3D, 0, GL_RGB16F, resolution.x, resolution.y, resolution.z * SH_COEFFICIENTS, 0,
+        GL_RGB, GL_HALF_FLOAT, texels.data());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_3D, 0);
+
+    if (glGetError() == GL_OUT_OF_MEMORY) {
+        std::cerr << "Irradiance volume texture olusturulamadi (bellek yetersiz)" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void IrradianceVolume::Bind() const {
+    glActiveTexture(GL_TEXTURE0 + Shader::PROBE_UNIT);
+    glBindTexture(GL_TEXTURE_3D, texture);
+    glActiveTexture(GL_TEXTURE0);
+}
+
+LightBuffer::ProbeParams IrradianceVolume::GetShaderParams() const {
+    LightBuffer::ProbeParams params;
+    params.volumeMin = glm::vec4(volumeMin, 0.0f);
+    params.volumeInvSize = glm::vec4(1.0f / volumeSize, 0.0f);
+    return params;
+}
+
+size_t IrradianceVolume::GetMemoryBytes() const {
+    return coefficients.size() * sizeof(glm::vec3);
+}
+
+size_t IrradianceVolume::GetTextureBytes() const {
+    return GetProbeCount() * SH_COEFFICIENTS * 3 * sizeof(uint16_t);
+}
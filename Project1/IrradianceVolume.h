@@ -0,0 +1,75 @@
+#pragma once
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstddef>
+#include "MuseumObject.h"
+#include "Light.h"
+#include "LightBuffer.h"
+
+// Hareketli objeler (robot, statik yapılmamış eserler) için önceden hesaplanmış ortam ışığı
+// Statik binanın sınırlarına düzenli bir prob ızgarası yerleşiyor, her prob kürenin her yönüne ışın atıp
+// çarptığı statik yüzeyin ışığını (Lightmap::DirectLight * renk) L2 küresel harmoniklere (9 katsayı) izdüşürüyor.
+// Katsayılar kosinüsle konvolüe edilmiş halde saklanıyor, shader normal yönündeki irradiance'ı 9 çarpımla buluyor.
+// Duvarın içinde kalan problar (çoğu ışın arka yüze çarpıyor) komşularından dolduruluyor.
+// GPU'da tek 3D texture (RGB16F): 9 katsayı z ekseninde art arda, her biri nz dilimlik blok
+// Lightmap'i olmayan fragmentler sabit ambient yerine bunu kullanıyor (LightBuffer::SetProbeVolume)
+class IrradianceVolume {
+public:
+    static constexpr int SH_COEFFICIENTS = 9;
+
+    struct BakeSettings {
+        float probeSpacing = 2.0f;   // metre, eksen başına en fazla maxProbesPerAxis
+        int maxProbesPerAxis = 64;
+        int raysPerProbe = 128;
+        float lightIntensity = 0.8f; // Lightmap::BakeSettings ile aynı
+    };
+
+    struct BakeStats {
+        glm::ivec3 resolution = glm::ivec3(0);
+        size_t probes = 0;
+        size_t invalidProbes = 0;    // duvar içinde kalıp komşudan doldurulan
+        size_t raysCast = 0;         // prob ışınları + çarpma noktalarının gölge ışınları
+        double raysPerSecond = 0.0;
+        double traceMs = 0.0;
+        double bakeMs = 0.0;
+        size_t threads = 0;
+    };
+
+    IrradianceVolume() = default;
+    ~IrradianceVolume();
+    IrradianceVolume(const IrradianceVolume&) = delete;
+    IrradianceVolume& operator=(const IrradianceVolume&) = delete;
+
+    // statik objelerin üçgenleri ve sahnenin ışıklarıyla bake ediyor, sonuç hemen kullanılıyor
+    bool Bake(const std::vector<std::shared_ptr<MuseumObject>>& objects, const std::vector<Light>& lights,
+        const BakeSettings& settings);
+    bool Save(const std::string& path) const;
+    bool Load(const std::string& path);
+    void Clear();
+
+    bool IsLoaded() const { return texture != 0; }
+    // Shader::PROBE_UNIT
+    void Bind() const;
+    LightBuffer::ProbeParams GetShaderParams() const;
+
+    glm::ivec3 GetResolution() const { return resolution; }
+    size_t GetProbeCount() const { return static_cast<size_t>(resolution.x) * resolution.y * resolution.z; }
+    size_t GetMemoryBytes() const;        // CPU tarafı katsayılar (float)
+    size_t GetTextureBytes() const;       // RGB16F 3D texture
+    const BakeStats& GetBakeStats() const { return bakeStats; }
+
+private:
+    bool CreateTexture();
+
+    glm::vec3 volumeMin = glm::vec3(0.0f);
+    glm::vec3 volumeSize = glm::vec3(0.0f);
+    glm::ivec3 resolution = glm::ivec3(0);
+    // prob başına 9 x RGB, x en hızlı değişen
+    std::vector<glm::vec3> coefficients;
+    GLuint texture = 0;
+
+    BakeStats bakeStats;
+};
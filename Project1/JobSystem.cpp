@@ -0,0 +1,88 @@
+#include "JobSystem.h"
+#include <algorithm>
+#include <iostream>
+
+JobSystem::JobSystem() {
+    // bir çekirdek ana thread için
+    unsigned int hardwareThreads = std::thread::hardware_concurrency();
+    size_t workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+    workerCount = std::min<size_t>(workerCount, 15);
+
+    for (size_t i = 0; i < workerCount; ++i) {
+        workers.emplace_back(&JobSystem::WorkerLoop, this);
+    }
+    std::cout << "JobSystem: " << workerCount << " worker thread" << std::endl;
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeCondition.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void JobSystem::ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& job) {
+    if (count == 0) {
+        return;
+    }
+    grain = std::max<size_t>(grain, 1);
+
+    // tek parça ya da worker yoksa uyandırmaya değmez
+    if (workers.empty() || count <= grain) {
+        job(0, count);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        currentJob = &job;
+        jobCount = count;
+        jobGrain = grain;
+        nextIndex.store(0);
+        busyWorkers = workers.size();
+        generation++;
+    }
+    wakeCondition.notify_all();
+
+    RunChunks();
+
+    // worker'lar job'a referans tutuyor, hepsi bırakmadan dönülmemeli
+    std::unique_lock<std::mutex> lock(mutex);
+    doneCondition.wait(lock, [this] { return busyWorkers == 0; });
+    currentJob = nullptr;
+}
+
+void JobSystem::RunChunks() {
+    while (true) {
+        size_t begin = nextIndex.fetch_add(jobGrain);
+        if (begin >= jobCount) {
+            break;
+        }
+        (*currentJob)(begin, std::min(begin + jobGrain, jobCount));
+    }
+}
+
+void JobSystem::WorkerLoop() {
+    size_t seenGeneration = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeCondition.wait(lock, [&] { return stopping || generation != seenGeneration; });
+            if (stopping) {
+                return;
+            }
+            seenGeneration = generation;
+        }
+
+        RunChunks();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--busyWorkers == 0) {
+            doneCondition.notify_one();
+        }
+    }
+}
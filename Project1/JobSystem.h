@@ -0,0 +1,48 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Frame içi paralel işler için kalıcı worker threadler (cluster culling vs.)
+// her ParallelFor için thread açıp kapatmak yerine threadler uyuyup bekliyor
+// çağıran thread de iş alıyor, ParallelFor tüm parçalar bitince dönüyor
+class JobSystem {
+public:
+    static JobSystem& GetInstance() {
+        static JobSystem instance;
+        return instance;
+    }
+
+    // [0, count) aralığı grain büyüklüğünde parçalara bölünüyor, job(begin, end) her parça için
+    // farklı threadlerden çağrılıyor. İç içe çağrılmamalı.
+    void ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& job);
+
+    size_t GetWorkerCount() const { return workers.size(); }
+
+private:
+    JobSystem();
+    ~JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    void WorkerLoop();
+    void RunChunks();
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wakeCondition;
+    std::condition_variable doneCondition;
+
+    // aktif iş, mutex altında yazılıyor
+    const std::function<void(size_t, size_t)>* currentJob = nullptr;
+    size_t jobCount = 0;
+    size_t jobGrain = 1;
+    std::atomic<size_t> nextIndex{ 0 };
+    size_t busyWorkers = 0;
+    size_t generation = 0;
+    bool stopping = false;
+};
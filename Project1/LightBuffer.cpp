@@ -0,0 +1,93 @@
+#include "LightBuffer.h"
+#include <cstring>
+#include <algorithm>
+#include <cstdint>
+
+LightBuffer::LightBuffer() {
+    staging.resize(BLOCK_SIZE, 0);
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+    glBufferData(GL_UNIFORM_BUFFER, BLOCK_SIZE, staging.data(), GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+LightBuffer::~LightBuffer() {
+    glDeleteBuffers(1, &buffer);
+}
+
+int LightBuffer::Upload(const std::vector<Light>& lights, size_t first) {
+    int count = 0;
+    if (lights.size() > first) {
+        count = static_cast<int>(std::min(lights.size() - first, static_cast<size_t>(MAX_LIGHTS)));
+    }
+
+    PackedLight* packed = reinterpret_cast<PackedLight*>(staging.data());
+    for (int i = 0; i < count; ++i) {
+        PackLight(lights[first + i], reinterpret_cast<float*>(&packed[i]));
+    }
+    // kümeler kapalı, EnableClusters ile açılıyor
+    int32_t header[4] = { count, 0, lightmapEnabled ? 1 : 0, probesEnabled ? 1 : 0 };
+    std::memcpy(staging.data() + HEADER_OFFSET, header, sizeof(header));
+    std::memcpy(staging.data() + PROBE_OFFSET, &probeParams, sizeof(probeParams));
+
+    // sadece kullanılan kısım + sayaç yükleniyor
+    glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+    if (count > 0) {
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(PackedLight) * count, staging.data());
+    }
+    glBufferSubData(GL_UNIFORM_BUFFER, HEADER_OFFSET, sizeof(header), header);
+    glBufferSubData(GL_UNIFORM_BUFFER, PROBE_OFFSET, sizeof(probeParams), &probeParams);
+    // hareketli ışıklar SetDynamicLights'ta paketlendi
+    glBufferSubData(GL_UNIFORM_BUFFER, DYNAMIC_OFFSET, BLOCK_SIZE - DYNAMIC_OFFSET, staging.data() + DYNAMIC_OFFSET);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    return count;
+}
+
+void LightBuffer::SetDynamicLights(const std::vector<const Light*>& lights) {
+    int32_t count = static_cast<int32_t>(std::min(lights.size(), static_cast<size_t>(MAX_DYNAMIC_LIGHTS)));
+    PackedLight* packed = reinterpret_cast<PackedLight*>(staging.data() + DYNAMIC_OFFSET);
+    for (int32_t i = 0; i < count; ++i) {
+        PackLight(*lights[i], reinterpret_cast<float*>(&packed[i]));
+    }
+    std::memcpy(staging.data() + DYNAMIC_COUNT_OFFSET, &count, sizeof(count));
+}
+
+void LightBuffer::EnableClusters(const ClusterParams& params) {
+    // düz liste boş bırakılıyor, ışıklar kümelerin listesinden geliyor
+    int32_t header[4] = { 0, 1, lightmapEnabled ? 1 : 0, probesEnabled ? 1 : 0 };
+    unsigned char* target = staging.data() + HEADER_OFFSET;
+    std::memcpy(target, header, sizeof(header));
+    std::memcpy(target + 16, &params.depth[0], sizeof(glm::vec4));
+    std::memcpy(target + 32, &params.viewport[0], sizeof(glm::vec4));
+
+    glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, HEADER_OFFSET, 48, target);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void LightBuffer::PackLight(const Light& light, float* out) {
+    // ShaderSetup::SetupLight ile aynı değerler
+    const glm::vec3& position = light.GetPosition();
+    const glm::vec3& direction = light.GetDirection();
+    const glm::vec3& color = light.GetColor();
+    out[0] = position.x;
+    out[1] = position.y;
+    out[2] = position.z;
+    out[3] = light.GetRange();
+    out[4] = direction.x;
+    out[5] = direction.y;
+    out[6] = direction.z;
+    out[7] = static_cast<float>(static_cast<int>(light.GetType()));
+    out[8] = color.r;
+    out[9] = color.g;
+    out[10] = color.b;
+    out[11] = light.GetIntensity();
+    out[12] = light.GetAmbientStrength();
+    out[13] = light.GetSpecularStrength();
+    out[14] = glm::cos(glm::radians(light.GetSpotCutOff()));
+    out[15] = glm::cos(glm::radians(light.GetSpotOuterCutOff()));
+}
+
+void LightBuffer::Bind() const {
+    glBindBufferBase(GL_UNIFORM_BUFFER, Shader::LIGHT_BLOCK_BINDING, buffer);
+}
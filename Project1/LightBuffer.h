@@ -0,0 +1,74 @@
+#pragma once
+#include <glad/glad.h>
+#include <vector>
+#include <cstddef>
+#include "Light.h"
+
+// Forward yolun ek ışıkları için uniform buffer (brdf.glsl PackedLight, fragmentShader.glsl LightBlock)
+// ilk ışık eskisi gibi "light" uniformuyla gidiyor, geri kalanlar frame başına bir kere buraya yazılıyor
+// ve Shader::LIGHT_BLOCK_BINDING noktasına bağlanıyor, tüm fragmentShader.glsl varyantları okuyor
+class LightBuffer {
+public:
+    static constexpr int MAX_LIGHTS = 128; // brdf.glsl MAX_LIGHTS ile aynı
+    static constexpr int MAX_DYNAMIC_LIGHTS = 4; // brdf.glsl MAX_DYNAMIC_LIGHTS ile aynı
+
+    LightBuffer();
+    ~LightBuffer();
+
+    // kümelenmiş aydınlatmada fragment shader'ın kümesini bulması için (ClusteredLighting::ShaderParams)
+    struct ClusterParams {
+        glm::vec4 depth;
+        glm::vec4 viewport;
+    };
+
+    // irradiance volume'un dünya uzayındaki kutusu (IrradianceVolume::GetShaderParams)
+    struct ProbeParams {
+        glm::vec4 volumeMin;
+        glm::vec4 volumeInvSize; // 1 / kutu boyu
+    };
+
+    // lights[first..] paketlenip yükleniyor, sığan ışık sayısını döndürür
+    int Upload(const std::vector<Light>& lights, size_t first);
+    // Upload'dan sonra çağrılırsa shader ek ışıkları düz listeden değil kendi kümesinin
+    // listesinden okuyor, bir sonraki Upload tekrar düz listeye dönüyor
+    void EnableClusters(const ClusterParams& params);
+    // açıkken lightmap'li fragmentler (statik kabuk) ışıkları tek tek hesaplamıyor, sonraki Upload'da geçerli
+    void SetLightmapEnabled(bool enabled) { lightmapEnabled = enabled; }
+    // açıkken lightmap'i olmayan fragmentlerin ortam ışığı ışıkların sabit ambient'i yerine
+    // prob ızgarasından geliyor, sonraki Upload'da geçerli
+    void SetProbeVolume(bool enabled, const ProbeParams& params) {
+        probesEnabled = enabled;
+        probeParams = params;
+    }
+    // hareketli ışıklar (robot lambası): bake edilmiyor, lightmap'li yüzeylerde de canlı hesaplanıyor,
+    // sonraki Upload'da geçerli. Sığmayanlar atlanıyor
+    void SetDynamicLights(const std::vector<const Light*>& lights);
+    void Bind() const;
+
+    // brdf.glsl PackedLight düzeni (16 float), ClusteredLighting de kullanıyor
+    static void PackLight(const Light& light, float* out);
+
+private:
+    // std140 düzeni: 4 x vec4
+    struct PackedLight {
+        float positionRange[4];
+        float directionType[4];
+        float colorIntensity[4];
+        float params[4]; // ambient, specular, cos(cutOff), cos(outerCutOff)
+    };
+
+    // LightBlock: PackedLight[MAX_LIGHTS], int extraLightCount, int clustered, int lightmapEnabled, int probesEnabled,
+    // vec4 clusterDepth, vec4 clusterViewport, vec4 probeVolumeMin, vec4 probeVolumeInvSize,
+    // PackedLight dynamicLights[MAX_DYNAMIC_LIGHTS], int dynamicLightCount
+    static constexpr size_t HEADER_OFFSET = sizeof(PackedLight) * MAX_LIGHTS;
+    static constexpr size_t PROBE_OFFSET = HEADER_OFFSET + 48;
+    static constexpr size_t DYNAMIC_OFFSET = HEADER_OFFSET + 80;
+    static constexpr size_t DYNAMIC_COUNT_OFFSET = DYNAMIC_OFFSET + sizeof(PackedLight) * MAX_DYNAMIC_LIGHTS;
+    static constexpr size_t BLOCK_SIZE = DYNAMIC_COUNT_OFFSET + 16;
+
+    GLuint buffer = 0;
+    bool lightmapEnabled = false;
+    bool probesEnabled = false;
+    ProbeParams probeParams = {};
+    std::vector<unsigned char> staging;
+};
@@ -0,0 +1,892 @@
+#include "Lightmap.h"
+#include "TriangleBVH.h"
+#include "JobSystem.h"
+#include "PotentiallyVisibleSet.h"
+#include "Shader.h"
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+
+namespace {
+    const char LIGHTMAP_MAGIC[4] = { 'L', 'M', 'P', '1' };
+    const int CHART_PADDING = 2;          // chart çevresinde dilate için boş texel
+    const int MAX_UNWRAP_ATTEMPTS = 16;   // her denemede yoğunluk %15 düşüyor
+    const float MIN_TRIANGLE_AREA = 1e-8f;
+    const float WELD_SCALE = 1e4f;        // açılımda 0.1 mm'den yakın köşeler aynı sayılıyor
+    const float RAY_OFFSET = 0.01f;       // yüzeyin kendine çarpmaması için normal yönünde kaydırma
+    const float MAX_ALBEDO = 0.9f;
+    const uint32_t NO_TRIANGLE = 0xFFFFFFFFu;
+
+    // bir meshin aynı eksene bakan bağlı üçgenleri
+    struct Chart {
+        uint32_t mesh;           // açılan meshler listesinde
+        int axis;                // eksen * 2 + (negatifse 1)
+        glm::vec3 worldMin;
+        glm::vec2 projectedMin;
+        glm::vec2 projectedMax;
+        int width = 0;           // texel, padding dahil
+        int height = 0;
+        int x = 0;
+        int y = 0;
+    };
+
+    int DominantAxis(const glm::vec3& normal) {
+        glm::vec3 absolute = glm::abs(normal);
+        int axis = absolute.x >= absolute.y ? (absolute.x >= absolute.z ? 0 : 2) : (absolute.y >= absolute.z ? 1 : 2);
+        return axis * 2 + (normal[axis] < 0.0f ? 1 : 0);
+    }
+
+    glm::vec2 Project(const glm::vec3& position, int axis) {
+        int a = axis / 2;
+        return glm::vec2(position[(a + 1) % 3], position[(a + 2) % 3]);
+    }
+
+    uint32_t FindRoot(std::vector<uint32_t>& parent, uint32_t i) {
+        while (parent[i] != i) {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    }
+
+    void HashValue(uint64_t& hash, uint64_t value) {
+        // FNV-1a
+        for (int i = 0; i < 8; ++i) {
+            hash ^= (value >> (i * 8)) & 0xFF;
+            hash *= 1099511628211ull;
+        }
+    }
+
+    // texel başına ucuz ve tekrarlanabilir rastgele sayı (PCG)
+    struct SampleRandom {
+        uint32_t state;
+
+        explicit SampleRandom(uint32_t seed) : state(seed * 747796405u + 2891336453u) {}
+
+        float Next() {
+            state = state * 747796405u + 2891336453u;
+            uint32_t word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+            word = (word >> 22u) ^ word;
+            return (word >> 8) * (1.0f / 16777216.0f);
+        }
+    };
+
+    // bake sırasında statik üçgen (dünya uzayı, UV atlas texel uzayında)
+    struct BakeTriangle {
+        glm::vec3 position[3];
+        glm::vec3 normal[3];
+        glm::vec2 uv[3];
+        glm::vec3 faceNormal;
+        glm::vec3 albedo;
+    };
+
+    struct TexelSample {
+        glm::vec3 position;
+        glm::vec3 normal;
+        uint32_t texel;
+        unsigned char coverage; // 2: texel merkezi üçgende, 1: kenara yakın
+    };
+
+    void WriteString(std::ofstream& file, const std::string& value) {
+        uint32_t length = static_cast<uint32_t>(value.size());
+        file.write(reinterpret_cast<const char*>(&length), sizeof(length));
+        file.write(value.data(), length);
+    }
+
+    bool ReadString(std::ifstream& file, std::string& value) {
+        uint32_t length = 0;
+        if (!file.read(reinterpret_cast<char*>(&length), sizeof(length)) || length > 4096) {
+            return false;
+        }
+        value.resize(length);
+        return static_cast<bool>(file.read(&value[0], length));
+    }
+
+    template <typename T>
+    void WriteValue(std::ofstream& file, const T& value) {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    bool ReadValue(std::ifstream& file, T& value) {
+        return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+    }
+
+    // normal etrafında kosinüs ağırlıklı yön
+    glm::vec3 CosineSample(const glm::vec3& normal, float r1, float r2) {
+        float sign = normal.z >= 0.0f ? 1.0f : -1.0f;
+        float a = -1.0f / (sign + normal.z);
+        float b = normal.x * normal.y * a;
+        glm::vec3 tangent(1.0f + sign * normal.x * normal.x * a, sign * b, -sign * normal.x);
+        glm::vec3 bitangent(b, sign + normal.y * normal.y * a, -normal.y);
+
+        float phi = 6.28318530718f * r1;
+        float radius = std::sqrt(r2);
+        return tangent * (radius * std::cos(phi)) + bitangent * (radius * std::sin(phi)) +
+            normal * std::sqrt(std::max(0.0f, 1.0f - r2));
+    }
+}
+
+Lightmap::~Lightmap() {
+    if (texture != 0) {
+        glDeleteTextures(1, &texture);
+    }
+}
+
+void Lightmap::Clear() {
+    if (texture != 0) {
+        glDeleteTextures(1, &texture);
+        texture = 0;
+    }
+    atlasSize = 0;
+    texelsPerUnit = 0.0f;
+    chartCount = 0;
+    layoutHash = 0;
+    objectNames.clear();
+    objectMeshCounts.clear();
+    compressedPlanes.clear();
+}
+
+bool Lightmap::Unwrap(const std::vector<std::shared_ptr<MuseumObject>>& objects, int atlasSize,
+    float texelsPerUnit, Layout& layout) {
+    const int stride = GeometryPool::VERTEX_FLOATS;
+    layout = Layout();
+
+    struct UnwrapMesh {
+        MuseumObject* object;
+        size_t meshIndex;
+        std::vector<glm::vec3> positions;  // dünya uzayı
+        std::vector<int32_t> triangleChart; // -1: dejenere üçgen, lightmap'siz
+    };
+    std::vector<UnwrapMesh> unwrapMeshes;
+    std::vector<Chart> charts;
+
+    for (const auto& object : objects) {
+        if (!object->IsStatic()) {
+            continue;
+        }
+        const auto& meshes = object->GetMeshes();
+        layout.objectNames.push_back(object->GetName());
+        layout.objectMeshCounts.push_back(static_cast<uint32_t>(meshes.size()));
+        glm::mat4 model = object->GetModelMatrix();
+
+        for (size_t m = 0; m < meshes.size(); ++m) {
+            const auto& mesh = meshes[m];
+            UnwrapMesh unwrapMesh;
+            unwrapMesh.object = object.get();
+            unwrapMesh.meshIndex = m;
+            size_t vertexCount = mesh.vertices.size() / stride;
+            size_t triangleCount = mesh.indices.size() / 3;
+
+            // sert kenarlarda (normal/uv farkı) bölünmüş vertexler konumdan birleştiriliyor
+            std::vector<uint32_t> weld(vertexCount);
+            std::map<std::tuple<long long, long long, long long>, uint32_t> weldLookup;
+            unwrapMesh.positions.resize(vertexCount);
+            for (size_t v = 0; v < vertexCount; ++v) {
+                const float* vertex = &mesh.vertices[v * stride];
+                glm::vec3 position = glm::vec3(model * glm::vec4(vertex[0], vertex[1], vertex[2], 1.0f));
+                unwrapMesh.positions[v] = position;
+                auto key = std::make_tuple(std::llround(position.x * WELD_SCALE), std::llround(position.y * WELD_SCALE),
+                    std::llround(position.z * WELD_SCALE));
+                weld[v] = weldLookup.emplace(key, static_cast<uint32_t>(weldLookup.size())).first->second;
+            }
+
+            // aynı eksene bakan ve kenar paylaşan üçgenler aynı chart
+            std::vector<int> triangleAxis(triangleCount, -1);
+            std::vector<uint32_t> parent(triangleCount);
+            std::unordered_map<uint64_t, uint32_t> edgeOwner;
+            for (uint32_t t = 0; t < triangleCount; ++t) {
+                parent[t] = t;
+                const glm::vec3& p0 = unwrapMesh.positions[mesh.indices[t * 3]];
+                const glm::vec3& p1 = unwrapMesh.positions[mesh.indices[t * 3 + 1]];
+                const glm::vec3& p2 = unwrapMesh.positions[mesh.indices[t * 3 + 2]];
+                glm::vec3 cross = glm::cross(p1 - p0, p2 - p0);
+                if (0.5f * glm::length(cross) < MIN_TRIANGLE_AREA) {
+                    continue;
+                }
+                triangleAxis[t] = DominantAxis(cross);
+
+                for (int k = 0; k < 3; ++k) {
+                    uint32_t a = weld[mesh.indices[t * 3 + k]];
+                    uint32_t b = weld[mesh.indices[t * 3 + (k + 1) % 3]];
+                    uint64_t edge = (static_cast<uint64_t>(std::min(a, b)) << 32) | std::max(a, b);
+                    auto owner = edgeOwner.emplace(edge, t);
+                    if (!owner.second && triangleAxis[owner.first->second] == triangleAxis[t]) {
+                        parent[FindRoot(parent, t)] = FindRoot(parent, owner.first->second);
+                    }
+                }
+            }
+
+            unwrapMesh.triangleChart.assign(triangleCount, -1);
+            std::unordered_map<uint32_t, int32_t> rootChart;
+            for (uint32_t t = 0; t < triangleCount; ++t) {
+                if (triangleAxis[t] < 0) {
+                    continue;
+                }
+                uint32_t root = FindRoot(parent, t);
+                auto found = rootChart.find(root);
+                if (found == rootChart.end()) {
+                    Chart chart;
+                    chart.mesh = static_cast<uint32_t>(unwrapMeshes.size());
+                    chart.axis = triangleAxis[t];
+                    chart.worldMin = glm::vec3(FLT_MAX);
+                    chart.projectedMin = glm::vec2(FLT_MAX);
+                    chart.projectedMax = glm::vec2(-FLT_MAX);
+                    found = rootChart.emplace(root, static_cast<int32_t>(charts.size())).first;
+                    charts.push_back(chart);
+                }
+                Chart& chart = charts[found->second];
+                unwrapMesh.triangleChart[t] = found->second;
+                for (int k = 0; k < 3; ++k) {
+                    const glm::vec3& position = unwrapMesh.positions[mesh.indices[t * 3 + k]];
+                    glm::vec2 projected = Project(position, chart.axis);
+                    chart.worldMin = glm::min(chart.worldMin, position);
+                    chart.projectedMin = glm::min(chart.projectedMin, projected);
+                    chart.projectedMax = glm::max(chart.projectedMax, projected);
+                }
+            }
+            unwrapMeshes.push_back(std::move(unwrapMesh));
+        }
+    }
+
+    if (charts.empty()) {
+        std::cerr << "Lightmap: statik obje yok" << std::endl;
+        return false;
+    }
+
+    // yerleşim sırası üçgen/vertex sırasından bağımsız: önce uzunlar, sonra konum
+    std::vector<uint32_t> order(charts.size());
+    for (uint32_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&charts](uint32_t a, uint32_t b) {
+        const Chart& left = charts[a];
+        const Chart& right = charts[b];
+        glm::vec2 leftExtent = left.projectedMax - left.projectedMin;
+        glm::vec2 rightExtent = right.projectedMax - right.projectedMin;
+        return std::make_tuple(-leftExtent.y, -leftExtent.x, left.axis, left.worldMin.x, left.worldMin.y, left.worldMin.z, left.mesh) <
+            std::make_tuple(-rightExtent.y, -rightExtent.x, right.axis, right.worldMin.x, right.worldMin.y, right.worldMin.z, right.mesh);
+    });
+
+    // raf yerleşimi, sığmazsa yoğunluk düşürülüp tekrar deneniyor
+    bool packed = false;
+    for (int attempt = 0; attempt < MAX_UNWRAP_ATTEMPTS && !packed; ++attempt) {
+        if (attempt > 0) {
+            texelsPerUnit *= 0.85f;
+        }
+        packed = true;
+        int shelfX = 0, shelfY = 0, shelfHeight = 0;
+        for (uint32_t index : order) {
+            Chart& chart = charts[index];
+            glm::vec2 extent = (chart.projectedMax - chart.projectedMin) * texelsPerUnit;
+            chart.width = static_cast<int>(std::ceil(extent.x)) + 1 + CHART_PADDING * 2;
+            chart.height = static_cast<int>(std::ceil(extent.y)) + 1 + CHART_PADDING * 2;
+            if (shelfX + chart.width > atlasSize) {
+                shelfX = 0;
+                shelfY += shelfHeight;
+                shelfHeight = 0;
+            }
+            if (chart.width > atlasSize || shelfY + chart.height > atlasSize) {
+                packed = false;
+                break;
+            }
+            chart.x = shelfX;
+            chart.y = shelfY;
+            shelfX += chart.width;
+            shelfHeight = std::max(shelfHeight, chart.height);
+        }
+    }
+    if (!packed) {
+        std::cerr << "Lightmap: chartlar " << atlasSize << " atlasa sigmadi" << std::endl;
+        return false;
+    }
+
+    layout.charts = charts.size();
+    layout.texelsPerUnit = texelsPerUnit;
+    layout.hash = 14695981039346656037ull;
+    HashValue(layout.hash, static_cast<uint64_t>(atlasSize));
+    for (uint32_t index : order) {
+        const Chart& chart = charts[index];
+        HashValue(layout.hash, (static_cast<uint64_t>(chart.x) << 32) | static_cast<uint32_t>(chart.y));
+        HashValue(layout.hash, (static_cast<uint64_t>(chart.width) << 32) | static_cast<uint32_t>(chart.height));
+    }
+
+    // vertexler chart başına kopyalanıyor, üçgen sırası aynı kalıyor
+    float invAtlasSize = 1.0f / atlasSize;
+    for (UnwrapMesh& unwrapMesh : unwrapMeshes) {
+        const auto& mesh = unwrapMesh.object->GetMeshes()[unwrapMesh.meshIndex];
+        std::vector<float> vertices;
+        std::vector<unsigned int> indices;
+        std::vector<float> lightmapUVs;
+        std::vector<unsigned char> occlusion;
+        vertices.reserve(mesh.vertices.size());
+        indices.reserve(mesh.indices.size());
+        lightmapUVs.reserve(mesh.vertices.size() / stride * 2);
+        std::unordered_map<uint64_t, unsigned int> remap;
+
+        for (size_t t = 0; t * 3 < mesh.indices.size(); ++t) {
+            int32_t chartIndex = unwrapMesh.triangleChart[t];
+            for (int k = 0; k < 3; ++k) {
+                unsigned int sourceIndex = mesh.indices[t * 3 + k];
+                uint64_t key = (static_cast<uint64_t>(chartIndex + 1) << 32) | sourceIndex;
+                auto existing = remap.find(key);
+                if (existing != remap.end()) {
+                    indices.push_back(existing->second);
+                    continue;
+                }
+
+                unsigned int newIndex = static_cast<unsigned int>(vertices.size() / stride);
+                const float* vertex = &mesh.vertices[sourceIndex * stride];
+                vertices.insert(vertices.end(), vertex, vertex + stride);
+                if (!mesh.occlusion.empty()) {
+                    occlusion.push_back(mesh.occlusion[sourceIndex]);
+                }
+                if (chartIndex < 0) {
+                    lightmapUVs.push_back(-1.0f);
+                    lightmapUVs.push_back(-1.0f);
+                }
+                else {
+                    // chart köşesi texel merkezine denk geliyor
+                    const Chart& chart = charts[chartIndex];
+                    glm::vec2 local = (Project(unwrapMesh.positions[sourceIndex], chart.axis) - chart.projectedMin) * texelsPerUnit;
+                    lightmapUVs.push_back((chart.x + CHART_PADDING + 0.5f + local.x) * invAtlasSize);
+                    lightmapUVs.push_back((chart.y + CHART_PADDING + 0.5f + local.y) * invAtlasSize);
+                }
+                indices.push_back(newIndex);
+                remap[key] = newIndex;
+            }
+        }
+        unwrapMesh.object->SetLightmapGeometry(unwrapMesh.meshIndex, std::move(vertices), std::move(indices),
+            std::move(lightmapUVs), std::move(occlusion));
+    }
+    return true;
+}
+
+glm::vec3 Lightmap::DirectLight(const glm::vec3& point, const glm::vec3& normal, bool includeAmbient,
+    const std::vector<Light>& lights, float intensity, const TriangleBVH& bvh, float sceneRadius, size_t& rays) {
+    glm::vec3 result(0.0f);
+    for (const Light& light : lights) {
+        glm::vec3 direction;
+        glm::vec3 end;
+        float attenuation = 1.0f;
+        float spotEffect = 1.0f;
+        if (light.GetType() == Light::Type::DIRECTIONAL) {
+            direction = glm::normalize(-light.GetDirection());
+            end = point + direction * sceneRadius;
+        }
+        else {
+            glm::vec3 toLight = light.GetPosition() - point;
+            float distance = glm::length(toLight);
+            if (distance > light.GetRange() || distance <= 0.0f) {
+                continue;
+            }
+            direction = toLight / distance;
+            end = light.GetPosition();
+            attenuation = 1.0f / (1.0f + 0.09f * distance + 0.032f * distance * distance);
+            if (light.GetType() == Light::Type::SPOT) {
+                float theta = glm::dot(direction, glm::normalize(-light.GetDirection()));
+                float cutOff = glm::cos(glm::radians(light.GetSpotCutOff()));
+                float outerCutOff = glm::cos(glm::radians(light.GetSpotOuterCutOff()));
+                spotEffect = glm::clamp((theta - outerCutOff) / (cutOff - outerCutOff), 0.0f, 1.0f);
+            }
+        }
+
+        // ortam ışığı shader'daki gibi yoğunluktan bağımsız, menzil içinde her yüzeye
+        if (includeAmbient) {
+            result += light.GetAmbientStrength() * light.GetColor();
+        }
+        float normalDotLight = glm::dot(normal, direction);
+        if (normalDotLight <= 0.0f || spotEffect <= 0.0f) {
+            continue;
+        }
+        rays++;
+        if (bvh.IsSegmentBlocked(point, end, NO_TRIANGLE)) {
+            continue;
+        }
+        result += light.GetColor() * (normalDotLight * attenuation * spotEffect * intensity);
+    }
+    return result;
+}
+
+bool Lightmap::Bake(const std::vector<std::shared_ptr<MuseumObject>>& objects, const std::vector<Light>& lights,
+    const BakeSettings& settings) {
+    auto start = std::chrono::high_resolution_clock::now();
+    Clear();
+    bakeStats = BakeStats();
+
+    if (settings.atlasSize < 64 || settings.atlasSize > 4096 || settings.texelsPerUnit <= 0.0f ||
+        settings.indirectSamples < 0) {
+        std::cerr << "Lightmap bake: ayarlar gecersiz" << std::endl;
+        return false;
+    }
+
+    Layout layout;
+    if (!Unwrap(objects, settings.atlasSize, settings.texelsPerUnit, layout)) {
+        return false;
+    }
+    auto unwrapEnd = std::chrono::high_resolution_clock::now();
+    bakeStats.unwrapMs = std::chrono::duration<double, std::milli>(unwrapEnd - start).count();
+
+    // statik üçgenler: hem ışın engeli/dolaylı ışığın kaynağı hem texel örnekleri
+    const int stride = GeometryPool::VERTEX_FLOATS;
+    const int size = settings.atlasSize;
+    std::vector<BakeTriangle> triangles;
+    std::vector<TriangleBVH::Triangle> bvhTriangles;
+    glm::vec3 sceneMin(FLT_MAX), sceneMax(-FLT_MAX);
+    for (const auto& object : objects) {
+        if (!object->IsStatic()) {
+            continue;
+        }
+        glm::mat4 model = object->GetModelMatrix();
+        glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(model)));
+        for (const auto& mesh : object->GetMeshes()) {
+            if (mesh.lightmapUVs.empty()) {
+                continue;
+            }
+            // texture ortalaması yerine materyal rengi, enerji kazanmasın diye sınırlı
+            glm::vec3 albedo = glm::clamp(mesh.material.diffuse, glm::vec3(0.0f), glm::vec3(MAX_ALBEDO));
+            for (size_t t = 0; t + 2 < mesh.indices.size(); t += 3) {
+                BakeTriangle triangle;
+                bool lightmapped = true;
+                for (int k = 0; k < 3; ++k) {
+                    unsigned int index = mesh.indices[t + k];
+                    const float* vertex = &mesh.vertices[index * stride];
+                    triangle.position[k] = glm::vec3(model * glm::vec4(vertex[0], vertex[1], vertex[2], 1.0f));
+                    triangle.normal[k] = normalMatrix * glm::vec3(vertex[3], vertex[4], vertex[5]);
+                    triangle.uv[k] = glm::vec2(mesh.lightmapUVs[index * 2], mesh.lightmapUVs[index * 2 + 1]) * static_cast<float>(size);
+                    lightmapped = lightmapped && mesh.lightmapUVs[index * 2] >= 0.0f;
+                    sceneMin = glm::min(sceneMin, triangle.position[k]);
+                    sceneMax = glm::max(sceneMax, triangle.position[k]);
+                }
+                glm::vec3 e1 = triangle.position[1] - triangle.position[0];
+                glm::vec3 e2 = triangle.position[2] - triangle.position[0];
+                glm::vec3 cross = glm::cross(e1, e2);
+                if (!lightmapped || 0.5f * glm::length(cross) < MIN_TRIANGLE_AREA) {
+                    continue;
+                }
+                // sarım yönü modele göre değişebiliyor, yüz normali vertex normallerine çevriliyor
+                triangle.faceNormal = glm::normalize(cross);
+                if (glm::dot(triangle.faceNormal, triangle.normal[0] + triangle.normal[1] + triangle.normal[2]) < 0.0f) {
+                    triangle.faceNormal = -triangle.faceNormal;
+                }
+                triangle.albedo = albedo;
+                bvhTriangles.push_back({ triangle.position[0], e1, e2, static_cast<uint32_t>(triangles.size()) });
+                triangles.push_back(triangle);
+            }
+        }
+    }
+    bakeStats.charts = layout.charts;
+    bakeStats.triangles = triangles.size();
+    bakeStats.texelsPerUnit = layout.texelsPerUnit;
+    float sceneRadius = glm::length(sceneMax - sceneMin) + 1.0f;
+
+    // texel merkezlerini üçgenlere dağıt, kenara değen texeller de (en yakın noktayla) örnekleniyor
+    std::vector<int32_t> texelSample(static_cast<size_t>(size) * size, -1);
+    std::vector<TexelSample> samples;
+    for (const BakeTriangle& triangle : triangles) {
+        const glm::vec2& uv0 = triangle.uv[0];
+        glm::vec2 edge1 = triangle.uv[1] - uv0;
+        glm::vec2 edge2 = triangle.uv[2] - uv0;
+        float area = edge1.x * edge2.y - edge1.y * edge2.x;
+        if (std::abs(area) < 1e-12f) {
+            continue;
+        }
+        glm::vec2 uvMin = glm::min(uv0, glm::min(triangle.uv[1], triangle.uv[2]));
+        glm::vec2 uvMax = glm::max(uv0, glm::max(triangle.uv[1], triangle.uv[2]));
+        int x0 = std::max(0, static_cast<int>(std::floor(uvMin.x)) - 1);
+        int y0 = std::max(0, static_cast<int>(std::floor(uvMin.y)) - 1);
+        int x1 = std::min(size - 1, static_cast<int>(std::floor(uvMax.x)) + 1);
+        int y1 = std::min(size - 1, static_cast<int>(std::floor(uvMax.y)) + 1);
+
+        for (int y = y0; y <= y1; ++y) {
+            for (int x = x0; x <= x1; ++x) {
+                glm::vec2 center(x + 0.5f, y + 0.5f);
+                glm::vec2 d = center - uv0;
+                float w1 = (d.x * edge2.y - d.y * edge2.x) / area;
+                float w2 = (edge1.x * d.y - edge1.y * d.x) / area;
+                glm::vec3 weights(1.0f - w1 - w2, w1, w2);
+                unsigned char coverage = 2;
+                if (weights.x < 0.0f || weights.y < 0.0f || weights.z < 0.0f) {
+                    weights = glm::max(weights, glm::vec3(0.0f));
+                    weights /= weights.x + weights.y + weights.z;
+                    glm::vec2 closest = triangle.uv[0] * weights.x + triangle.uv[1] * weights.y + triangle.uv[2] * weights.z;
+                    if (glm::length(closest - center) > 0.75f) {
+                        continue;
+                    }
+                    coverage = 1;
+                }
+
+                size_t texel = static_cast<size_t>(y) * size + x;
+                int32_t existing = texelSample[texel];
+                if (existing >= 0 && samples[existing].coverage >= coverage) {
+                    continue;
+                }
+                TexelSample sample;
+                sample.position = triangle.position[0] * weights.x + triangle.position[1] * weights.y + triangle.position[2] * weights.z;
+                sample.normal = triangle.normal[0] * weights.x + triangle.normal[1] * weights.y + triangle.normal[2] * weights.z;
+                if (glm::dot(sample.normal, sample.normal) < 1e-8f) {
+                    sample.normal = triangle.faceNormal;
+                }
+                sample.normal = glm::normalize(sample.normal);
+                if (glm::dot(sample.normal, triangle.faceNormal) < 0.0f) {
+                    sample.normal = -sample.normal;
+                }
+                sample.texel = static_cast<uint32_t>(texel);
+                sample.coverage = coverage;
+                if (existing >= 0) {
+                    samples[existing] = sample;
+                }
+                else {
+                    texelSample[texel] = static_cast<int32_t>(samples.size());
+                    samples.push_back(sample);
+                }
+            }
+        }
+    }
+    bakeStats.texels = samples.size();
+
+    TriangleBVH bvh;
+    bvh.Build(std::move(bvhTriangles));
+
+    // her texel: doğrudan ışık + tek sekmelik dolaylı ışık (isabet eden yüzeyin doğrudan ışığı * rengi)
+    auto traceStart = std::chrono::high_resolution_clock::now();
+    std::vector<glm::vec3> direct(samples.size());
+    std::vector<glm::vec3> indirect(samples.size(), glm::vec3(0.0f));
+    std::atomic<size_t> raysCast(0);
+    JobSystem::GetInstance().ParallelFor(samples.size(), 64, [&](size_t begin, size_t end) {
+        size_t rays = 0;
+        for (size_t i = begin; i < end; ++i) {
+            const TexelSample& sample = samples[i];
+            glm::vec3 origin = sample.position + sample.normal * RAY_OFFSET;
+            direct[i] = DirectLight(origin, sample.normal, true, lights, settings.lightIntensity, bvh, sceneRadius, rays);
+            if (settings.indirectSamples == 0) {
+                continue;
+            }
+
+            // aynı sahne aynı sonucu versin diye texel başına seed
+            SampleRandom random(sample.texel);
+            glm::vec3 bounce(0.0f);
+            for (int s = 0; s < settings.indirectSamples; ++s) {
+                float r1 = random.Next();
+                float r2 = random.Next();
+                glm::vec3 direction = CosineSample(sample.normal, r1, r2);
+                TriangleBVH::Hit hit;
+                rays++;
+                if (!bvh.Intersect(origin, direction, 1e-4f, sceneRadius, hit)) {
+                    continue; // iç mekan, gökyüzü yok
+                }
+                const BakeTriangle& hitTriangle = triangles[hit.id];
+                if (glm::dot(hitTriangle.faceNormal, direction) >= 0.0f) {
+                    continue; // arka yüz: duvarın içi
+                }
+                glm::vec3 hitPoint = origin + direction * hit.t + hitTriangle.faceNormal * RAY_OFFSET;
+                // kosinüs ağırlıklı örnekte pdf ve lambert 1/pi birbirini götürüyor
+                bounce += hitTriangle.albedo * DirectLight(hitPoint, hitTriangle.faceNormal, false, lights,
+                    settings.lightIntensity, bvh, sceneRadius, rays);
+            }
+            indirect[i] = bounce / static_cast<float>(settings.indirectSamples);
+        }
+        raysCast += rays;
+    });
+    auto traceEnd = std::chrono::high_resolution_clock::now();
+    bakeStats.traceMs = std::chrono::duration<double, std::milli>(traceEnd - traceStart).count();
+    bakeStats.raysCast = raysCast;
+    bakeStats.raysPerSecond = bakeStats.traceMs > 0.0 ? bakeStats.raysCast / (bakeStats.traceMs / 1000.0) : 0.0;
+    bakeStats.threads = JobSystem::GetInstance().GetWorkerCount() + 1;
+
+    // dolaylı ışık gürültülü: aynı yüzeydeki (normali ve konumu yakın) komşularla ortalanıyor,
+    // chartlar arasında en az 2 * CHART_PADDING boş texel olduğu için başka charta taşmıyor
+    std::vector<glm::vec3> filtered(indirect);
+    int radius = settings.denoiseRadius;
+    if (radius > 0 && settings.indirectSamples > 0) {
+        float maxDistance = 2.0f * (radius + 1) / layout.texelsPerUnit;
+        JobSystem::GetInstance().ParallelFor(samples.size(), 256, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const TexelSample& sample = samples[i];
+                int x = static_cast<int>(sample.texel % size);
+                int y = static_cast<int>(sample.texel / size);
+                glm::vec3 sum(0.0f);
+                float weight = 0.0f;
+                for (int dy = -radius; dy <= radius; ++dy) {
+                    for (int dx = -radius; dx <= radius; ++dx) {
+                        int nx = x + dx, ny = y + dy;
+                        if (nx < 0 || ny < 0 || nx >= size || ny >= size) {
+                            continue;
+                        }
+                        int32_t neighbor = texelSample[static_cast<size_t>(ny) * size + nx];
+                        if (neighbor < 0 || glm::dot(samples[neighbor].normal, sample.normal) < 0.9f ||
+                            glm::length(samples[neighbor].position - sample.position) > maxDistance) {
+                            continue;
+                        }
+                        sum += indirect[neighbor];
+                        weight += 1.0f;
+                    }
+                }
+                filtered[i] = sum / weight;
+            }
+        });
+    }
+
+    std::vector<glm::vec3> image(static_cast<size_t>(size) * size, glm::vec3(0.0f));
+    std::vector<unsigned char> filled(image.size(), 0);
+    for (size_t i = 0; i < samples.size(); ++i) {
+        image[samples[i].texel] = direct[i] + filtered[i];
+        filled[samples[i].texel] = 1;
+    }
+
+    // bilinear filtre chart dışını da okuyor, kenar texelleri boşluğa taşırılıyor
+    for (int iteration = 0; iteration < settings.dilateIterations; ++iteration) {
+        std::vector<glm::vec3> dilated(image);
+        std::vector<unsigned char> dilatedFilled(filled);
+        for (int y = 0; y < size; ++y) {
+            for (int x = 0; x < size; ++x) {
+                size_t texel = static_cast<size_t>(y) * size + x;
+                if (filled[texel]) {
+                    continue;
+                }
+                glm::vec3 sum(0.0f);
+                int count = 0;
+                for (int dy = -1; dy <= 1; ++dy) {
+                    for (int dx = -1; dx <= 1; ++dx) {
+                        int nx = x + dx, ny = y + dy;
+                        if (nx < 0 || ny < 0 || nx >= size || ny >= size) {
+                            continue;
+                        }
+                        size_t neighbor = static_cast<size_t>(ny) * size + nx;
+                        if (filled[neighbor]) {
+                            sum += image[neighbor];
+                            count++;
+                        }
+                    }
+                }
+                if (count > 0) {
+                    dilated[texel] = sum / static_cast<float>(count);
+                    dilatedFilled[texel] = 1;
+                }
+            }
+        }
+        image.swap(dilated);
+        filled.swap(dilatedFilled);
+    }
+
+    // RGB9_E5 (texel başına 4 byte, GPU doğrudan okuyor), byte düzlemleri PackBits ile
+    std::vector<uint32_t> texels(image.size());
+    for (size_t i = 0; i < image.size(); ++i) {
+        texels[i] = PackRGB9E5(image[i]);
+    }
+    compressedPlanes.assign(4, std::vector<unsigned char>());
+    std::vector<unsigned char> plane(texels.size());
+    for (int p = 0; p < 4; ++p) {
+        for (size_t i = 0; i < texels.size(); ++i) {
+            plane[i] = static_cast<unsigned char>(texels[i] >> (p * 8));
+        }
+        PotentiallyVisibleSet::Compress(plane, compressedPlanes[p]);
+    }
+
+    atlasSize = size;
+    texelsPerUnit = layout.texelsPerUnit;
+    chartCount = layout.charts;
+    layoutHash = layout.hash;
+    objectNames = layout.objectNames;
+    objectMeshCounts = layout.objectMeshCounts;
+    if (!CreateTexture()) {
+        Clear();
+        return false;
+    }
+
+    bakeStats.rawBytes = image.size() * sizeof(glm::vec3);
+    bakeStats.compressedBytes = GetCompressedBytes();
+    bakeStats.bakeMs = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - start).count();
+
+    std::cout << "Lightmap bake: " << bakeStats.charts << " chart, " << bakeStats.triangles << " ucgen, "
+        << bakeStats.texels << " texel (" << size << "x" << size << ", " << bakeStats.texelsPerUnit << " texel/m), "
+        << bakeStats.raysCast << " isin, " << bakeStats.raysPerSecond / 1.0e6 << " Misin/sn (" << bakeStats.threads
+        << " thread), " << bakeStats.rawBytes << " -> " << bakeStats.compressedBytes << " byte, "
+        << bakeStats.bakeMs << " ms" << std::endl;
+    return true;
+}
+
+bool Lightmap::Save(const std::string& path) const {
+    if (!IsLoaded()) {
+        std::cerr << "Lightmap kaydedilemedi: bake edilmemis" << std::endl;
+        return false;
+    }
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Lightmap dosyasi acilamadi: " << path << std::endl;
+        return false;
+    }
+
+    file.write(LIGHTMAP_MAGIC, sizeof(LIGHTMAP_MAGIC));
+    WriteValue(file, static_cast<int32_t>(atlasSize));
+    WriteValue(file, texelsPerUnit);
+    WriteValue(file, static_cast<uint32_t>(chartCount));
+    WriteValue(file, layoutHash);
+
+    uint32_t objectCount = static_cast<uint32_t>(objectNames.size());
+    WriteValue(file, objectCount);
+    for (uint32_t i = 0; i < objectCount; ++i) {
+        WriteString(file, objectNames[i]);
+        WriteValue(file, objectMeshCounts[i]);
+    }
+    for (const auto& plane : compressedPlanes) {
+        uint32_t planeSize = static_cast<uint32_t>(plane.size());
+        WriteValue(file, planeSize);
+        file.write(reinterpret_cast<const char*>(plane.data()), planeSize);
+    }
+
+    if (!file) {
+        std::cerr << "Lightmap dosyasi yazilamadi: " << path << std::endl;
+        return false;
+    }
+    std::cout << "Lightmap kaydedildi: " << path << std::endl;
+    return true;
+}
+
+bool Lightmap::Load(const std::string& path, const std::vector<std::shared_ptr<MuseumObject>>& objects) {
+    Clear();
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false; // bake edilmemiş sahne, hata değil
+    }
+
+    char magic[4];
+    if (!file.read(magic, sizeof(magic)) || !std::equal(magic, magic + 4, LIGHTMAP_MAGIC)) {
+        std::cerr << "Lightmap dosyasi gecersiz: " << path << std::endl;
+        return false;
+    }
+
+    int32_t size = 0;
+    uint32_t charts = 0;
+    uint32_t objectCount = 0;
+    bool ok = ReadValue(file, size) && ReadValue(file, texelsPerUnit) && ReadValue(file, charts) &&
+        ReadValue(file, layoutHash) && ReadValue(file, objectCount);
+    ok = ok && size >= 64 && size <= 4096 && texelsPerUnit > 0.0f && objectCount < 100000;
+    for (uint32_t i = 0; ok && i < objectCount; ++i) {
+        std::string name;
+        uint32_t meshCount = 0;
+        ok = ReadString(file, name) && ReadValue(file, meshCount);
+        objectNames.push_back(name);
+        objectMeshCounts.push_back(meshCount);
+    }
+
+    size_t texelCount = ok ? static_cast<size_t>(size) * size : 0;
+    compressedPlanes.assign(4, std::vector<unsigned char>());
+    for (auto& plane : compressedPlanes) {
+        uint32_t planeSize = 0;
+        ok = ok && ReadValue(file, planeSize) && planeSize <= texelCount;
+        if (ok) {
+            plane.resize(planeSize);
+            ok = planeSize == 0 || static_cast<bool>(file.read(reinterpret_cast<char*>(plane.data()), planeSize));
+        }
+    }
+    if (!ok) {
+        std::cerr << "Lightmap dosyasi bozuk: " << path << std::endl;
+        Clear();
+        return false;
+    }
+
+    // statik objeler bake edilenle aynı mı, aynıysa aynı yoğunlukla açılıyor
+    std::vector<std::string> staticNames;
+    std::vector<uint32_t> staticMeshCounts;
+    for (const auto& object : objects) {
+        if (object->IsStatic()) {
+            staticNames.push_back(object->GetName());
+            staticMeshCounts.push_back(static_cast<uint32_t>(object->GetMeshes().size()));
+        }
+    }
+    Layout layout;
+    if (staticNames != objectNames || staticMeshCounts != objectMeshCounts ||
+        !Unwrap(objects, size, texelsPerUnit, layout) || layout.charts != charts || layout.hash != layoutHash) {
+        std::cerr << "Lightmap sahneyle uyusmuyor, yeniden bake edilmeli: " << path << std::endl;
+        Clear();
+        return false;
+    }
+
+    atlasSize = size;
+    chartCount = charts;
+    if (!CreateTexture()) {
+        Clear();
+        return false;
+    }
+    std::cout << "Lightmap yuklendi: " << path << " (" << atlasSize << "x" << atlasSize << ", " << chartCount
+        << " chart, " << GetCompressedBytes() << " byte)" << std::endl;
+    return true;
+}
+
+bool Lightmap::CreateTexture() {
+    size_t texelCount = static_cast<size_t>(atlasSize) * atlasSize;
+    std::vector<uint32_t> texels(texelCount, 0);
+    std::vector<unsigned char> plane;
+    for (int p = 0; p < 4; ++p) {
+        if (!PotentiallyVisibleSet::Decompress(compressedPlanes[p], texelCount, plane)) {
+            std::cerr << "Lightmap acilamadi (bozuk veri)" << std::endl;
+            return false;
+        }
+        for (size_t i = 0; i < texelCount; ++i) {
+            texels[i] |= static_cast<uint32_t>(plane[i]) << (p * 8);
+        }
+    }
+
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB9_E5, atlasSize, atlasSize, 0, GL_RGB, GL_UNSIGNED_INT_5_9_9_9_REV, texels.data());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    if (glGetError() != GL_NO_ERROR) {
+        std::cerr << "Lightmap texture olusturulamadi" << std::endl;
+        glDeleteTextures(1, &texture);
+        texture = 0;
+        return false;
+    }
+    return true;
+}
+
+void Lightmap::Bind() const {
+    glActiveTexture(GL_TEXTURE0 + Shader::LIGHTMAP_UNIT);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glActiveTexture(GL_TEXTURE0);
+}
+
+size_t Lightmap::GetCompressedBytes() const {
+    size_t total = 0;
+    for (const auto& plane : compressedPlanes) {
+        total += plane.size();
+    }
+    return total;
+}
+
+// EXT_texture_shared_exponent: 9 bit mantis x 3, ortak 5 bit üs
+uint32_t Lightmap::PackRGB9E5(const glm::vec3& color) {
+    const int MANTISSA_BITS = 9;
+    const int EXPONENT_BIAS = 15;
+    const float MAX_VALUE = 65408.0f; // (511 / 512) * 2^16
+    glm::vec3 clamped = glm::clamp(color, glm::vec3(0.0f), glm::vec3(MAX_VALUE));
+    float maxComponent = std::max(std::max(clamped.r, clamped.g), clamped.b);
+    if (maxComponent <= 0.0f) {
+        return 0;
+    }
+
+    int exponent = std::max(-EXPONENT_BIAS - 1, static_cast<int>(std::floor(std::log2(maxComponent)))) + 1 + EXPONENT_BIAS;
+    float scale = std::exp2(static_cast<float>(exponent - EXPONENT_BIAS - MANTISSA_BITS));
+    if (static_cast<int>(std::floor(maxComponent / scale + 0.5f)) == (1 << MANTISSA_BITS)) {
+        exponent++;
+        scale *= 2.0f;
+    }
+    uint32_t r = std::min<uint32_t>(511, static_cast<uint32_t>(std::floor(clamped.r / scale + 0.5f)));
+    uint32_t g = std::min<uint32_t>(511, static_cast<uint32_t>(std::floor(clamped.g / scale + 0.5f)));
+    uint32_t b = std::min<uint32_t>(511, static_cast<uint32_t>(std::floor(clamped.b / scale + 0.5f)));
+    return r | (g << 9) | (b << 18) | (static_cast<uint32_t>(exponent) << 27);
+}
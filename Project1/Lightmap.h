@@ -0,0 +1,104 @@
+#pragma once
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include "MuseumObject.h"
+#include "Light.h"
+
+class TriangleBVH;
+
+// Statik kabuk (MakeStatic edilmiş bina) için önceden hesaplanmış dağınık aydınlatma
+// Açılım: her statik meshin üçgenleri baskın eksenlerine (±X/±Y/±Z) göre bağlı chartlara ayrılıyor,
+// chartlar dünya ölçeğinde düzleme izdüşürülüp tek atlasa raf (shelf) yöntemiyle diziliyor,
+// vertexler chart başına kopyalanıp ikinci UV kanalı havuzun lightmap akışına yazılıyor.
+// Açılım sadece üçgenlerin konumlarına bakıyor, aynı bina her açılışta aynı atlası veriyor.
+// Bake: atlasın her texeli için sahnenin ışıklarından doğrudan ışık (gölge ışınıyla) ve kosinüs ağırlıklı
+// örneklerle bir sekmelik dolaylı ışık statik üçgenlerin BVH'sinde izleniyor (JobSystem worker threadleri).
+// Dolaylı kısım chart içinde yumuşatılıyor, boş texeller chart kenarından doldurulup (dilate)
+// RGB9_E5 olarak PackBits ile sıkıştırılıp sahnenin yanına kaydediliyor.
+// Çalışırken lightmap'li fragmentler dağınık ışığı tek texture okumasıyla alıyor,
+// üstüne sadece ana ışığın yansıması (specular) hesaplanıyor
+class Lightmap {
+public:
+    struct BakeSettings {
+        int atlasSize = 1024;
+        float texelsPerUnit = 4.0f;  // atlasa sığmazsa küçültülüyor
+        int indirectSamples = 32;    // texel başına dolaylı ışın
+        float lightIntensity = 0.8f; // ışıklar mesafeye göre kısılıyor, bake en yüksek değerle (UpdateLightIntensities)
+        int denoiseRadius = 2;       // dolaylı ışık yumuşatma yarıçapı (texel), 0 = kapalı
+        int dilateIterations = 4;
+    };
+
+    struct BakeStats {
+        size_t charts = 0;
+        size_t triangles = 0;
+        size_t texels = 0;          // dolu texel
+        size_t raysCast = 0;        // gölge + dolaylı ışınlar
+        double raysPerSecond = 0.0;
+        double unwrapMs = 0.0;
+        double traceMs = 0.0;
+        double bakeMs = 0.0;        // toplam
+        size_t rawBytes = 0;        // RGB32F atlas
+        size_t compressedBytes = 0;
+        float texelsPerUnit = 0.0f; // kullanılan yoğunluk
+        size_t threads = 0;
+    };
+
+    Lightmap() = default;
+    ~Lightmap();
+    Lightmap(const Lightmap&) = delete;
+    Lightmap& operator=(const Lightmap&) = delete;
+
+    // statik objeleri açıp sahnenin ışıklarıyla bake ediyor, sonuç hemen kullanılıyor
+    bool Bake(const std::vector<std::shared_ptr<MuseumObject>>& objects, const std::vector<Light>& lights,
+        const BakeSettings& settings);
+    bool Save(const std::string& path) const;
+    // dosyadaki yoğunlukla statik objeleri yeniden açıyor, atlas düzeni tutmazsa yüklenmiyor
+    bool Load(const std::string& path, const std::vector<std::shared_ptr<MuseumObject>>& objects);
+    void Clear();
+
+    bool IsLoaded() const { return texture != 0; }
+    // Shader::LIGHTMAP_UNIT
+    void Bind() const;
+
+    int GetAtlasSize() const { return atlasSize; }
+    size_t GetChartCount() const { return chartCount; }
+    size_t GetCompressedBytes() const;
+    const BakeStats& GetBakeStats() const { return bakeStats; }
+
+    // sahnenin ışıklarından bir noktaya gelen dağınık ışık (gölge ışınıyla), brdf.glsl calculateLight'ın albedo'suz hali
+    // IrradianceVolume bake'i de aynı ışık modelini kullanıyor, rays atılan gölge ışını kadar artıyor
+    static glm::vec3 DirectLight(const glm::vec3& point, const glm::vec3& normal, bool includeAmbient,
+        const std::vector<Light>& lights, float intensity, const TriangleBVH& bvh, float sceneRadius, size_t& rays);
+
+private:
+    // atlas düzeni, dosyadaki değerlerle karşılaştırılıyor
+    struct Layout {
+        size_t charts = 0;
+        float texelsPerUnit = 0.0f; // sığdırmak için düşürülmüş olabilir
+        uint64_t hash = 0;
+        std::vector<std::string> objectNames; // açılan statik objeler
+        std::vector<uint32_t> objectMeshCounts;
+    };
+
+    static bool Unwrap(const std::vector<std::shared_ptr<MuseumObject>>& objects, int atlasSize,
+        float texelsPerUnit, Layout& layout);
+    static uint32_t PackRGB9E5(const glm::vec3& color);
+    bool CreateTexture();
+
+    int atlasSize = 0;
+    float texelsPerUnit = 0.0f;
+    size_t chartCount = 0;
+    uint64_t layoutHash = 0;
+    std::vector<std::string> objectNames;
+    std::vector<uint32_t> objectMeshCounts;
+    // RGB9_E5 texeller 4 byte düzlemine ayrılıp sıkıştırılıyor (üst byte'lar uzun tekrarlar)
+    std::vector<std::vector<unsigned char>> compressedPlanes;
+    GLuint texture = 0;
+
+    BakeStats bakeStats;
+};
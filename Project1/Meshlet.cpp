@@ -0,0 +1,195 @@
+#include "Meshlet.h"
+#include "GeometryPool.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace {
+    glm::vec3 GetPosition(const std::vector<float>& vertices, unsigned int index) {
+        const float* v = &vertices[static_cast<size_t>(index) * GeometryPool::VERTEX_FLOATS];
+        return glm::vec3(v[0], v[1], v[2]);
+    }
+
+    glm::vec3 GetNormal(const std::vector<float>& vertices, unsigned int index) {
+        const float* v = &vertices[static_cast<size_t>(index) * GeometryPool::VERTEX_FLOATS];
+        return glm::vec3(v[3], v[4], v[5]);
+    }
+
+    // sarım sırasından yüz normali, dejenere üçgende sıfır
+    glm::vec3 FaceNormal(const std::vector<float>& vertices, const unsigned int* tri) {
+        glm::vec3 a = GetPosition(vertices, tri[0]);
+        glm::vec3 n = glm::cross(GetPosition(vertices, tri[1]) - a, GetPosition(vertices, tri[2]) - a);
+        float length = glm::length(n);
+        return length > 1e-12f ? n / length : glm::vec3(0.0f);
+    }
+
+    void ComputeBounds(const std::vector<float>& vertices, const unsigned int* indices, Meshlet& meshlet) {
+        const unsigned int* begin = indices + meshlet.indexOffset;
+        const unsigned int* end = begin + meshlet.indexCount;
+
+        glm::vec3 boundsMin(FLT_MAX), boundsMax(-FLT_MAX);
+        for (const unsigned int* i = begin; i != end; ++i) {
+            glm::vec3 p = GetPosition(vertices, *i);
+            boundsMin = glm::min(boundsMin, p);
+            boundsMax = glm::max(boundsMax, p);
+        }
+        meshlet.center = (boundsMin + boundsMax) * 0.5f;
+        meshlet.radius = 0.0f;
+        for (const unsigned int* i = begin; i != end; ++i) {
+            meshlet.radius = std::max(meshlet.radius, glm::length(GetPosition(vertices, *i) - meshlet.center));
+        }
+
+        // normal konisi: ekseni yüz normallerinin ortalaması, açıyı en sapan normal belirliyor
+        glm::vec3 normalSum(0.0f);
+        glm::vec3 vertexNormalSum(0.0f);
+        for (const unsigned int* tri = begin; tri != end; tri += 3) {
+            normalSum += FaceNormal(vertices, tri);
+            vertexNormalSum += GetNormal(vertices, tri[0]) + GetNormal(vertices, tri[1]) + GetNormal(vertices, tri[2]);
+        }
+        meshlet.coneCutoff = 1.0f;
+        float sumLength = glm::length(normalSum);
+        if (sumLength < 1e-6f) {
+            return;
+        }
+        meshlet.coneAxis = normalSum / sumLength;
+
+        // sarım modeldeki normallerle ters ise (içi dışına çevrilmiş model) koni güvenilmez
+        if (glm::dot(meshlet.coneAxis, vertexNormalSum) <= 0.0f) {
+            return;
+        }
+
+        float minDot = 1.0f;
+        for (const unsigned int* tri = begin; tri != end; tri += 3) {
+            glm::vec3 n = FaceNormal(vertices, tri);
+            if (n != glm::vec3(0.0f)) {
+                minDot = std::min(minDot, glm::dot(meshlet.coneAxis, n));
+            }
+        }
+        // koni yarım küreye yaklaşıyorsa hiçbir zaman tamamen arkası dönük olmaz
+        if (minDot <= 0.1f) {
+            return;
+        }
+        meshlet.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+    }
+}
+
+std::vector<Meshlet> MeshletBuilder::Build(const std::vector<float>& vertices, std::vector<unsigned int>& indices) {
+    std::vector<Meshlet> meshlets;
+    size_t triangleCount = indices.size() / 3;
+    size_t vertexCount = vertices.size() / GeometryPool::VERTEX_FLOATS;
+    if (triangleCount < MIN_TRIANGLES || vertexCount == 0) {
+        return meshlets;
+    }
+
+    // vertex -> üçgen komşuluğu (CSR)
+    std::vector<uint32_t> adjacencyStart(vertexCount + 1, 0);
+    for (unsigned int index : indices) {
+        adjacencyStart[index + 1]++;
+    }
+    for (size_t v = 0; v < vertexCount; ++v) {
+        adjacencyStart[v + 1] += adjacencyStart[v];
+    }
+    std::vector<uint32_t> adjacency(indices.size());
+    std::vector<uint32_t> fill(adjacencyStart.begin(), adjacencyStart.end() - 1);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        for (int k = 0; k < 3; ++k) {
+            adjacency[fill[indices[t * 3 + k]]++] = static_cast<uint32_t>(t);
+        }
+    }
+
+    std::vector<glm::vec3> faceNormals(triangleCount);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        faceNormals[t] = FaceNormal(vertices, &indices[t * 3]);
+    }
+
+    std::vector<unsigned char> emitted(triangleCount, 0);
+    // vertex'in en son hangi kümeye eklendiği, küme içi vertex sayımı için
+    std::vector<uint32_t> vertexStamp(vertexCount, UINT32_MAX);
+    std::vector<unsigned int> reordered;
+    reordered.reserve(indices.size());
+
+    std::vector<uint32_t> meshletVertices;
+    meshletVertices.reserve(MAX_VERTICES);
+    size_t scan = 0;
+
+    while (true) {
+        while (scan < triangleCount && emitted[scan]) {
+            scan++;
+        }
+        if (scan == triangleCount) {
+            break;
+        }
+
+        uint32_t stamp = static_cast<uint32_t>(meshlets.size());
+        Meshlet meshlet;
+        meshlet.indexOffset = static_cast<uint32_t>(reordered.size());
+        meshletVertices.clear();
+        glm::vec3 normalSum(0.0f);
+
+        auto newVertexCount = [&](size_t t) {
+            int count = 0;
+            for (int k = 0; k < 3; ++k) {
+                count += vertexStamp[indices[t * 3 + k]] != stamp;
+            }
+            return count;
+        };
+
+        size_t triangle = scan;
+        size_t meshletTriangles = 0;
+        while (true) {
+            for (int k = 0; k < 3; ++k) {
+                unsigned int v = indices[triangle * 3 + k];
+                if (vertexStamp[v] != stamp) {
+                    vertexStamp[v] = stamp;
+                    meshletVertices.push_back(v);
+                }
+                reordered.push_back(v);
+            }
+            emitted[triangle] = 1;
+            meshletTriangles++;
+            normalSum += faceNormals[triangle];
+
+            if (meshletTriangles == MAX_TRIANGLES) {
+                break;
+            }
+
+            // kümedeki vertexlere komşu üçgenlerden en az yeni vertex getireni seç,
+            // eşitlikte normali kümeye en yakın olanı (koni dar kalsın)
+            size_t best = SIZE_MAX;
+            int bestNew = 4;
+            float bestDot = -2.0f;
+            for (uint32_t v : meshletVertices) {
+                for (uint32_t a = adjacencyStart[v]; a < adjacencyStart[v + 1]; ++a) {
+                    uint32_t candidate = adjacency[a];
+                    if (emitted[candidate]) {
+                        continue;
+                    }
+                    int added = newVertexCount(candidate);
+                    if (meshletVertices.size() + added > MAX_VERTICES || added > bestNew) {
+                        continue;
+                    }
+                    float dot = glm::dot(normalSum, faceNormals[candidate]);
+                    if (added < bestNew || dot > bestDot) {
+                        best = candidate;
+                        bestNew = added;
+                        bestDot = dot;
+                    }
+                }
+            }
+            // komşu kalmadıysa küme kapanıyor, uzak bir üçgen eklemek küreyi şişirir
+            if (best == SIZE_MAX) {
+                break;
+            }
+            triangle = best;
+        }
+
+        meshlet.indexCount = static_cast<uint32_t>(reordered.size()) - meshlet.indexOffset;
+        meshlets.push_back(meshlet);
+    }
+
+    indices.swap(reordered);
+    for (Meshlet& meshlet : meshlets) {
+        ComputeBounds(vertices, indices.data(), meshlet);
+    }
+    return meshlets;
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "Frustum.h"
+
+// Büyük meshler yükleme sırasında küçük kümelere (meshlet) bölünüyor:
+// en fazla 64 vertex / 124 üçgen, her birinin bounding sphere'i ve normal konisi var
+// kümeler index bufferında ardışık, yani her küme meshin index aralığının bir alt aralığı.
+// Her frame görüş alanı dışında kalan ve kameraya tamamen arkasını dönen kümeler çizilmiyor
+struct Meshlet {
+    uint32_t indexOffset = 0; // meshin index dizisi içinde
+    uint32_t indexCount = 0;
+    glm::vec3 center = glm::vec3(0.0f); // model uzayında
+    float radius = 0.0f;
+    glm::vec3 coneAxis = glm::vec3(0.0f, 0.0f, 1.0f);
+    float coneCutoff = 1.0f; // sin(koni açısı), 1 ise koni testi yapılmıyor
+};
+
+struct ClusterCullStats {
+    size_t clustersTested = 0;
+    size_t culledByFrustum = 0;
+    size_t culledByCone = 0;
+    size_t trianglesTotal = 0;
+    size_t trianglesSubmitted = 0;
+};
+
+// bir meshin o frame'deki görünür kümeleri, ardışık görünür kümeler tek aralıkta birleşiyor
+// glMultiDrawElementsBaseVertex'e doğrudan verilebilecek düzende
+struct ClusterDrawList {
+    bool active = false; // false ise mesh bütün olarak çiziliyor
+    std::vector<unsigned char> state; // küme başına: 0 frustum dışı, 1 görünür, 2 arkası dönük
+    std::vector<GLsizei> counts;
+    std::vector<const void*> offsets; // byte cinsinden, havuzun index bufferında
+    std::vector<GLint> baseVertices;
+    ClusterCullStats stats;
+};
+
+class MeshletBuilder {
+public:
+    static constexpr size_t MAX_VERTICES = 64;
+    static constexpr size_t MAX_TRIANGLES = 124;
+    // daha küçük meshlerde küme testi çizimden pahalı
+    static constexpr size_t MIN_TRIANGLES = 512;
+
+    // indices yerinde yeniden sıralanıyor (kümeler ardışık olsun diye), vertexler değişmiyor
+    // vertices GeometryPool::VERTEX_FLOATS düzeninde
+    static std::vector<Meshlet> Build(const std::vector<float>& vertices, std::vector<unsigned int>& indices);
+};
+
+// kümeyi dünya uzayında test etmek için objeden bir kere hesaplanan değerler
+struct ClusterCullContext {
+    const Frustum* frustum = nullptr;
+    glm::vec3 cameraPosition = glm::vec3(0.0f);
+    glm::mat4 model = glm::mat4(1.0f);
+    float maxScale = 1.0f;
+    bool coneTest = true; // ölçek eşit değilse (veya kapalıysa) koni testi yapılmıyor
+
+    // 0: frustum dışı, 1: görünür, 2: arkası dönük
+    unsigned char Classify(const Meshlet& meshlet) const {
+        glm::vec3 center = glm::vec3(model * glm::vec4(meshlet.center, 1.0f));
+        float radius = meshlet.radius * maxScale;
+        if (!frustum->IsSphereVisible(center, radius)) {
+            return 0;
+        }
+        if (coneTest && meshlet.coneCutoff < 1.0f) {
+            glm::vec3 axis = glm::normalize(glm::mat3(model) * meshlet.coneAxis);
+            glm::vec3 toCluster = center - cameraPosition;
+            if (glm::dot(toCluster, axis) >= meshlet.coneCutoff * glm::length(toCluster) + radius) {
+                return 2;
+            }
+        }
+        return 1;
+    }
+};
@@ -1,10 +1,14 @@
 #include "MuseumObject.h"
+#include "SoftwareOcclusion.h"
 #include <iostream>
 #include <glm/gtc/matrix_transform.hpp>
 #include <string>
 #include <fstream>
 #include <unordered_map>
 #include <map>
+#include <tuple>
+#include <sstream>
+#include <algorithm>
 
 MuseumObject::MuseumObject(const std::string& name, const std::string& description,
     const std::string& modelPath, const std::string& texturePath,
@@ -24,9 +28,7 @@ MuseumObject::~MuseumObject() {
 
 void MuseumObject::cleanup() {
     for (auto& mesh : meshes) {
-        glDeleteVertexArrays(1, &mesh.VAO);
-        glDeleteBuffers(1, &mesh.VBO);
-        glDeleteBuffers(1, &mesh.EBO);
+        GeometryPool::GetInstance().Free(mesh.geometry);
     }
     meshes.clear();
 }
@@ -152,6 +154,7 @@ bool MuseumObject::loadModel(const std::string& path) {
         mesh.name = "mesh_" + std::to_string(meshes.size());
         mesh.vertices = modelMesh.vertices;
         mesh.indices = modelMesh.indices;
+        mesh.occlusion = modelMesh.occlusion;
 
         // material bilgilerini aktar
         if (!modelMesh.materialName.empty()) {
@@ -184,65 +187,422 @@ bool MuseumObject::loadModel(const std::string& path) {
 }
 
 void MuseumObject::setupMesh(Mesh& mesh) {
-    glGenVertexArrays(1, &mesh.VAO);
-    glGenBuffers(1, &mesh.VBO);
-    glGenBuffers(1, &mesh.EBO);
+    // büyük meshler kümelere bölünüyor, index sırası değiştiği için havuza yüklemeden önce
+    mesh.meshlets = MeshletBuilder::Build(mesh.vertices, mesh.indices);
 
-    glBindVertexArray(mesh.VAO);
+    // her mesh için ayrı VAO/VBO/EBO yerine ortak havuzdan yer alıyoruz
+    if (!GeometryPool::GetInstance().Allocate(mesh.vertices, mesh.indices, mesh.geometry,
+        mesh.lightmapUVs.empty() ? nullptr : &mesh.lightmapUVs, mesh.occlusion.empty() ? nullptr : &mesh.occlusion)) {
+        std::cerr << "Mesh geometri havuzuna yuklenemedi: " << name << "/" << mesh.name << std::endl;
+    }
 
-    glBindBuffer(GL_ARRAY_BUFFER, mesh.VBO);
-    glBufferData(GL_ARRAY_BUFFER, mesh.vertices.size() * sizeof(float), 
-        mesh.vertices.data(), GL_STATIC_DRAW);
+    // mesh bazında culling için sınırlar
+    mesh.boundsMin = glm::vec3(FLT_MAX);
+    mesh.boundsMax = glm::vec3(-FLT_MAX);
+    for (size_t i = 0; i + 2 < mesh.vertices.size(); i += GeometryPool::VERTEX_FLOATS) {
+        glm::vec3 vertex(mesh.vertices[i], mesh.vertices[i + 1], mesh.vertices[i + 2]);
+        mesh.boundsMin = glm::min(mesh.boundsMin, vertex);
+        mesh.boundsMax = glm::max(mesh.boundsMax, vertex);
+    }
+    if (mesh.vertices.empty()) {
+        mesh.boundsMin = mesh.boundsMax = glm::vec3(0.0f);
+    }
+}
 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, mesh.indices.size() * sizeof(unsigned int), 
-        mesh.indices.data(), GL_STATIC_DRAW);
+namespace {
+    // aynı anahtarı veren materyaller tek çizimde birleştirilebilir
+    std::string MaterialKey(const MuseumObject::Material& material) {
+        std::ostringstream key;
+        key << material.diffuseMap << '|' << material.normalMap << '|'
+            << material.roughnessMap << '|' << material.metallicMap << '|'
+            << material.ambient.x << ',' << material.ambient.y << ',' << material.ambient.z << '|'
+            << material.diffuse.x << ',' << material.diffuse.y << ',' << material.diffuse.z << '|'
+            << material.specular.x << ',' << material.specular.y << ',' << material.specular.z << '|'
+            << material.shininess << '|' << material.opacity << '|' << material.brightness << '|'
+            << material.useVertexColors;
+        return key.str();
+    }
+}
 
-    const int stride = 14 * sizeof(float);
-    
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
-    glEnableVertexAttribArray(0);
-    
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-    
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, (void*)(6 * sizeof(float)));
-    glEnableVertexAttribArray(2);
-    
-    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, stride, (void*)(8 * sizeof(float)));
-    glEnableVertexAttribArray(3);
-    
-    glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, stride, (void*)(11 * sizeof(float)));
-    glEnableVertexAttribArray(4);
+void MuseumObject::MakeStatic(float chunkSize) {
+    if (isStatic || meshes.empty() || chunkSize <= 0.0f) {
+        return;
+    }
+
+    glm::mat4 model = GetModelMatrix();
+    glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(model)));
+    const int stride = GeometryPool::VERTEX_FLOATS;
+
+    typedef std::tuple<std::string, int, int> BatchKey; // materyal + chunk hücresi (XZ)
+    std::map<BatchKey, size_t> batchLookup;
+    std::vector<Mesh> batches;
+    size_t sourceMeshCount = meshes.size();
+
+    // vertexleri bir kere dünya uzayına taşı
+    std::vector<std::vector<float>> worldMeshes;
+    glm::vec3 worldMin(FLT_MAX);
+    for (const auto& mesh : meshes) {
+        size_t vertexCount = mesh.vertices.size() / stride;
+        std::vector<float> worldVertices(mesh.vertices);
+        for (size_t v = 0; v < vertexCount; ++v) {
+            float* vertex = &worldVertices[v * stride];
+            glm::vec3 position = glm::vec3(model * glm::vec4(vertex[0], vertex[1], vertex[2], 1.0f));
+            glm::vec3 normal = normalMatrix * glm::vec3(vertex[3], vertex[4], vertex[5]);
+            glm::vec3 tangent = glm::mat3(model) * glm::vec3(vertex[8], vertex[9], vertex[10]);
+            glm::vec3 bitangent = glm::mat3(model) * glm::vec3(vertex[11], vertex[12], vertex[13]);
+            if (glm::length(normal) > 0.0f) normal = glm::normalize(normal);
+            if (glm::length(tangent) > 0.0f) tangent = glm::normalize(tangent);
+            if (glm::length(bitangent) > 0.0f) bitangent = glm::normalize(bitangent);
+
+            vertex[0] = position.x; vertex[1] = position.y; vertex[2] = position.z;
+            vertex[3] = normal.x; vertex[4] = normal.y; vertex[5] = normal.z;
+            vertex[8] = tangent.x; vertex[9] = tangent.y; vertex[10] = tangent.z;
+            vertex[11] = bitangent.x; vertex[12] = bitangent.y; vertex[13] = bitangent.z;
+            worldMin = glm::min(worldMin, position);
+        }
+        worldMeshes.push_back(std::move(worldVertices));
+    }
+
+    // hücreler binanın köşesinden başlıyor, dikeyde bölmeye gerek yok (tek katlı)
+    for (size_t m = 0; m < meshes.size(); ++m) {
+        const Mesh& mesh = meshes[m];
+        const std::vector<float>& worldVertices = worldMeshes[m];
+
+        std::string materialKey = MaterialKey(mesh.material);
+        // bu meshin vertexlerinin hangi batchte hangi indexe gittiği
+        std::unordered_map<unsigned long long, unsigned int> remap;
+
+        for (size_t t = 0; t + 2 < mesh.indices.size(); t += 3) {
+            glm::vec3 centroid(0.0f);
+            for (int k = 0; k < 3; ++k) {
+                const float* vertex = &worldVertices[mesh.indices[t + k] * stride];
+                centroid += glm::vec3(vertex[0], vertex[1], vertex[2]);
+            }
+            centroid /= 3.0f;
+
+            // üçgen ağırlık merkezine göre hücre seçiliyor
+            BatchKey key(materialKey,
+                static_cast<int>(std::floor((centroid.x - worldMin.x) / chunkSize)),
+                static_cast<int>(std::floor((centroid.z - worldMin.z) / chunkSize)));
+
+            auto found = batchLookup.find(key);
+            size_t batchIndex;
+            if (found == batchLookup.end()) {
+                batchIndex = batches.size();
+                batchLookup[key] = batchIndex;
+                Mesh batch;
+                batch.name = "batch_" + std::to_string(batchIndex);
+                batch.material = mesh.material;
+                batches.push_back(std::move(batch));
+            }
+            else {
+                batchIndex = found->second;
+            }
+            Mesh& batch = batches[batchIndex];
+
+            for (int k = 0; k < 3; ++k) {
+                unsigned int sourceIndex = mesh.indices[t + k];
+                unsigned long long remapKey = (static_cast<unsigned long long>(batchIndex) << 32) | sourceIndex;
+                auto existing = remap.find(remapKey);
+                if (existing != remap.end()) {
+                    batch.indices.push_back(existing->second);
+                    continue;
+                }
+
+                unsigned int newIndex = static_cast<unsigned int>(batch.vertices.size() / stride);
+                const float* vertex = &worldVertices[sourceIndex * stride];
+                batch.vertices.insert(batch.vertices.end(), vertex, vertex + stride);
+                // AO'su olmayan meshler batchte açık sayılıyor
+                batch.occlusion.push_back(mesh.occlusion.empty() ? 255 : mesh.occlusion[sourceIndex]);
+                batch.indices.push_back(newIndex);
+                remap[remapKey] = newIndex;
+            }
+        }
+    }
 
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    // orijinal meshleri bırak, yerlerine batchleri yükle
+    cleanup();
+    meshes = std::move(batches);
+    for (auto& mesh : meshes) {
+        setupMesh(mesh);
+    }
+
+    // transform artık vertexlerde
+    position = glm::vec3(0.0f);
+    rotation = glm::vec3(0.0f);
+    scale = glm::vec3(1.0f);
+    UpdateBoundingBox();
+    meshVisible.clear();
+    meshPlaneHint.clear();
+    isStatic = true;
+
+    // vertexler zaten dünya uzayında, occluder listesi bir kere çıkarılıyor
+    occluderTriangles = SoftwareOcclusion::BuildOccluderTriangles(meshes);
+
+    std::cout << "Statik batch (" << name << "): " << sourceMeshCount << " mesh -> "
+        << meshes.size() << " batch, " << occluderTriangles.size() / 3 << " occluder ucgen" << std::endl;
+}
+
+void MuseumObject::SetLightmapGeometry(size_t meshIndex, std::vector<float>&& vertices,
+    std::vector<unsigned int>&& indices, std::vector<float>&& lightmapUVs, std::vector<unsigned char>&& occlusion) {
+    Mesh& mesh = meshes[meshIndex];
+    GeometryPool::GetInstance().Free(mesh.geometry);
+    mesh.vertices = std::move(vertices);
+    mesh.indices = std::move(indices);
+    mesh.lightmapUVs = std::move(lightmapUVs);
+    mesh.occlusion = std::move(occlusion);
+    setupMesh(mesh);
+}
+
+void MuseumObject::GetMeshWorldBoundingSphere(size_t meshIndex, glm::vec3& center, float& radius) const {
+    const Mesh& mesh = meshes[meshIndex];
+    glm::mat4 model = GetModelMatrix();
+    center = glm::vec3(model * glm::vec4((mesh.boundsMin + mesh.boundsMax) * 0.5f, 1.0f));
+    float maxScale = std::max(std::max(scale.x, scale.y), scale.z);
+    radius = glm::length(mesh.boundsMax - mesh.boundsMin) * 0.5f * maxScale;
+}
+
+void MuseumObject::CullMeshes(const Frustum* frustum, FrustumCullStats* stats) {
+    if (frustum == nullptr) {
+        meshVisible.clear();
+        return;
+    }
+
+    meshVisible.assign(meshes.size(), 1);
+    meshPlaneHint.resize(meshes.size(), 0);
+
+    const glm::mat4& model = GetModelMatrix();
+    glm::vec3 modelCenter = glm::vec3(model[3]);
+    glm::mat3 linear = glm::mat3(model);
+    float maxScale = std::max(std::max(std::abs(scale.x), std::abs(scale.y)), std::abs(scale.z));
+    bool hasRotation = rotation != glm::vec3(0.0f);
+
+    for (size_t i = 0; i < meshes.size(); ++i) {
+        const Mesh& mesh = meshes[i];
+        glm::vec3 localCenter = (mesh.boundsMin + mesh.boundsMax) * 0.5f;
+        glm::vec3 localHalf = (mesh.boundsMax - mesh.boundsMin) * 0.5f;
+        glm::vec3 center = modelCenter + linear * localCenter;
+
+        int planeHint = meshPlaneHint[i];
+        int previousHint = planeHint;
+        bool visible = true;
+
+        Frustum::Visibility sphere = frustum->ClassifySphere(center, glm::length(localHalf) * maxScale, planeHint);
+        if (sphere == Frustum::Visibility::Outside) {
+            visible = false;
+            if (stats) stats->meshesCulledBySphere++;
+        }
+        else if (sphere == Frustum::Visibility::Intersect) {
+            // küre sınırda, sıkı kutu testi
+            if (hasRotation) {
+                glm::vec3 halfAxes[3] = {
+                    linear[0] * localHalf.x,
+                    linear[1] * localHalf.y,
+                    linear[2] * localHalf.z
+                };
+                visible = frustum->IsOBBVisible(center, halfAxes, planeHint);
+            }
+            else {
+                glm::vec3 worldHalf = glm::abs(scale) * localHalf;
+                visible = frustum->IsAABBVisible(center - worldHalf, center + worldHalf, planeHint);
+            }
+            if (!visible && stats) stats->meshesCulledByBox++;
+        }
+
+        if (!visible && stats && planeHint == previousHint) {
+            stats->coherenceHits++;
+        }
+        meshPlaneHint[i] = static_cast<unsigned char>(planeHint);
+        meshVisible[i] = visible ? 1 : 0;
+    }
+
+    if (stats) {
+        stats->meshesTested += meshes.size();
+    }
+}
+
+void MuseumObject::BeginClusterCulling(const Frustum* frustum, const glm::vec3& cameraPosition, bool coneCulling) {
+    clusterDraws.resize(meshes.size());
+    for (size_t i = 0; i < meshes.size(); ++i) {
+        ClusterDrawList& list = clusterDraws[i];
+        list.active = frustum != nullptr && !meshes[i].meshlets.empty() && IsMeshVisible(i);
+        if (list.active) {
+            list.state.resize(meshes[i].meshlets.size());
+        }
+    }
+    if (!frustum) {
+        return;
+    }
+
+    // worker threadler model matrisine dokunmasın (önbellek thread-safe değil)
+    const glm::mat4& model = GetModelMatrix();
+    float scaleX = glm::length(glm::vec3(model[0]));
+    float scaleY = glm::length(glm::vec3(model[1]));
+    float scaleZ = glm::length(glm::vec3(model[2]));
+    float maxScale = std::max(std::max(scaleX, scaleY), scaleZ);
+    float minScale = std::min(std::min(scaleX, scaleY), scaleZ);
+
+    clusterContext.frustum = frustum;
+    clusterContext.cameraPosition = cameraPosition;
+    clusterContext.model = model;
+    clusterContext.maxScale = maxScale;
+    // eşit olmayan ölçekte koni açısı bozuluyor
+    clusterContext.coneTest = coneCulling && maxScale - minScale <= maxScale * 1e-3f;
+}
+
+void MuseumObject::CullClusters(size_t meshIndex, size_t firstMeshlet, size_t lastMeshlet) {
+    const std::vector<Meshlet>& meshlets = meshes[meshIndex].meshlets;
+    ClusterDrawList& list = clusterDraws[meshIndex];
+    for (size_t i = firstMeshlet; i < lastMeshlet; ++i) {
+        list.state[i] = clusterContext.Classify(meshlets[i]);
+    }
+}
+
+void MuseumObject::FinishClusterCulling(size_t meshIndex) {
+    const Mesh& mesh = meshes[meshIndex];
+    ClusterDrawList& list = clusterDraws[meshIndex];
+    list.counts.clear();
+    list.offsets.clear();
+    list.stats = ClusterCullStats();
+    list.stats.clustersTested = mesh.meshlets.size();
+    list.stats.trianglesTotal = mesh.geometry.indexCount / 3;
+
+    // kümeler index bufferında ardışık, arka arkaya görünenler tek aralık oluyor
+    bool previousVisible = false;
+    for (size_t i = 0; i < mesh.meshlets.size(); ++i) {
+        const Meshlet& meshlet = mesh.meshlets[i];
+        unsigned char state = list.state[i];
+        if (state == 0) list.stats.culledByFrustum++;
+        if (state == 2) list.stats.culledByCone++;
+        if (state != 1) {
+            previousVisible = false;
+            continue;
+        }
+
+        list.stats.trianglesSubmitted += meshlet.indexCount / 3;
+        if (previousVisible) {
+            list.counts.back() += static_cast<GLsizei>(meshlet.indexCount);
+        }
+        else {
+            list.counts.push_back(static_cast<GLsizei>(meshlet.indexCount));
+            list.offsets.push_back((const void*)((mesh.geometry.indexOffset + meshlet.indexOffset) * sizeof(GLuint)));
+        }
+        previousVisible = true;
+    }
+    list.baseVertices.assign(list.counts.size(), static_cast<GLint>(mesh.geometry.vertexOffset));
+}
+
+size_t MuseumObject::GetVisibleMeshCount() const {
+    if (meshVisible.empty()) {
+        return meshes.size();
+    }
+    size_t count = 0;
+    for (unsigned char visible : meshVisible) {
+        count += visible;
+    }
+    return count;
+}
+
+void MuseumObject::DrawDepth(Shader& depthShader) {
+    depthShader.setMat4("model", GetModelMatrix());
+
+    GeometryPool& geometryPool = GeometryPool::GetInstance();
+    geometryPool.BindPositionOnly();
+    for (size_t meshIndex = 0; meshIndex < meshes.size(); ++meshIndex) {
+        if (!IsMeshVisible(meshIndex)) {
+            continue;
+        }
+        const ClusterDrawList* clusters = GetClusterDrawList(meshIndex);
+        if (clusters) {
+            if (!clusters->counts.empty()) {
+                glMultiDrawElementsBaseVertex(GL_TRIANGLES, clusters->counts.data(), GL_UNSIGNED_INT,
+                    clusters->offsets.data(), static_cast<GLsizei>(clusters->counts.size()),
+                    clusters->baseVertices.data());
+            }
+        }
+        else {
+            geometryPool.Draw(meshes[meshIndex].geometry);
+        }
+    }
+    geometryPool.Unbind();
+}
+
+void MuseumObject::DrawShadowCaster(Shader& depthShader, const Frustum& lightFrustum) {
+    depthShader.setMat4("model", GetModelMatrix());
+
+    GeometryPool& geometryPool = GeometryPool::GetInstance();
+    geometryPool.BindPositionOnly();
+    for (size_t meshIndex = 0; meshIndex < meshes.size(); ++meshIndex) {
+        glm::vec3 boundsMin, boundsMax;
+        GetMeshWorldBounds(meshIndex, boundsMin, boundsMax);
+        if (lightFrustum.IsAABBVisible(boundsMin, boundsMax)) {
+            geometryPool.Draw(meshes[meshIndex].geometry);
+        }
+    }
+    geometryPool.Unbind();
 }
 
 void MuseumObject::Draw(const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix,
     const glm::vec3& lightPos, const glm::vec3& viewPos) {
+    DrawWithShader(shader, viewMatrix, projectionMatrix, lightPos, viewPos);
+}
+
+void MuseumObject::DrawGBuffer(const Shader& gbufferShader, const glm::mat4& viewMatrix,
+    const glm::mat4& projectionMatrix, const glm::vec3& viewPos) {
+    DrawWithShader(gbufferShader, viewMatrix, projectionMatrix, glm::vec3(0.0f), viewPos);
+}
+
+void MuseumObject::DrawShadingLevels(const Shader* const* levelShaders, size_t levelCount,
+    const std::vector<unsigned char>& meshLevels, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix,
+    const glm::vec3& lightPos, const glm::vec3& viewPos) {
+    for (size_t level = 0; level < levelCount; ++level) {
+        // boş seviyede shader değiştirilmesin
+        if (std::find(meshLevels.begin(), meshLevels.end(), static_cast<unsigned char>(level)) == meshLevels.end()) {
+            continue;
+        }
+        DrawWithShader(*levelShaders[level], viewMatrix, projectionMatrix, lightPos, viewPos, &meshLevels,
+            static_cast<unsigned char>(level));
+    }
+}
+
+void MuseumObject::DrawCubemap(const Shader& layeredShader, const glm::vec3& lightPos, const glm::vec3& capturePos) {
+    DrawWithShader(layeredShader, glm::mat4(1.0f), glm::mat4(1.0f), lightPos, capturePos);
+}
+
+void MuseumObject::DrawWithShader(const Shader& targetShader, const glm::mat4& viewMatrix,
+    const glm::mat4& projectionMatrix, const glm::vec3& lightPos, const glm::vec3& viewPos,
+    const std::vector<unsigned char>* meshLevels, unsigned char level) {
     
-    shader.use();
+    targetShader.use();
 
-    glm::mat4 model = glm::mat4(1.0f);
-    model = glm::translate(model, position);
-    model = glm::rotate(model, glm::radians(rotation.x), glm::vec3(1.0f, 0.0f, 0.0f));
-    model = glm::rotate(model, glm::radians(rotation.y), glm::vec3(0.0f, 1.0f, 0.0f));
-    model = glm::rotate(model, glm::radians(rotation.z), glm::vec3(0.0f, 0.0f, 1.0f));
-    model = glm::scale(model, scale);
+    glm::mat4 model = GetModelMatrix();
 
-    shader.setMat4("model", model);
-    shader.setMat4("view", viewMatrix);
-    shader.setMat4("projection", projectionMatrix);
-    shader.setVec3("viewPos", viewPos);
-    shader.setVec3("lightPos", lightPos);
+    targetShader.setMat4("model", model);
+    // indirect yol ile aynı sonucu vermesi için normal matrisi de gönderiyoruz
+    targetShader.setMat3("normalMatrix", glm::transpose(glm::inverse(glm::mat3(model))));
+    targetShader.setMat4("view", viewMatrix);
+    targetShader.setMat4("projection", projectionMatrix);
+    targetShader.setVec3("viewPos", viewPos);
+    targetShader.setVec3("lightPos", lightPos);
 
-    for (auto& mesh : meshes) {
-        shader.setVec3("material.ambient", mesh.material.ambient);
-        shader.setVec3("material.diffuse", mesh.material.diffuse);
-        shader.setVec3("material.specular", mesh.material.specular);
-        shader.setFloat("material.shininess", mesh.material.shininess);
-        shader.setFloat("material.brightness", mesh.material.brightness);
+    // tüm meshler aynı VAO'yu kullanıyor, döngü dışında bir kere bind ediyoruz
+    GeometryPool& geometryPool = GeometryPool::GetInstance();
+    geometryPool.Bind();
+
+    for (size_t meshIndex = 0; meshIndex < meshes.size(); ++meshIndex) {
+        if (!IsMeshVisible(meshIndex) || (meshLevels && (*meshLevels)[meshIndex] != level)) {
+            continue;
+        }
+        const ClusterDrawList* clusters = GetClusterDrawList(meshIndex);
+        if (clusters && clusters->counts.empty()) {
+            continue; // tüm kümeler elendi
+        }
+        const Mesh& mesh = meshes[meshIndex];
+        targetShader.setVec3("material.ambient", mesh.material.ambient);
+        targetShader.setVec3("material.diffuse", mesh.material.diffuse);
+        targetShader.setVec3("material.specular", mesh.material.specular);
+        targetShader.setFloat("material.shininess", mesh.material.shininess);
+        targetShader.setFloat("material.brightness", mesh.material.brightness);
 
         if (!mesh.material.diffuseMap.empty()) {
             if (mesh.material.diffuseMap != lastBoundTexture) {
@@ -256,23 +616,31 @@ void MuseumObject::Draw(const glm::mat4& viewMatrix, const glm::mat4& projection
                     glActiveTexture(GL_TEXTURE0);
                     texture->Bind(0);
                     lastBoundTexture = mesh.material.diffuseMap;
-                    shader.setInt("material.diffuseMap", 0);
-                    shader.setBool("material.hasDiffuseMap", true);
+                    targetShader.setInt("material.diffuseMap", 0);
+                    targetShader.setBool("material.hasDiffuseMap", true);
                 }
             }
         } else {
             if (!lastBoundTexture.empty()) {
                 glActiveTexture(GL_TEXTURE0);
                 glBindTexture(GL_TEXTURE_2D, 0);
-                shader.setBool("material.hasDiffuseMap", false);
                 lastBoundTexture.clear();
             }
+            // G-buffer shader'ı objeler arasında paylaşılıyor, önceki objenin değeri kalmasın
+            targetShader.setBool("material.hasDiffuseMap", false);
         }
 
-        glBindVertexArray(mesh.VAO);
-        glDrawElements(GL_TRIANGLES, mesh.indices.size(), GL_UNSIGNED_INT, 0);
-        glBindVertexArray(0);
+        if (clusters) {
+            // sadece görünür küme aralıkları
+            glMultiDrawElementsBaseVertex(GL_TRIANGLES, clusters->counts.data(), GL_UNSIGNED_INT,
+                clusters->offsets.data(), static_cast<GLsizei>(clusters->counts.size()),
+                clusters->baseVertices.data());
+        }
+        else {
+            geometryPool.Draw(mesh.geometry);
+        }
     }
+    geometryPool.Unbind();
 
     if (!lastBoundTexture.empty()) {
         glActiveTexture(GL_TEXTURE0);
@@ -16,6 +16,8 @@
 #include "Frustum.h"
 #include "ResourceManager.h"
 #include "MuseumArtifact.h"
+#include "GeometryPool.h"
+#include "Meshlet.h"
 
 
 //bu classı abstract olarak tasarlamıaştım başlangıçta ancak sonrasında her obje için tekrar tekrar fonksiyonları doldurmak 
@@ -66,7 +68,12 @@ public:
 		std::vector<float> vertices;
 		std::vector<unsigned int> indices;
 		Material material;
-		unsigned int VAO, VBO, EBO;
+		GeometryRange geometry; // ortak geometri havuzundaki yeri
+		glm::vec3 boundsMin = glm::vec3(0.0f); // model uzayında, setupMesh'te hesaplanıyor
+		glm::vec3 boundsMax = glm::vec3(0.0f);
+		std::vector<Meshlet> meshlets; // büyük meshlerde doluyor, indices bunlara göre sıralı
+		std::vector<float> lightmapUVs; // vertex başına 2 float (atlas 0-1), boşsa lightmap yok
+		std::vector<unsigned char> occlusion; // vertex başına AO (modelden), boşsa tamamen açık
 	};
 
 	// Bounding box için yapı performasn optimizasyonuiçin ekledim
@@ -85,6 +92,24 @@ public:
 
 	virtual void Draw(const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix,
 		const glm::vec3& lightPos, const glm::vec3& viewPos);
+	// derinlik ön geçişi: Draw ile aynı meshler/kümeler, konum akışıyla ve verilen shader ile
+	// (shader bağlı, view/projection ayarlı olmalı, model burada yazılıyor)
+	void DrawDepth(Shader& depthShader);
+	// gölge haritası: kameranın culling'i yerine ışığın frustum'u, kutusu içine giren tüm meshler konum akışıyla
+	// Robot gövdesini ve kolunu kendi matrisleriyle çiziyor
+	virtual void DrawShadowCaster(Shader& depthShader, const Frustum& lightFrustum);
+	// deferred yolun G-buffer geçişi: Draw ile aynı meshler ve materyal uniformları,
+	// objenin shader'ı yerine paylaşılan GBUFFER varyantıyla
+	void DrawGBuffer(const Shader& gbufferShader, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix,
+		const glm::vec3& viewPos);
+	// shading LOD: meshLevels[i] meshin seviyesi, her seviye levelShaders'taki kendi varyantıyla ayrı geçişte
+	// (ShadingLod::Draw, levelShaders[0] genelde objenin kendi shader'ı)
+	void DrawShadingLevels(const Shader* const* levelShaders, size_t levelCount,
+		const std::vector<unsigned char>& meshLevels, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix,
+		const glm::vec3& lightPos, const glm::vec3& viewPos);
+	// küp harita yakalama (CubemapCapture): Draw ile aynı meshler, view/projection yerine yüz matrisleri
+	// katmanlı shader'ın geometry aşamasında. Küme listeleri kameranın olduğu için kapalı olmalı
+	void DrawCubemap(const Shader& layeredShader, const glm::vec3& lightPos, const glm::vec3& capturePos);
 	void SetPosition(glm::vec3 newPosition);
 	void SetScale(glm::vec3 newScale);
 	void SetRotation(glm::vec3 newRotation);
@@ -93,6 +118,52 @@ public:
 	void setColor(glm::vec3 color, float brightness);
 	void setBrightness(float brightness);
 
+	// translate * rotX * rotY * rotZ * scale, Draw ve culling aynı matrisi kullanıyor
+	// transform değişmedikçe önbellekten dönüyor (mesh culling her frame çağırıyor)
+	const glm::mat4& GetModelMatrix() const {
+		if (position != cachedPosition || rotation != cachedRotation || scale != cachedScale) {
+			glm::mat4 model = glm::mat4(1.0f);
+			model = glm::translate(model, position);
+			model = glm::rotate(model, glm::radians(rotation.x), glm::vec3(1.0f, 0.0f, 0.0f));
+			model = glm::rotate(model, glm::radians(rotation.y), glm::vec3(0.0f, 1.0f, 0.0f));
+			model = glm::rotate(model, glm::radians(rotation.z), glm::vec3(0.0f, 0.0f, 1.0f));
+			model = glm::scale(model, scale);
+			cachedModelMatrix = model;
+			cachedPosition = position;
+			cachedRotation = rotation;
+			cachedScale = scale;
+			transformVersion++;
+		}
+		return cachedModelMatrix;
+	}
+
+	// transform her değiştiğinde artıyor, BVH refit için
+	size_t GetTransformVersion() const {
+		GetModelMatrix();
+		return transformVersion;
+	}
+
+	// yerel AABB'yi matrisle dönüştürüp yeniden eksen hizalı kutu yapar
+	static void TransformAABB(const glm::mat4& matrix, const glm::vec3& localMin, const glm::vec3& localMax,
+		glm::vec3& outMin, glm::vec3& outMax) {
+		glm::vec3 center = glm::vec3(matrix * glm::vec4((localMin + localMax) * 0.5f, 1.0f));
+		glm::vec3 half = (localMax - localMin) * 0.5f;
+		glm::mat3 absolute = glm::mat3(glm::abs(glm::vec3(matrix[0])), glm::abs(glm::vec3(matrix[1])),
+			glm::abs(glm::vec3(matrix[2])));
+		glm::vec3 worldHalf = absolute * half;
+		outMin = center - worldHalf;
+		outMax = center + worldHalf;
+	}
+
+	// dünya uzayında eksen hizalı kutular (BVH bunları kullanıyor)
+	// Robot gibi kendi matrisini kuran objeler override ediyor
+	virtual void GetWorldBounds(glm::vec3& outMin, glm::vec3& outMax) const {
+		TransformAABB(GetModelMatrix(), boundingBox.min, boundingBox.max, outMin, outMax);
+	}
+	void GetMeshWorldBounds(size_t meshIndex, glm::vec3& outMin, glm::vec3& outMax) const {
+		TransformAABB(GetModelMatrix(), meshes[meshIndex].boundsMin, meshes[meshIndex].boundsMax, outMin, outMax);
+	}
+
 	const Shader& GetShader() const { return shader; }
 	const std::string& GetName() const { return name; }
 	const std::string& GetDescription() const { return description; }
@@ -110,22 +181,58 @@ public:
 	// Görünürlük kontrolü burda yapılarak performasn artışı sağladım
 	// normalde 4 dakika sürüyordu şuan 37 saniye
 	bool IsVisible(const Frustum& frustum) const {
+		glm::vec3 center;
+		float transformedRadius;
+		GetWorldBoundingSphere(center, transformedRadius);
+		return frustum.IsSphereVisible(center, transformedRadius);
+	}
+
+	// Statik batching: transform dünya uzayına gömülüp aynı materyalli meshler
+	// yatayda chunkSize büyüklüğündeki hücrelere göre birleştiriliyor, eski meshler siliniyor
+	// sonrasında culling obje yerine chunk (mesh) bazında yapılıyor
+	void MakeStatic(float chunkSize = 20.0f);
+	bool IsStatic() const { return isStatic; }
+	// MakeStatic sırasında seçilen büyük üçgenler (dünya uzayı), yazılım occlusion için
+	const std::vector<glm::vec3>& GetOccluderTriangles() const { return occluderTriangles; }
+	// lightmap açılımı (Lightmap::Unwrap) meshin vertexlerini chartlara göre bölünmüş haliyle değiştiriyor,
+	// mesh yeniden havuza yükleniyor. Konumlar ve sınırlar aynı kalıyor
+	void SetLightmapGeometry(size_t meshIndex, std::vector<float>&& vertices, std::vector<unsigned int>&& indices,
+		std::vector<float>&& lightmapUVs, std::vector<unsigned char>&& occlusion);
+
+	// Draw'dan önce çağrılıyor, her mesh önce küre sonra kutu testinden geçiyor
+	// (dönüş yoksa AABB, varsa OBB). frustum nullptr ise tüm meshler görünür sayılıyor
+	void CullMeshes(const Frustum* frustum, FrustumCullStats* stats = nullptr);
+	bool IsMeshVisible(size_t meshIndex) const { return meshVisible.empty() || meshVisible[meshIndex] != 0; }
+	// görünürlük dışarıda (BVH) hesaplandığında CullMeshes yerine bunlar kullanılıyor
+	void ResetMeshVisibility(bool visible) { meshVisible.assign(meshes.size(), visible ? 1 : 0); }
+	void SetMeshVisible(size_t meshIndex, bool visible) { meshVisible[meshIndex] = visible ? 1 : 0; }
+	size_t GetVisibleMeshCount() const;
+	void GetMeshWorldBoundingSphere(size_t meshIndex, glm::vec3& center, float& radius) const;
+
+	// Küme (meshlet) culling: Begin ana threadde, CullClusters farklı threadlerden ayrık
+	// küme aralıklarıyla, Finish hepsi bittikten sonra çağrılıyor. frustum nullptr ise kapalı
+	void BeginClusterCulling(const Frustum* frustum, const glm::vec3& cameraPosition, bool coneCulling);
+	void CullClusters(size_t meshIndex, size_t firstMeshlet, size_t lastMeshlet);
+	void FinishClusterCulling(size_t meshIndex);
+	// nullptr ise mesh bütün olarak çiziliyor
+	const ClusterDrawList* GetClusterDrawList(size_t meshIndex) const {
+		return meshIndex < clusterDraws.size() && clusterDraws[meshIndex].active ? &clusterDraws[meshIndex] : nullptr;
+	}
+
+	// model uzayındaki sınırlar (instancing her kopya için kendisi dönüştürüyor)
+	const BoundingBox& GetBoundingBox() const { return boundingBox; }
+
+	// GPU culling de aynı küreyi kullanıyor
+	void GetWorldBoundingSphere(glm::vec3& center, float& radius) const {
 		// Bounding box'ı dünya koordinatlarına dönüştür
-		glm::mat4 model = glm::mat4(1.0f);
-		model = glm::translate(model, position);
-		model = glm::rotate(model, glm::radians(rotation.x), glm::vec3(1.0f, 0.0f, 0.0f));
-		model = glm::rotate(model, glm::radians(rotation.y), glm::vec3(0.0f, 1.0f, 0.0f));
-		model = glm::rotate(model, glm::radians(rotation.z), glm::vec3(0.0f, 0.0f, 1.0f));
-		model = glm::scale(model, scale);
+		glm::mat4 model = GetModelMatrix();
 
 		// Dönüştürülmüş merkez noktası
-		glm::vec3 center = glm::vec3(model * glm::vec4(boundingBox.min + (boundingBox.max - boundingBox.min) * 0.5f, 1.0f));
+		center = glm::vec3(model * glm::vec4(boundingBox.min + (boundingBox.max - boundingBox.min) * 0.5f, 1.0f));
 		
 		// Dönüştürülmüş yarıçap (en büyük ölçek faktörünü kullan)
 		float maxScale = std::max(std::max(scale.x, scale.y), scale.z);
-		float transformedRadius = boundingBox.radius * maxScale;
-
-		return frustum.IsSphereVisible(center, transformedRadius);
+		radius = boundingBox.radius * maxScale;
 	}
 
 	// Bounding box'ı güncelle
@@ -184,9 +291,24 @@ private:
 	Shader shader;
 	bool isGLBModel;
 	BoundingBox boundingBox;
+	bool isStatic = false;
+	std::vector<glm::vec3> occluderTriangles;
+	std::vector<unsigned char> meshVisible; // CullMeshes sonucu, boşsa hepsi görünür
+	std::vector<unsigned char> meshPlaneHint; // her meshin son elendiği frustum düzlemi
+	std::vector<ClusterDrawList> clusterDraws; // mesh başına bu frame'in görünür kümeleri
+	ClusterCullContext clusterContext;
+	mutable glm::mat4 cachedModelMatrix = glm::mat4(1.0f);
+	mutable glm::vec3 cachedPosition = glm::vec3(0.0f);
+	mutable glm::vec3 cachedRotation = glm::vec3(0.0f);
+	mutable glm::vec3 cachedScale = glm::vec3(1.0f);
+	mutable size_t transformVersion = 0;
 	std::shared_ptr<MuseumArtifact> artifactInfo; // eser bilgisini imgui aktarma için kullandığım class 
 
 	void cleanup();
+	// meshLevels verilirse sadece seviyesi level olan meshler
+	void DrawWithShader(const Shader& targetShader, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix,
+		const glm::vec3& lightPos, const glm::vec3& viewPos,
+		const std::vector<unsigned char>* meshLevels = nullptr, unsigned char level = 0);
 
 	// Yardımcı fonksiyonlar
 	static std::string FixTexturePath(const std::string& path, const std::string& basePath);
@@ -0,0 +1,184 @@
+#include "OcclusionCuller.h"
+#include "GLExtensions.h"
+#include <iostream>
+
+OcclusionCuller::OcclusionCuller() {
+    boxShader = std::make_unique<Shader>("shaders/occlusionBoxVertex.glsl", "shaders/occlusionBoxFragment.glsl");
+    CreateBoxGeometry();
+
+    std::cout << "Occlusion culling hazir ("
+        << (GLExtensions::GetOcclusionQueryTarget() == GL_ANY_SAMPLES_PASSED_CONSERVATIVE ? "conservative" : "normal")
+        << " query)" << std::endl;
+}
+
+OcclusionCuller::~OcclusionCuller() {
+    Reset();
+    glDeleteVertexArrays(1, &boxVAO);
+    glDeleteBuffers(1, &boxVBO);
+    glDeleteBuffers(1, &boxEBO);
+}
+
+void OcclusionCuller::CreateBoxGeometry() {
+    // birim küp, shader boxMin/boxMax arasına geriyor
+    const float vertices[] = {
+        0, 0, 0,  1, 0, 0,  1, 1, 0,  0, 1, 0,
+        0, 0, 1,  1, 0, 1,  1, 1, 1,  0, 1, 1
+    };
+    const GLuint indices[] = {
+        0, 2, 1, 0, 3, 2,  4, 5, 6, 4, 6, 7,
+        0, 1, 5, 0, 5, 4,  3, 6, 2, 3, 7, 6,
+        0, 4, 7, 0, 7, 3,  1, 2, 6, 1, 6, 5
+    };
+
+    glGenVertexArrays(1, &boxVAO);
+    glGenBuffers(1, &boxVBO);
+    glGenBuffers(1, &boxEBO);
+
+    glBindVertexArray(boxVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, boxVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, boxEBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void OcclusionCuller::Reset() {
+    for (auto& pair : entries) {
+        glDeleteQueries(1, &pair.second.query);
+    }
+    entries.clear();
+}
+
+void OcclusionCuller::BeginFrame(const glm::mat4& newViewProjection, const glm::vec3& newCameraPosition) {
+    frame++;
+    viewProjection = newViewProjection;
+    cameraPosition = newCameraPosition;
+    PollTimers();
+
+    // koşulsuz ölçüm için boş timer gerekiyor, doluysa sonraki frame'e kalıyor
+    if (frame % BASELINE_INTERVAL == 0) {
+        baselineRequested = true;
+    }
+    baselineFrame = baselineRequested && candidateTimer.CanBegin();
+    if (baselineFrame) {
+        baselineRequested = false;
+    }
+
+    stats.candidates = 0;
+    stats.conditionalDraws = 0;
+    stats.occluded = 0;
+    stats.queriesIssued = 0;
+}
+
+void OcclusionCuller::EndFrame() {
+    // uzun süredir görülmeyen (silinmiş ya da çok uzakta kalan) objeler
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (frame - it->second.lastSeenFrame > STALE_FRAMES) {
+            glDeleteQueries(1, &it->second.query);
+            it = entries.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+void OcclusionCuller::BeginCandidatePass() {
+    candidateTimer.Begin(baselineFrame ? 1.0f : 0.0f);
+}
+
+void OcclusionCuller::EndCandidatePass() {
+    candidateTimer.End();
+}
+
+void OcclusionCuller::PollTimers() {
+    candidateTimer.Poll([this](const GpuTimer::Result& result) {
+        GpuTimer::Smooth(result.tag != 0.0f ? stats.baselinePassMs : stats.candidatePassMs, result.ms);
+    });
+}
+
+bool OcclusionCuller::BeginConditionalDraw(const MuseumObject* object) {
+    Entry& entry = entries[object];
+    entry.lastSeenFrame = frame;
+    stats.candidates++;
+
+    // query sadece geçen frame'den kalmışsa anlamlı, yoksa (yeni görünen obje) koşulsuz çiz
+    if (entry.query == 0 || entry.queryFrame + 1 != frame || baselineFrame) {
+        return false;
+    }
+
+    // sadece istatistik için, hazır değilse beklenmiyor
+    GLint available = 0;
+    glGetQueryObjectiv(entry.query, GL_QUERY_RESULT_AVAILABLE, &available);
+    if (available) {
+        GLuint samplesPassed = 0;
+        glGetQueryObjectuiv(entry.query, GL_QUERY_RESULT, &samplesPassed);
+        if (samplesPassed == 0) {
+            stats.occluded++;
+        }
+    }
+
+    stats.conditionalDraws++;
+    glBeginConditionalRender(entry.query, GL_QUERY_NO_WAIT);
+    return true;
+}
+
+void OcclusionCuller::EndConditionalDraw() {
+    glEndConditionalRender();
+}
+
+void OcclusionCuller::IssueQueries(const std::vector<MuseumObject*>& candidates) {
+    if (candidates.empty()) {
+        return;
+    }
+
+    // renk ve derinlik yazılmıyor, sadece test
+    // derinlik ön geçişi açıkken renk geçişi GL_EQUAL ile çalışıyor, kutular için normal test
+    GLint previousDepthFunc = GL_LESS;
+    GLboolean previousDepthMask = GL_TRUE;
+    glGetIntegerv(GL_DEPTH_FUNC, &previousDepthFunc);
+    glGetBooleanv(GL_DEPTH_WRITEMASK, &previousDepthMask);
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    glDepthMask(GL_FALSE);
+    glDepthFunc(GL_LESS);
+
+    boxShader->use();
+    boxShader->setMat4("viewProjection", viewProjection);
+    glBindVertexArray(boxVAO);
+
+    GLenum target = GLExtensions::GetOcclusionQueryTarget();
+    for (MuseumObject* object : candidates) {
+        Entry& entry = entries[object];
+        entry.lastSeenFrame = frame;
+
+        glm::vec3 boxMin, boxMax;
+        object->GetWorldBounds(boxMin, boxMax);
+
+        // kamera kutunun içindeyse ön yüzler near plane'de kırpılıyor, query yanlış sonuç verir
+        glm::vec3 margin(0.1f);
+        if (glm::all(glm::greaterThanEqual(cameraPosition, boxMin - margin)) &&
+            glm::all(glm::lessThanEqual(cameraPosition, boxMax + margin))) {
+            entry.queryFrame = 0;
+            continue;
+        }
+
+        if (entry.query == 0) {
+            glGenQueries(1, &entry.query);
+        }
+        boxShader->setVec3("boxMin", boxMin);
+        boxShader->setVec3("boxMax", boxMax);
+        glBeginQuery(target, entry.query);
+        glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, 0);
+        glEndQuery(target);
+        entry.queryFrame = frame;
+        stats.queriesIssued++;
+    }
+
+    glBindVertexArray(0);
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    glDepthMask(previousDepthMask);
+    glDepthFunc(previousDepthFunc);
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "MuseumObject.h"
+#include "Shader.h"
+#include "GpuTimer.h"
+
+// Donanım occlusion query ile gizli obje eleme
+// her aday objenin dünya AABB'si, derinlik yazılmadan query içinde çiziliyor.
+// Sonuç CPU'da beklenmiyor: bir sonraki frame obje glBeginConditionalRender ile
+// çiziliyor, sürücü query sonucuna göre çizimi kendisi atlıyor (sonuç hazır değilse çiziyor)
+// Kullanım (her frame): BeginFrame -> büyük occluderlar çizilir -> adaylar
+// BeginConditionalDraw/EndConditionalDraw arasında çizilir -> IssueQueries -> EndFrame
+class OcclusionCuller {
+public:
+    struct Stats {
+        size_t candidates = 0;        // occluder olmayan, frustum içindeki objeler
+        size_t conditionalDraws = 0;  // geçen frame'in query'si ile çizilen
+        size_t occluded = 0;          // sonucu okunabilen ve tamamen gizli çıkan
+        size_t queriesIssued = 0;
+        double candidatePassMs = -1.0;  // adayların GPU süresi (birkaç frame gecikmeli)
+        double baselinePassMs = -1.0;   // aynı geçiş koşulsuz çizildiğinde (ara ara ölçülüyor)
+    };
+
+    OcclusionCuller();
+    ~OcclusionCuller();
+
+    void BeginFrame(const glm::mat4& viewProjection, const glm::vec3& cameraPosition);
+    void EndFrame();
+
+    // adayların çizimi zamanlanıyor
+    void BeginCandidatePass();
+    void EndCandidatePass();
+
+    // true dönerse çizimden sonra EndConditionalDraw çağrılmalı
+    bool BeginConditionalDraw(const MuseumObject* object);
+    void EndConditionalDraw();
+
+    // tüm çizimden sonra, bu frame çizilen adayların kutuları için query
+    void IssueQueries(const std::vector<MuseumObject*>& candidates);
+
+    // sahne değişince eski objelerin query'leri atılıyor
+    void Reset();
+
+    const Stats& GetStats() const { return stats; }
+
+private:
+    struct Entry {
+        GLuint query = 0;
+        size_t queryFrame = 0; // query'nin verildiği frame, 0 = hiç
+        size_t lastSeenFrame = 0;
+    };
+
+    static constexpr size_t BASELINE_INTERVAL = 120; // bu kadar frame'de bir koşulsuz ölçüm
+    static constexpr size_t STALE_FRAMES = 300;      // görülmeyen objenin query'si silinir
+
+    void CreateBoxGeometry();
+    void PollTimers();
+
+    std::unique_ptr<Shader> boxShader;
+    GLuint boxVAO = 0;
+    GLuint boxVBO = 0;
+    GLuint boxEBO = 0;
+
+    std::unordered_map<const MuseumObject*, Entry> entries;
+    glm::mat4 viewProjection = glm::mat4(1.0f);
+    glm::vec3 cameraPosition = glm::vec3(0.0f);
+    size_t frame = 0;
+    bool baselineRequested = false;
+    bool baselineFrame = false;
+
+    GpuTimer candidateTimer; // tag 1 koşulsuz (karşılaştırma) frame'i
+
+    Stats stats;
+};
@@ -0,0 +1,498 @@
+#include "PotentiallyVisibleSet.h"
+#include "GeometryPool.h"
+#include "JobSystem.h"
+#include "TriangleBVH.h"
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+
+namespace {
+    const char PVS_MAGIC[4] = { 'P', 'V', 'S', '2' }; // 2: obje transform hash'i eklendi
+
+    typedef TriangleBVH::Triangle Triangle;
+
+    // hedef yüzeyinden alana göre örnek almak için
+    struct TargetSurface {
+        glm::vec3 boundsMin, boundsMax;
+        uint32_t firstTriangle = 0;
+        uint32_t triangleCount = 0;
+        float totalArea = 0.0f;
+    };
+
+    void WriteString(std::ofstream& file, const std::string& value) {
+        uint32_t length = static_cast<uint32_t>(value.size());
+        file.write(reinterpret_cast<const char*>(&length), sizeof(length));
+        file.write(value.data(), length);
+    }
+
+    bool ReadString(std::ifstream& file, std::string& value) {
+        uint32_t length = 0;
+        if (!file.read(reinterpret_cast<char*>(&length), sizeof(length)) || length > 4096) {
+            return false;
+        }
+        value.resize(length);
+        return static_cast<bool>(file.read(&value[0], length));
+    }
+
+    template <typename T>
+    void WriteValue(std::ofstream& file, const T& value) {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    bool ReadValue(std::ifstream& file, T& value) {
+        return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+    }
+
+    // FNV-1a, elemanlar yuvarlanıyor (sin/cos'un son bitindeki derleyici farkı dosyayı geçersiz kılmasın)
+    uint64_t HashTransform(const glm::mat4& model) {
+        uint64_t hash = 1469598103934665603ull;
+        for (int column = 0; column < 4; ++column) {
+            for (int row = 0; row < 4; ++row) {
+                int64_t quantized = std::llround(static_cast<double>(model[column][row]) * 1.0e4);
+                hash = (hash ^ static_cast<uint64_t>(quantized)) * 1099511628211ull;
+            }
+        }
+        return hash;
+    }
+}
+
+void PotentiallyVisibleSet::Clear() {
+    objectNames.clear();
+    objectMeshCounts.clear();
+    objectTransforms.clear();
+    objectFirstTarget.clear();
+    targetCount = 0;
+    visibilitySets.clear();
+    cellSets.clear();
+    gridSize = glm::ivec3(0);
+    decodedSet = -1;
+    decodedBits.clear();
+}
+
+bool PotentiallyVisibleSet::Bake(const std::vector<std::shared_ptr<MuseumObject>>& objects, const BakeSettings& settings) {
+    auto start = std::chrono::high_resolution_clock::now();
+    Clear();
+    bakeStats = BakeStats();
+
+    if (objects.empty() || settings.cellSize <= 0.0f || settings.originSamples <= 0 || settings.targetSamples <= 0) {
+        std::cerr << "PVS bake: sahne bos ya da ayarlar gecersiz" << std::endl;
+        return false;
+    }
+
+    const int stride = GeometryPool::VERTEX_FLOATS;
+    std::vector<TargetSurface> targets;
+    std::vector<Triangle> surfaceTriangles; // örnekleme için tüm hedeflerin üçgenleri
+    std::vector<float> surfaceAreas;        // hedef içinde birikimli alan
+    std::vector<Triangle> blockers;
+
+    glm::vec3 staticMin(FLT_MAX), staticMax(-FLT_MAX);
+    glm::vec3 sceneMin(FLT_MAX), sceneMax(-FLT_MAX);
+
+    for (const auto& object : objects) {
+        const auto& meshes = object->GetMeshes();
+        glm::mat4 model = object->GetModelMatrix();
+        objectNames.push_back(object->GetName());
+        objectMeshCounts.push_back(static_cast<uint32_t>(meshes.size()));
+        objectTransforms.push_back(HashTransform(model));
+        objectFirstTarget.push_back(targetCount);
+
+        glm::vec3 objectMin, objectMax;
+        object->GetWorldBounds(objectMin, objectMax);
+        sceneMin = glm::min(sceneMin, objectMin);
+        sceneMax = glm::max(sceneMax, objectMax);
+        if (object->IsStatic()) {
+            staticMin = glm::min(staticMin, objectMin);
+            staticMax = glm::max(staticMax, objectMax);
+        }
+
+        for (size_t m = 0; m < meshes.size(); ++m) {
+            const auto& mesh = meshes[m];
+            TargetSurface target;
+            object->GetMeshWorldBounds(m, target.boundsMin, target.boundsMax);
+            target.firstTriangle = static_cast<uint32_t>(surfaceTriangles.size());
+
+            for (size_t t = 0; t + 2 < mesh.indices.size(); t += 3) {
+                glm::vec3 v[3];
+                for (int k = 0; k < 3; ++k) {
+                    const float* vertex = &mesh.vertices[mesh.indices[t + k] * stride];
+                    v[k] = glm::vec3(model * glm::vec4(vertex[0], vertex[1], vertex[2], 1.0f));
+                }
+                Triangle triangle = { v[0], v[1] - v[0], v[2] - v[0], targetCount };
+                float area = 0.5f * glm::length(glm::cross(triangle.e1, triangle.e2));
+                if (area <= 0.0f) {
+                    continue;
+                }
+                target.totalArea += area;
+                surfaceTriangles.push_back(triangle);
+                surfaceAreas.push_back(target.totalArea);
+                // sadece hiç hareket etmeyen geometri ışını engelliyor
+                if (object->IsStatic()) {
+                    blockers.push_back(triangle);
+                }
+            }
+            target.triangleCount = static_cast<uint32_t>(surfaceTriangles.size()) - target.firstTriangle;
+            targets.push_back(target);
+            targetCount++;
+        }
+    }
+
+    // gezilebilir hacim statik binanın kutusu, bina yoksa tüm sahne
+    if (staticMin.x > staticMax.x) {
+        staticMin = sceneMin;
+        staticMax = sceneMax;
+    }
+    cellSize = settings.cellSize;
+    gridOrigin = staticMin;
+    glm::vec3 extent = staticMax - staticMin;
+    gridSize = glm::max(glm::ivec3(glm::ceil(extent / cellSize)), glm::ivec3(1));
+    size_t cellCount = static_cast<size_t>(gridSize.x) * gridSize.y * gridSize.z;
+
+    bakeStats.targets = targetCount;
+    bakeStats.blockerTriangles = blockers.size();
+    bakeStats.cells = cellCount;
+
+    // sadece ışın engel testi, id = hedef indexi
+    TriangleBVH bvh;
+    bvh.Build(std::move(blockers));
+
+    size_t bitsetBytes = (targetCount + 7) / 8;
+    std::vector<std::vector<unsigned char>> cellData(cellCount);
+    std::atomic<size_t> raysCast(0);
+    std::atomic<size_t> visiblePairs(0);
+
+    JobSystem::GetInstance().ParallelFor(cellCount, 1, [&](size_t begin, size_t end) {
+        std::vector<unsigned char> bits;
+        std::vector<glm::vec3> origins(settings.originSamples);
+        for (size_t cell = begin; cell < end; ++cell) {
+            // aynı sahne aynı sonucu versin diye her hücrenin kendi seedi
+            std::mt19937 random(static_cast<unsigned int>(cell * 2654435761u + 1));
+            std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+            glm::ivec3 coord(static_cast<int>(cell % gridSize.x),
+                static_cast<int>((cell / gridSize.x) % gridSize.y),
+                static_cast<int>(cell / (static_cast<size_t>(gridSize.x) * gridSize.y)));
+            glm::vec3 cellMin = gridOrigin + glm::vec3(coord) * cellSize;
+            glm::vec3 cellMax = cellMin + glm::vec3(cellSize);
+            for (auto& origin : origins) {
+                origin = cellMin + glm::vec3(unit(random), unit(random), unit(random)) * cellSize;
+            }
+
+            bits.assign(bitsetBytes, 0);
+            size_t cellRays = 0, cellVisible = 0;
+            for (uint32_t targetIndex = 0; targetIndex < targetCount; ++targetIndex) {
+                const TargetSurface& target = targets[targetIndex];
+                bool visible = false;
+
+                // hücreye değen hedef her zaman görünür (kamera içinde ya da dibinde)
+                if (glm::all(glm::lessThanEqual(target.boundsMin, cellMax)) &&
+                    glm::all(glm::greaterThanEqual(target.boundsMax, cellMin))) {
+                    visible = true;
+                }
+
+                for (int o = 0; o < settings.originSamples && !visible; ++o) {
+                    for (int s = 0; s < settings.targetSamples && !visible; ++s) {
+                        glm::vec3 point;
+                        if (target.triangleCount > 0) {
+                            // alana göre üçgen, sonra üçgen içinde düzgün nokta
+                            float pick = unit(random) * target.totalArea;
+                            auto first = surfaceAreas.begin() + target.firstTriangle;
+                            auto found = std::upper_bound(first, first + target.triangleCount, pick);
+                            size_t triangleIndex = std::min<size_t>(found - surfaceAreas.begin(),
+                                target.firstTriangle + target.triangleCount - 1);
+                            const Triangle& triangle = surfaceTriangles[triangleIndex];
+                            float r1 = std::sqrt(unit(random));
+                            float r2 = unit(random);
+                            point = triangle.v0 + triangle.e1 * (r1 * (1.0f - r2)) + triangle.e2 * (r1 * r2);
+                        }
+                        else {
+                            point = target.boundsMin + glm::vec3(unit(random), unit(random), unit(random)) *
+                                (target.boundsMax - target.boundsMin);
+                        }
+                        cellRays++;
+                        visible = !bvh.IsSegmentBlocked(origins[o], point, targetIndex);
+                    }
+                }
+
+                if (visible) {
+                    bits[targetIndex >> 3] |= static_cast<unsigned char>(1u << (targetIndex & 7));
+                    cellVisible++;
+                }
+            }
+
+            Compress(bits, cellData[cell]);
+            raysCast += cellRays;
+            visiblePairs += cellVisible;
+        }
+    });
+
+    // aynı salondaki hücreler çoğunlukla aynı seti görüyor, tek kopya tutuluyor
+    std::map<std::vector<unsigned char>, uint32_t> setLookup;
+    cellSets.resize(cellCount);
+    for (size_t cell = 0; cell < cellCount; ++cell) {
+        auto found = setLookup.find(cellData[cell]);
+        if (found == setLookup.end()) {
+            found = setLookup.emplace(cellData[cell], static_cast<uint32_t>(visibilitySets.size())).first;
+            visibilitySets.push_back(std::move(cellData[cell]));
+        }
+        cellSets[cell] = found->second;
+    }
+
+    bakeStats.uniqueSets = visibilitySets.size();
+    bakeStats.raysCast = raysCast;
+    bakeStats.visiblePairs = visiblePairs;
+    bakeStats.rawBytes = bitsetBytes * cellCount;
+    bakeStats.compressedBytes = GetCompressedBytes();
+    bakeStats.bakeMs = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - start).count();
+
+    std::cout << "PVS bake: " << cellCount << " hucre (" << gridSize.x << "x" << gridSize.y << "x" << gridSize.z
+        << "), " << targetCount << " hedef, " << bakeStats.uniqueSets << " farkli set, " << bakeStats.raysCast << " isin, "
+        << bakeStats.rawBytes << " -> " << bakeStats.compressedBytes << " byte, "
+        << bakeStats.bakeMs << " ms" << std::endl;
+    return true;
+}
+
+bool PotentiallyVisibleSet::Save(const std::string& path) const {
+    if (!IsLoaded()) {
+        std::cerr << "PVS kaydedilemedi: bake edilmemis" << std::endl;
+        return false;
+    }
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "PVS dosyasi acilamadi: " << path << std::endl;
+        return false;
+    }
+
+    file.write(PVS_MAGIC, sizeof(PVS_MAGIC));
+    WriteValue(file, gridOrigin);
+    WriteValue(file, cellSize);
+    WriteValue(file, gridSize);
+    WriteValue(file, targetCount);
+
+    uint32_t objectCount = static_cast<uint32_t>(objectNames.size());
+    WriteValue(file, objectCount);
+    for (uint32_t i = 0; i < objectCount; ++i) {
+        WriteString(file, objectNames[i]);
+        WriteValue(file, objectMeshCounts[i]);
+        WriteValue(file, objectTransforms[i]);
+    }
+
+    uint32_t setCount = static_cast<uint32_t>(visibilitySets.size());
+    WriteValue(file, setCount);
+    for (const auto& data : visibilitySets) {
+        uint32_t size = static_cast<uint32_t>(data.size());
+        WriteValue(file, size);
+        file.write(reinterpret_cast<const char*>(data.data()), size);
+    }
+    // set sayısı küçükse hücre tablosu 16 bit
+    if (setCount <= 0xFFFFu) {
+        std::vector<uint16_t> shortSets(cellSets.begin(), cellSets.end());
+        file.write(reinterpret_cast<const char*>(shortSets.data()), shortSets.size() * sizeof(uint16_t));
+    }
+    else {
+        file.write(reinterpret_cast<const char*>(cellSets.data()), cellSets.size() * sizeof(uint32_t));
+    }
+
+    if (!file) {
+        std::cerr << "PVS dosyasi yazilamadi: " << path << std::endl;
+        return false;
+    }
+    std::cout << "PVS kaydedildi: " << path << std::endl;
+    return true;
+}
+
+bool PotentiallyVisibleSet::Load(const std::string& path) {
+    Clear();
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false; // bake edilmemiş sahne, hata değil
+    }
+
+    char magic[4];
+    if (!file.read(magic, sizeof(magic)) || !std::equal(magic, magic + 4, PVS_MAGIC)) {
+        std::cerr << "PVS dosyasi gecersiz: " << path << std::endl;
+        return false;
+    }
+
+    uint32_t objectCount = 0;
+    bool ok = ReadValue(file, gridOrigin) && ReadValue(file, cellSize) && ReadValue(file, gridSize) &&
+        ReadValue(file, targetCount) && ReadValue(file, objectCount);
+    ok = ok && cellSize > 0.0f && glm::all(glm::greaterThan(gridSize, glm::ivec3(0))) &&
+        glm::all(glm::lessThan(gridSize, glm::ivec3(1024))) && objectCount < 100000;
+
+    uint32_t meshTotal = 0;
+    for (uint32_t i = 0; ok && i < objectCount; ++i) {
+        std::string name;
+        uint32_t meshCount = 0;
+        uint64_t transform = 0;
+        ok = ReadString(file, name) && ReadValue(file, meshCount) && ReadValue(file, transform);
+        objectNames.push_back(name);
+        objectMeshCounts.push_back(meshCount);
+        objectTransforms.push_back(transform);
+        objectFirstTarget.push_back(meshTotal);
+        meshTotal += meshCount;
+    }
+    ok = ok && meshTotal == targetCount;
+
+    size_t cellCount = ok ? static_cast<size_t>(gridSize.x) * gridSize.y * gridSize.z : 0;
+    size_t bitsetBytes = (targetCount + 7) / 8;
+    uint32_t setCount = 0;
+    ok = ok && ReadValue(file, setCount) && setCount <= cellCount;
+    visibilitySets.resize(ok ? setCount : 0);
+    for (uint32_t set = 0; ok && set < setCount; ++set) {
+        uint32_t size = 0;
+        ok = ReadValue(file, size) && size <= bitsetBytes;
+        if (ok) {
+            visibilitySets[set].resize(size);
+            ok = size == 0 || static_cast<bool>(file.read(reinterpret_cast<char*>(visibilitySets[set].data()), size));
+        }
+    }
+    if (ok) {
+        cellSets.resize(cellCount);
+        if (setCount <= 0xFFFFu) {
+            std::vector<uint16_t> shortSets(cellCount);
+            ok = static_cast<bool>(file.read(reinterpret_cast<char*>(shortSets.data()), cellCount * sizeof(uint16_t)));
+            cellSets.assign(shortSets.begin(), shortSets.end());
+        }
+        else {
+            ok = static_cast<bool>(file.read(reinterpret_cast<char*>(cellSets.data()), cellCount * sizeof(uint32_t)));
+        }
+        for (size_t cell = 0; ok && cell < cellCount; ++cell) {
+            ok = cellSets[cell] < setCount;
+        }
+    }
+
+    if (!ok) {
+        std::cerr << "PVS dosyasi bozuk: " << path << std::endl;
+        Clear();
+        return false;
+    }
+
+    std::cout << "PVS yuklendi: " << path << " (" << cellCount << " hucre, " << targetCount << " hedef, "
+        << GetCompressedBytes() << " byte)" << std::endl;
+    return true;
+}
+
+bool PotentiallyVisibleSet::MatchesScene(const std::vector<std::shared_ptr<MuseumObject>>& objects) const {
+    if (objects.size() != objectNames.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < objects.size(); ++i) {
+        if (objects[i]->GetMeshes().size() != objectMeshCounts[i] || objects[i]->GetName() != objectNames[i] ||
+            HashTransform(objects[i]->GetModelMatrix()) != objectTransforms[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int PotentiallyVisibleSet::FindCell(const glm::vec3& position) const {
+    if (!IsLoaded()) {
+        return -1;
+    }
+    glm::ivec3 coord(glm::floor((position - gridOrigin) / cellSize));
+    if (glm::any(glm::lessThan(coord, glm::ivec3(0))) || glm::any(glm::greaterThanEqual(coord, gridSize))) {
+        return -1;
+    }
+    return coord.x + gridSize.x * (coord.y + gridSize.y * coord.z);
+}
+
+const std::vector<unsigned char>& PotentiallyVisibleSet::DecodeCell(int cell) {
+    int set = static_cast<int>(cellSets[cell]);
+    if (set != decodedSet) {
+        size_t bitsetBytes = (targetCount + 7) / 8;
+        if (!Decompress(visibilitySets[set], bitsetBytes, decodedBits)) {
+            // bozuk set: her şey görünür
+            decodedBits.assign(bitsetBytes, 0xFF);
+        }
+        decodedSet = set;
+    }
+    return decodedBits;
+}
+
+bool PotentiallyVisibleSet::IsObjectVisible(const std::vector<unsigned char>& bits, size_t objectIndex) const {
+    for (uint32_t m = 0; m < objectMeshCounts[objectIndex]; ++m) {
+        if (IsMeshVisible(bits, objectIndex, m)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t PotentiallyVisibleSet::GetCompressedBytes() const {
+    size_t total = cellSets.size() * (visibilitySets.size() <= 0xFFFFu ? sizeof(uint16_t) : sizeof(uint32_t));
+    for (const auto& data : visibilitySets) {
+        total += data.size();
+    }
+    return total;
+}
+
+// PackBits: kontrol byte'ı c < 128 ise c + 1 ham byte, c >= 128 ise sonraki byte (c - 126) kez
+// bitsetler çoğunlukla uzun 0x00 / 0xFF dizileri olduğu için iyi sıkışıyor.
+// Kısalmazsa ham tutuluyor, boyu bitset boyuna eşit olan veri ham sayılıyor
+void PotentiallyVisibleSet::Compress(const std::vector<unsigned char>& bits, std::vector<unsigned char>& out) {
+    out.clear();
+    size_t i = 0;
+    while (i < bits.size()) {
+        size_t run = 1;
+        while (i + run < bits.size() && run < 129 && bits[i + run] == bits[i]) {
+            run++;
+        }
+        if (run >= 2) {
+            out.push_back(static_cast<unsigned char>(run + 126));
+            out.push_back(bits[i]);
+            i += run;
+            continue;
+        }
+
+        // tekrar başlayana kadar ham byte'lar
+        size_t literalStart = i;
+        while (i < bits.size() && i - literalStart < 128 &&
+            !(i + 1 < bits.size() && bits[i + 1] == bits[i])) {
+            i++;
+        }
+        if (i == literalStart) {
+            i++;
+        }
+        out.push_back(static_cast<unsigned char>(i - literalStart - 1));
+        out.insert(out.end(), bits.begin() + literalStart, bits.begin() + i);
+    }
+    if (out.size() >= bits.size()) {
+        out = bits;
+    }
+}
+
+bool PotentiallyVisibleSet::Decompress(const std::vector<unsigned char>& data, size_t size, std::vector<unsigned char>& out) {
+    if (data.size() == size) {
+        out = data;
+        return true;
+    }
+    out.clear();
+    out.reserve(size);
+    size_t i = 0;
+    while (i < data.size()) {
+        unsigned char control = data[i++];
+        if (control < 128) {
+            size_t count = control + 1;
+            if (i + count > data.size()) {
+                return false;
+            }
+            out.insert(out.end(), data.begin() + i, data.begin() + i + count);
+            i += count;
+        }
+        else {
+            if (i >= data.size()) {
+                return false;
+            }
+            out.insert(out.end(), static_cast<size_t>(control - 126), data[i++]);
+        }
+    }
+    return out.size() == size;
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include "MuseumObject.h"
+
+// son frame'in PVS sayaçları
+struct PVSCullStats {
+    int cell = -1;              // kameranın hücresi, -1 = PVS kullanılmadı
+    size_t objectsRejected = 0; // frustum testine hiç girmeden atılan
+    size_t meshesRejected = 0;
+};
+
+// Önceden hesaplanmış görünürlük (PVS)
+// gezilebilir hacim (statik binanın kutusu) cellSize büyüklüğünde hücrelere bölünüyor,
+// her hücreden her hedefe (obje meshi / statik chunk) rastgele ışınlar atılıp
+// statik geometriye çarpmadan ulaşan hedefler görünür işaretleniyor.
+// Sonuç hücre başına bitset: aynı görünürlüğe sahip hücreler tek seti paylaşıyor,
+// setler PackBits ile sıkıştırılıp sahnenin yanına kaydediliyor.
+// Çalışırken kameranın hücresi açılıyor, sadece o hücreden görünebilecekler frustum testine gidiyor
+class PotentiallyVisibleSet {
+public:
+    struct BakeSettings {
+        float cellSize = 4.0f;
+        int originSamples = 8;  // hücre içindeki ışın başlangıç noktaları
+        int targetSamples = 16; // her başlangıçtan hedef yüzeyine atılan ışın
+    };
+
+    struct BakeStats {
+        size_t cells = 0;
+        size_t targets = 0;
+        size_t blockerTriangles = 0;
+        size_t raysCast = 0;
+        size_t visiblePairs = 0;
+        size_t uniqueSets = 0;
+        size_t rawBytes = 0;        // hücre başına ham bitset
+        size_t compressedBytes = 0; // setler + hücre tablosu
+        double bakeMs = 0.0;
+    };
+
+    // objelerin meshleri hedef, statik objelerin üçgenleri engel. Worker threadlerde çalışıyor
+    bool Bake(const std::vector<std::shared_ptr<MuseumObject>>& objects, const BakeSettings& settings);
+    bool Save(const std::string& path) const;
+    bool Load(const std::string& path);
+    void Clear();
+
+    bool IsLoaded() const { return !cellSets.empty(); }
+    // obje/mesh düzeni ve objelerin transformu bake edilenle aynı mı (obje eklenip çıkarılınca ya da
+    // taşınınca/döndürülünce/ölçeklenince PVS geçersiz, yoksa görünen objeler elenebiliyor)
+    bool MatchesScene(const std::vector<std::shared_ptr<MuseumObject>>& objects) const;
+
+    // kameranın hücresi, hacmin dışındaysa -1
+    int FindCell(const glm::vec3& position) const;
+    // hücrenin açılmış bitseti, son açılan hücre tutuluyor
+    const std::vector<unsigned char>& DecodeCell(int cell);
+
+    bool IsMeshVisible(const std::vector<unsigned char>& bits, size_t objectIndex, size_t meshIndex) const {
+        uint32_t target = objectFirstTarget[objectIndex] + static_cast<uint32_t>(meshIndex);
+        return (bits[target >> 3] >> (target & 7)) & 1;
+    }
+    // objenin en az bir meshi görünür mü
+    bool IsObjectVisible(const std::vector<unsigned char>& bits, size_t objectIndex) const;
+
+    const BakeStats& GetBakeStats() const { return bakeStats; }
+    size_t GetCellCount() const { return cellSets.size(); }
+    size_t GetSetCount() const { return visibilitySets.size(); }
+    size_t GetTargetCount() const { return targetCount; }
+    size_t GetCompressedBytes() const;
+
+    // PackBits, lightmap dosyası da kullanıyor. Kısalmayan veri ham tutuluyor (boyu size'a eşitse ham)
+    static void Compress(const std::vector<unsigned char>& bits, std::vector<unsigned char>& out);
+    static bool Decompress(const std::vector<unsigned char>& data, size_t size, std::vector<unsigned char>& out);
+
+private:
+    glm::vec3 gridOrigin = glm::vec3(0.0f);
+    float cellSize = 4.0f;
+    glm::ivec3 gridSize = glm::ivec3(0);
+
+    // bake sırasındaki sahne düzeni, doğrulama için
+    std::vector<std::string> objectNames;
+    std::vector<uint32_t> objectMeshCounts;
+    std::vector<uint64_t> objectTransforms; // model matrisinin hash'i
+    std::vector<uint32_t> objectFirstTarget;
+    uint32_t targetCount = 0;
+
+    std::vector<std::vector<unsigned char>> visibilitySets; // farklı bitsetler, sıkıştırılmış
+    std::vector<uint32_t> cellSets; // hücre -> set indexi
+    int decodedSet = -1;
+    std::vector<unsigned char> decodedBits;
+
+    BakeStats bakeStats;
+};
@@ -1,4 +1,5 @@
 #include "ResourceManager.h"
+#include "VertexOcclusion.h"
 #include <iostream>
 #include <filesystem>
 #include <algorithm>
@@ -70,6 +71,9 @@ bool ResourceManager::LoadModel(const std::string& path) {
     // meshleri işle
     ProcessNode(scene->mRootNode, scene, *modelData);
 
+    // vertex AO'su: model başına bir kere, sonraki açılışlarda .ao dosyasından
+    VertexOcclusion::LoadOrBake(path, *modelData, VertexOcclusion::Settings());
+
     // materiaları işle
     for (unsigned int i = 0; i < scene->mNumMaterials; i++) {
         aiMaterial* material = scene->mMaterials[i];
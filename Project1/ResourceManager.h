@@ -14,6 +14,7 @@ struct ModelData {
         std::vector<float> vertices;
         std::vector<unsigned int> indices;
         std::string materialName;
+        std::vector<unsigned char> occlusion; // vertex başına AO (VertexOcclusion), 255 = açık
     };
 
     struct Material {
@@ -95,19 +95,69 @@ void Robot::ToggleArmMovement() {
     }
 }
 
-void Robot::Draw(const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix,
-    const glm::vec3& lightPos, const glm::vec3& viewPos) {
-    
-    // Robot gövdesi için model matrisini oluştur (90 derece offset ile)
+glm::mat4 Robot::GetBodyMatrix() const {
+    // 90 derece offset robotun dönüşünde
     glm::mat4 modelMatrix = glm::mat4(1.0f);
     modelMatrix = glm::translate(modelMatrix, GetPosition());
     modelMatrix = glm::rotate(modelMatrix, glm::radians(m_RobotRotation), glm::vec3(0.0f, 1.0f, 0.0f));
     modelMatrix = glm::scale(modelMatrix, m_BodyScale);
+    return modelMatrix;
+}
+
+glm::mat4 Robot::GetArmMatrix() const {
+    glm::mat4 armModelMatrix = glm::mat4(1.0f);
+    armModelMatrix = glm::translate(armModelMatrix, GetPosition());
+    armModelMatrix = glm::rotate(armModelMatrix, glm::radians(m_RobotRotation), glm::vec3(0.0f, 1.0f, 0.0f));
+    armModelMatrix = glm::rotate(armModelMatrix, glm::radians(m_ArmAngle), glm::vec3(0.0f, 0.0f, 1.0f));
+    armModelMatrix = glm::scale(armModelMatrix, m_ArmScale);
+    return armModelMatrix;
+}
+
+void Robot::GetWorldBounds(glm::vec3& outMin, glm::vec3& outMax) const {
+    TransformAABB(GetBodyMatrix(), GetBoundingBox().min, GetBoundingBox().max, outMin, outMax);
+
+    if (m_ArmModel) {
+        glm::vec3 armMin, armMax;
+        TransformAABB(GetArmMatrix(), m_ArmModel->GetBoundingBox().min, m_ArmModel->GetBoundingBox().max, armMin, armMax);
+        outMin = glm::min(outMin, armMin);
+        outMax = glm::max(outMax, armMax);
+    }
+}
+
+void Robot::DrawShadowCaster(Shader& depthShader, const Frustum& lightFrustum) {
+    glm::vec3 boundsMin, boundsMax;
+    GetWorldBounds(boundsMin, boundsMax);
+    if (!lightFrustum.IsAABBVisible(boundsMin, boundsMax)) {
+        return;
+    }
+
+    // robot küçük, mesh bazında eleme yapılmıyor
+    GeometryPool& geometryPool = GeometryPool::GetInstance();
+    geometryPool.BindPositionOnly();
+    depthShader.setMat4("model", GetBodyMatrix());
+    for (const auto& mesh : GetMeshes()) {
+        geometryPool.Draw(mesh.geometry);
+    }
+    if (m_ArmModel) {
+        depthShader.setMat4("model", GetArmMatrix());
+        for (const auto& mesh : m_ArmModel->GetMeshes()) {
+            geometryPool.Draw(mesh.geometry);
+        }
+    }
+    geometryPool.Unbind();
+}
+
+void Robot::Draw(const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix,
+    const glm::vec3& lightPos, const glm::vec3& viewPos) {
+    
+    // Robot gövdesi için model matrisini oluştur (90 derece offset ile)
+    glm::mat4 modelMatrix = GetBodyMatrix();
     
     // shaderı kullan ve uniformları set et
     const Shader& shader = GetShader();
     shader.use();
     shader.setMat4("model", modelMatrix);
+    shader.setMat3("normalMatrix", glm::transpose(glm::inverse(glm::mat3(modelMatrix))));
     shader.setMat4("view", viewMatrix);
     shader.setMat4("projection", projectionMatrix);
     
@@ -117,6 +167,8 @@ void Robot::Draw(const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix,
     shader.setVec3("viewPos", viewPos);
 
     // Robot gövdesini çiz
+    GeometryPool& geometryPool = GeometryPool::GetInstance();
+    geometryPool.Bind();
     for (const auto& mesh : GetMeshes()) {
         // Materyal ayarlarını uygula
         const Material& material = mesh.material;
@@ -143,9 +195,7 @@ void Robot::Draw(const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix,
         }
 
         // Mesh'i çiz
-        glBindVertexArray(mesh.VAO);
-        glDrawElements(GL_TRIANGLES, mesh.indices.size(), GL_UNSIGNED_INT, 0);
-        glBindVertexArray(0);
+        geometryPool.Draw(mesh.geometry);
 
         // Texture'ı cleanle
         if (!mesh.material.diffuseMap.empty()) {
@@ -156,16 +206,13 @@ void Robot::Draw(const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix,
 
     // Kol modeli için model matrisini oluştur
     if (m_ArmModel) {
-        glm::mat4 armModelMatrix = glm::mat4(1.0f);
-        armModelMatrix = glm::translate(armModelMatrix, GetPosition());
-        armModelMatrix = glm::rotate(armModelMatrix, glm::radians(m_RobotRotation), glm::vec3(0.0f, 1.0f, 0.0f));
-        armModelMatrix = glm::rotate(armModelMatrix, glm::radians(m_ArmAngle), glm::vec3(0.0f, 0.0f, 1.0f));
-        armModelMatrix = glm::scale(armModelMatrix, m_ArmScale);
+        glm::mat4 armModelMatrix = GetArmMatrix();
 
         // Kol modelini çiz
         const Shader& armShader = m_ArmModel->GetShader();
         armShader.use();
         armShader.setMat4("model", armModelMatrix);
+        armShader.setMat3("normalMatrix", glm::transpose(glm::inverse(glm::mat3(armModelMatrix))));
         armShader.setMat4("view", viewMatrix);
         armShader.setMat4("projection", projectionMatrix);
         
@@ -198,9 +245,7 @@ void Robot::Draw(const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix,
                 armShader.setBool("material.hasDiffuseMap", false);
             }
 
-            glBindVertexArray(mesh.VAO);
-            glDrawElements(GL_TRIANGLES, mesh.indices.size(), GL_UNSIGNED_INT, 0);
-            glBindVertexArray(0);
+            geometryPool.Draw(mesh.geometry);
 
             // Texture'ı cleanla
             if (!mesh.material.diffuseMap.empty()) {
@@ -209,4 +254,5 @@ void Robot::Draw(const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix,
             }
         }
     }
+    geometryPool.Unbind();
 } 
\ No newline at end of file
@@ -37,7 +37,16 @@ public:
     void Draw(const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix,
         const glm::vec3& lightPos, const glm::vec3& viewPos) override;
 
+    // gövde ve kol kendi matrisleriyle çiziliyor, culling de aynı matrisleri kullanmalı
+    void GetWorldBounds(glm::vec3& outMin, glm::vec3& outMax) const override;
+    // her frame gölge atlasının dinamik katmanına
+    void DrawShadowCaster(Shader& depthShader, const Frustum& lightFrustum) override;
+
 private:
+    // Draw, GetWorldBounds ve DrawShadowCaster aynı matrisleri kullanıyor
+    glm::mat4 GetBodyMatrix() const;
+    glm::mat4 GetArmMatrix() const;
+
     // Kol modlei için pointer atadsim
     std::unique_ptr<MuseumObject> m_ArmModel;
     
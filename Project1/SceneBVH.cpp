@@ -0,0 +1,234 @@
+#include "SceneBVH.h"
+#include <algorithm>
+#include <cfloat>
+
+namespace {
+    float SurfaceArea(const glm::vec3& min, const glm::vec3& max) {
+        glm::vec3 extent = glm::max(max - min, glm::vec3(0.0f));
+        return 2.0f * (extent.x * extent.y + extent.y * extent.z + extent.z * extent.x);
+    }
+}
+
+void SceneBVH::Clear() {
+    items.clear();
+    centroids.clear();
+    order.clear();
+    nodes.clear();
+    depth = 0;
+}
+
+void SceneBVH::Build(const std::vector<Item>& newItems) {
+    Clear();
+    items = newItems;
+    if (items.empty()) {
+        return;
+    }
+
+    centroids.resize(items.size());
+    order.resize(items.size());
+    for (uint32_t i = 0; i < items.size(); ++i) {
+        centroids[i] = (items[i].min + items[i].max) * 0.5f;
+        order[i] = i;
+    }
+
+    nodes.reserve(items.size() * 2 / MAX_LEAF_ITEMS + 1);
+    BuildRecursive(0, static_cast<uint32_t>(items.size()), 1);
+}
+
+void SceneBVH::ComputeNodeBounds(Node& node) const {
+    node.min = glm::vec3(FLT_MAX);
+    node.max = glm::vec3(-FLT_MAX);
+    for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+        node.min = glm::min(node.min, items[order[i]].min);
+        node.max = glm::max(node.max, items[order[i]].max);
+    }
+}
+
+uint32_t SceneBVH::BuildRecursive(uint32_t first, uint32_t count, int level) {
+    uint32_t nodeIndex = static_cast<uint32_t>(nodes.size());
+    nodes.push_back(Node());
+    {
+        Node& node = nodes[nodeIndex];
+        node.first = first;
+        node.count = count;
+        node.left = INVALID_INDEX;
+        node.right = INVALID_INDEX;
+        ComputeNodeBounds(node);
+    }
+    depth = std::max(depth, level);
+
+    if (count <= MAX_LEAF_ITEMS) {
+        return nodeIndex;
+    }
+
+    // merkezlerin sınırları, binler bunun üzerinde
+    glm::vec3 centroidMin(FLT_MAX), centroidMax(-FLT_MAX);
+    for (uint32_t i = first; i < first + count; ++i) {
+        centroidMin = glm::min(centroidMin, centroids[order[i]]);
+        centroidMax = glm::max(centroidMax, centroids[order[i]]);
+    }
+
+    // her eksende binned SAH, en ucuz bölme seçiliyor
+    float bestCost = FLT_MAX;
+    int bestAxis = -1;
+    int bestSplit = 0;
+    for (int axis = 0; axis < 3; ++axis) {
+        float extent = centroidMax[axis] - centroidMin[axis];
+        if (extent <= 1e-6f) {
+            continue;
+        }
+
+        struct Bin {
+            glm::vec3 min = glm::vec3(FLT_MAX);
+            glm::vec3 max = glm::vec3(-FLT_MAX);
+            uint32_t count = 0;
+        } bins[SAH_BINS];
+
+        float scale = SAH_BINS / extent;
+        for (uint32_t i = first; i < first + count; ++i) {
+            uint32_t id = order[i];
+            int b = std::min(SAH_BINS - 1, static_cast<int>((centroids[id][axis] - centroidMin[axis]) * scale));
+            bins[b].min = glm::min(bins[b].min, items[id].min);
+            bins[b].max = glm::max(bins[b].max, items[id].max);
+            bins[b].count++;
+        }
+
+        // soldan ve sağdan birikimli alanlar
+        float leftArea[SAH_BINS - 1], rightArea[SAH_BINS - 1];
+        uint32_t leftCount[SAH_BINS - 1], rightCount[SAH_BINS - 1];
+        glm::vec3 boxMin(FLT_MAX), boxMax(-FLT_MAX);
+        uint32_t sum = 0;
+        for (int b = 0; b < SAH_BINS - 1; ++b) {
+            boxMin = glm::min(boxMin, bins[b].min);
+            boxMax = glm::max(boxMax, bins[b].max);
+            sum += bins[b].count;
+            leftArea[b] = sum > 0 ? SurfaceArea(boxMin, boxMax) : 0.0f;
+            leftCount[b] = sum;
+        }
+        boxMin = glm::vec3(FLT_MAX);
+        boxMax = glm::vec3(-FLT_MAX);
+        sum = 0;
+        for (int b = SAH_BINS - 1; b > 0; --b) {
+            boxMin = glm::min(boxMin, bins[b].min);
+            boxMax = glm::max(boxMax, bins[b].max);
+            sum += bins[b].count;
+            rightArea[b - 1] = sum > 0 ? SurfaceArea(boxMin, boxMax) : 0.0f;
+            rightCount[b - 1] = sum;
+        }
+
+        for (int b = 0; b < SAH_BINS - 1; ++b) {
+            if (leftCount[b] == 0 || rightCount[b] == 0) {
+                continue;
+            }
+            float cost = leftArea[b] * leftCount[b] + rightArea[b] * rightCount[b];
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestAxis = axis;
+                bestSplit = b;
+            }
+        }
+    }
+
+    uint32_t* begin = order.data() + first;
+    uint32_t* end = begin + count;
+    uint32_t* middle;
+    if (bestAxis >= 0) {
+        float extent = centroidMax[bestAxis] - centroidMin[bestAxis];
+        float scale = SAH_BINS / extent;
+        float axisMin = centroidMin[bestAxis];
+        middle = std::partition(begin, end, [&](uint32_t id) {
+            int b = std::min(SAH_BINS - 1, static_cast<int>((centroids[id][bestAxis] - axisMin) * scale));
+            return b <= bestSplit;
+        });
+    }
+    else {
+        // tüm merkezler üst üste, sayıya göre ikiye böl
+        middle = begin + count / 2;
+    }
+
+    uint32_t leftCountFinal = static_cast<uint32_t>(middle - begin);
+    if (leftCountFinal == 0 || leftCountFinal == count) {
+        leftCountFinal = count / 2;
+    }
+
+    uint32_t left = BuildRecursive(first, leftCountFinal, level + 1);
+    uint32_t right = BuildRecursive(first + leftCountFinal, count - leftCountFinal, level + 1);
+    nodes[nodeIndex].left = left;
+    nodes[nodeIndex].right = right;
+    return nodeIndex;
+}
+
+void SceneBVH::SetItemBounds(uint32_t itemId, const glm::vec3& min, const glm::vec3& max) {
+    if (itemId >= items.size()) {
+        return;
+    }
+    items[itemId].min = min;
+    items[itemId].max = max;
+}
+
+void SceneBVH::Refit() {
+    // preorder dizildiği için tersten gitmek çocukları ebeveynden önce işliyor
+    for (size_t i = nodes.size(); i-- > 0;) {
+        Node& node = nodes[i];
+        if (node.left == INVALID_INDEX) {
+            ComputeNodeBounds(node);
+        }
+        else {
+            node.min = glm::min(nodes[node.left].min, nodes[node.right].min);
+            node.max = glm::max(nodes[node.left].max, nodes[node.right].max);
+        }
+    }
+}
+
+void SceneBVH::Cull(const Frustum& frustum, std::vector<uint32_t>& visibleItems, CullStats* stats) const {
+    if (nodes.empty()) {
+        return;
+    }
+
+    struct StackEntry {
+        uint32_t node;
+        unsigned int planeMask;
+    };
+    StackEntry stack[64];
+    int stackSize = 0;
+    stack[stackSize++] = { 0, 0x3Fu };
+
+    while (stackSize > 0) {
+        StackEntry entry = stack[--stackSize];
+        const Node& node = nodes[entry.node];
+        if (stats) stats->nodesVisited++;
+
+        unsigned int planeMask = entry.planeMask;
+        Frustum::Visibility visibility = frustum.ClassifyAABB(node.min, node.max, planeMask);
+        if (visibility == Frustum::Visibility::Outside) {
+            if (stats) stats->subtreesRejected++;
+            continue;
+        }
+        if (visibility == Frustum::Visibility::Inside) {
+            // alt ağacın tamamı görünür, itemlar zaten ardışık
+            visibleItems.insert(visibleItems.end(), order.begin() + node.first, order.begin() + node.first + node.count);
+            if (stats) stats->subtreesAccepted++;
+            continue;
+        }
+
+        if (node.left == INVALID_INDEX) {
+            for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                uint32_t id = order[i];
+                unsigned int itemMask = planeMask;
+                if (frustum.ClassifyAABB(items[id].min, items[id].max, itemMask) != Frustum::Visibility::Outside) {
+                    visibleItems.push_back(id);
+                }
+            }
+            if (stats) stats->itemsTested += node.count;
+            continue;
+        }
+
+        if (stackSize + 2 > 64) {
+            // pratikte olmaz (SAH ağacı dengeli), olursa güvenli tarafta kal
+            visibleItems.insert(visibleItems.end(), order.begin() + node.first, order.begin() + node.first + node.count);
+            continue;
+        }
+        stack[stackSize++] = { node.right, planeMask };
+        stack[stackSize++] = { node.left, planeMask };
+    }
+}
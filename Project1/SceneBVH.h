@@ -0,0 +1,69 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+#include "Frustum.h"
+
+// Sahne objeleri/meshleri üzerinde bounding volume hierarchy
+// SAH (surface area heuristic) ile binned olarak kuruluyor
+// her düğüm kendi alt ağacındaki itemların ardışık aralığını tutuyor, böylece
+// frustum içinde kalan bir düğümün tamamı tek testle kabul ediliyor
+// hareket eden objeler için ağaç yeniden kurulmuyor, sadece kutular güncelleniyor (refit)
+class SceneBVH {
+public:
+    static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+    struct Item {
+        glm::vec3 min;
+        glm::vec3 max;
+        uint32_t object; // çağıranın kullandığı indexler, BVH yorumlamıyor
+        uint32_t mesh;
+    };
+
+    struct CullStats {
+        size_t nodesVisited = 0;
+        size_t subtreesAccepted = 0; // tamamen içeride, test edilmeden kabul
+        size_t subtreesRejected = 0;
+        size_t itemsTested = 0;      // yaprakta tek tek test edilen itemlar
+    };
+
+    // item id = items vektöründeki index
+    void Build(const std::vector<Item>& items);
+    void Clear();
+
+    // kutuyu değiştirir, Refit çağrılana kadar üst düğümler güncellenmiyor
+    void SetItemBounds(uint32_t itemId, const glm::vec3& min, const glm::vec3& max);
+    // alt düğümlerden yukarı doğru tüm kutuları yeniden hesaplar
+    void Refit();
+
+    // görünür itemların id'lerini ekler (temizlemez)
+    void Cull(const Frustum& frustum, std::vector<uint32_t>& visibleItems, CullStats* stats = nullptr) const;
+
+    const Item& GetItem(uint32_t itemId) const { return items[itemId]; }
+    size_t GetItemCount() const { return items.size(); }
+    size_t GetNodeCount() const { return nodes.size(); }
+    int GetDepth() const { return depth; }
+    bool IsEmpty() const { return nodes.empty(); }
+
+private:
+    struct Node {
+        glm::vec3 min;
+        glm::vec3 max;
+        uint32_t first; // order içindeki başlangıç
+        uint32_t count; // alt ağaçtaki item sayısı
+        uint32_t left;  // yaprakta INVALID_INDEX
+        uint32_t right;
+    };
+
+    static constexpr uint32_t MAX_LEAF_ITEMS = 4;
+    static constexpr int SAH_BINS = 12;
+
+    uint32_t BuildRecursive(uint32_t first, uint32_t count, int level);
+    void ComputeNodeBounds(Node& node) const;
+
+    std::vector<Item> items;
+    std::vector<glm::vec3> centroids;
+    std::vector<uint32_t> order; // item id'leri, her düğüm ardışık bir aralık
+    std::vector<Node> nodes;     // preorder, çocukların indexi ebeveynden büyük
+    int depth = 0;
+};
@@ -3,6 +3,9 @@
 #include "Robot.h"
 #include <iostream>
 #include <algorithm>
+#include <chrono>
+#include <random>
+#include "JobSystem.h"
 
 SceneManager::SceneManager()
 	: sceneName("Default Scene"), sceneCenter(0.0f, 0.0f, 0.0f) {
@@ -23,11 +26,20 @@ std::shared_ptr<MuseumObject> SceneManager::AddMuseumObject(const std::string& n
 	auto obj = std::make_shared<MuseumObject>(name, description, modelPath, texturePath,
 		position, scale, rotation);
 	museumObjects.push_back(obj);
+	bvhDirty = true;
 
 	std::cout << "Muze objesi eklendi: " << name << std::endl;
 	return obj;
 }
 
+std::shared_ptr<InstancedObject> SceneManager::AddInstancedObject(const std::string& name, const std::string& modelPath) {
+	auto obj = std::make_shared<InstancedObject>(name, modelPath);
+	instancedObjects.push_back(obj);
+
+	std::cout << "Instanced obje eklendi: " << name << std::endl;
+	return obj;
+}
+
 void SceneManager::RemoveMuseumObject(const std::string& name) {
 	auto it = std::remove_if(museumObjects.begin(), museumObjects.end(),
 		[&name](const std::shared_ptr<MuseumObject>& obj) {
@@ -36,6 +48,7 @@ void SceneManager::RemoveMuseumObject(const std::string& name) {
 
 	if (it != museumObjects.end()) {
 		museumObjects.erase(it, museumObjects.end());
+		bvhDirty = true;
 		std::cout << "Muze objesi silindi: " << name << std::endl;
 	}
 }
@@ -98,8 +111,11 @@ void SceneManager::LoadAdanaMuseumScene() {
 	std::cout << "Adana Muzesi sahnesi yukleniyor..." << std::endl;
 
 	//  muze binasi
-	AddMuseumObject("Muze Binasi", "Muze giris salonu", "models/museum/museum11.obj", "",
+	auto museumBuilding = AddMuseumObject("Muze Binasi", "Muze giris salonu", "models/museum/museum11.obj", "",
 		glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(1.0f), glm::vec3(0.0f));
+	// bina hiç hareket etmiyor, alt meshler materyal + bölgeye göre birleştiriliyor
+	museumBuilding->MakeStatic();
+	bvhDirty = true; // meshler değişti
 
 	// Lahit 1
 	//auto kod okuanabilirliği açısından kullanıldı
@@ -181,6 +197,20 @@ void SceneManager::LoadAdanaMuseumScene() {
 	//AddLight(glm::vec3(-15.0f, 4.0f, 0.0f), glm::vec3(0.9f, 0.9f, 1.0f),
 	//    0.3f, 0.4f, 0.25f, 50.0f);
 
+	// önceden bake edilmiş görünürlük varsa yükle
+	pvsPath = "models/museum/museum11.pvs";
+	if (!pvs.Load(pvsPath)) {
+		std::cout << "PVS bulunamadi (" << pvsPath << "), Frustum penceresinden bake edilebilir" << std::endl;
+	}
+	lightmapPath = "models/museum/museum11.lightmap";
+	if (!lightmap.Load(lightmapPath, museumObjects)) {
+		std::cout << "Lightmap yuklenmedi (" << lightmapPath << "), Render Ayarlari penceresinden bake edilebilir" << std::endl;
+	}
+	probeVolumePath = "models/museum/museum11.probes";
+	if (!irradianceVolume.Load(probeVolumePath)) {
+		std::cout << "Irradiance problari yuklenmedi (" << probeVolumePath << "), Render Ayarlari penceresinden bake edilebilir" << std::endl;
+	}
+
 	std::cout << "Adana Muzesi sahnesi yuklendi. Objeler: " << GetObjectCount()
 		<< ", Isikklar: " << GetLightCount() << std::endl;
 }
@@ -199,8 +229,56 @@ void SceneManager::LoadTestScene() {
 	std::cout << "Test sahnesi yuklendi" << std::endl;
 }*/
 
+// depo salonu: müzenin arkasında sıra sıra dizilmiş küçük lahit replikaları
+// her model tipi tek instanced obje, toplam 100 x 50 = 5000 kopya
+void SceneManager::LoadStorageHallScene() {
+	const char* modelPaths[] = {
+		"models/lahit2/lahit2.obj",
+		"models/lahit4/lahit4.obj",
+		"models/lahit5/lahit5.obj"
+	};
+
+	std::vector<std::shared_ptr<InstancedObject>> hallObjects;
+	for (int i = 0; i < 3; ++i) {
+		hallObjects.push_back(AddInstancedObject("Depo " + std::to_string(i + 1), modelPaths[i]));
+	}
+
+	const int COLUMNS = 100;
+	const int ROWS = 50;
+	std::mt19937 rng(42); // her açılışta aynı dizilim
+	std::uniform_real_distribution<float> jitter(-10.0f, 10.0f);
+	std::uniform_real_distribution<float> shade(0.8f, 1.0f);
+
+	for (int row = 0; row < ROWS; ++row) {
+		auto& hallObject = hallObjects[row % hallObjects.size()];
+		for (int col = 0; col < COLUMNS; ++col) {
+			glm::vec3 position(-30.0f + col * 0.6f, 0.0f, -30.0f - row * 0.7f);
+			float tone = shade(rng);
+			hallObject->AddInstance(position, glm::vec3(0.15f), glm::vec3(0.0f, jitter(rng), 0.0f),
+				glm::vec4(tone, tone, tone * 0.95f, 1.0f));
+		}
+	}
+
+	size_t total = 0;
+	for (auto& hallObject : hallObjects) {
+		total += hallObject->GetInstanceCount();
+	}
+	std::cout << "Depo salonu yuklendi. Kopya sayisi: " << total << std::endl;
+}
+
 void SceneManager::ClearScene() {
 	museumObjects.clear();
+	instancedObjects.clear();
+	bvhDirty = true;
+	if (occlusionCuller) {
+		occlusionCuller->Reset();
+	}
+	pvs.Clear();
+	pvsPath.clear();
+	lightmap.Clear();
+	lightmapPath.clear();
+	irradianceVolume.Clear();
+	probeVolumePath.clear();
 	lights.clear();
 	//lightCubes.clear();
 	std::cout << "Sahne temizlendi" << std::endl;
@@ -224,21 +302,125 @@ void SceneManager::Draw(const glm::mat4& view, const glm::mat4& projection,
 		frustum.Update(view, projection);
 	}
 
+	// shading LOD varyantları ışık uniformlarını SetupLightsForShaders'ta alıyor
+	if ((useShadingLod || shadingLodBenchmarkRequested) && !shadingLod) {
+		shadingLod = std::make_unique<ShadingLod>();
+	}
+	if (shadingLod) {
+		GLint viewport[4];
+		glGetIntegerv(GL_VIEWPORT, viewport);
+		shadingLod->SetSettings(shadingLodSettings);
+		shadingLod->BeginFrame(cameraPosition, projection[1][1] * viewport[3] * 0.5f);
+	}
+
 	// Tüm shader'lar için ışık ayarları
 	SetupLightsForShaders();
+	if (useClusteredLighting) {
+		ApplyLightClusters(view, projection);
+	}
 
-	// Müze objelerini çiz
-	for (auto& obj : museumObjects) {
-		// Frustum culling kontrolü
-		if (enableFrustumCulling && !obj->IsVisible(frustum)) {
-			continue; // Görünür değilse çizme
+	cullStats = FrustumCullStats();
+
+	auto submitStart = std::chrono::high_resolution_clock::now();
+
+	bool indirect = useIndirectDraw && IndirectRenderer::IsSupported();
+	// GPU culling açıksa tüm objeler ekleniyor, görünürlüğü compute shader belirliyor
+	bool gpuCulling = indirect && enableFrustumCulling && useGpuCulling && GpuCuller::IsSupported();
+	bool cpuCulling = enableFrustumCulling && !gpuCulling;
+
+	// PVS hücresi: sahne bake edilenden farklıysa ya da kamera binanın dışındaysa kullanılmıyor
+	pvsCellBits = nullptr;
+	pvsStats = PVSCullStats();
+	if (usePVS && pvs.IsLoaded() && pvs.MatchesScene(museumObjects)) {
+		pvsStats.cell = pvs.FindCell(cameraPosition);
+		if (pvsStats.cell >= 0) {
+			pvsCellBits = &pvs.DecodeCell(pvsStats.cell);
 		}
+	}
 
-		// Her obje için ana ışık kullanılıyor
-		glm::vec3 lightPos = lights.empty() ? glm::vec3(0.0f) : lights[0].GetPosition();
-		obj->Draw(view, projection, lightPos, cameraPosition);
+	bvhCulledThisFrame = cpuCulling && useBVHCulling;
+	if (bvhCulledThisFrame) {
+		CullWithBVH();
 	}
 
+	// görünür objeler, ardından büyük meshlerin kümeleri worker threadlerde eleniyor
+	drawObjects.clear();
+	for (size_t i = 0; i < museumObjects.size(); ++i) {
+		if (PrepareObjectForDraw(i, cpuCulling)) {
+			drawObjects.push_back(museumObjects[i].get());
+		}
+	}
+	if (cpuCulling && useSoftwareOcclusion) {
+		ApplySoftwareOcclusion(view, projection);
+	}
+	CullClusters(cameraPosition, cpuCulling);
+
+	if (lightingBenchmarkRequested) {
+		lightingBenchmarkRequested = false;
+		RunLightingBenchmark(view, projection, cameraPosition);
+	}
+	if (impostorBenchmarkRequested) {
+		impostorBenchmarkRequested = false;
+		RunImpostorBenchmark(view, projection, cameraPosition);
+	}
+	if (shadingLodBenchmarkRequested) {
+		shadingLodBenchmarkRequested = false;
+		RunShadingLodBenchmark(view, projection, cameraPosition);
+	}
+
+	// gölge atlası renk geçişinden önce, statik katman önbellekte kaldıkça sadece robotu gören tile'lar çiziliyor
+	UpdateShadows();
+
+	// occlusion culling objeleri tek tek koşullu çiziyor, indirect yolun yerine geçiyor
+	bool occlusion = useOcclusionCulling && !gpuCulling;
+
+	if (useDeferredShading) {
+		DrawLitObjects(view, projection, cameraPosition, true);
+	}
+	else {
+		// ön geçiş bir kere açıldıysa kapalıyken de karşılaştırma için ölçmeye devam ediyor
+		if (useDepthPrepass && !depthPrepass) {
+			depthPrepass = std::make_unique<DepthPrepass>();
+		}
+		if (depthPrepass) {
+			if (depthPrepass->BeginFrame(useDepthPrepass)) {
+				depthPrepass->DrawDepth(drawObjects, view, projection);
+			}
+			// occlusion yolu aynı tür sorguları kullanıyor, orada renk geçişi ölçülmüyor
+			depthPrepass->BeginColorPass(!occlusion);
+		}
+
+		if (occlusion) {
+			DrawWithOcclusionCulling(view, projection, cameraPosition);
+		}
+		else if (indirect) {
+			// GL 4.3+: görünür meshler bucketlara toplanıp tek seferde gönderiliyor
+			if (!indirectRenderer) {
+				indirectRenderer = std::make_unique<IndirectRenderer>();
+			}
+
+			indirectRenderer->BeginFrame();
+			for (MuseumObject* obj : drawObjects) {
+				indirectRenderer->AddObject(*obj);
+			}
+			indirectRenderer->Submit(view, projection, cameraPosition, lights.empty() ? nullptr : &lights[0],
+				gpuCulling ? &frustum : nullptr);
+		}
+		else {
+			DrawLitObjects(view, projection, cameraPosition, false);
+		}
+
+		if (depthPrepass) {
+			depthPrepass->EndColorPass();
+		}
+	}
+
+	// instanced objeler: kopyalar tek tek culling'den geçip tek çağrıda çiziliyor, uzaktakiler impostor
+	DrawInstancedObjects(view, projection, cameraPosition, useImpostors);
+
+	lastSubmitTimeMs = std::chrono::duration<float, std::milli>(
+		std::chrono::high_resolution_clock::now() - submitStart).count();
+
 	// Light cube'lari ben  bunu testlerde kullnyorum
 	/*
 	for (auto& lightCube : lightCubes) {
@@ -250,6 +432,708 @@ void SceneManager::Draw(const glm::mat4& view, const glm::mat4& projection,
 	imguiManager->UpdateArtifactInfo(museumObjects, cameraPosition);
 }
 
+void SceneManager::DrawPanorama(const glm::vec3& center) {
+	if (!cubemapCapture) {
+		cubemapCapture = std::make_unique<CubemapCapture>();
+	}
+
+	// altı 90 derecelik yüzün birleşimi merkezde kenarı 2*far olan küp: ortografik bir "frustum" ile tam o kutu,
+	// BVH ve mesh testleri yüz başına değil bir kere. Kameranın frustum'u Draw için geri yükleniyor
+	float farPlane = cubemapCapture->GetFarPlane();
+	Frustum cameraFrustum = frustum;
+	frustum.Update(glm::translate(glm::mat4(1.0f), -center),
+		glm::ortho(-farPlane, farPlane, -farPlane, farPlane, -farPlane, farPlane));
+
+	cullStats = FrustumCullStats();
+	bool cpuCulling = enableFrustumCulling;
+
+	// PVS hücresinin görünürlüğü yönden bağımsız, panoramada da geçerli
+	pvsCellBits = nullptr;
+	pvsStats = PVSCullStats();
+	if (usePVS && pvs.IsLoaded() && pvs.MatchesScene(museumObjects)) {
+		pvsStats.cell = pvs.FindCell(center);
+		if (pvsStats.cell >= 0) {
+			pvsCellBits = &pvs.DecodeCell(pvsStats.cell);
+		}
+	}
+
+	bvhCulledThisFrame = cpuCulling && useBVHCulling;
+	if (bvhCulledThisFrame) {
+		CullWithBVH();
+	}
+	drawObjects.clear();
+	for (size_t i = 0; i < museumObjects.size(); ++i) {
+		if (PrepareObjectForDraw(i, cpuCulling)) {
+			// küme listeleri ana kameranın frustum'undan, küpte meshler bütün çiziliyor
+			museumObjects[i]->BeginClusterCulling(nullptr, center, false);
+			drawObjects.push_back(museumObjects[i].get());
+		}
+	}
+	frustum = cameraFrustum;
+
+	// kümeli ışıklar ekran uzayında, katmanlı varyant düz listeyi kullanıyor
+	SetupLightsForShaders();
+	const Shader& layeredShader = cubemapCapture->GetLayeredShader();
+	if (!lights.empty()) {
+		ShaderSetup::SetupLight(layeredShader, lights[0]);
+	}
+	UpdateShadows();
+
+	if (!cubemapCapture->BeginCube(center)) {
+		return;
+	}
+	glm::vec3 lightPos = lights.empty() ? glm::vec3(0.0f) : lights[0].GetPosition();
+	for (MuseumObject* obj : drawObjects) {
+		obj->DrawCubemap(layeredShader, lightPos, center);
+	}
+	cubemapCapture->EndCube();
+}
+
+void SceneManager::DrawLitObjects(const glm::mat4& view, const glm::mat4& projection,
+	const glm::vec3& cameraPosition, bool deferred) {
+	if (deferred) {
+		if (!deferredRenderer) {
+			deferredRenderer = std::make_unique<DeferredRenderer>();
+		}
+		if (dynamicLights.empty()) {
+			deferredRenderer->Render(drawObjects, lights, view, projection, cameraPosition);
+			return;
+		}
+		// hareketli ışıklar ışık geçişine sahnenin ışıklarıyla birlikte, forward'daki gibi ambient'siz
+		std::vector<Light> allLights = lights;
+		for (const Light* light : dynamicLights) {
+			allLights.push_back(*light);
+			allLights.back().SetAmbientStrength(0.0f);
+		}
+		deferredRenderer->Render(drawObjects, allLights, view, projection, cameraPosition);
+		return;
+	}
+
+	// Müze objelerini çiz, ilk ışık uniform ile geri kalanlar LightBuffer'dan
+	glm::vec3 lightPos = lights.empty() ? glm::vec3(0.0f) : lights[0].GetPosition();
+	for (MuseumObject* obj : drawObjects) {
+		DrawForwardObject(obj, view, projection, lightPos, cameraPosition);
+	}
+}
+
+void SceneManager::DrawForwardObject(MuseumObject* obj, const glm::mat4& view, const glm::mat4& projection,
+	const glm::vec3& lightPos, const glm::vec3& cameraPosition) {
+	if (useShadingLod && shadingLod) {
+		shadingLod->Draw(*obj, view, projection, lightPos, cameraPosition);
+	}
+	else {
+		obj->Draw(view, projection, lightPos, cameraPosition);
+	}
+}
+
+double SceneManager::MeasureGpuMs(const std::function<void()>& drawPass, const std::function<void()>& beginFrame) {
+	GLuint timestamps[2];
+	glGenQueries(2, timestamps);
+	double totalMs = 0.0;
+	for (int frame = 0; frame < BENCHMARK_WARMUP_FRAMES + BENCHMARK_MEASURED_FRAMES; ++frame) {
+		if (beginFrame) {
+			beginFrame();
+		}
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		glQueryCounter(timestamps[0], GL_TIMESTAMP);
+		drawPass();
+		glQueryCounter(timestamps[1], GL_TIMESTAMP);
+
+		GLuint64 start = 0;
+		GLuint64 end = 0;
+		glGetQueryObjectui64v(timestamps[0], GL_QUERY_RESULT, &start);
+		glGetQueryObjectui64v(timestamps[1], GL_QUERY_RESULT, &end);
+		if (frame >= BENCHMARK_WARMUP_FRAMES) {
+			totalMs += (end - start) / 1.0e6;
+		}
+	}
+	glDeleteQueries(2, timestamps);
+	return totalMs / BENCHMARK_MEASURED_FRAMES;
+}
+
+void SceneManager::RunLightingBenchmark(const glm::mat4& view, const glm::mat4& projection,
+	const glm::vec3& cameraPosition) {
+	const size_t lightCounts[] = { 1, 16, 128 };
+
+	// sahnenin ışıkları yerine kameranın çevresine sabit seed ile dağıtılmış nokta ışıklar
+	std::vector<Light> savedLights = lights;
+	lightingBenchmarkResults.clear();
+	// lightmap'li kabuk ve problar test ışıklarını hesaplamıyor, ölçüm boyunca kapalı
+	// gölge tile'ları sahnenin ışıklarına dağıtıldı, test ışıkları gölgesiz
+	if (shadowAtlas) {
+		shadowAtlas->Disable();
+	}
+	bool savedLightmap = useLightmap;
+	bool savedProbeVolume = useProbeVolume;
+	useLightmap = false;
+	useProbeVolume = false;
+
+	for (size_t lightCount : lightCounts) {
+		std::mt19937 rng(1234);
+		std::uniform_real_distribution<float> offset(-12.0f, 12.0f);
+		std::uniform_real_distribution<float> height(0.5f, 4.0f);
+		std::uniform_real_distribution<float> channel(0.4f, 1.0f);
+		lights.clear();
+		for (size_t i = 0; i < lightCount; ++i) {
+			glm::vec3 position = cameraPosition + glm::vec3(offset(rng), 0.0f, offset(rng));
+			position.y = height(rng);
+			lights.emplace_back(position, glm::vec3(channel(rng), channel(rng), channel(rng)), 0.02f, 1.0f, 0.8f, 6.0f);
+		}
+
+		// 0: forward (düz liste), 1: kümelenmiş forward, 2: deferred
+		DeferredRenderer::BenchmarkResult result;
+		result.lightCount = lightCount;
+		for (int mode = 0; mode < 3; ++mode) {
+			SetupLightsForShaders();
+			if (mode == 1) {
+				ApplyLightClusters(view, projection);
+			}
+			double averageMs = MeasureGpuMs([&]() {
+				DrawLitObjects(view, projection, cameraPosition, mode == 2);
+			});
+			(mode == 0 ? result.forwardMs : mode == 1 ? result.clusteredMs : result.deferredMs) = averageMs;
+		}
+		lightingBenchmarkResults.push_back(result);
+		std::cout << "Aydinlatma benchmark: " << lightCount << " isik, forward " << result.forwardMs
+			<< " ms, kumelenmis " << result.clusteredMs << " ms, deferred " << result.deferredMs << " ms" << std::endl;
+	}
+
+	lights = savedLights;
+	useLightmap = savedLightmap;
+	useProbeVolume = savedProbeVolume;
+	SetupLightsForShaders();
+	if (useClusteredLighting) {
+		ApplyLightClusters(view, projection);
+	}
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+}
+
+void SceneManager::DrawInstancedObjects(const glm::mat4& view, const glm::mat4& projection,
+	const glm::vec3& cameraPosition, bool impostors) {
+	// ekrandaki boy: yarıçap * projection[1][1] * viewport yüksekliği / 2 / uzaklık
+	GLint viewport[4];
+	glGetIntegerv(GL_VIEWPORT, viewport);
+	InstancedObject::LodParams lod = impostorLod;
+	lod.cameraPosition = cameraPosition;
+	lod.pixelsPerUnit = projection[1][1] * viewport[3] * 0.5f;
+
+	glm::vec3 lightPos = lights.empty() ? glm::vec3(0.0f) : lights[0].GetPosition();
+	for (auto& obj : instancedObjects) {
+		obj->CullInstances(enableFrustumCulling ? &frustum : nullptr, impostors ? &lod : nullptr);
+		obj->Draw(view, projection, lightPos, cameraPosition);
+	}
+}
+
+void SceneManager::RunImpostorBenchmark(const glm::mat4& view, const glm::mat4& projection,
+	const glm::vec3& cameraPosition) {
+	impostorBenchmarkResult = Impostor::BenchmarkResult();
+	if (instancedObjects.empty()) {
+		std::cout << "Impostor benchmark: instanced obje yok (depo salonu yuklenmeli)" << std::endl;
+		return;
+	}
+
+	// 0: tüm görünür kopyalar mesh, 1: uzaktakiler impostor (atlaslar ilk ısınma frame'inde yakalanıyor)
+	for (int mode = 0; mode < 2; ++mode) {
+		(mode == 0 ? impostorBenchmarkResult.meshOnlyMs : impostorBenchmarkResult.impostorMs) = MeasureGpuMs([&]() {
+			DrawInstancedObjects(view, projection, cameraPosition, mode == 1);
+		});
+	}
+
+	for (auto& obj : instancedObjects) {
+		impostorBenchmarkResult.visibleInstances += obj->GetVisibleInstanceCount();
+		impostorBenchmarkResult.impostorInstances += obj->GetImpostorInstanceCount();
+		impostorBenchmarkResult.meshInstances += obj->GetMeshInstanceCount();
+		if (obj->GetImpostor()) {
+			impostorBenchmarkResult.textureBytes += obj->GetImpostor()->GetTextureBytes();
+		}
+	}
+	std::cout << "Impostor benchmark: " << impostorBenchmarkResult.visibleInstances << " gorunur kopya, mesh "
+		<< impostorBenchmarkResult.meshOnlyMs << " ms, impostorlu " << impostorBenchmarkResult.impostorMs << " ms ("
+		<< impostorBenchmarkResult.impostorInstances << " impostor, " << impostorBenchmarkResult.meshInstances
+		<< " mesh), atlaslar " << impostorBenchmarkResult.textureBytes << " byte" << std::endl;
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+}
+
+void SceneManager::RunShadingLodBenchmark(const glm::mat4& view, const glm::mat4& projection,
+	const glm::vec3& cameraPosition) {
+	shadingLodBenchmarkResult = ShadingLod::BenchmarkResult();
+	if (useDeferredShading) {
+		std::cout << "Shading LOD benchmark: deferred modda kullanilmiyor" << std::endl;
+		return;
+	}
+
+	GLint viewport[4];
+	glGetIntegerv(GL_VIEWPORT, viewport);
+	float pixelsPerUnit = projection[1][1] * viewport[3] * 0.5f;
+	glm::vec3 lightPos = lights.empty() ? glm::vec3(0.0f) : lights[0].GetPosition();
+	bool savedShadingLod = useShadingLod;
+	useShadingLod = true;
+
+	// 0-2: tüm meshler o seviyede, 3: otomatik seçim. Görüntüler son frame'den, 0 (tam PBR) referans
+	std::vector<unsigned char> reference;
+	std::vector<unsigned char> image(static_cast<size_t>(viewport[2]) * viewport[3] * 4);
+	for (int mode = 0; mode <= ShadingLod::LEVEL_COUNT; ++mode) {
+		ShadingLod::Settings settings = shadingLodSettings;
+		settings.forcedLevel = mode < ShadingLod::LEVEL_COUNT ? mode : -1;
+		shadingLod->SetSettings(settings);
+		shadingLodBenchmarkResult.gpuMs[mode] = MeasureGpuMs([&]() {
+			for (MuseumObject* obj : drawObjects) {
+				DrawForwardObject(obj, view, projection, lightPos, cameraPosition);
+			}
+		}, [&]() {
+			shadingLod->BeginFrame(cameraPosition, pixelsPerUnit);
+		});
+
+		glPixelStorei(GL_PACK_ALIGNMENT, 1);
+		glReadPixels(viewport[0], viewport[1], viewport[2], viewport[3], GL_RGBA, GL_UNSIGNED_BYTE, image.data());
+		if (mode == 0) {
+			reference = image;
+		}
+		ShadingLod::CompareImages(reference, image, shadingLodBenchmarkResult.meanDiff[mode],
+			shadingLodBenchmarkResult.changedPixels[mode], shadingLodBenchmarkResult.maxDiff[mode]);
+	}
+	for (int level = 0; level < ShadingLod::LEVEL_COUNT; ++level) {
+		shadingLodBenchmarkResult.autoMeshes[level] = shadingLod->GetStats().meshes[level];
+	}
+	shadingLodBenchmarkResult.valid = true;
+
+	useShadingLod = savedShadingLod;
+	shadingLod->SetSettings(shadingLodSettings);
+	shadingLod->BeginFrame(cameraPosition, pixelsPerUnit);
+
+	const char* modeNames[] = { "tam", "blinn-phong", "daginik", "otomatik" };
+	for (int mode = 0; mode <= ShadingLod::LEVEL_COUNT; ++mode) {
+		std::cout << "Shading LOD benchmark: " << modeNames[mode] << " " << shadingLodBenchmarkResult.gpuMs[mode]
+			<< " ms, ortalama fark " << shadingLodBenchmarkResult.meanDiff[mode] << ", degisen piksel %"
+			<< shadingLodBenchmarkResult.changedPixels[mode] * 100.0 << ", en buyuk fark "
+			<< shadingLodBenchmarkResult.maxDiff[mode] << std::endl;
+	}
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+}
+
+void SceneManager::ApplyLightClusters(const glm::mat4& view, const glm::mat4& projection) {
+	if (!clusteredLighting) {
+		clusteredLighting = std::make_unique<ClusteredLighting>();
+	}
+	clusteredLighting->Update(lights, 1, view, projection);
+	lightBuffer->EnableClusters(clusteredLighting->GetShaderParams());
+	clusteredLighting->Bind();
+}
+
+void SceneManager::AddArtifactSpotLights() {
+	size_t added = 0;
+	for (auto& obj : museumObjects) {
+		if (obj->IsStatic()) {
+			continue;
+		}
+		glm::vec3 boundsMin, boundsMax;
+		obj->GetWorldBounds(boundsMin, boundsMax);
+		glm::vec3 center = (boundsMin + boundsMax) * 0.5f;
+		glm::vec3 position(center.x, boundsMax.y + 1.5f, center.z);
+		float range = position.y - boundsMin.y + 2.0f;
+		lights.emplace_back(position, glm::vec3(1.0f, 0.95f, 0.85f), 0.02f, 1.0f, 0.8f, range,
+			Light::Type::SPOT, glm::vec3(0.0f, -1.0f, 0.0f), 30.0f, 40.0f);
+		added++;
+	}
+	std::cout << added << " esere spot isik eklendi. Toplam isik sayisi: " << lights.size() << std::endl;
+}
+
+bool SceneManager::PrepareObjectForDraw(size_t objectIndex, bool cpuCulling) {
+	MuseumObject& obj = *museumObjects[objectIndex];
+
+	// bulunduğumuz hücreden hiç görünmeyen obje frustum testine girmiyor
+	if (pvsCellBits && !pvs.IsObjectVisible(*pvsCellBits, objectIndex)) {
+		pvsStats.objectsRejected++;
+		return false;
+	}
+
+	bool visible = true;
+	if (!cpuCulling) {
+		obj.CullMeshes(nullptr);
+	}
+	else if (bvhCulledThisFrame) {
+		// BVH meshlerin görünürlüğünü zaten yazdı
+		visible = obj.GetVisibleMeshCount() > 0;
+	}
+	else {
+		cullStats.objectsTested++;
+		if (!obj.IsVisible(frustum)) {
+			cullStats.objectsCulled++;
+			return false;
+		}
+		// obje görünse bile duvar/zemin gibi meshleri tek tek ele
+		obj.CullMeshes(&frustum, &cullStats);
+	}
+
+	if (!visible || !pvsCellBits) {
+		return visible;
+	}
+
+	// hücreden görünmeyen chunklar (başka salonların duvarları vs.)
+	if (!cpuCulling) {
+		obj.ResetMeshVisibility(true);
+	}
+	size_t meshCount = obj.GetMeshes().size();
+	for (size_t m = 0; m < meshCount; ++m) {
+		if (obj.IsMeshVisible(m) && !pvs.IsMeshVisible(*pvsCellBits, objectIndex, m)) {
+			obj.SetMeshVisible(m, false);
+			pvsStats.meshesRejected++;
+		}
+	}
+	return obj.GetVisibleMeshCount() > 0;
+}
+
+bool SceneManager::BakeLightmap(const Lightmap::BakeSettings& settings) {
+	if (lightmapPath.empty()) {
+		std::cerr << "Lightmap bake: sahnenin lightmap dosyasi yok" << std::endl;
+		return false;
+	}
+	if (!lightmap.Bake(museumObjects, lights, settings)) {
+		return false;
+	}
+	return lightmap.Save(lightmapPath);
+}
+
+bool SceneManager::BakeProbeVolume(const IrradianceVolume::BakeSettings& settings) {
+	if (probeVolumePath.empty()) {
+		std::cerr << "Irradiance volume bake: sahnenin prob dosyasi yok" << std::endl;
+		return false;
+	}
+	if (!irradianceVolume.Bake(museumObjects, lights, settings)) {
+		return false;
+	}
+	return irradianceVolume.Save(probeVolumePath);
+}
+
+bool SceneManager::BakePVS(const PotentiallyVisibleSet::BakeSettings& settings) {
+	if (pvsPath.empty()) {
+		std::cerr << "PVS bake: sahnenin PVS dosyasi yok" << std::endl;
+		return false;
+	}
+	if (!pvs.Bake(museumObjects, settings)) {
+		return false;
+	}
+	return pvs.Save(pvsPath);
+}
+
+void SceneManager::ApplySoftwareOcclusion(const glm::mat4& view, const glm::mat4& projection) {
+	if (!softwareOcclusion) {
+		softwareOcclusion = std::make_unique<SoftwareOcclusion>();
+	}
+
+	// occluderlar sadece görünür statik objelerden (görünmeyen bina parçası da bir şey kapatmaz)
+	softwareOcclusion->BeginFrame(projection * view);
+	for (MuseumObject* obj : drawObjects) {
+		if (obj->IsStatic()) {
+			softwareOcclusion->AddOccluders(obj->GetOccluderTriangles());
+		}
+	}
+	softwareOcclusion->Rasterize();
+
+	// statik objelerde chunk bazında, diğerlerinde obje kutusuyla test
+	// occluder olan chunklar kendilerinin önünde kaldığı için elenmiyor (kutunun en yakın noktası)
+	size_t kept = 0;
+	for (MuseumObject* obj : drawObjects) {
+		glm::vec3 boundsMin, boundsMax;
+		if (obj->IsStatic()) {
+			size_t meshCount = obj->GetMeshes().size();
+			for (size_t m = 0; m < meshCount; ++m) {
+				if (!obj->IsMeshVisible(m)) {
+					continue;
+				}
+				obj->GetMeshWorldBounds(m, boundsMin, boundsMax);
+				if (!softwareOcclusion->IsBoxVisible(boundsMin, boundsMax)) {
+					obj->SetMeshVisible(m, false);
+				}
+			}
+			if (obj->GetVisibleMeshCount() == 0) {
+				continue;
+			}
+		}
+		else {
+			obj->GetWorldBounds(boundsMin, boundsMax);
+			if (!softwareOcclusion->IsBoxVisible(boundsMin, boundsMax)) {
+				continue;
+			}
+		}
+		drawObjects[kept++] = obj;
+	}
+	drawObjects.resize(kept);
+
+	// robot gibi kayıtlı dinamik objeler de aynı bufferla test ediliyor
+	if (bvhCulledThisFrame) {
+		for (size_t i = 0; i < dynamicObjects.size() && i < dynamicVisible.size(); ++i) {
+			if (!dynamicVisible[i]) {
+				continue;
+			}
+			glm::vec3 boundsMin, boundsMax;
+			dynamicObjects[i]->GetWorldBounds(boundsMin, boundsMax);
+			if (!softwareOcclusion->IsBoxVisible(boundsMin, boundsMax)) {
+				dynamicVisible[i] = 0;
+			}
+		}
+	}
+}
+
+void SceneManager::DrawWithOcclusionCulling(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& cameraPosition) {
+	if (!occlusionCuller) {
+		occlusionCuller = std::make_unique<OcclusionCuller>();
+	}
+	glm::vec3 lightPos = lights.empty() ? glm::vec3(0.0f) : lights[0].GetPosition();
+
+	occlusionCuller->BeginFrame(projection * view, cameraPosition);
+
+	// önce büyük occluderlar (statik bina kabuğu), derinlik bufferını onlar dolduruyor
+	occlusionCandidates.clear();
+	for (MuseumObject* obj : drawObjects) {
+		if (obj->IsStatic()) {
+			DrawForwardObject(obj, view, projection, lightPos, cameraPosition);
+		}
+		else {
+			occlusionCandidates.push_back(obj);
+		}
+	}
+
+	// adaylar geçen frame'in query sonucuna göre, CPU beklemeden
+	occlusionCuller->BeginCandidatePass();
+	for (MuseumObject* obj : occlusionCandidates) {
+		bool conditional = occlusionCuller->BeginConditionalDraw(obj);
+		DrawForwardObject(obj, view, projection, lightPos, cameraPosition);
+		if (conditional) {
+			occlusionCuller->EndConditionalDraw();
+		}
+	}
+	occlusionCuller->EndCandidatePass();
+
+	// derinlik tamamlandıktan sonra sonraki frame için kutular
+	occlusionCuller->IssueQueries(occlusionCandidates);
+	occlusionCuller->EndFrame();
+}
+
+void SceneManager::CullClusters(const glm::vec3& cameraPosition, bool cpuCulling) {
+	clusterStats = ClusterCullStats();
+	clusterJobs.clear();
+
+	// GPU culling açıkken görünürlük GPU'da, kümeler de bütün çiziliyor
+	bool enabled = cpuCulling && useClusterCulling;
+	for (MuseumObject* obj : drawObjects) {
+		obj->BeginClusterCulling(enabled ? &frustum : nullptr, cameraPosition, useClusterConeCulling);
+		if (!enabled) {
+			continue;
+		}
+		const auto& meshes = obj->GetMeshes();
+		for (size_t m = 0; m < meshes.size(); ++m) {
+			if (!obj->GetClusterDrawList(m)) {
+				continue;
+			}
+			// tek parça büyük taramalar da birden fazla threade bölünsün
+			size_t meshletCount = meshes[m].meshlets.size();
+			for (size_t first = 0; first < meshletCount; first += CLUSTER_JOB_SIZE) {
+				clusterJobs.push_back({ obj, m, first, std::min(meshletCount, first + CLUSTER_JOB_SIZE) });
+			}
+		}
+	}
+	if (clusterJobs.empty()) {
+		return;
+	}
+
+	JobSystem::GetInstance().ParallelFor(clusterJobs.size(), 1, [this](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			const ClusterJob& job = clusterJobs[i];
+			job.object->CullClusters(job.meshIndex, job.firstMeshlet, job.lastMeshlet);
+		}
+	});
+
+	for (MuseumObject* obj : drawObjects) {
+		for (size_t m = 0; m < obj->GetMeshes().size(); ++m) {
+			if (!obj->GetClusterDrawList(m)) {
+				continue;
+			}
+			obj->FinishClusterCulling(m);
+			const ClusterCullStats& stats = obj->GetClusterDrawList(m)->stats;
+			clusterStats.clustersTested += stats.clustersTested;
+			clusterStats.culledByFrustum += stats.culledByFrustum;
+			clusterStats.culledByCone += stats.culledByCone;
+			clusterStats.trianglesTotal += stats.trianglesTotal;
+			clusterStats.trianglesSubmitted += stats.trianglesSubmitted;
+		}
+	}
+}
+
+void SceneManager::RegisterDynamicLight(const Light* light, const MuseumObject* owner) {
+	if (light && std::find(dynamicLights.begin(), dynamicLights.end(), light) == dynamicLights.end()) {
+		dynamicLights.push_back(light);
+		dynamicLightOwners.push_back(owner);
+	}
+}
+
+void SceneManager::UnregisterDynamicLight(const Light* light) {
+	auto it = std::find(dynamicLights.begin(), dynamicLights.end(), light);
+	if (it != dynamicLights.end()) {
+		dynamicLightOwners.erase(dynamicLightOwners.begin() + (it - dynamicLights.begin()));
+		dynamicLights.erase(it);
+	}
+}
+
+void SceneManager::SetShadowSettings(const ShadowAtlas::Settings& settings) {
+	shadowSettings = settings;
+	if (shadowAtlas) {
+		shadowAtlas->SetSettings(shadowSettings);
+	}
+}
+
+void SceneManager::UpdateShadows() {
+	if (!shadowAtlas) {
+		shadowAtlas = std::make_unique<ShadowAtlas>();
+		shadowAtlas->SetSettings(shadowSettings);
+	}
+	// deferred ışık geçişi gölge okumuyor
+	if (useShadows && !useDeferredShading) {
+		std::vector<MuseumObject*> staticCasters;
+		staticCasters.reserve(museumObjects.size());
+		for (auto& obj : museumObjects) {
+			staticCasters.push_back(obj.get());
+		}
+		shadowAtlas->Update(lights, dynamicLights, dynamicLightOwners, staticCasters, dynamicObjects);
+	}
+	else {
+		shadowAtlas->Disable();
+	}
+	shadowAtlas->Bind();
+}
+
+void SceneManager::RegisterDynamicObject(MuseumObject* object) {
+	if (object && std::find(dynamicObjects.begin(), dynamicObjects.end(), object) == dynamicObjects.end()) {
+		dynamicObjects.push_back(object);
+		bvhDirty = true;
+	}
+}
+
+void SceneManager::UnregisterDynamicObject(MuseumObject* object) {
+	auto it = std::find(dynamicObjects.begin(), dynamicObjects.end(), object);
+	if (it != dynamicObjects.end()) {
+		dynamicObjects.erase(it);
+		bvhDirty = true;
+	}
+}
+
+bool SceneManager::IsDynamicObjectVisible(const MuseumObject* object) const {
+	if (!bvhCulledThisFrame) {
+		return true;
+	}
+	for (size_t i = 0; i < dynamicObjects.size(); ++i) {
+		if (dynamicObjects[i] == object) {
+			return i < dynamicVisible.size() && dynamicVisible[i] != 0;
+		}
+	}
+	return true;
+}
+
+void SceneManager::RebuildBVH() {
+	std::vector<SceneBVH::Item> items;
+	bvhObjectFirstItem.assign(museumObjects.size(), 0);
+	bvhTransformVersions.assign(museumObjects.size(), 0);
+
+	for (size_t i = 0; i < museumObjects.size(); ++i) {
+		const MuseumObject& obj = *museumObjects[i];
+		bvhObjectFirstItem[i] = static_cast<uint32_t>(items.size());
+		bvhTransformVersions[i] = obj.GetTransformVersion();
+		for (size_t m = 0; m < obj.GetMeshes().size(); ++m) {
+			SceneBVH::Item item;
+			obj.GetMeshWorldBounds(m, item.min, item.max);
+			item.object = static_cast<uint32_t>(i);
+			item.mesh = static_cast<uint32_t>(m);
+			items.push_back(item);
+		}
+	}
+
+	bvhDynamicFirstItem = static_cast<uint32_t>(items.size());
+	for (size_t d = 0; d < dynamicObjects.size(); ++d) {
+		SceneBVH::Item item;
+		dynamicObjects[d]->GetWorldBounds(item.min, item.max);
+		item.object = DYNAMIC_OBJECT_FLAG | static_cast<uint32_t>(d);
+		item.mesh = 0;
+		items.push_back(item);
+	}
+
+	sceneBVH.Build(items);
+	bvhDirty = false;
+	std::cout << "Sahne BVH kuruldu: " << items.size() << " item, " << sceneBVH.GetNodeCount()
+		<< " dugum, derinlik " << sceneBVH.GetDepth() << std::endl;
+}
+
+void SceneManager::UpdateBVH() {
+	if (bvhDirty || bvhObjectFirstItem.size() != museumObjects.size()) {
+		RebuildBVH();
+		return;
+	}
+
+	// hareket eden objeler: ağaç yeniden kurulmuyor, kutular güncellenip refit ediliyor
+	bool moved = false;
+	for (size_t i = 0; i < museumObjects.size(); ++i) {
+		const MuseumObject& obj = *museumObjects[i];
+		size_t version = obj.GetTransformVersion();
+		if (version == bvhTransformVersions[i]) {
+			continue;
+		}
+		bvhTransformVersions[i] = version;
+		for (size_t m = 0; m < obj.GetMeshes().size(); ++m) {
+			glm::vec3 min, max;
+			obj.GetMeshWorldBounds(m, min, max);
+			sceneBVH.SetItemBounds(bvhObjectFirstItem[i] + static_cast<uint32_t>(m), min, max);
+		}
+		moved = true;
+	}
+
+	for (size_t d = 0; d < dynamicObjects.size(); ++d) {
+		uint32_t itemId = bvhDynamicFirstItem + static_cast<uint32_t>(d);
+		glm::vec3 min, max;
+		dynamicObjects[d]->GetWorldBounds(min, max);
+		const SceneBVH::Item& item = sceneBVH.GetItem(itemId);
+		if (item.min != min || item.max != max) {
+			sceneBVH.SetItemBounds(itemId, min, max);
+			moved = true;
+		}
+	}
+
+	if (moved) {
+		sceneBVH.Refit();
+	}
+}
+
+void SceneManager::CullWithBVH() {
+	UpdateBVH();
+
+	bvhVisibleItems.clear();
+	bvhStats = SceneBVH::CullStats();
+	sceneBVH.Cull(frustum, bvhVisibleItems, &bvhStats);
+
+	for (auto& obj : museumObjects) {
+		obj->ResetMeshVisibility(false);
+	}
+	dynamicVisible.assign(dynamicObjects.size(), 0);
+
+	for (uint32_t itemId : bvhVisibleItems) {
+		const SceneBVH::Item& item = sceneBVH.GetItem(itemId);
+		if (item.object & DYNAMIC_OBJECT_FLAG) {
+			dynamicVisible[item.object & ~DYNAMIC_OBJECT_FLAG] = 1;
+		}
+		else {
+			museumObjects[item.object]->SetMeshVisible(item.mesh, true);
+		}
+	}
+
+	// ShowFrustumControls aynı sayaçları gösteriyor
+	cullStats.objectsTested = museumObjects.size();
+	for (auto& obj : museumObjects) {
+		if (obj->GetVisibleMeshCount() == 0) {
+			cullStats.objectsCulled++;
+		}
+	}
+	cullStats.meshesTested = sceneBVH.GetItemCount();
+	cullStats.meshesCulledByBox = sceneBVH.GetItemCount() - bvhVisibleItems.size();
+}
+
 void SceneManager::UpdateLightIntensities(const glm::vec3& cameraPosition) {
 	for (auto& light : lights) {
 		float distance = glm::length(light.GetPosition() - cameraPosition);
@@ -275,6 +1159,34 @@ void SceneManager::SetupLightsForShaders() {
 			ShaderSetup::SetupLight(shader, lights[0]);
 		}
 	}
+
+	for (auto& obj : instancedObjects) {
+		if (!lights.empty()) {
+			ShaderSetup::SetupLight(obj->GetInstancedShader(), lights[0]);
+			ShaderSetup::SetupLight(obj->GetLodFadeShader(), lights[0]);
+			ShaderSetup::SetupLight(obj->GetImpostorShader(), lights[0]);
+		}
+	}
+	if (shadingLod && !lights.empty()) {
+		ShaderSetup::SetupLight(shadingLod->GetBlinnPhongShader(), lights[0]);
+		ShaderSetup::SetupLight(shadingLod->GetDiffuseShader(), lights[0]);
+	}
+
+	// ilk ışıktan sonrakiler tüm forward shaderların okuduğu uniform buffera
+	if (!lightBuffer) {
+		lightBuffer = std::make_unique<LightBuffer>();
+	}
+	lightBuffer->SetLightmapEnabled(useLightmap && lightmap.IsLoaded());
+	lightBuffer->SetProbeVolume(useProbeVolume && irradianceVolume.IsLoaded(), irradianceVolume.GetShaderParams());
+	lightBuffer->SetDynamicLights(dynamicLights);
+	lightBuffer->Upload(lights, 1);
+	lightBuffer->Bind();
+	if (lightmap.IsLoaded()) {
+		lightmap.Bind();
+	}
+	if (irradianceVolume.IsLoaded()) {
+		irradianceVolume.Bind();
+	}
 }
 
 void SceneManager::PrintSceneInfo() {
@@ -283,6 +1195,7 @@ void SceneManager::PrintSceneInfo() {
 	std::cout << "Sahne Merkezi: X:" << sceneCenter.x << " Y:" << sceneCenter.y << " Z:" << sceneCenter.z << std::endl;
 	std::cout << "Toplam Objeler: " << GetObjectCount() << std::endl;
 	std::cout << "Toplam Isiklar: " << GetLightCount() << std::endl;
+	std::cout << "Instanced Objeler: " << instancedObjects.size() << std::endl;
 
 	std::cout << "\n--- OBJELER ---" << std::endl;
 	for (size_t i = 0; i < museumObjects.size(); ++i) {
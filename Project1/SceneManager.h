@@ -1,6 +1,7 @@
 #pragma once
 #include <vector>
 #include <memory>
+#include <functional>
 #include <string>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -9,6 +10,22 @@
 //#include "LightCube.h"
 #include "ShaderSetup.h"
 #include "Frustum.h"
+#include "IndirectRenderer.h"
+#include "CullingBenchmark.h"
+#include "InstancedObject.h"
+#include "SceneBVH.h"
+#include "OcclusionCuller.h"
+#include "SoftwareOcclusion.h"
+#include "PotentiallyVisibleSet.h"
+#include "DepthPrepass.h"
+#include "DeferredRenderer.h"
+#include "LightBuffer.h"
+#include "ClusteredLighting.h"
+#include "Lightmap.h"
+#include "IrradianceVolume.h"
+#include "ShadowAtlas.h"
+#include "ShadingLod.h"
+#include "CubemapCapture.h"
 
 // Forward declaration
 class ImGuiManager;
@@ -17,6 +34,8 @@ class SceneManager {
 private:
     std::vector<std::shared_ptr<MuseumObject>> museumObjects;
     std::vector<Light> lights;
+    // tekrar eden objeler (kopya başına ayrı MuseumObject yerine tek instanced çizim)
+    std::vector<std::shared_ptr<InstancedObject>> instancedObjects;
    // std::vector<std::unique_ptr<LightCube>> lightCubes;
 
     // Sahne ayarlari
@@ -29,6 +48,135 @@ private:
 
     Frustum frustum;
     bool enableFrustumCulling = true; // Frustum culling'i açıp kapatmak için
+    FrustumCullStats cullStats; // son frame'in CPU culling sayaçları
+
+    // BVH ile hiyerarşik culling: museumObjects meshleri + kayıtlı dinamik objeler (robot)
+    static constexpr uint32_t DYNAMIC_OBJECT_FLAG = 0x80000000u;
+    SceneBVH sceneBVH;
+    bool useBVHCulling = true;
+    bool bvhDirty = true;            // obje eklenip silinince yeniden kuruluyor
+    bool bvhCulledThisFrame = false;
+    std::vector<uint32_t> bvhObjectFirstItem;
+    std::vector<size_t> bvhTransformVersions; // hareket tespiti için
+    uint32_t bvhDynamicFirstItem = 0;
+    std::vector<MuseumObject*> dynamicObjects;
+    std::vector<unsigned char> dynamicVisible;
+    std::vector<uint32_t> bvhVisibleItems;
+    SceneBVH::CullStats bvhStats;
+
+    // önceden hesaplanmış görünürlük, sahne modelinin yanında .pvs dosyası olarak duruyor
+    PotentiallyVisibleSet pvs;
+    std::string pvsPath;
+    bool usePVS = true;
+    const std::vector<unsigned char>* pvsCellBits = nullptr; // bu frame'in hücresi, yoksa nullptr
+    PVSCullStats pvsStats;
+
+    // statik kabuğun önceden hesaplanmış dağınık ışığı, sahne modelinin yanında .lightmap dosyası
+    Lightmap lightmap;
+    std::string lightmapPath;
+    // bake ışıkların en yüksek yoğunluğuyla, açıkken kabukta yaklaştıkça yanan ışıklar (UpdateLightIntensities)
+    // görünmüyor; bu yüzden isteğe bağlı
+    bool useLightmap = false;
+
+    // hareketli objelerin ortam ışığı: statik kabuğun üzerine yerleşen SH prob ızgarası, .probes dosyası
+    IrradianceVolume irradianceVolume;
+    std::string probeVolumePath;
+    bool useProbeVolume = true;
+
+    // meshlet culling, büyük meshler CLUSTER_JOB_SIZE kümelik işlere bölünüyor
+    struct ClusterJob {
+        MuseumObject* object;
+        size_t meshIndex;
+        size_t firstMeshlet;
+        size_t lastMeshlet;
+    };
+    static constexpr size_t CLUSTER_JOB_SIZE = 256;
+    bool useClusterCulling = true;
+    bool useClusterConeCulling = true;
+    std::vector<MuseumObject*> drawObjects; // bu frame çizilecek objeler
+    std::vector<ClusterJob> clusterJobs;
+    ClusterCullStats clusterStats;
+
+    // donanım occlusion query (ilk açılışta oluşturuluyor)
+    bool useOcclusionCulling = false;
+    std::unique_ptr<OcclusionCuller> occlusionCuller;
+    std::vector<MuseumObject*> occlusionCandidates;
+
+    // deferred shading ve forward yolun ek ışıkları
+    bool useDeferredShading = false;
+    std::unique_ptr<DeferredRenderer> deferredRenderer;
+    std::unique_ptr<LightBuffer> lightBuffer;
+    bool useClusteredLighting = false;
+    std::unique_ptr<ClusteredLighting> clusteredLighting;
+    bool lightingBenchmarkRequested = false;
+    std::vector<DeferredRenderer::BenchmarkResult> lightingBenchmarkResults;
+
+    // derinlik ön geçişi (ilk açılışta oluşturuluyor)
+    bool useDepthPrepass = false;
+    std::unique_ptr<DepthPrepass> depthPrepass;
+
+    // önbellekli gölge atlası, forward yolda her frame Update
+    bool useShadows = true;
+    std::unique_ptr<ShadowAtlas> shadowAtlas;
+    ShadowAtlas::Settings shadowSettings;
+    // sahne dışında tutulan hareketli ışıklar (robot lambası) ve onları taşıyan objeler
+    std::vector<const Light*> dynamicLights;
+    std::vector<const MuseumObject*> dynamicLightOwners;
+    void UpdateShadows();
+
+    // uzak instanced kopyalar impostor olarak, kamera ve ekran ölçeği her frame dolduruluyor
+    bool useImpostors = true;
+    InstancedObject::LodParams impostorLod;
+    bool impostorBenchmarkRequested = false;
+    Impostor::BenchmarkResult impostorBenchmarkResult;
+    void DrawInstancedObjects(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& cameraPosition,
+        bool impostors);
+    void RunImpostorBenchmark(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& cameraPosition);
+
+    // shading LOD: forward yolda küçük/uzak meshler ucuz BRDF varyantlarıyla (ilk açılışta oluşturuluyor)
+    // seviye geçişleri ani ve görüntüyü değiştiriyor, diğer isteğe bağlı yollar gibi kapalı başlıyor
+    bool useShadingLod = false;
+    std::unique_ptr<ShadingLod> shadingLod;
+    ShadingLod::Settings shadingLodSettings;
+    bool shadingLodBenchmarkRequested = false;
+    ShadingLod::BenchmarkResult shadingLodBenchmarkResult;
+    // forward yolda tek obje: shading LOD açıksa mesh başına seviyeyle, değilse objenin kendi shader'ıyla
+    void DrawForwardObject(MuseumObject* obj, const glm::mat4& view, const glm::mat4& projection,
+        const glm::vec3& lightPos, const glm::vec3& cameraPosition);
+    void RunShadingLodBenchmark(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& cameraPosition);
+
+    // eser panoramaları: altı küp yüzü katmanlı tek geçişte (ilk panoramada oluşturuluyor)
+    std::unique_ptr<CubemapCapture> cubemapCapture;
+
+    // CPU yazılım occlusion: statik binanın occluderları düşük çözünürlükte rasterize ediliyor
+    bool useSoftwareOcclusion = false;
+    std::unique_ptr<SoftwareOcclusion> softwareOcclusion;
+
+    bool PrepareObjectForDraw(size_t objectIndex, bool cpuCulling);
+    void DrawWithOcclusionCulling(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& cameraPosition);
+    void CullClusters(const glm::vec3& cameraPosition, bool cpuCulling);
+    void ApplySoftwareOcclusion(const glm::mat4& view, const glm::mat4& projection);
+    // drawObjects'i forward (klasik) ya da deferred yolla çizer, benchmark da bunu kullanıyor
+    void DrawLitObjects(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& cameraPosition, bool deferred);
+    void RunLightingBenchmark(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& cameraPosition);
+    // benchmarkların ortak ölçümü: ısınma frame'lerinden sonra drawPass'in ortalama GPU süresi (timestamp, bloklayarak).
+    // beginFrame her frame temizlemeden önce, ölçüm dışında
+    static constexpr int BENCHMARK_WARMUP_FRAMES = 2;
+    static constexpr int BENCHMARK_MEASURED_FRAMES = 8;
+    double MeasureGpuMs(const std::function<void()>& drawPass, const std::function<void()>& beginFrame = nullptr);
+    // ek ışıklar kümelere dağıtılıyor, SetupLightsForShaders'tan sonra çağrılmalı
+    void ApplyLightClusters(const glm::mat4& view, const glm::mat4& projection);
+    void RebuildBVH();
+    void UpdateBVH();
+    void CullWithBVH();
+
+    // GL 4.3+ multi-draw indirect yolu, desteklenmiyorsa eski yol kullanılıyor
+    std::unique_ptr<IndirectRenderer> indirectRenderer;
+    bool useIndirectDraw = false;
+    bool useGpuCulling = false; // indirect yolda culling compute shaderda (GL 4.3+)
+    std::vector<CullingBenchmark::Result> cullingBenchmarkResults;
+    std::vector<CullingBenchmark::BVHResult> bvhBenchmarkResults;
+    float lastSubmitTimeMs = 0.0f; // çizim gönderme CPU süresi
 
     ImGuiManager* imguiManager; // Pointer olarak değiştirildi
 
@@ -46,6 +194,10 @@ public:
     MuseumObject* GetMuseumObject(const std::string& name);
     std::vector<MuseumObject*> GetAllMuseumObjects();
 
+    // Instanced obje yonetimi, kopyalar dönen objeye AddInstance ile ekleniyor
+    std::shared_ptr<InstancedObject> AddInstancedObject(const std::string& name, const std::string& modelPath);
+    const std::vector<std::shared_ptr<InstancedObject>>& GetInstancedObjects() const { return instancedObjects; }
+
     // Isik yonetimi
     void AddLight(const glm::vec3& position, const glm::vec3& color,
         float ambientStrength, float specularStrength,
@@ -57,6 +209,7 @@ public:
 
     // Sahne olusturma metodlari
     void LoadAdanaMuseumScene(); // Ana muze sahnesini yukler
+    void LoadStorageHallScene(); // Muzenin arkasina ~5000 kucuk objeli depo salonu ekler
    // void LoadTestScene();        // Test sahnesi gerekirse açarız
     void ClearScene();           // Sahneyi temizler
 
@@ -64,6 +217,11 @@ public:
     void Update(const glm::vec3& cameraPosition, float deltaTime);
     void Draw(const glm::mat4& view, const glm::mat4& projection,
         const glm::vec3& cameraPosition);
+    // center'dan 360 derece panorama bağlı hedefe (equirectangular, viewport genişliği = 2 x yükseklik).
+    // Culling altı yüzün birleşimiyle bir kere, objeler katmanlı shader'la tek çizimde altı yüze.
+    // Instanced kopyalar ve dinamik objeler (robot) panoramaya girmiyor
+    void DrawPanorama(const glm::vec3& center);
+    const CubemapCapture* GetCubemapCapture() const { return cubemapCapture.get(); }
 
     // Isik yonetimi
     void UpdateLightIntensities(const glm::vec3& cameraPosition);
@@ -72,6 +230,137 @@ public:
     // Frustum  ayarları
     void EnableFrustumCulling(bool enable) { enableFrustumCulling = enable; }
     bool IsFrustumCullingEnabled() const { return enableFrustumCulling; }
+    const FrustumCullStats& GetCullStats() const { return cullStats; }
+
+    // BVH culling (kapalıysa objeler tek tek test ediliyor)
+    void EnableBVHCulling(bool enable) { useBVHCulling = enable; }
+    bool IsBVHCullingEnabled() const { return useBVHCulling; }
+    const SceneBVH& GetBVH() const { return sceneBVH; }
+    const SceneBVH::CullStats& GetBVHStats() const { return bvhStats; }
+
+    // PVS: kameranın hücresinden görünmeyen objeler frustum testine hiç girmiyor
+    // sahnedeki obje/mesh düzeni bake edilenden farklıysa kendiliğinden devre dışı kalıyor
+    // (eserler yerinden oynatılırsa yeniden bake edilmeli)
+    void EnablePVS(bool enable) { usePVS = enable; }
+    bool IsPVSEnabled() const { return usePVS; }
+    bool IsPVSActive() const { return pvsCellBits != nullptr; }
+    bool BakePVS(const PotentiallyVisibleSet::BakeSettings& settings);
+    const PotentiallyVisibleSet& GetPVS() const { return pvs; }
+    const std::string& GetPVSPath() const { return pvsPath; }
+    const PVSCullStats& GetPVSStats() const { return pvsStats; }
+
+    // lightmap: bina bake edildiyse statik yüzeyler dağınık ışığı tek texture okumasıyla alıyor,
+    // ışık eklenip taşınınca yeniden bake edilmeli. Deferred yol ışıkları zaten ekranda hesaplıyor, orada kullanılmıyor
+    void EnableLightmap(bool enable) { useLightmap = enable; }
+    bool IsLightmapEnabled() const { return useLightmap; }
+    bool BakeLightmap(const Lightmap::BakeSettings& settings);
+    const Lightmap& GetLightmap() const { return lightmap; }
+    const std::string& GetLightmapPath() const { return lightmapPath; }
+
+    // irradiance probları: lightmap'i olmayan yüzeyler (robot, taşınan eserler) sabit ambient yerine
+    // bulundukları noktadaki yönlü ortam ışığını alıyor. Lightmap gibi ışıklar değişince yeniden bake edilmeli
+    void EnableProbeVolume(bool enable) { useProbeVolume = enable; }
+    bool IsProbeVolumeEnabled() const { return useProbeVolume; }
+    bool BakeProbeVolume(const IrradianceVolume::BakeSettings& settings);
+    const IrradianceVolume& GetIrradianceVolume() const { return irradianceVolume; }
+
+    // occlusion culling: bina duvarlarının arkasında kalan objeler bir sonraki frame çizilmiyor
+    // GPU culling açıkken kullanılmıyor, açıkken indirect yol yerine objeler tek tek çiziliyor
+    void EnableOcclusionCulling(bool enable) { useOcclusionCulling = enable; }
+    bool IsOcclusionCullingEnabled() const { return useOcclusionCulling; }
+    const OcclusionCuller* GetOcclusionCuller() const { return occlusionCuller.get(); }
+
+    // deferred shading: müze objeleri G-buffer'a çizilip ışıklar ekranda kapladıkları yerde hesaplanıyor
+    // (occlusion query, indirect ve ön geçiş yolları bu modda kullanılmıyor)
+    void EnableDeferredShading(bool enable) { useDeferredShading = enable; }
+    bool IsDeferredShadingEnabled() const { return useDeferredShading; }
+    const DeferredRenderer* GetDeferredRenderer() const { return deferredRenderer.get(); }
+    // kümelenmiş forward: her piksel sadece kendi kümesine düşen ışıkları hesaplıyor
+    void EnableClusteredLighting(bool enable) { useClusteredLighting = enable; }
+    bool IsClusteredLightingEnabled() const { return useClusteredLighting; }
+    const ClusteredLighting* GetClusteredLighting() const { return clusteredLighting.get(); }
+    // statik olmayan her objenin (eser/vitrin) üstüne aşağı bakan bir spot ışık
+    void AddArtifactSpotLights();
+
+    // 1, 16 ve 128 test ışığıyla forward, kümelenmiş forward ve deferred; bir sonraki Draw içinde çalışıyor
+    void RequestLightingBenchmark() { lightingBenchmarkRequested = true; }
+    const std::vector<DeferredRenderer::BenchmarkResult>& GetLightingBenchmarkResults() const { return lightingBenchmarkResults; }
+
+    // derinlik ön geçişi: müze objeleri önce sadece derinliğe, sonra GL_EQUAL ile renge çiziliyor
+    // instanced objeler ve robot ön geçişe girmiyor, onlar normal testle çiziliyor
+    void EnableDepthPrepass(bool enable) { useDepthPrepass = enable; }
+    bool IsDepthPrepassEnabled() const { return useDepthPrepass; }
+    const DepthPrepass* GetDepthPrepass() const { return depthPrepass.get(); }
+
+    // yazılım occlusion: aynı frame içinde, GL'ye bir şey gönderilmeden eliyor
+    // CPU culling yolunda çalışıyor (GPU culling açıkken kullanılmıyor)
+    void EnableSoftwareOcclusion(bool enable) { useSoftwareOcclusion = enable; }
+    bool IsSoftwareOcclusionEnabled() const { return useSoftwareOcclusion; }
+    SoftwareOcclusion* GetSoftwareOcclusion() const { return softwareOcclusion.get(); }
+
+    // meshlet culling: görüş dışı ve kameraya arkası dönük kümeler çizilmiyor (CPU worker threadleri)
+    void EnableClusterCulling(bool enable) { useClusterCulling = enable; }
+    bool IsClusterCullingEnabled() const { return useClusterCulling; }
+    void EnableClusterConeCulling(bool enable) { useClusterConeCulling = enable; }
+    bool IsClusterConeCullingEnabled() const { return useClusterConeCulling; }
+    const ClusterCullStats& GetClusterStats() const { return clusterStats; }
+
+    // sahne dışında çizilen ama culling'e katılan hareketli objeler (robot)
+    // her frame kutuları güncelleniyor, BVH refit ediliyor
+    void RegisterDynamicObject(MuseumObject* object);
+    void UnregisterDynamicObject(MuseumObject* object);
+    bool IsDynamicObjectVisible(const MuseumObject* object) const;
+
+    // hareketli ışıklar: lightmap ve prob bake'ine girmiyor, her fragmentte canlı hesaplanıyor
+    // (LightBuffer::MAX_DYNAMIC_LIGHTS). owner ışığı taşıyan obje, o ışığa gölge düşürmüyor
+    void RegisterDynamicLight(const Light* light, const MuseumObject* owner);
+    void UnregisterDynamicLight(const Light* light);
+
+    // gölgeler: statik katman ışık yer değiştirdiğinde ya da statik obje taşındığında çiziliyor,
+    // her frame sadece hareketli objeleri (robot) gören tile'lar tazeleniyor. Deferred yolda kapalı
+    void EnableShadows(bool enable) { useShadows = enable; }
+    bool IsShadowsEnabled() const { return useShadows; }
+    void SetShadowSettings(const ShadowAtlas::Settings& settings);
+    const ShadowAtlas::Settings& GetShadowSettings() const { return shadowSettings; }
+    void InvalidateShadows() { if (shadowAtlas) shadowAtlas->Invalidate(); }
+    const ShadowAtlas* GetShadowAtlas() const { return shadowAtlas.get(); }
+
+    // impostor: ekrandaki boyu eşiğin altına inen instanced kopyalar (depo salonu) tek quad olarak çiziliyor,
+    // eşiğin hemen üstünde mesh ile dither'lı geçiş. Görünüş atlası modelin ilk kullanımında yakalanıyor
+    void EnableImpostors(bool enable) { useImpostors = enable; }
+    bool IsImpostorsEnabled() const { return useImpostors; }
+    void SetImpostorLod(const InstancedObject::LodParams& lod) { impostorLod = lod; }
+    const InstancedObject::LodParams& GetImpostorLod() const { return impostorLod; }
+    // bir sonraki Draw içinde çalışıyor
+    void RequestImpostorBenchmark() { impostorBenchmarkRequested = true; }
+    const Impostor::BenchmarkResult& GetImpostorBenchmarkResult() const { return impostorBenchmarkResult; }
+
+    // shading LOD: ekranda küçük kalan ya da uzaktaki meshler Blinn-Phong ya da sadece dağınık ışıkla
+    // (klasik forward ve occlusion yolu; indirect ve deferred yollar her zaman tam PBR)
+    void EnableShadingLod(bool enable) { useShadingLod = enable; }
+    bool IsShadingLodEnabled() const { return useShadingLod; }
+    void SetShadingLodSettings(const ShadingLod::Settings& settings) { shadingLodSettings = settings; }
+    const ShadingLod::Settings& GetShadingLodSettings() const { return shadingLodSettings; }
+    const ShadingLod* GetShadingLod() const { return shadingLod.get(); }
+    // her seviye zorlanarak ve otomatik seçimle GPU süresi ve tam PBR'ye göre görüntü farkı, bir sonraki Draw içinde
+    void RequestShadingLodBenchmark() { shadingLodBenchmarkRequested = true; }
+    const ShadingLod::BenchmarkResult& GetShadingLodBenchmarkResult() const { return shadingLodBenchmarkResult; }
+
+    // Multi-draw indirect ayarları
+    void EnableIndirectDraw(bool enable) { useIndirectDraw = enable; }
+    bool IsIndirectDrawEnabled() const { return useIndirectDraw; }
+    bool IsIndirectDrawSupported() const { return IndirectRenderer::IsSupported(); }
+    const IndirectRenderer* GetIndirectRenderer() const { return indirectRenderer.get(); }
+    float GetLastSubmitTimeMs() const { return lastSubmitTimeMs; }
+
+    // GPU culling sadece indirect yolda geçerli, kapalıysa CPU'da küre testi yapılıyor
+    void EnableGpuCulling(bool enable) { useGpuCulling = enable; }
+    bool IsGpuCullingEnabled() const { return useGpuCulling; }
+    bool IsGpuCullingSupported() const { return IndirectRenderer::IsSupported() && GpuCuller::IsSupported(); }
+    void RunCullingBenchmark() { cullingBenchmarkResults = CullingBenchmark::Run(); }
+    const std::vector<CullingBenchmark::Result>& GetCullingBenchmarkResults() const { return cullingBenchmarkResults; }
+    void RunBVHBenchmark() { bvhBenchmarkResults = CullingBenchmark::RunBVHScaling(); }
+    const std::vector<CullingBenchmark::BVHResult>& GetBVHBenchmarkResults() const { return bvhBenchmarkResults; }
 
     void SetSceneName(const std::string& name) { sceneName = name; }
     const std::string& GetSceneName() const { return sceneName; }
@@ -82,5 +371,6 @@ public:
     // Debug bilgileri
     void PrintSceneInfo();
     int GetObjectCount() const { return museumObjects.size(); }
+    const std::vector<std::shared_ptr<MuseumObject>>& GetMuseumObjects() const { return museumObjects; }
     int GetLightCount() const { return lights.size(); }
 };
\ No newline at end of file
@@ -33,11 +33,131 @@ private:
         }
     }
 
+    // shader varyantları için #version satırından hemen sonra define ekler
+    // glslVersion verilirse dosyadaki #version satırı onunla değiştirilir (örn. SSBO için 430)
+    static std::string InjectHeader(const std::string& source, const std::string& defines, int glslVersion) {
+        if (defines.empty() && glslVersion == 0) {
+            return source;
+        }
+
+        size_t versionPos = source.find("#version");
+        if (versionPos == std::string::npos) {
+            return defines + source;
+        }
+        size_t lineEnd = source.find('\n', versionPos);
+        if (lineEnd == std::string::npos) {
+            lineEnd = source.size();
+        }
+
+        std::string versionLine = glslVersion != 0
+            ? "#version " + std::to_string(glslVersion) + " core"
+            : source.substr(versionPos, lineEnd - versionPos);
+
+        std::string result = source.substr(0, versionPos) + versionLine + "\n" + defines;
+        if (lineEnd < source.size()) {
+            result += source.substr(lineEnd + 1);
+        }
+        return result;
+    }
+
+    // '#include "dosya.glsl"' satırlarını shader dosyasının klasöründen okuyup yerine koyar
+    // (forward ve deferred yolun ortak BRDF fonksiyonları için)
+    static std::string ResolveIncludes(const std::string& source, const std::string& path, int depth = 0) {
+        if (depth > 8 || source.find("#include") == std::string::npos) {
+            return source;
+        }
+        std::string directory;
+        size_t slash = path.find_last_of("/\\");
+        if (slash != std::string::npos) {
+            directory = path.substr(0, slash + 1);
+        }
+
+        std::stringstream input(source);
+        std::string result;
+        std::string line;
+        while (std::getline(input, line)) {
+            size_t includePos = line.find("#include");
+            size_t open = line.find('"', includePos);
+            size_t close = open == std::string::npos ? std::string::npos : line.find('"', open + 1);
+            if (includePos == std::string::npos || close == std::string::npos) {
+                result += line + "\n";
+                continue;
+            }
+
+            std::string includePath = directory + line.substr(open + 1, close - open - 1);
+            std::ifstream includeFile(includePath);
+            if (!includeFile) {
+                std::cerr << "Hata: shader include dosyasi okunamadi: " << includePath << std::endl;
+                continue;
+            }
+            std::stringstream includeStream;
+            includeStream << includeFile.rdbuf();
+            result += ResolveIncludes(includeStream.str(), includePath, depth + 1) + "\n";
+        }
+        return result;
+    }
+
+    // bilinen uniform blokları ve samplerlar sabit binding noktalarına bağlanıyor (GLSL 330'da layout(binding) yok)
+    void BindKnownSlots() {
+        GLuint lightBlock = glGetUniformBlockIndex(ID, "LightBlock");
+        if (lightBlock != GL_INVALID_INDEX) {
+            glUniformBlockBinding(ID, lightBlock, LIGHT_BLOCK_BINDING);
+        }
+        GLuint shadowBlock = glGetUniformBlockIndex(ID, "ShadowBlock");
+        if (shadowBlock != GL_INVALID_INDEX) {
+            glUniformBlockBinding(ID, shadowBlock, SHADOW_BLOCK_BINDING);
+        }
+
+        const struct { const char* name; int unit; } samplers[] = {
+            { "clusterLightData", CLUSTER_LIGHT_UNIT },
+            { "clusterGrid", CLUSTER_GRID_UNIT },
+            { "clusterLightIndices", CLUSTER_INDEX_UNIT },
+            { "lightmap", LIGHTMAP_UNIT },
+            { "probeIrradiance", PROBE_UNIT },
+            { "shadowAtlas", SHADOW_UNIT },
+            { "impostorAlbedo", IMPOSTOR_ALBEDO_UNIT },
+            { "impostorNormal", IMPOSTOR_NORMAL_UNIT },
+            { "impostorDepth", IMPOSTOR_DEPTH_UNIT },
+        };
+        GLint previousProgram = 0;
+        glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+        glUseProgram(ID);
+        for (const auto& sampler : samplers) {
+            GLint location = glGetUniformLocation(ID, sampler.name);
+            if (location >= 0) {
+                glUniform1i(location, sampler.unit);
+            }
+        }
+        glUseProgram(static_cast<GLuint>(previousProgram));
+    }
+
 public:
-    Shader(const char* vertexPath, const char* fragmentPath) {
+    // LightBuffer'ın bağlandığı uniform buffer noktası
+    static constexpr unsigned int LIGHT_BLOCK_BINDING = 2;
+    // ShadowAtlas'ın tile matrisleri
+    static constexpr unsigned int SHADOW_BLOCK_BINDING = 3;
+    // impostor görünüş atlası (Impostor::Bind), materyal textureları 0-3'ün hemen arkasında
+    static constexpr int IMPOSTOR_ALBEDO_UNIT = 4;
+    static constexpr int IMPOSTOR_NORMAL_UNIT = 5;
+    static constexpr int IMPOSTOR_DEPTH_UNIT = 6;
+    // ClusteredLighting texture bufferlarının birimleri (materyal textureları 0-3)
+    static constexpr int CLUSTER_LIGHT_UNIT = 8;
+    static constexpr int CLUSTER_GRID_UNIT = 9;
+    static constexpr int CLUSTER_INDEX_UNIT = 10;
+    // statik kabuğun lightmap'i (Lightmap::Bind)
+    static constexpr int LIGHTMAP_UNIT = 11;
+    // hareketli objelerin irradiance probları (IrradianceVolume::Bind)
+    static constexpr int PROBE_UNIT = 12;
+    // gölge atlası (ShadowAtlas::Bind)
+    static constexpr int SHADOW_UNIT = 13;
+
+    // geometryPath verilirse vertex ile fragment arasına geometry shader (GL 3.2+, ör. küp haritaya katmanlı çizim)
+    Shader(const char* vertexPath, const char* fragmentPath,
+        const std::string& defines = "", int glslVersion = 0, const char* geometryPath = nullptr) {
         
         std::string vertexCode;
         std::string fragmentCode;
+        std::string geometryCode;
         std::ifstream vShaderFile;
         std::ifstream fShaderFile;
 
@@ -54,8 +174,18 @@ public:
             vShaderFile.close();
             fShaderFile.close();
 
-            vertexCode = vShaderStream.str();
-            fragmentCode = fShaderStream.str();
+            vertexCode = InjectHeader(ResolveIncludes(vShaderStream.str(), vertexPath), defines, glslVersion);
+            fragmentCode = InjectHeader(ResolveIncludes(fShaderStream.str(), fragmentPath), defines, glslVersion);
+
+            if (geometryPath) {
+                std::ifstream gShaderFile;
+                gShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+                gShaderFile.open(geometryPath);
+                std::stringstream gShaderStream;
+                gShaderStream << gShaderFile.rdbuf();
+                gShaderFile.close();
+                geometryCode = InjectHeader(ResolveIncludes(gShaderStream.str(), geometryPath), defines, glslVersion);
+            }
         }
         catch (std::ifstream::failure& e) {
             std::cerr << "Hata: shader dosyaları okunamadi: " << e.what() << std::endl;
@@ -80,16 +210,65 @@ public:
         glCompileShader(fragment);
         checkCompileErrors(fragment, "FRAGMENT");
 
+        unsigned int geometry = 0;
+        if (geometryPath) {
+            const char* gShaderCode = geometryCode.c_str();
+            geometry = glCreateShader(GL_GEOMETRY_SHADER);
+            glShaderSource(geometry, 1, &gShaderCode, NULL);
+            glCompileShader(geometry);
+            checkCompileErrors(geometry, "GEOMETRY");
+        }
+
         
         ID = glCreateProgram();
         glAttachShader(ID, vertex);
+        if (geometry) {
+            glAttachShader(ID, geometry);
+        }
         glAttachShader(ID, fragment);
         glLinkProgram(ID);
         checkCompileErrors(ID, "PROGRAM");
+        BindKnownSlots();
 
         // Shader'ları temizle
         glDeleteShader(vertex);
         glDeleteShader(fragment);
+        if (geometry) {
+            glDeleteShader(geometry);
+        }
+    }
+
+    // compute shader programı (GL 4.3+), GLExtensions::HasComputeShaders ile kontrol edilmeli
+    explicit Shader(const char* computePath, const std::string& defines = "") {
+        std::string computeCode;
+        std::ifstream cShaderFile;
+        cShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+        try {
+            cShaderFile.open(computePath);
+            std::stringstream cShaderStream;
+            cShaderStream << cShaderFile.rdbuf();
+            cShaderFile.close();
+            computeCode = InjectHeader(ResolveIncludes(cShaderStream.str(), computePath), defines, 0);
+        }
+        catch (std::ifstream::failure& e) {
+            std::cerr << "Hata: compute shader dosyasi okunamadi: " << e.what() << std::endl;
+            ID = 0;
+            return;
+        }
+
+        const char* cShaderCode = computeCode.c_str();
+        // GL_COMPUTE_SHADER = 0x91B9, glad 3.3 başlığında yok
+        unsigned int compute = glCreateShader(0x91B9);
+        glShaderSource(compute, 1, &cShaderCode, NULL);
+        glCompileShader(compute);
+        checkCompileErrors(compute, "COMPUTE");
+
+        ID = glCreateProgram();
+        glAttachShader(ID, compute);
+        glLinkProgram(ID);
+        checkCompileErrors(ID, "PROGRAM");
+
+        glDeleteShader(compute);
     }
 
     ~Shader() {
@@ -100,6 +279,8 @@ public:
         glUseProgram(ID);
     }
 
+    unsigned int GetID() const { return ID; }
+
     void setBool(const std::string &name, bool value) const {
         glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value);
     }
@@ -108,14 +289,38 @@ public:
         glUniform1i(glGetUniformLocation(ID, name.c_str()), value);
     }
 
+    void setUInt(const std::string &name, unsigned int value) const {
+        glUniform1ui(glGetUniformLocation(ID, name.c_str()), value);
+    }
+
     void setFloat(const std::string &name, float value) const {
         glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
     }
 
+    void setVec2(const std::string &name, const glm::vec2 &value) const {
+        glUniform2f(glGetUniformLocation(ID, name.c_str()), value.x, value.y);
+    }
+
+    void setIVec2(const std::string &name, const glm::ivec2 &value) const {
+        glUniform2i(glGetUniformLocation(ID, name.c_str()), value.x, value.y);
+    }
+
     void setVec3(const std::string &name, const glm::vec3 &value) const {
         glUniform3f(glGetUniformLocation(ID, name.c_str()), value.x, value.y, value.z);
     }
 
+    void setVec4(const std::string &name, const glm::vec4 &value) const {
+        glUniform4f(glGetUniformLocation(ID, name.c_str()), value.x, value.y, value.z, value.w);
+    }
+
+    void setVec4Array(const std::string &name, const glm::vec4* values, int count) const {
+        glUniform4fv(glGetUniformLocation(ID, name.c_str()), count, glm::value_ptr(values[0]));
+    }
+
+    void setMat3(const std::string &name, const glm::mat3 &mat) const {
+        glUniformMatrix3fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, glm::value_ptr(mat));
+    }
+
     void setMat4(const std::string &name, const glm::mat4 &mat) const {
         glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, glm::value_ptr(mat));
     }
@@ -12,6 +12,11 @@ public:
         SetUniform(shader, "light.specularStrength", light.GetSpecularStrength());
         SetUniform(shader, "light.intensity", light.GetIntensity());
         SetUniform(shader, "light.range", light.GetRange());
+        // tür ve spot parametreleri (LightBuffer ve deferred ışık geçişiyle aynı)
+        shader.setInt("light.type", static_cast<int>(light.GetType()));
+        SetUniform(shader, "light.direction", light.GetDirection());
+        SetUniform(shader, "light.cutOff", glm::cos(glm::radians(light.GetSpotCutOff())));
+        SetUniform(shader, "light.outerCutOff", glm::cos(glm::radians(light.GetSpotOuterCutOff())));
     }
 
 private:
@@ -0,0 +1,91 @@
+#include "ShadingLod.h"
+#include <algorithm>
+#include <cstdlib>
+
+ShadingLod::ShadingLod() :
+    blinnPhongShader("shaders/vertexShader.glsl", "shaders/fragmentShader.glsl", "#define SHADING_BLINN_PHONG\n"),
+    diffuseShader("shaders/vertexShader.glsl", "shaders/fragmentShader.glsl", "#define SHADING_DIFFUSE\n") {
+}
+
+void ShadingLod::BeginFrame(const glm::vec3& newCameraPosition, float newPixelsPerUnit) {
+    cameraPosition = newCameraPosition;
+    pixelsPerUnit = newPixelsPerUnit;
+    stats = Stats();
+}
+
+ShadingLod::Level ShadingLod::SelectLevel(const glm::vec3& center, float radius) const {
+    if (settings.forcedLevel >= 0 && settings.forcedLevel < LEVEL_COUNT) {
+        return static_cast<Level>(settings.forcedLevel);
+    }
+
+    // kamera kürenin içindeyse (statik kabuğun chunk'ları) her zaman tam
+    float distance = glm::length(center - cameraPosition);
+    if (distance <= radius) {
+        return Level::FULL;
+    }
+    float screenSize = 2.0f * radius * pixelsPerUnit / distance;
+    if (screenSize < settings.diffuseScreenSize || distance > settings.diffuseDistance) {
+        return Level::DIFFUSE;
+    }
+    if (screenSize < settings.fullScreenSize || distance > settings.fullDistance) {
+        return Level::BLINN_PHONG;
+    }
+    return Level::FULL;
+}
+
+void ShadingLod::Draw(MuseumObject& object, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix,
+    const glm::vec3& lightPos, const glm::vec3& viewPos) {
+    size_t meshCount = object.GetMeshes().size();
+    meshLevels.assign(meshCount, static_cast<unsigned char>(Level::FULL));
+    for (size_t i = 0; i < meshCount; ++i) {
+        if (!object.IsMeshVisible(i)) {
+            continue;
+        }
+        glm::vec3 center;
+        float radius;
+        object.GetMeshWorldBoundingSphere(i, center, radius);
+        Level level = SelectLevel(center, radius);
+        meshLevels[i] = static_cast<unsigned char>(level);
+        stats.meshes[static_cast<int>(level)]++;
+    }
+
+    const Shader* levelShaders[LEVEL_COUNT] = { &object.GetShader(), &blinnPhongShader, &diffuseShader };
+    object.DrawShadingLevels(levelShaders, LEVEL_COUNT, meshLevels, viewMatrix, projectionMatrix, lightPos, viewPos);
+}
+
+const char* ShadingLod::GetLevelName(Level level) {
+    switch (level) {
+    case Level::FULL: return "Tam PBR";
+    case Level::BLINN_PHONG: return "Blinn-Phong";
+    case Level::DIFFUSE: return "Sadece daginik";
+    }
+    return "";
+}
+
+void ShadingLod::CompareImages(const std::vector<unsigned char>& reference, const std::vector<unsigned char>& image,
+    double& meanDiff, double& changedPixels, int& maxDiff) {
+    meanDiff = 0.0;
+    changedPixels = 0.0;
+    maxDiff = 0;
+    size_t pixelCount = std::min(reference.size(), image.size()) / 4;
+    if (pixelCount == 0) {
+        return;
+    }
+
+    double total = 0.0;
+    size_t changed = 0;
+    for (size_t i = 0; i < pixelCount; ++i) {
+        int pixelMax = 0;
+        for (size_t c = 0; c < 3; ++c) {
+            int difference = std::abs(static_cast<int>(reference[i * 4 + c]) - static_cast<int>(image[i * 4 + c]));
+            total += difference;
+            pixelMax = std::max(pixelMax, difference);
+        }
+        maxDiff = std::max(maxDiff, pixelMax);
+        if (pixelMax > DIFF_THRESHOLD) {
+            changed++;
+        }
+    }
+    meanDiff = total / (pixelCount * 3.0);
+    changedPixels = static_cast<double>(changed) / pixelCount;
+}
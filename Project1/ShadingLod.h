@@ -0,0 +1,79 @@
+#pragma once
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <vector>
+#include "MuseumObject.h"
+#include "Shader.h"
+
+// Shading LOD: ekranda birkaç piksel kaplayan ya da uzakta kalan meshlerde tam GGX/Smith/Fresnel yerine daha ucuz BRDF
+// seviyeler fragmentShader.glsl'in varyantları (brdf.glsl specularTerm): tam PBR objenin kendi shader'ı,
+// Blinn-Phong (üs roughness'tan) ve sadece dağınık + ambient. Seviye mesh başına (statik batch'te chunk başına)
+// bounding sphere'in ekrandaki çapından ve kameraya uzaklığından seçiliyor, her seviye ayrı geçişte çiziliyor
+class ShadingLod {
+public:
+    enum class Level : unsigned char {
+        FULL = 0,
+        BLINN_PHONG = 1,
+        DIFFUSE = 2
+    };
+    static constexpr int LEVEL_COUNT = 3;
+
+    struct Settings {
+        float fullScreenSize = 160.0f;   // piksel, çap bunun altındaysa en fazla Blinn-Phong
+        float diffuseScreenSize = 40.0f; // bunun altında sadece dağınık
+        float fullDistance = 25.0f;      // bu uzaklığın ötesi en fazla Blinn-Phong
+        float diffuseDistance = 60.0f;   // ötesi sadece dağınık
+        int forcedLevel = -1;            // 0-2 ise tüm meshler o seviyede (karşılaştırma için)
+    };
+
+    // son frame'de seviye başına çizilen mesh
+    struct Stats {
+        size_t meshes[LEVEL_COUNT] = {};
+    };
+
+    // SceneManager::RequestShadingLodBenchmark: aynı kameradan tüm meshler zorlanmış seviyede ve otomatik seçimle,
+    // görüntüler tam PBR ile karşılaştırılıyor. index: FULL, BLINN_PHONG, DIFFUSE, otomatik
+    struct BenchmarkResult {
+        bool valid = false;
+        double gpuMs[LEVEL_COUNT + 1] = {};
+        double meanDiff[LEVEL_COUNT + 1] = {};     // piksel başına ortalama kanal farkı (0-255)
+        double changedPixels[LEVEL_COUNT + 1] = {}; // farkı DIFF_THRESHOLD'u geçen piksel oranı
+        int maxDiff[LEVEL_COUNT + 1] = {};
+        size_t autoMeshes[LEVEL_COUNT] = {};       // otomatik seçimde seviye başına mesh
+    };
+    static constexpr int DIFF_THRESHOLD = 8;
+
+    ShadingLod();
+
+    // ekran ölçeği: projection[1][1] * viewport yüksekliği / 2, istatistikler sıfırlanıyor
+    void BeginFrame(const glm::vec3& cameraPosition, float pixelsPerUnit);
+    // objenin görünür meshlerine seviye seçip çiziyor (MuseumObject::Draw yerine)
+    void Draw(MuseumObject& object, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix,
+        const glm::vec3& lightPos, const glm::vec3& viewPos);
+
+    // BLINN_PHONG ve DIFFUSE varyantları, ışık uniformları SceneManager::SetupLightsForShaders'ta
+    const Shader& GetBlinnPhongShader() const { return blinnPhongShader; }
+    const Shader& GetDiffuseShader() const { return diffuseShader; }
+
+    void SetSettings(const Settings& newSettings) { settings = newSettings; }
+    const Settings& GetSettings() const { return settings; }
+    const Stats& GetStats() const { return stats; }
+    static const char* GetLevelName(Level level);
+
+    // aynı boyutta iki RGBA8 görüntü, alfa karşılaştırılmıyor
+    static void CompareImages(const std::vector<unsigned char>& reference, const std::vector<unsigned char>& image,
+        double& meanDiff, double& changedPixels, int& maxDiff);
+
+private:
+    Level SelectLevel(const glm::vec3& center, float radius) const;
+
+    Settings settings;
+    Stats stats;
+    glm::vec3 cameraPosition = glm::vec3(0.0f);
+    float pixelsPerUnit = 0.0f;
+
+    Shader blinnPhongShader;
+    Shader diffuseShader;
+    std::vector<unsigned char> meshLevels; // çizilen objenin mesh başına seviyesi
+};
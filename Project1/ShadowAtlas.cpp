@@ -0,0 +1,384 @@
+#include "ShadowAtlas.h"
+#include "Frustum.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+
+namespace {
+    const float POSITION_EPSILON = 1e-4f;
+    const float MAX_SPOT_FOV = 160.0f;
+    const int PCF_BORDER_TEXELS = 3; // 5x5 çekirdeğin yarıçapı + 1, küp yüzleri bu kadar geniş çiziliyor
+
+    // nokta ışığın küp yüzleri, fragmentShader.glsl lightShadow'daki sırayla (+X, -X, +Y, -Y, +Z, -Z)
+    const glm::vec3 CUBE_DIRECTIONS[6] = {
+        { 1.0f, 0.0f, 0.0f }, { -1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f },
+        { 0.0f, -1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, -1.0f }
+    };
+    const glm::vec3 CUBE_UPS[6] = {
+        { 0.0f, 1.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f },
+        { 0.0f, 0.0f, 1.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }
+    };
+
+    void HashValue(uint64_t& hash, uint64_t value) {
+        // FNV-1a
+        for (int i = 0; i < 8; ++i) {
+            hash ^= (value >> (i * 8)) & 0xFF;
+            hash *= 1099511628211ull;
+        }
+    }
+}
+
+ShadowAtlas::ShadowAtlas() {
+    depthShader = std::make_unique<Shader>("shaders/depthPrepassVertex.glsl", "shaders/depthPrepassFragment.glsl");
+
+    std::memset(&block, 0, sizeof(block));
+    glGenBuffers(1, &blockBuffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, blockBuffer);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(BlockData), &block, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+ShadowAtlas::~ShadowAtlas() {
+    DestroyTextures();
+    glDeleteBuffers(1, &blockBuffer);
+}
+
+void ShadowAtlas::CreateTextures() {
+    DestroyTextures();
+    atlasSize = settings.tileSize * TILES_PER_ROW;
+
+    GLuint* textures[2] = { &staticTexture, &shadowTexture };
+    GLuint* framebuffers[2] = { &staticFramebuffer, &shadowFramebuffer };
+    for (int i = 0; i < 2; ++i) {
+        glGenTextures(1, textures[i]);
+        glBindTexture(GL_TEXTURE_2D, *textures[i]);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24, atlasSize, atlasSize, 0, GL_DEPTH_COMPONENT,
+            GL_UNSIGNED_INT, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+        glGenFramebuffers(1, framebuffers[i]);
+        glBindFramebuffer(GL_FRAMEBUFFER, *framebuffers[i]);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, *textures[i], 0);
+        glDrawBuffer(GL_NONE);
+        glReadBuffer(GL_NONE);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            std::cerr << "Golge atlasi framebuffer'i eksik" << std::endl;
+        }
+        // kullanılmayan tile'lar aydınlık
+        glClear(GL_DEPTH_BUFFER_BIT);
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    // shader'ın okuduğu katman donanım karşılaştırmasıyla, sert filtrede en yakın texel
+    glBindTexture(GL_TEXTURE_2D, shadowTexture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+    GLint filter = settings.filter == Filter::HARD ? GL_NEAREST : GL_LINEAR;
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    Invalidate();
+    std::cout << "Golge atlasi: " << atlasSize << "x" << atlasSize << " (" << MAX_TILES << " tile), "
+        << GetTextureBytes() << " byte" << std::endl;
+}
+
+void ShadowAtlas::DestroyTextures() {
+    if (staticTexture != 0) {
+        glDeleteTextures(1, &staticTexture);
+        glDeleteTextures(1, &shadowTexture);
+        glDeleteFramebuffers(1, &staticFramebuffer);
+        glDeleteFramebuffers(1, &shadowFramebuffer);
+        staticTexture = shadowTexture = 0;
+        staticFramebuffer = shadowFramebuffer = 0;
+    }
+    atlasSize = 0;
+}
+
+void ShadowAtlas::SetSettings(const Settings& newSettings) {
+    bool resize = newSettings.tileSize != settings.tileSize;
+    settings = newSettings;
+    if (resize) {
+        DestroyTextures(); // Update yeniden oluşturuyor
+    }
+    else if (shadowTexture != 0) {
+        glBindTexture(GL_TEXTURE_2D, shadowTexture);
+        GLint filter = settings.filter == Filter::HARD ? GL_NEAREST : GL_LINEAR;
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+    // bias ve yakın düzlem statik katmana gömülü
+    Invalidate();
+}
+
+void ShadowAtlas::Invalidate() {
+    for (Tile& tile : tiles) {
+        tile.staticValid = false;
+    }
+}
+
+int ShadowAtlas::AssignTiles(const Light& light, int& nextTile, std::vector<View>& views) const {
+    View view;
+    view.position = light.GetPosition();
+    view.farPlane = std::max(light.GetRange(), settings.nearPlane * 2.0f);
+
+    if (light.GetType() == Light::Type::SPOT) {
+        if (nextTile + 1 > MAX_TILES) {
+            return -1;
+        }
+        float length = glm::length(light.GetDirection());
+        view.direction = length > 0.0f ? light.GetDirection() / length : glm::vec3(0.0f, -1.0f, 0.0f);
+        view.up = std::abs(view.direction.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+        view.fieldOfView = std::min(2.0f * (light.GetSpotOuterCutOff() + settings.spotMarginDegrees), MAX_SPOT_FOV);
+        view.minCosine = std::cos(glm::radians(settings.spotMarginDegrees));
+        views.push_back(view);
+        return nextTile++;
+    }
+    if (light.GetType() == Light::Type::POINT) {
+        if (nextTile + 6 > MAX_TILES) {
+            return -1;
+        }
+        // 90 dereceden biraz geniş, yüz sınırındaki PCF örnekleri komşu tile'a taşmasın
+        float halfTile = settings.tileSize * 0.5f;
+        view.fieldOfView = glm::degrees(2.0f * std::atan(halfTile / (halfTile - PCF_BORDER_TEXELS)));
+        for (int face = 0; face < 6; ++face) {
+            view.direction = CUBE_DIRECTIONS[face];
+            view.up = CUBE_UPS[face];
+            views.push_back(view);
+        }
+        int first = nextTile;
+        nextTile += 6;
+        return first;
+    }
+    return -1; // yönlü ışık müzede yok
+}
+
+bool ShadowAtlas::IsCached(const Tile& tile, const View& view) const {
+    return tile.staticValid &&
+        glm::length(tile.view.position - view.position) < POSITION_EPSILON &&
+        std::abs(tile.view.farPlane - view.farPlane) < POSITION_EPSILON &&
+        std::abs(tile.view.fieldOfView - view.fieldOfView) < POSITION_EPSILON &&
+        glm::dot(tile.view.direction, view.direction) >= tile.view.minCosine - 1e-6f;
+}
+
+void ShadowAtlas::GetTileRect(int tileIndex, int& x, int& y) const {
+    x = (tileIndex % TILES_PER_ROW) * settings.tileSize;
+    y = (tileIndex / TILES_PER_ROW) * settings.tileSize;
+}
+
+size_t ShadowAtlas::RenderTile(GLuint framebuffer, int tileIndex, const std::vector<MuseumObject*>& casters,
+    const MuseumObject* exclude, bool clear) {
+    int x, y;
+    GetTileRect(tileIndex, x, y);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glViewport(x, y, settings.tileSize, settings.tileSize);
+    if (clear) {
+        glEnable(GL_SCISSOR_TEST);
+        glScissor(x, y, settings.tileSize, settings.tileSize);
+        glClear(GL_DEPTH_BUFFER_BIT);
+        glDisable(GL_SCISSOR_TEST);
+    }
+
+    Frustum lightFrustum;
+    lightFrustum.Update(glm::mat4(1.0f), tiles[tileIndex].viewProjection);
+    depthShader->setMat4("view", glm::mat4(1.0f));
+    depthShader->setMat4("projection", tiles[tileIndex].viewProjection);
+
+    size_t drawn = 0;
+    for (MuseumObject* caster : casters) {
+        if (caster == exclude) {
+            continue;
+        }
+        glm::vec3 boundsMin, boundsMax;
+        caster->GetWorldBounds(boundsMin, boundsMax);
+        if (!lightFrustum.IsAABBVisible(boundsMin, boundsMax)) {
+            continue;
+        }
+        caster->DrawShadowCaster(*depthShader, lightFrustum);
+        drawn++;
+    }
+    return drawn;
+}
+
+uint64_t ShadowAtlas::ComputeStaticSignature(const std::vector<MuseumObject*>& casters) const {
+    uint64_t hash = 1469598103934665603ull;
+    HashValue(hash, casters.size());
+    for (const MuseumObject* caster : casters) {
+        HashValue(hash, reinterpret_cast<uintptr_t>(caster));
+        HashValue(hash, caster->GetTransformVersion());
+        HashValue(hash, caster->GetMeshes().size());
+    }
+    return hash;
+}
+
+void ShadowAtlas::Update(const std::vector<Light>& lights, const std::vector<const Light*>& dynamicLights,
+    const std::vector<const MuseumObject*>& dynamicLightOwners, const std::vector<MuseumObject*>& staticCasters,
+    const std::vector<MuseumObject*>& dynamicCasters) {
+    auto start = std::chrono::high_resolution_clock::now();
+    PollQuery();
+    // CreateTextures da framebuffer değiştiriyor, en başta alınıyor
+    GLint previousFramebuffer = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+    if (atlasSize != settings.tileSize * TILES_PER_ROW) {
+        CreateTextures();
+    }
+
+    // statik obje eklendi, silindi ya da taşındı: tüm statik katman geçersiz
+    uint64_t signature = ComputeStaticSignature(staticCasters);
+    if (signature != staticSignature) {
+        staticSignature = signature;
+        Invalidate();
+    }
+
+    // tile'lar önce hareketli ışıklara, sonra sahne ışıklarına sırayla; sığmayan ışık gölgesiz
+    std::vector<View> views;
+    std::vector<const MuseumObject*> owners;
+    int nextTile = 0;
+    size_t shadowedLights = 0;
+    std::fill(std::begin(block.lightTiles), std::end(block.lightTiles), -1);
+    std::fill(std::begin(block.dynamicTiles), std::end(block.dynamicTiles), -1);
+    for (size_t i = 0; i < dynamicLights.size() && i < LightBuffer::MAX_DYNAMIC_LIGHTS; ++i) {
+        block.dynamicTiles[i] = AssignTiles(*dynamicLights[i], nextTile, views);
+        owners.resize(views.size(), i < dynamicLightOwners.size() ? dynamicLightOwners[i] : nullptr);
+        shadowedLights += block.dynamicTiles[i] >= 0 ? 1 : 0;
+    }
+    for (size_t i = 0; i < lights.size() && i < static_cast<size_t>(MAX_SCENE_LIGHTS); ++i) {
+        block.lightTiles[i] = AssignTiles(lights[i], nextTile, views);
+        owners.resize(views.size(), nullptr);
+        shadowedLights += block.lightTiles[i] >= 0 ? 1 : 0;
+    }
+
+    stats.shadowedLights = shadowedLights;
+    stats.tiles = views.size();
+    stats.staticTilesRendered = 0;
+    stats.compositeTiles = 0;
+    stats.dynamicCasterDraws = 0;
+
+    updateTimer.Begin();
+
+    GLint previousViewport[4];
+    GLint previousDepthFunc = GL_LESS;
+    glGetIntegerv(GL_VIEWPORT, previousViewport);
+    glGetIntegerv(GL_DEPTH_FUNC, &previousDepthFunc);
+    GLboolean cullFace = glIsEnabled(GL_CULL_FACE);
+    glDisable(GL_CULL_FACE);
+    glEnable(GL_DEPTH_TEST);
+    glDepthFunc(GL_LESS);
+    glDepthMask(GL_TRUE);
+    glEnable(GL_POLYGON_OFFSET_FILL);
+    glPolygonOffset(settings.slopeBias, settings.constantBias);
+    depthShader->use();
+
+    float tileScale = 1.0f / TILES_PER_ROW;
+    float texel = 1.0f / atlasSize;
+    for (size_t t = 0; t < views.size(); ++t) {
+        Tile& tile = tiles[t];
+        if (!IsCached(tile, views[t])) {
+            tile.view = views[t];
+            glm::mat4 view = glm::lookAt(tile.view.position, tile.view.position + tile.view.direction, tile.view.up);
+            glm::mat4 projection = glm::perspective(glm::radians(tile.view.fieldOfView), 1.0f, settings.nearPlane,
+                tile.view.farPlane);
+            tile.viewProjection = projection * view;
+            tile.staticValid = false;
+        }
+        tile.owner = owners[t];
+
+        bool staticRendered = false;
+        if (!tile.staticValid) {
+            RenderTile(staticFramebuffer, static_cast<int>(t), staticCasters, nullptr, true);
+            tile.staticValid = true;
+            staticRendered = true;
+            stats.staticTilesRendered++;
+            stats.staticRendersTotal++;
+        }
+
+        // hareketli caster'ı olmayan ve statik katmanı değişmeyen tile'a dokunulmuyor
+        Frustum lightFrustum;
+        lightFrustum.Update(glm::mat4(1.0f), tile.viewProjection);
+        bool hasDynamic = false;
+        for (MuseumObject* caster : dynamicCasters) {
+            glm::vec3 boundsMin, boundsMax;
+            caster->GetWorldBounds(boundsMin, boundsMax);
+            if (caster != tile.owner && lightFrustum.IsAABBVisible(boundsMin, boundsMax)) {
+                hasDynamic = true;
+                break;
+            }
+        }
+        if (staticRendered || hasDynamic || tile.hasDynamic) {
+            int x, y;
+            GetTileRect(static_cast<int>(t), x, y);
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, staticFramebuffer);
+            glBindFramebuffer(GL_DRAW_FRAMEBUFFER, shadowFramebuffer);
+            glBlitFramebuffer(x, y, x + settings.tileSize, y + settings.tileSize, x, y, x + settings.tileSize,
+                y + settings.tileSize, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+            if (hasDynamic) {
+                stats.dynamicCasterDraws += RenderTile(shadowFramebuffer, static_cast<int>(t), dynamicCasters, tile.owner, false);
+            }
+            stats.compositeTiles++;
+        }
+        tile.hasDynamic = hasDynamic;
+
+        // atlas uv'sine: tile ofseti + [-1, 1] -> [0, tileScale]
+        glm::vec2 offset(static_cast<float>(t % TILES_PER_ROW) * tileScale, static_cast<float>(t / TILES_PER_ROW) * tileScale);
+        glm::mat4 atlasMatrix = glm::translate(glm::mat4(1.0f),
+            glm::vec3(offset + glm::vec2(0.5f * tileScale), 0.5f));
+        atlasMatrix = glm::scale(atlasMatrix, glm::vec3(0.5f * tileScale, 0.5f * tileScale, 0.5f));
+        block.matrices[t] = atlasMatrix * tile.viewProjection;
+        block.bounds[t] = glm::vec4(offset + glm::vec2(0.5f * texel), offset + glm::vec2(tileScale - 0.5f * texel));
+        float texelAngle = 2.0f * std::tan(glm::radians(tile.view.fieldOfView) * 0.5f) / settings.tileSize;
+        block.params[t] = glm::vec4(texelAngle, 0.0f, 0.0f, 0.0f);
+    }
+
+    glDisable(GL_POLYGON_OFFSET_FILL);
+    glDepthFunc(previousDepthFunc);
+    if (cullFace) {
+        glEnable(GL_CULL_FACE);
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, previousFramebuffer);
+    glViewport(previousViewport[0], previousViewport[1], previousViewport[2], previousViewport[3]);
+
+    updateTimer.End();
+
+    block.enabled = 1;
+    block.filter = static_cast<int32_t>(settings.filter);
+    block.texelSize = texel;
+    block.normalBias = settings.normalBias;
+    glBindBuffer(GL_UNIFORM_BUFFER, blockBuffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(BlockData), &block);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    stats.cpuMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+void ShadowAtlas::Disable() {
+    if (block.enabled == 0) {
+        return;
+    }
+    block.enabled = 0;
+    glBindBuffer(GL_UNIFORM_BUFFER, blockBuffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, offsetof(BlockData, enabled), sizeof(block.enabled), &block.enabled);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void ShadowAtlas::Bind() const {
+    glBindBufferBase(GL_UNIFORM_BUFFER, Shader::SHADOW_BLOCK_BINDING, blockBuffer);
+    glActiveTexture(GL_TEXTURE0 + Shader::SHADOW_UNIT);
+    glBindTexture(GL_TEXTURE_2D, shadowTexture);
+    glActiveTexture(GL_TEXTURE0);
+}
+
+void ShadowAtlas::PollQuery() {
+    updateTimer.Poll([this](const GpuTimer::Result& result) { GpuTimer::Smooth(stats.gpuMs, result.ms); });
+}
+
+size_t ShadowAtlas::GetTextureBytes() const {
+    return 2 * static_cast<size_t>(atlasSize) * atlasSize * 4;
+}
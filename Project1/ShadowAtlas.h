@@ -0,0 +1,137 @@
+#pragma once
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include "MuseumObject.h"
+#include "Light.h"
+#include "LightBuffer.h"
+#include "Shader.h"
+#include "GpuTimer.h"
+
+// Önbellekli gölge haritaları
+// Tüm gölgeler tek bir derinlik atlasında: spot ışık bir, nokta ışık altı tile (küp yüzleri) alıyor.
+// İki katman var: statik katman (bina ve eserler) bir tile'ın ışığı yer değiştirmedikçe ya da statik bir obje
+// taşınmadıkça yeniden çizilmiyor. Shader'ın okuduğu katman her frame sadece hareketli caster (robot gövdesi ve kolu)
+// içeren tile'larda tazeleniyor: statik tile kopyalanıp (glBlitFramebuffer) üzerine hareketli objeler çiziliyor.
+// Spot ışıklar koninin biraz genişiyle çiziliyor, ışık sadece dönüp bu pay içinde kalırsa statik katman
+// yeniden kullanılıyor (robot kendi ekseninde dönerken lambasının gölgesi baştan çizilmiyor).
+// Forward yol okuyor (fragmentShader.glsl ShadowBlock), deferred yol gölgesiz
+class ShadowAtlas {
+public:
+    static constexpr int MAX_TILES = 16;                            // fragmentShader.glsl MAX_SHADOW_TILES ile aynı
+    static constexpr int TILES_PER_ROW = 4;
+    static constexpr int MAX_SCENE_LIGHTS = LightBuffer::MAX_LIGHTS + 1; // "light" uniformu + LightBuffer
+
+    enum class Filter {
+        HARD,       // en yakın texel
+        PCF_2X2,    // donanım karşılaştırması + bilineer
+        PCF_3X3,
+        PCF_5X5
+    };
+
+    struct Settings {
+        int tileSize = 512;              // atlas TILES_PER_ROW * tileSize
+        Filter filter = Filter::PCF_3X3;
+        float slopeBias = 2.0f;          // glPolygonOffset
+        float constantBias = 2.0f;
+        float normalBias = 1.0f;         // texel cinsinden, shader'da normal yönünde kaydırma
+        float spotMarginDegrees = 10.0f; // spot tile'ı koniden bu kadar geniş, dönüş bu pay içindeyse önbellek geçerli
+        float nearPlane = 0.1f;
+    };
+
+    struct Stats {
+        size_t shadowedLights = 0;
+        size_t tiles = 0;
+        size_t staticTilesRendered = 0;   // bu frame statik katmanı yeniden çizilen
+        size_t compositeTiles = 0;        // bu frame hareketli casterlarla tazelenen
+        size_t dynamicCasterDraws = 0;
+        size_t staticRendersTotal = 0;    // açılıştan beri
+        double gpuMs = -1.0;              // tüm gölge geçişi, birkaç frame gecikmeli
+        double cpuMs = 0.0;
+    };
+
+    ShadowAtlas();
+    ~ShadowAtlas();
+    ShadowAtlas(const ShadowAtlas&) = delete;
+    ShadowAtlas& operator=(const ShadowAtlas&) = delete;
+
+    // renk geçişinden önce: tile'ları ışıklara dağıtıyor, gereken statik tile'ları ve dinamik katmanı çiziyor.
+    // dynamicLightOwners[i] dynamicLights[i]'yi taşıyan obje (robot lambası gövdenin içinde), o ışığa gölge düşürmüyor.
+    // Framebuffer ve viewport geri yükleniyor
+    void Update(const std::vector<Light>& lights, const std::vector<const Light*>& dynamicLights,
+        const std::vector<const MuseumObject*>& dynamicLightOwners, const std::vector<MuseumObject*>& staticCasters,
+        const std::vector<MuseumObject*>& dynamicCasters);
+    // shader gölgesiz çalışıyor (kapalıyken, ışık ölçümünde)
+    void Disable();
+    // statik katman bir sonraki Update'te baştan çiziliyor
+    void Invalidate();
+    void Bind() const;
+
+    void SetSettings(const Settings& newSettings);
+    const Settings& GetSettings() const { return settings; }
+    const Stats& GetStats() const { return stats; }
+    int GetAtlasSize() const { return atlasSize; }
+    size_t GetTextureBytes() const;  // iki katman
+
+private:
+    // bir ışığın bir tile'daki görünüşü
+    struct View {
+        glm::vec3 position = glm::vec3(0.0f);
+        glm::vec3 direction = glm::vec3(0.0f, 0.0f, -1.0f);
+        glm::vec3 up = glm::vec3(0.0f, 1.0f, 0.0f);
+        float fieldOfView = 90.0f;     // derece
+        float farPlane = 1.0f;
+        float minCosine = 1.0f;        // spot: yön bu kadar değişirse önbellek geçersiz
+    };
+
+    struct Tile {
+        View view;
+        glm::mat4 viewProjection = glm::mat4(1.0f);
+        bool staticValid = false;
+        bool hasDynamic = false;       // dinamik katmanda son çizimde hareketli caster vardı
+        const MuseumObject* owner = nullptr; // ışığı taşıyan obje, bu tile'a çizilmiyor
+    };
+
+    // std140 ShadowBlock
+    struct BlockData {
+        glm::mat4 matrices[MAX_TILES];
+        glm::vec4 bounds[MAX_TILES];
+        glm::vec4 params[MAX_TILES];
+        int32_t lightTiles[(MAX_SCENE_LIGHTS + 3) / 4 * 4];
+        int32_t dynamicTiles[4];
+        int32_t enabled;
+        int32_t filter;
+        float texelSize;
+        float normalBias;
+    };
+
+    void CreateTextures();
+    void DestroyTextures();
+    // ışığın ihtiyacı olan tile'lar (spot 1, nokta 6, yönlü ışık gölgesiz), sığmazsa -1
+    int AssignTiles(const Light& light, int& nextTile, std::vector<View>& views) const;
+    bool IsCached(const Tile& tile, const View& view) const;
+    // exclude çizilmiyor, tile'a giren caster sayısını döndürür
+    size_t RenderTile(GLuint framebuffer, int tileIndex, const std::vector<MuseumObject*>& casters,
+        const MuseumObject* exclude, bool clear);
+    void GetTileRect(int tileIndex, int& x, int& y) const;
+    uint64_t ComputeStaticSignature(const std::vector<MuseumObject*>& casters) const;
+    void PollQuery();
+
+    Settings settings;
+    Stats stats;
+    int atlasSize = 0;
+    GLuint staticTexture = 0;    // sadece statik casterlar
+    GLuint shadowTexture = 0;    // statik + hareketli, shader bunu okuyor
+    GLuint staticFramebuffer = 0;
+    GLuint shadowFramebuffer = 0;
+    GLuint blockBuffer = 0;
+    std::unique_ptr<Shader> depthShader;
+
+    Tile tiles[MAX_TILES];
+    uint64_t staticSignature = 0;
+    BlockData block;
+
+    GpuTimer updateTimer;
+};
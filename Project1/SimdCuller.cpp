@@ -0,0 +1,240 @@
+#include "SimdCuller.h"
+#include "SimdCullerKernels.h"
+#include <cfloat>
+#include <iostream>
+
+#if SIMD_CULLER_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+// ---- SphereSoA ----
+
+void SphereSoA::Clear() {
+    x.clear();
+    y.clear();
+    z.clear();
+    r.clear();
+    count = 0;
+    Pad();
+}
+
+void SphereSoA::Reserve(size_t newCount) {
+    size_t padded = (newCount + BATCH_SIZE - 1) / BATCH_SIZE * BATCH_SIZE;
+    x.reserve(padded);
+    y.reserve(padded);
+    z.reserve(padded);
+    r.reserve(padded);
+}
+
+size_t SphereSoA::Add(const glm::vec3& center, float radius) {
+    size_t index = count++;
+    Pad();
+    Set(index, center, radius);
+    return index;
+}
+
+void SphereSoA::Set(size_t index, const glm::vec3& center, float radius) {
+    x[index] = center.x;
+    y[index] = center.y;
+    z[index] = center.z;
+    r[index] = radius;
+}
+
+void SphereSoA::Pad() {
+    size_t padded = (count + BATCH_SIZE - 1) / BATCH_SIZE * BATCH_SIZE;
+    if (padded == 0) {
+        padded = BATCH_SIZE;
+    }
+    // yeni eklenen dolgu: hiçbir düzlemi geçemeyen küre
+    x.resize(padded, 0.0f);
+    y.resize(padded, 0.0f);
+    z.resize(padded, 0.0f);
+    r.resize(padded, -FLT_MAX);
+}
+
+// ---- skaler kernel ----
+
+void SimdCullerKernels::CullScalar(const float* planes, const float* x, const float* y, const float* z, const float* r,
+    size_t count, uint64_t* bits) {
+
+    for (size_t i = 0; i < count; ++i) {
+        bool visible = true;
+        for (int p = 0; p < 6; ++p) {
+            const float* plane = planes + p * 4;
+            // glm::dot(vec3) ile aynı sıra
+            float d = (plane[0] * x[i] + plane[1] * y[i]) + plane[2] * z[i];
+            if (d + plane[3] < -r[i]) {
+                visible = false;
+                break;
+            }
+        }
+        if (visible) {
+            bits[i >> 6] |= uint64_t(1) << (i & 63);
+        }
+    }
+}
+
+// ---- CPU tespiti ----
+
+namespace {
+    struct CpuFeatures {
+        bool sse41 = false;
+        bool avx2 = false;
+        bool avx512 = false;
+    };
+
+#if SIMD_CULLER_X86
+    void Cpuid(int leaf, int subleaf, unsigned int out[4]) {
+#if defined(_MSC_VER)
+        int regs[4];
+        __cpuidex(regs, leaf, subleaf);
+        for (int i = 0; i < 4; ++i) out[i] = static_cast<unsigned int>(regs[i]);
+#else
+        __cpuid_count(leaf, subleaf, out[0], out[1], out[2], out[3]);
+#endif
+    }
+
+    // işletim sisteminin hangi register durumlarını kaydettiği (XCR0)
+    unsigned long long ReadXcr0() {
+#if defined(_MSC_VER)
+        return _xgetbv(0);
+#else
+        unsigned int eax = 0, edx = 0;
+        __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+        return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+    }
+#endif
+
+    CpuFeatures DetectCpu() {
+        CpuFeatures features;
+#if SIMD_CULLER_X86
+        unsigned int regs[4];
+        Cpuid(0, 0, regs);
+        unsigned int maxLeaf = regs[0];
+
+        Cpuid(1, 0, regs);
+        features.sse41 = (regs[2] & (1u << 19)) != 0;
+        bool osxsave = (regs[2] & (1u << 27)) != 0;
+        bool avx = (regs[2] & (1u << 28)) != 0;
+        if (!osxsave || !avx || maxLeaf < 7) {
+            return features;
+        }
+
+        unsigned long long xcr0 = ReadXcr0();
+        bool ymmState = (xcr0 & 0x6) == 0x6;     // XMM + YMM
+        bool zmmState = (xcr0 & 0xE6) == 0xE6;   // + opmask, ZMM_Hi256, Hi16_ZMM
+
+        Cpuid(7, 0, regs);
+        features.avx2 = ymmState && (regs[1] & (1u << 5)) != 0;
+        features.avx512 = zmmState && (regs[1] & (1u << 16)) != 0;
+#endif
+        return features;
+    }
+
+    const CpuFeatures& GetCpuFeatures() {
+        static const CpuFeatures features = DetectCpu();
+        return features;
+    }
+
+    bool activeIsaSet = false;
+    SimdCuller::Isa activeIsa = SimdCuller::Isa::Scalar;
+
+    size_t Popcount64(uint64_t value) {
+        // SWAR, popcnt talimatına bağımlı olmamak için
+        value = value - ((value >> 1) & 0x5555555555555555ull);
+        value = (value & 0x3333333333333333ull) + ((value >> 2) & 0x3333333333333333ull);
+        value = (value + (value >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+        return static_cast<size_t>((value * 0x0101010101010101ull) >> 56);
+    }
+}
+
+// ---- SimdCuller ----
+
+bool SimdCuller::IsIsaSupported(Isa isa) {
+    const CpuFeatures& features = GetCpuFeatures();
+    switch (isa) {
+    case Isa::Scalar: return true;
+    case Isa::SSE4: return features.sse41;
+    case Isa::AVX2: return features.avx2;
+    case Isa::AVX512: return features.avx512;
+    }
+    return false;
+}
+
+SimdCuller::Isa SimdCuller::GetBestIsa() {
+    if (IsIsaSupported(Isa::AVX512)) return Isa::AVX512;
+    if (IsIsaSupported(Isa::AVX2)) return Isa::AVX2;
+    if (IsIsaSupported(Isa::SSE4)) return Isa::SSE4;
+    return Isa::Scalar;
+}
+
+const char* SimdCuller::GetIsaName(Isa isa) {
+    switch (isa) {
+    case Isa::Scalar: return "Skaler";
+    case Isa::SSE4: return "SSE4";
+    case Isa::AVX2: return "AVX2";
+    case Isa::AVX512: return "AVX-512";
+    }
+    return "?";
+}
+
+SimdCuller::Isa SimdCuller::GetActiveIsa() {
+    if (!activeIsaSet) {
+        activeIsa = GetBestIsa();
+        activeIsaSet = true;
+        std::cout << "SIMD culling yolu: " << GetIsaName(activeIsa) << std::endl;
+    }
+    return activeIsa;
+}
+
+void SimdCuller::SetActiveIsa(Isa isa) {
+    activeIsa = IsIsaSupported(isa) ? isa : GetBestIsa();
+    activeIsaSet = true;
+}
+
+size_t SimdCuller::CullSpheres(const Frustum& frustum, const SphereSoA& spheres, std::vector<uint64_t>& visibleBits) {
+    return CullSpheres(GetActiveIsa(), frustum, spheres, visibleBits);
+}
+
+size_t SimdCuller::CullSpheres(Isa isa, const Frustum& frustum, const SphereSoA& spheres, std::vector<uint64_t>& visibleBits) {
+    if (!IsIsaSupported(isa)) {
+        isa = GetBestIsa();
+    }
+
+    size_t padded = spheres.PaddedSize();
+    visibleBits.assign((padded + 63) / 64, 0);
+
+    float planes[24];
+    const auto& frustumPlanes = frustum.GetPlanes();
+    for (int p = 0; p < 6; ++p) {
+        for (int c = 0; c < 4; ++c) {
+            planes[p * 4 + c] = frustumPlanes[p][c];
+        }
+    }
+
+    switch (isa) {
+    case Isa::AVX512:
+        SimdCullerKernels::CullAVX512(planes, spheres.X(), spheres.Y(), spheres.Z(), spheres.R(), padded, visibleBits.data());
+        break;
+    case Isa::AVX2:
+        SimdCullerKernels::CullAVX2(planes, spheres.X(), spheres.Y(), spheres.Z(), spheres.R(), padded, visibleBits.data());
+        break;
+    case Isa::SSE4:
+        SimdCullerKernels::CullSSE4(planes, spheres.X(), spheres.Y(), spheres.Z(), spheres.R(), padded, visibleBits.data());
+        break;
+    default:
+        SimdCullerKernels::CullScalar(planes, spheres.X(), spheres.Y(), spheres.Z(), spheres.R(), padded, visibleBits.data());
+        break;
+    }
+
+    size_t visible = 0;
+    for (uint64_t word : visibleBits) {
+        visible += Popcount64(word);
+    }
+    return visible;
+}
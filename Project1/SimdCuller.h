@@ -0,0 +1,60 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "Frustum.h"
+
+// Küreler structure-of-arrays düzeninde: merkezler ve yarıçaplar ayrı float dizilerinde
+// SIMD kernel her iterasyonda 4/8/16 küreyi altı düzleme karşı test ediyor
+// dizi sonu her zaman BATCH_SIZE'a tamamlanıyor, dolgu kürelerinin yarıçapı -FLT_MAX
+// olduğu için hiçbir zaman görünür çıkmıyor, kernel kuyruğu ayrıca işlemiyor
+class SphereSoA {
+public:
+    static constexpr size_t BATCH_SIZE = 16; // AVX-512 genişliği
+
+    SphereSoA() { Clear(); }
+
+    void Clear();
+    void Reserve(size_t count);
+    // yeni kürenin indexini döndürür, bitsetteki sırası da bu
+    size_t Add(const glm::vec3& center, float radius);
+    void Set(size_t index, const glm::vec3& center, float radius);
+
+    size_t Size() const { return count; }
+    size_t PaddedSize() const { return x.size(); }
+    const float* X() const { return x.data(); }
+    const float* Y() const { return y.data(); }
+    const float* Z() const { return z.data(); }
+    const float* R() const { return r.data(); }
+
+private:
+    void Pad();
+
+    std::vector<float> x, y, z, r;
+    size_t count = 0;
+};
+
+// Çalışma anında CPU'ya göre en geniş SIMD yolu seçiliyor
+// sonuç sıkıştırılmış bitset: bit i = küre i görünür (64 bitlik kelimeler)
+class SimdCuller {
+public:
+    enum class Isa { Scalar, SSE4, AVX2, AVX512 };
+
+    // CPU'nun (ve işletim sisteminin register kaydetme desteğinin) izin verdiği en iyi yol
+    static Isa GetBestIsa();
+    static bool IsIsaSupported(Isa isa);
+    static const char* GetIsaName(Isa isa);
+
+    // aktif yol, desteklenmeyen bir yol istenirse en iyi yola düşülüyor (benchmark için)
+    static Isa GetActiveIsa();
+    static void SetActiveIsa(Isa isa);
+
+    // Frustum::IsSphereVisible ile birebir aynı sonuç, görünen sayısını döndürür
+    static size_t CullSpheres(const Frustum& frustum, const SphereSoA& spheres, std::vector<uint64_t>& visibleBits);
+    static size_t CullSpheres(Isa isa, const Frustum& frustum, const SphereSoA& spheres, std::vector<uint64_t>& visibleBits);
+
+    static bool IsBitSet(const std::vector<uint64_t>& bits, size_t index) {
+        return (bits[index >> 6] >> (index & 63)) & 1u;
+    }
+};
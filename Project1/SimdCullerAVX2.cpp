@@ -0,0 +1,40 @@
+#include "SimdCullerKernels.h"
+
+#if SIMD_CULLER_X86
+#include <immintrin.h>
+
+// 8 küre / iterasyon
+void SimdCullerKernels::CullAVX2(const float* planes, const float* x, const float* y, const float* z, const float* r,
+    size_t count, uint64_t* bits) {
+
+    __m256 pa[6], pb[6], pc[6], pd[6];
+    for (int p = 0; p < 6; ++p) {
+        pa[p] = _mm256_set1_ps(planes[p * 4 + 0]);
+        pb[p] = _mm256_set1_ps(planes[p * 4 + 1]);
+        pc[p] = _mm256_set1_ps(planes[p * 4 + 2]);
+        pd[p] = _mm256_set1_ps(planes[p * 4 + 3]);
+    }
+
+    const __m256 zero = _mm256_setzero_ps();
+    for (size_t i = 0; i < count; i += 8) {
+        __m256 cx = _mm256_loadu_ps(x + i);
+        __m256 cy = _mm256_loadu_ps(y + i);
+        __m256 cz = _mm256_loadu_ps(z + i);
+        __m256 negRadius = _mm256_sub_ps(zero, _mm256_loadu_ps(r + i));
+
+        // FMA bilerek kullanılmıyor, skaler yolla aynı yuvarlama
+        int mask = 0xFF;
+        for (int p = 0; p < 6 && mask; ++p) {
+            __m256 d = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(pa[p], cx), _mm256_mul_ps(pb[p], cy)),
+                _mm256_mul_ps(pc[p], cz)), pd[p]);
+            mask &= _mm256_movemask_ps(_mm256_cmp_ps(d, negRadius, _CMP_GE_OQ));
+        }
+        bits[i >> 6] |= static_cast<uint64_t>(mask) << (i & 63);
+    }
+}
+#else
+void SimdCullerKernels::CullAVX2(const float* planes, const float* x, const float* y, const float* z, const float* r,
+    size_t count, uint64_t* bits) {
+    CullScalar(planes, x, y, z, r, count, bits);
+}
+#endif
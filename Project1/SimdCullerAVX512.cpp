@@ -0,0 +1,39 @@
+#include "SimdCullerKernels.h"
+
+#if SIMD_CULLER_X86
+#include <immintrin.h>
+
+// 16 küre / iterasyon, karşılaştırma sonucu doğrudan mask registerında
+void SimdCullerKernels::CullAVX512(const float* planes, const float* x, const float* y, const float* z, const float* r,
+    size_t count, uint64_t* bits) {
+
+    __m512 pa[6], pb[6], pc[6], pd[6];
+    for (int p = 0; p < 6; ++p) {
+        pa[p] = _mm512_set1_ps(planes[p * 4 + 0]);
+        pb[p] = _mm512_set1_ps(planes[p * 4 + 1]);
+        pc[p] = _mm512_set1_ps(planes[p * 4 + 2]);
+        pd[p] = _mm512_set1_ps(planes[p * 4 + 3]);
+    }
+
+    const __m512 zero = _mm512_setzero_ps();
+    for (size_t i = 0; i < count; i += 16) {
+        __m512 cx = _mm512_loadu_ps(x + i);
+        __m512 cy = _mm512_loadu_ps(y + i);
+        __m512 cz = _mm512_loadu_ps(z + i);
+        __m512 negRadius = _mm512_sub_ps(zero, _mm512_loadu_ps(r + i));
+
+        __mmask16 mask = 0xFFFF;
+        for (int p = 0; p < 6 && mask; ++p) {
+            __m512 d = _mm512_add_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(pa[p], cx), _mm512_mul_ps(pb[p], cy)),
+                _mm512_mul_ps(pc[p], cz)), pd[p]);
+            mask = _mm512_mask_cmp_ps_mask(mask, d, negRadius, _CMP_GE_OQ);
+        }
+        bits[i >> 6] |= static_cast<uint64_t>(mask) << (i & 63);
+    }
+}
+#else
+void SimdCullerKernels::CullAVX512(const float* planes, const float* x, const float* y, const float* z, const float* r,
+    size_t count, uint64_t* bits) {
+    CullScalar(planes, x, y, z, r, count, bits);
+}
+#endif
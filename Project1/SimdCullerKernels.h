@@ -0,0 +1,23 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// SimdCuller'ın ISA'ya özel kernelleri, her biri kendi derleme bayraklarıyla ayrı dosyada
+// planes: 6 düzlem x (a, b, c, d), count BATCH_SIZE'ın katı, bits (count + 63) / 64 kelimeye
+// yer açmış ve sıfırlanmış olmalı. x86 dışında SIMD kernelleri derlenmiyor, sadece skaler var.
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SIMD_CULLER_X86 1
+#else
+#define SIMD_CULLER_X86 0
+#endif
+
+namespace SimdCullerKernels {
+    void CullScalar(const float* planes, const float* x, const float* y, const float* z, const float* r,
+        size_t count, uint64_t* bits);
+    void CullSSE4(const float* planes, const float* x, const float* y, const float* z, const float* r,
+        size_t count, uint64_t* bits);
+    void CullAVX2(const float* planes, const float* x, const float* y, const float* z, const float* r,
+        size_t count, uint64_t* bits);
+    void CullAVX512(const float* planes, const float* x, const float* y, const float* z, const float* r,
+        size_t count, uint64_t* bits);
+}
@@ -0,0 +1,40 @@
+#include "SimdCullerKernels.h"
+
+#if SIMD_CULLER_X86
+#include <smmintrin.h>
+
+// 4 küre / iterasyon
+void SimdCullerKernels::CullSSE4(const float* planes, const float* x, const float* y, const float* z, const float* r,
+    size_t count, uint64_t* bits) {
+
+    __m128 pa[6], pb[6], pc[6], pd[6];
+    for (int p = 0; p < 6; ++p) {
+        pa[p] = _mm_set1_ps(planes[p * 4 + 0]);
+        pb[p] = _mm_set1_ps(planes[p * 4 + 1]);
+        pc[p] = _mm_set1_ps(planes[p * 4 + 2]);
+        pd[p] = _mm_set1_ps(planes[p * 4 + 3]);
+    }
+
+    const __m128 zero = _mm_setzero_ps();
+    for (size_t i = 0; i < count; i += 4) {
+        __m128 cx = _mm_loadu_ps(x + i);
+        __m128 cy = _mm_loadu_ps(y + i);
+        __m128 cz = _mm_loadu_ps(z + i);
+        __m128 negRadius = _mm_sub_ps(zero, _mm_loadu_ps(r + i));
+
+        // skaler testle aynı toplama sırası, sonuçlar bit bit aynı
+        int mask = 0xF;
+        for (int p = 0; p < 6 && mask; ++p) {
+            __m128 d = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(pa[p], cx), _mm_mul_ps(pb[p], cy)),
+                _mm_mul_ps(pc[p], cz)), pd[p]);
+            mask &= _mm_movemask_ps(_mm_cmpge_ps(d, negRadius));
+        }
+        bits[i >> 6] |= static_cast<uint64_t>(mask) << (i & 63);
+    }
+}
+#else
+void SimdCullerKernels::CullSSE4(const float* planes, const float* x, const float* y, const float* z, const float* r,
+    size_t count, uint64_t* bits) {
+    CullScalar(planes, x, y, z, r, count, bits);
+}
+#endif
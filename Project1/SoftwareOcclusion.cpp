@@ -0,0 +1,355 @@
+#include "SoftwareOcclusion.h"
+#include "SimdCullerKernels.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cfloat>
+
+#if SIMD_CULLER_X86
+#include <emmintrin.h>
+#endif
+
+namespace {
+    // near plane'e bu kadar yakın vertexler kırpılıyor (clip uzayında z + w)
+    constexpr float NEAR_EPSILON = 1e-5f;
+}
+
+SoftwareOcclusion::SoftwareOcclusion()
+    : depth(WIDTH * HEIGHT, 0.0f), tileMin(TILES_X * TILES_Y, 0.0f), tileMax(TILES_X * TILES_Y, 0.0f) {
+}
+
+SoftwareOcclusion::~SoftwareOcclusion() {
+    if (debugTexture) {
+        glDeleteTextures(1, &debugTexture);
+    }
+}
+
+std::vector<glm::vec3> SoftwareOcclusion::BuildOccluderTriangles(const std::vector<MuseumObject::Mesh>& meshes) {
+    struct Candidate {
+        glm::vec3 v[3];
+        float area;
+    };
+    std::vector<Candidate> candidates;
+    const int stride = GeometryPool::VERTEX_FLOATS;
+
+    // küçük üçgenler (süsleme, detay) neredeyse hiçbir şey kapatmıyor, büyük yüzeyler yeterli
+    // gerçek üçgenlerin alt kümesi olduğu için sonuç her zaman temkinli
+    for (const auto& mesh : meshes) {
+        for (size_t t = 0; t + 2 < mesh.indices.size(); t += 3) {
+            Candidate candidate;
+            for (int k = 0; k < 3; ++k) {
+                const float* vertex = &mesh.vertices[mesh.indices[t + k] * stride];
+                candidate.v[k] = glm::vec3(vertex[0], vertex[1], vertex[2]);
+            }
+            candidate.area = 0.5f * glm::length(glm::cross(candidate.v[1] - candidate.v[0], candidate.v[2] - candidate.v[0]));
+            if (candidate.area >= MIN_OCCLUDER_AREA) {
+                candidates.push_back(candidate);
+            }
+        }
+    }
+
+    if (candidates.size() > MAX_OCCLUDER_TRIANGLES) {
+        std::nth_element(candidates.begin(), candidates.begin() + MAX_OCCLUDER_TRIANGLES, candidates.end(),
+            [](const Candidate& a, const Candidate& b) { return a.area > b.area; });
+        candidates.resize(MAX_OCCLUDER_TRIANGLES);
+    }
+
+    std::vector<glm::vec3> triangles;
+    triangles.reserve(candidates.size() * 3);
+    for (const auto& candidate : candidates) {
+        triangles.insert(triangles.end(), candidate.v, candidate.v + 3);
+    }
+    return triangles;
+}
+
+void SoftwareOcclusion::BeginFrame(const glm::mat4& newViewProjection) {
+    viewProjection = newViewProjection;
+    pendingOccluders.clear();
+    screenTriangles.clear();
+    stats = Stats();
+}
+
+void SoftwareOcclusion::AddOccluders(const std::vector<glm::vec3>& triangles) {
+    pendingOccluders.insert(pendingOccluders.end(), triangles.begin(), triangles.end());
+}
+
+void SoftwareOcclusion::Rasterize() {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    stats.occluderTriangles = pendingOccluders.size() / 3;
+    for (size_t i = 0; i + 2 < pendingOccluders.size(); i += 3) {
+        SetupTriangle(viewProjection * glm::vec4(pendingOccluders[i], 1.0f),
+            viewProjection * glm::vec4(pendingOccluders[i + 1], 1.0f),
+            viewProjection * glm::vec4(pendingOccluders[i + 2], 1.0f));
+    }
+    stats.rasterizedTriangles = screenTriangles.size();
+
+    // her şerit kendi satırlarını ve karolarını yazıyor, kilit gerekmiyor
+    JobSystem::GetInstance().ParallelFor(BIN_COUNT, 1, [this](size_t begin, size_t end) {
+        for (size_t bin = begin; bin < end; ++bin) {
+            RasterizeBin(static_cast<int>(bin));
+        }
+    });
+
+    stats.rasterMs = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - start).count();
+}
+
+void SoftwareOcclusion::SetupTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c) {
+    // near plane kırpması (Sutherland-Hodgman, tek düzlem), en fazla 4 köşe
+    const glm::vec4 input[3] = { a, b, c };
+    glm::vec4 clipped[4];
+    int count = 0;
+    for (int i = 0; i < 3; ++i) {
+        const glm::vec4& current = input[i];
+        const glm::vec4& next = input[(i + 1) % 3];
+        float dCurrent = current.z + current.w;
+        float dNext = next.z + next.w;
+        if (dCurrent >= NEAR_EPSILON) {
+            clipped[count++] = current;
+        }
+        if ((dCurrent >= NEAR_EPSILON) != (dNext >= NEAR_EPSILON)) {
+            float t = (NEAR_EPSILON - dCurrent) / (dNext - dCurrent);
+            clipped[count++] = current + (next - current) * t;
+        }
+    }
+    if (count < 3) {
+        return;
+    }
+    AddScreenTriangle(clipped[0], clipped[1], clipped[2]);
+    if (count == 4) {
+        AddScreenTriangle(clipped[0], clipped[2], clipped[3]);
+    }
+}
+
+void SoftwareOcclusion::AddScreenTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c) {
+    const glm::vec4* v[3] = { &a, &b, &c };
+    ScreenTriangle triangle;
+    float minX = FLT_MAX, maxX = -FLT_MAX, minY = FLT_MAX, maxY = -FLT_MAX;
+    for (int k = 0; k < 3; ++k) {
+        float invW = 1.0f / v[k]->w;
+        triangle.x[k] = (v[k]->x * invW * 0.5f + 0.5f) * WIDTH;
+        triangle.y[k] = (v[k]->y * invW * 0.5f + 0.5f) * HEIGHT;
+        triangle.z[k] = invW;
+        minX = std::min(minX, triangle.x[k]);
+        maxX = std::max(maxX, triangle.x[k]);
+        minY = std::min(minY, triangle.y[k]);
+        maxY = std::max(maxY, triangle.y[k]);
+    }
+
+    // ekran dışı
+    if (maxX < 0.0f || minX > WIDTH || maxY < 0.0f || minY > HEIGHT) {
+        return;
+    }
+
+    // duvarlar iki taraftan da kapatıyor, arka yüz ayrımı yok; sarım saat yönünün tersine çevriliyor
+    float area = (triangle.x[1] - triangle.x[0]) * (triangle.y[2] - triangle.y[0]) -
+        (triangle.x[2] - triangle.x[0]) * (triangle.y[1] - triangle.y[0]);
+    if (std::abs(area) < 1e-6f) {
+        return;
+    }
+    if (area < 0.0f) {
+        std::swap(triangle.x[1], triangle.x[2]);
+        std::swap(triangle.y[1], triangle.y[2]);
+        std::swap(triangle.z[1], triangle.z[2]);
+    }
+
+    triangle.minY = std::max(0, static_cast<int>(std::floor(minY)));
+    triangle.maxY = std::min(HEIGHT - 1, static_cast<int>(std::ceil(maxY)));
+    screenTriangles.push_back(triangle);
+}
+
+void SoftwareOcclusion::RasterizeBin(int bin) {
+    int rowBegin = bin * BIN_ROWS;
+    int rowEnd = rowBegin + BIN_ROWS;
+    std::fill(depth.begin() + rowBegin * WIDTH, depth.begin() + rowEnd * WIDTH, 0.0f);
+
+    for (const ScreenTriangle& triangle : screenTriangles) {
+        if (triangle.maxY < rowBegin || triangle.minY >= rowEnd) {
+            continue;
+        }
+        RasterizeTriangle(triangle, std::max(rowBegin, triangle.minY), std::min(rowEnd, triangle.maxY + 1));
+    }
+
+    BuildTiles(rowBegin / TILE_SIZE, rowEnd / TILE_SIZE);
+}
+
+void SoftwareOcclusion::RasterizeTriangle(const ScreenTriangle& t, int rowBegin, int rowEnd) {
+    // kenar fonksiyonları E(x, y) = A x + B y + C, içeride hepsi >= 0
+    float edgeA[3], edgeB[3], edgeC[3];
+    for (int i = 0; i < 3; ++i) {
+        int j = (i + 1) % 3;
+        edgeA[i] = t.y[i] - t.y[j];
+        edgeB[i] = t.x[j] - t.x[i];
+        edgeC[i] = t.x[i] * t.y[j] - t.x[j] * t.y[i];
+    }
+
+    // 1/w ekran uzayında doğrusal: z = zA x + zB y + zC
+    float area = (t.x[1] - t.x[0]) * (t.y[2] - t.y[0]) - (t.x[2] - t.x[0]) * (t.y[1] - t.y[0]);
+    float zA = ((t.z[1] - t.z[0]) * (t.y[2] - t.y[0]) - (t.z[2] - t.z[0]) * (t.y[1] - t.y[0])) / area;
+    float zB = ((t.z[2] - t.z[0]) * (t.x[1] - t.x[0]) - (t.z[1] - t.z[0]) * (t.x[2] - t.x[0])) / area;
+    float zC = t.z[0] - zA * t.x[0] - zB * t.y[0];
+
+    float minX = std::min(std::min(t.x[0], t.x[1]), t.x[2]);
+    float maxX = std::max(std::max(t.x[0], t.x[1]), t.x[2]);
+    int columnBegin = std::max(0, static_cast<int>(std::floor(minX))) & ~3; // 4'lü gruplar hizalı
+    int columnEnd = std::min(WIDTH, static_cast<int>(std::ceil(maxX)) + 1);
+
+    for (int row = rowBegin; row < rowEnd; ++row) {
+        float py = row + 0.5f;
+        float* depthRow = &depth[row * WIDTH];
+
+#if SIMD_CULLER_X86
+        // SSE2: 4 piksel birden, x64'te her zaman var
+        __m128 offsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+        __m128 e[3], eStep[3];
+        for (int i = 0; i < 3; ++i) {
+            __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(columnBegin)), offsets);
+            e[i] = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(edgeA[i]), px), _mm_set1_ps(edgeB[i] * py + edgeC[i]));
+            eStep[i] = _mm_set1_ps(edgeA[i] * 4.0f);
+        }
+        __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(columnBegin)), offsets);
+        __m128 z = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(zA), px), _mm_set1_ps(zB * py + zC));
+        __m128 zStep = _mm_set1_ps(zA * 4.0f);
+        __m128 zero = _mm_setzero_ps();
+
+        for (int column = columnBegin; column < columnEnd; column += 4) {
+            __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e[0], zero), _mm_cmpge_ps(e[1], zero)),
+                _mm_cmpge_ps(e[2], zero));
+            if (_mm_movemask_ps(inside)) {
+                __m128 current = _mm_loadu_ps(depthRow + column);
+                __m128 nearer = _mm_max_ps(current, z);
+                _mm_storeu_ps(depthRow + column, _mm_or_ps(_mm_and_ps(inside, nearer), _mm_andnot_ps(inside, current)));
+            }
+            for (int i = 0; i < 3; ++i) {
+                e[i] = _mm_add_ps(e[i], eStep[i]);
+            }
+            z = _mm_add_ps(z, zStep);
+        }
+#else
+        for (int column = columnBegin; column < columnEnd; ++column) {
+            float px = column + 0.5f;
+            if (edgeA[0] * px + edgeB[0] * py + edgeC[0] >= 0.0f &&
+                edgeA[1] * px + edgeB[1] * py + edgeC[1] >= 0.0f &&
+                edgeA[2] * px + edgeB[2] * py + edgeC[2] >= 0.0f) {
+                depthRow[column] = std::max(depthRow[column], zA * px + zB * py + zC);
+            }
+        }
+#endif
+    }
+}
+
+void SoftwareOcclusion::BuildTiles(int tileRowBegin, int tileRowEnd) {
+    for (int tileY = tileRowBegin; tileY < tileRowEnd; ++tileY) {
+        for (int tileX = 0; tileX < TILES_X; ++tileX) {
+            float farthest = FLT_MAX;
+            float nearest = 0.0f;
+            for (int y = 0; y < TILE_SIZE; ++y) {
+                const float* row = &depth[(tileY * TILE_SIZE + y) * WIDTH + tileX * TILE_SIZE];
+                for (int x = 0; x < TILE_SIZE; ++x) {
+                    farthest = std::min(farthest, row[x]);
+                    nearest = std::max(nearest, row[x]);
+                }
+            }
+            tileMin[tileY * TILES_X + tileX] = farthest;
+            tileMax[tileY * TILES_X + tileX] = nearest;
+        }
+    }
+}
+
+bool SoftwareOcclusion::IsBoxVisible(const glm::vec3& boxMin, const glm::vec3& boxMax) {
+    auto start = std::chrono::high_resolution_clock::now();
+    stats.testedBoxes++;
+
+    auto finish = [&](bool visible) {
+        if (!visible) stats.occludedBoxes++;
+        stats.testMs += std::chrono::duration<double, std::milli>(
+            std::chrono::high_resolution_clock::now() - start).count();
+        return visible;
+    };
+
+    // köşeleri ekrana taşı, en yakın 1/w kutunun en yakın noktası için üst sınır
+    float minX = FLT_MAX, maxX = -FLT_MAX, minY = FLT_MAX, maxY = -FLT_MAX;
+    float boxNearest = 0.0f;
+    for (int corner = 0; corner < 8; ++corner) {
+        glm::vec3 p((corner & 1) ? boxMax.x : boxMin.x, (corner & 2) ? boxMax.y : boxMin.y, (corner & 4) ? boxMax.z : boxMin.z);
+        glm::vec4 clip = viewProjection * glm::vec4(p, 1.0f);
+        // kamera kutunun içinde ya da near plane'i kesiyor
+        if (clip.z + clip.w < NEAR_EPSILON) {
+            return finish(true);
+        }
+        float invW = 1.0f / clip.w;
+        float x = (clip.x * invW * 0.5f + 0.5f) * WIDTH;
+        float y = (clip.y * invW * 0.5f + 0.5f) * HEIGHT;
+        minX = std::min(minX, x);
+        maxX = std::max(maxX, x);
+        minY = std::min(minY, y);
+        maxY = std::max(maxY, y);
+        boxNearest = std::max(boxNearest, invW);
+    }
+
+    // kenar piksellerinde rasterizasyon kaymasına karşı bir piksel pay
+    int x0 = std::max(0, static_cast<int>(std::floor(minX)) - 1);
+    int x1 = std::min(WIDTH - 1, static_cast<int>(std::ceil(maxX)) + 1);
+    int y0 = std::max(0, static_cast<int>(std::floor(minY)) - 1);
+    int y1 = std::min(HEIGHT - 1, static_cast<int>(std::ceil(maxY)) + 1);
+    if (x0 > x1 || y0 > y1) {
+        return finish(true); // ekran dışı, frustum culling'e kalsın
+    }
+
+    for (int tileY = y0 / TILE_SIZE; tileY <= y1 / TILE_SIZE; ++tileY) {
+        for (int tileX = x0 / TILE_SIZE; tileX <= x1 / TILE_SIZE; ++tileX) {
+            int tile = tileY * TILES_X + tileX;
+            // karonun en uzak pikseli bile kutudan yakınsa karo tamamen kapatıyor
+            if (boxNearest < tileMin[tile]) {
+                continue;
+            }
+            // kutu karodaki her pikselden yakın
+            if (boxNearest >= tileMax[tile]) {
+                return finish(true);
+            }
+            // karoda pikselleri tek tek kontrol et
+            int px0 = std::max(x0, tileX * TILE_SIZE), px1 = std::min(x1, tileX * TILE_SIZE + TILE_SIZE - 1);
+            int py0 = std::max(y0, tileY * TILE_SIZE), py1 = std::min(y1, tileY * TILE_SIZE + TILE_SIZE - 1);
+            for (int y = py0; y <= py1; ++y) {
+                for (int x = px0; x <= px1; ++x) {
+                    if (boxNearest >= depth[y * WIDTH + x]) {
+                        return finish(true);
+                    }
+                }
+            }
+        }
+    }
+    return finish(false);
+}
+
+GLuint SoftwareOcclusion::UpdateDebugTexture() {
+    if (!debugTexture) {
+        glGenTextures(1, &debugTexture);
+        glBindTexture(GL_TEXTURE_2D, debugTexture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, WIDTH, HEIGHT, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    }
+
+    // yakın parlak, boş piksel kırmızımsı siyah
+    debugPixels.resize(WIDTH * HEIGHT * 4);
+    for (int i = 0; i < WIDTH * HEIGHT; ++i) {
+        unsigned char* pixel = &debugPixels[i * 4];
+        if (depth[i] <= 0.0f) {
+            pixel[0] = 40; pixel[1] = 0; pixel[2] = 0;
+        }
+        else {
+            float distance = 1.0f / depth[i];
+            unsigned char gray = static_cast<unsigned char>(255.0f * std::max(0.0f, 1.0f - distance / 40.0f));
+            pixel[0] = pixel[1] = pixel[2] = gray;
+        }
+        pixel[3] = 255;
+    }
+
+    glBindTexture(GL_TEXTURE_2D, debugTexture);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, WIDTH, HEIGHT, GL_RGBA, GL_UNSIGNED_BYTE, debugPixels.data());
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return debugTexture;
+}
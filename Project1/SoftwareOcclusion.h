@@ -0,0 +1,79 @@
+#pragma once
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstddef>
+#include "MuseumObject.h"
+
+// CPU'da düşük çözünürlüklü derinlik bufferı ile occlusion culling
+// statik binanın büyük üçgenleri (duvar, zemin, kolon yüzleri) import sırasında sadeleştirilmiş
+// occluder listesine alınıyor, her frame worker threadlerde SIMD ile rasterize ediliyor.
+// Objelerin kutuları GL'ye hiçbir şey gönderilmeden 8x8 karolu min/max derinliğe karşı
+// test ediliyor, GPU query'lerinin aksine gecikme yok.
+// Buffer 1/w tutuyor (ekranda doğrusal, büyük = yakın, 0 = boş)
+class SoftwareOcclusion {
+public:
+    static constexpr int WIDTH = 256;
+    static constexpr int HEIGHT = 128;
+    static constexpr int TILE_SIZE = 8;
+    static constexpr int TILES_X = WIDTH / TILE_SIZE;
+    static constexpr int TILES_Y = HEIGHT / TILE_SIZE;
+    static constexpr int BIN_ROWS = 16; // her iş bu kadar satırlık şerit
+    static constexpr int BIN_COUNT = HEIGHT / BIN_ROWS;
+
+    // occluder üretimi: bu alandan küçük üçgenler atılıyor, en büyükler tutuluyor
+    static constexpr float MIN_OCCLUDER_AREA = 0.5f;
+    static constexpr size_t MAX_OCCLUDER_TRIANGLES = 8192;
+
+    struct Stats {
+        size_t occluderTriangles = 0;   // gönderilen
+        size_t rasterizedTriangles = 0; // kırpma sonrası ekrana düşen
+        size_t testedBoxes = 0;
+        size_t occludedBoxes = 0;
+        double rasterMs = 0.0;
+        double testMs = 0.0;
+    };
+
+    SoftwareOcclusion();
+    ~SoftwareOcclusion();
+
+    // dünya uzayındaki meshlerden occluder üçgenleri (3 köşe / üçgen)
+    static std::vector<glm::vec3> BuildOccluderTriangles(const std::vector<MuseumObject::Mesh>& meshes);
+
+    void BeginFrame(const glm::mat4& viewProjection);
+    void AddOccluders(const std::vector<glm::vec3>& triangles);
+    void Rasterize();
+
+    // kutunun herhangi bir kısmı occluderların önünde kalıyorsa true
+    bool IsBoxVisible(const glm::vec3& boxMin, const glm::vec3& boxMax);
+
+    const Stats& GetStats() const { return stats; }
+    const std::vector<float>& GetDepth() const { return depth; }
+
+    // debug penceresi için, sadece açıkken çağrılmalı
+    GLuint UpdateDebugTexture();
+
+private:
+    struct ScreenTriangle {
+        float x[3], y[3], z[3]; // piksel koordinatı ve 1/w
+        int minY, maxY;
+    };
+
+    void SetupTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c);
+    void AddScreenTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c);
+    void RasterizeBin(int bin);
+    void RasterizeTriangle(const ScreenTriangle& triangle, int rowBegin, int rowEnd);
+    void BuildTiles(int tileRowBegin, int tileRowEnd);
+
+    glm::mat4 viewProjection = glm::mat4(1.0f);
+    std::vector<glm::vec3> pendingOccluders;
+    std::vector<ScreenTriangle> screenTriangles;
+    std::vector<float> depth;
+    std::vector<float> tileMin; // karonun en uzak değeri (1/w en küçük)
+    std::vector<float> tileMax; // en yakın
+
+    GLuint debugTexture = 0;
+    std::vector<unsigned char> debugPixels;
+
+    Stats stats;
+};
@@ -0,0 +1,661 @@
+#include "TourCapture.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace {
+    const float CAPTURE_FOV = 45.0f; // main'in projeksiyonuyla aynı
+
+    uint32_t Crc32(const unsigned char* data, size_t size, uint32_t crc = 0) {
+        static const std::vector<uint32_t> table = [] {
+            std::vector<uint32_t> values(256);
+            for (uint32_t i = 0; i < 256; ++i) {
+                uint32_t c = i;
+                for (int k = 0; k < 8; ++k) {
+                    c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                }
+                values[i] = c;
+            }
+            return values;
+        }();
+        crc = ~crc;
+        for (size_t i = 0; i < size; ++i) {
+            crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        }
+        return ~crc;
+    }
+
+    void AppendBigEndian(std::vector<unsigned char>& out, uint32_t value) {
+        out.push_back(static_cast<unsigned char>(value >> 24));
+        out.push_back(static_cast<unsigned char>(value >> 16));
+        out.push_back(static_cast<unsigned char>(value >> 8));
+        out.push_back(static_cast<unsigned char>(value));
+    }
+
+    void AppendChunk(std::vector<unsigned char>& out, const char* type, const std::vector<unsigned char>& data) {
+        AppendBigEndian(out, static_cast<uint32_t>(data.size()));
+        size_t typeStart = out.size();
+        out.insert(out.end(), type, type + 4);
+        out.insert(out.end(), data.begin(), data.end());
+        AppendBigEndian(out, Crc32(out.data() + typeStart, data.size() + 4));
+    }
+
+    // RGBA alttan üste -> RGB PNG, deflate "stored" bloklarla (sıkıştırmasız ama her okuyucu açıyor)
+    bool WritePng(const std::string& path, const std::vector<unsigned char>& rgba, int width, int height) {
+        size_t rowBytes = static_cast<size_t>(width) * 3 + 1;
+        std::vector<unsigned char> raw(rowBytes * height);
+        for (int y = 0; y < height; ++y) {
+            const unsigned char* source = rgba.data() + static_cast<size_t>(height - 1 - y) * width * 4;
+            unsigned char* row = raw.data() + y * rowBytes;
+            row[0] = 0; // filtre yok
+            for (int x = 0; x < width; ++x) {
+                row[1 + x * 3] = source[x * 4];
+                row[2 + x * 3] = source[x * 4 + 1];
+                row[3 + x * 3] = source[x * 4 + 2];
+            }
+        }
+
+        const size_t MAX_BLOCK = 65535;
+        std::vector<unsigned char> zlib;
+        zlib.reserve(raw.size() + raw.size() / MAX_BLOCK * 5 + 16);
+        zlib.push_back(0x78);
+        zlib.push_back(0x01);
+        uint32_t adlerA = 1;
+        uint32_t adlerB = 0;
+        for (size_t offset = 0; offset < raw.size() || offset == 0; offset += MAX_BLOCK) {
+            size_t blockSize = std::min(MAX_BLOCK, raw.size() - offset);
+            bool last = offset + blockSize >= raw.size();
+            zlib.push_back(last ? 1 : 0);
+            zlib.push_back(static_cast<unsigned char>(blockSize & 0xFF));
+            zlib.push_back(static_cast<unsigned char>(blockSize >> 8));
+            zlib.push_back(static_cast<unsigned char>(~blockSize & 0xFF));
+            zlib.push_back(static_cast<unsigned char>((~blockSize >> 8) & 0xFF));
+            zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + blockSize);
+            for (size_t i = offset; i < offset + blockSize; ++i) {
+                adlerA = (adlerA + raw[i]) % 65521;
+                adlerB = (adlerB + adlerA) % 65521;
+            }
+            if (last) {
+                break;
+            }
+        }
+        AppendBigEndian(zlib, (adlerB << 16) | adlerA);
+
+        std::vector<unsigned char> header;
+        AppendBigEndian(header, static_cast<uint32_t>(width));
+        AppendBigEndian(header, static_cast<uint32_t>(height));
+        header.insert(header.end(), { 8, 2, 0, 0, 0 }); // 8 bit, RGB
+
+        static const unsigned char signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+        std::vector<unsigned char> png(signature, signature + 8);
+        png.reserve(zlib.size() + 64);
+        AppendChunk(png, "IHDR", header);
+        AppendChunk(png, "IDAT", zlib);
+        AppendChunk(png, "IEND", {});
+
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(png.data()), png.size());
+        return static_cast<bool>(file);
+    }
+
+    // RGBA alttan üste -> I420 (BT.709 sınırlı aralık), kroma 2x2 ortalama
+    void ConvertToYuv420(const std::vector<unsigned char>& rgba, int width, int height, std::vector<unsigned char>& yuv) {
+        size_t lumaSize = static_cast<size_t>(width) * height;
+        size_t chromaWidth = width / 2;
+        yuv.resize(lumaSize + lumaSize / 2);
+        unsigned char* planeY = yuv.data();
+        unsigned char* planeU = planeY + lumaSize;
+        unsigned char* planeV = planeU + lumaSize / 4;
+
+        auto pixel = [&](int x, int y) { return rgba.data() + (static_cast<size_t>(height - 1 - y) * width + x) * 4; };
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                const unsigned char* p = pixel(x, y);
+                float luma = 0.2126f * p[0] + 0.7152f * p[1] + 0.0722f * p[2];
+                planeY[static_cast<size_t>(y) * width + x] = static_cast<unsigned char>(16.0f + luma * (219.0f / 255.0f) + 0.5f);
+            }
+        }
+        for (int y = 0; y < height / 2; ++y) {
+            for (int x = 0; x < width / 2; ++x) {
+                float r = 0.0f, g = 0.0f, b = 0.0f;
+                for (int dy = 0; dy < 2; ++dy) {
+                    for (int dx = 0; dx < 2; ++dx) {
+                        const unsigned char* p = pixel(x * 2 + dx, y * 2 + dy);
+                        r += p[0];
+                        g += p[1];
+                        b += p[2];
+                    }
+                }
+                r *= 0.25f;
+                g *= 0.25f;
+                b *= 0.25f;
+                float cb = (-0.1146f * r - 0.3854f * g + 0.5f * b) * (224.0f / 255.0f);
+                float cr = (0.5f * r - 0.4542f * g - 0.0458f * b) * (224.0f / 255.0f);
+                planeU[y * chromaWidth + x] = static_cast<unsigned char>(glm::clamp(128.0f + cb + 0.5f, 0.0f, 255.0f));
+                planeV[y * chromaWidth + x] = static_cast<unsigned char>(glm::clamp(128.0f + cr + 0.5f, 0.0f, 255.0f));
+            }
+        }
+    }
+}
+
+TourCapture::TourCapture() {
+}
+
+TourCapture::~TourCapture() {
+    Cancel();
+}
+
+bool TourCapture::LoadPath(const std::string& path) {
+    if (stats.active) {
+        std::cerr << "Tur kaydi suruyor, yol degistirilemez" << std::endl;
+        return false;
+    }
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Tur yolu acilamadi: " << path << std::endl;
+        return false;
+    }
+
+    std::vector<Keyframe> loaded;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') {
+            continue;
+        }
+        std::istringstream values(line);
+        Keyframe keyframe;
+        if (!(values >> keyframe.time >> keyframe.position.x >> keyframe.position.y >> keyframe.position.z
+            >> keyframe.yaw >> keyframe.pitch)) {
+            std::cerr << "Tur yolu gecersiz satir " << lineNumber << ": " << path << std::endl;
+            return false;
+        }
+        if (!loaded.empty() && keyframe.time <= loaded.back().time) {
+            std::cerr << "Tur yolu zamanlari artmiyor, satir " << lineNumber << ": " << path << std::endl;
+            return false;
+        }
+        loaded.push_back(keyframe);
+    }
+    if (loaded.size() < 2) {
+        std::cerr << "Tur yolunda en az iki anahtar kare olmali: " << path << std::endl;
+        return false;
+    }
+
+    keyframes = std::move(loaded);
+    shots.clear();
+    panoramaShots = false;
+    return true;
+}
+
+void TourCapture::SetArtifactShots(const std::vector<std::shared_ptr<MuseumObject>>& objects, bool panoramas) {
+    // kodlayıcılar dosya adlarını shots'tan okuyor
+    if (stats.active) {
+        return;
+    }
+    keyframes.clear();
+    shots.clear();
+    panoramaShots = panoramas;
+
+    std::vector<const MuseumObject*> artifacts;
+    glm::vec3 centroid(0.0f);
+    for (const auto& object : objects) {
+        if (object && object->GetArtifactInfo()) {
+            glm::vec3 center;
+            float radius;
+            object->GetWorldBoundingSphere(center, radius);
+            centroid += center;
+            artifacts.push_back(object.get());
+        }
+    }
+    if (artifacts.empty()) {
+        return;
+    }
+    centroid /= static_cast<float>(artifacts.size());
+
+    // küre dikey görüş açısına sığacak kadar uzaktan, biraz yukarıdan; eserler duvar kenarında, salonun ortası açık
+    float fitDistance = 1.0f / std::sin(glm::radians(CAPTURE_FOV * 0.5f));
+    for (const MuseumObject* artifact : artifacts) {
+        glm::vec3 center;
+        float radius;
+        artifact->GetWorldBoundingSphere(center, radius);
+        glm::vec3 toward = centroid - center;
+        toward.y = 0.0f;
+        toward = glm::length(toward) > 1e-3f ? glm::normalize(toward) : glm::vec3(0.0f, 0.0f, 1.0f);
+
+        Shot shot;
+        shot.position = center + toward * radius * fitDistance + glm::vec3(0.0f, radius * 0.3f, 0.0f);
+        glm::vec3 direction = glm::normalize(center - shot.position);
+        shot.yaw = glm::degrees(std::atan2(direction.z, direction.x));
+        shot.pitch = glm::degrees(std::asin(direction.y));
+
+        // dosya adında boşluk/ayraç olmasın
+        shot.name = (panoramas ? "panorama_" : "eser_") + artifact->GetArtifactInfo()->GetId();
+        for (char& c : shot.name) {
+            if (!std::isalnum(static_cast<unsigned char>(c)) && c != '_' && c != '-') {
+                c = '_';
+            }
+        }
+        shots.push_back(shot);
+    }
+}
+
+bool TourCapture::Start(const Settings& newSettings) {
+    if (stats.active) {
+        std::cerr << "Tur kaydi zaten suruyor" << std::endl;
+        return false;
+    }
+    if (keyframes.empty() && shots.empty()) {
+        std::cerr << "Tur kaydi: yol ya da eser yok" << std::endl;
+        return false;
+    }
+    // equirectangular panorama: 360 x 180 derece, genişlik yüksekliğin iki katı
+    Settings requested = newSettings;
+    if (panoramaShots && !shots.empty()) {
+        requested.width = requested.height * 2;
+    }
+
+    GLint maxSize = 0;
+    glGetIntegerv(GL_MAX_RENDERBUFFER_SIZE, &maxSize);
+    if (requested.width <= 0 || requested.height <= 0 || requested.width > maxSize || requested.height > maxSize ||
+        requested.fps <= 0.0f) {
+        std::cerr << "Tur kaydi: ayarlar gecersiz (" << requested.width << "x" << requested.height << ", "
+            << requested.fps << " fps)" << std::endl;
+        return false;
+    }
+    if (requested.format == Format::YUV420 && (requested.width % 2 != 0 || requested.height % 2 != 0)) {
+        std::cerr << "Tur kaydi: YUV 4:2:0 icin boyutlar cift olmali" << std::endl;
+        return false;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(requested.outputDirectory, error);
+    if (error) {
+        std::cerr << "Tur kaydi klasoru olusturulamadi: " << requested.outputDirectory << std::endl;
+        return false;
+    }
+
+    settings = requested;
+    if (settings.format == Format::YUV420) {
+        // tek dosya, kodlayıcılar frame'lerini kendi konumlarına yazıyor
+        std::ofstream file(GetFramePath(0), std::ios::binary | std::ios::trunc);
+        if (!file) {
+            std::cerr << "Tur kaydi dosyasi acilamadi: " << GetFramePath(0) << std::endl;
+            return false;
+        }
+    }
+    if (!CreateTargets()) {
+        return false;
+    }
+
+    stats = Stats();
+    if (shots.empty()) {
+        float duration = keyframes.back().time - keyframes.front().time;
+        stats.totalFrames = static_cast<size_t>(std::floor(duration * settings.fps + 1e-3f)) + 1;
+    }
+    else {
+        stats.totalFrames = shots.size();
+    }
+    stats.active = true;
+    frameIndex = 0;
+    bytesRead = 0;
+    startTime = std::chrono::steady_clock::now();
+    StartEncoders();
+
+    std::cout << "Tur kaydi basladi: " << stats.totalFrames << " frame, " << settings.width << "x" << settings.height
+        << (settings.format == Format::PNG ? " PNG" : " YUV420") << ", " << encoders.size() << " kodlayici -> "
+        << settings.outputDirectory << std::endl;
+    return true;
+}
+
+bool TourCapture::CreateTargets() {
+    glGenRenderbuffers(1, &colorRenderbuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, colorRenderbuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, settings.width, settings.height);
+    glGenRenderbuffers(1, &depthRenderbuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthRenderbuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, settings.width, settings.height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorRenderbuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthRenderbuffer);
+    bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (!complete) {
+        std::cerr << "Hata: tur kaydi hedefi olusturulamadi (" << settings.width << "x" << settings.height << ")" << std::endl;
+        DestroyTargets();
+        return false;
+    }
+
+    // RGBA okumada satır hizası sorun değil, sürücünün hızlı yolu
+    frameBytes = static_cast<size_t>(settings.width) * settings.height * 4;
+    for (auto& slot : slots) {
+        glGenBuffers(1, &slot.buffer);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+        glBufferData(GL_PIXEL_PACK_BUFFER, frameBytes, nullptr, GL_STREAM_READ);
+        slot.fence = nullptr;
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    slotIndex = 0;
+    return true;
+}
+
+void TourCapture::DestroyTargets() {
+    for (auto& slot : slots) {
+        if (slot.fence) {
+            glDeleteSync(slot.fence);
+            slot.fence = nullptr;
+        }
+        glDeleteBuffers(1, &slot.buffer);
+        slot.buffer = 0;
+    }
+    glDeleteFramebuffers(1, &framebuffer);
+    glDeleteRenderbuffers(1, &colorRenderbuffer);
+    glDeleteRenderbuffers(1, &depthRenderbuffer);
+    framebuffer = 0;
+    colorRenderbuffer = 0;
+    depthRenderbuffer = 0;
+}
+
+TourCapture::Keyframe TourCapture::SamplePath(float time) const {
+    if (time <= keyframes.front().time) {
+        return keyframes.front();
+    }
+    if (time >= keyframes.back().time) {
+        return keyframes.back();
+    }
+
+    size_t segment = 0;
+    while (segment + 2 < keyframes.size() && keyframes[segment + 1].time <= time) {
+        segment++;
+    }
+    const Keyframe& k1 = keyframes[segment];
+    const Keyframe& k2 = keyframes[segment + 1];
+    const Keyframe& k0 = keyframes[segment > 0 ? segment - 1 : segment];
+    const Keyframe& k3 = keyframes[std::min(segment + 2, keyframes.size() - 1)];
+    float t = (time - k1.time) / (k2.time - k1.time);
+    float t2 = t * t;
+    float t3 = t2 * t;
+
+    Keyframe result;
+    result.time = time;
+    result.position = 0.5f * ((2.0f * k1.position) + (-k0.position + k2.position) * t +
+        (2.0f * k0.position - 5.0f * k1.position + 4.0f * k2.position - k3.position) * t2 +
+        (-k0.position + 3.0f * k1.position - 3.0f * k2.position + k3.position) * t3);
+    // yaw kısa yoldan dönüyor
+    float yawDelta = std::fmod(k2.yaw - k1.yaw + 540.0f, 360.0f) - 180.0f;
+    result.yaw = k1.yaw + yawDelta * t;
+    result.pitch = glm::mix(k1.pitch, k2.pitch, t);
+    return result;
+}
+
+void TourCapture::ApplyCamera(Camera& camera) const {
+    if (!stats.active) {
+        return;
+    }
+    if (!shots.empty()) {
+        const Shot& shot = shots[std::min(frameIndex, shots.size() - 1)];
+        camera.Position = shot.position;
+        camera.SetOrientation(shot.yaw, shot.pitch);
+        return;
+    }
+    Keyframe keyframe = SamplePath(keyframes.front().time + frameIndex / settings.fps);
+    camera.Position = keyframe.position;
+    camera.SetOrientation(keyframe.yaw, keyframe.pitch);
+}
+
+glm::mat4 TourCapture::GetProjection() const {
+    return glm::perspective(glm::radians(CAPTURE_FOV), static_cast<float>(settings.width) / settings.height, 0.1f, 100.0f);
+}
+
+void TourCapture::BeginFrame() {
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glViewport(0, 0, settings.width, settings.height);
+}
+
+void TourCapture::EndFrame(int previewWidth, int previewHeight) {
+    if (!stats.active) {
+        return;
+    }
+
+    // önce işi bitmiş PBO'lar, sonra sıradaki yuva hala doluysa (GPU geride) beklemek zorunda
+    HarvestReady(false);
+    ReadbackSlot& slot = slots[slotIndex];
+    if (slot.fence) {
+        stats.fenceStalls++;
+        Harvest(slot);
+    }
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+    glReadPixels(0, 0, settings.width, settings.height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot.frameIndex = frameIndex;
+    slotIndex = (slotIndex + 1) % READBACK_SLOTS;
+    frameIndex++;
+    stats.renderedFrames++;
+    bytesRead += frameBytes;
+
+    // pencereye en-boy oranı korunarak önizleme
+    if (previewWidth > 0 && previewHeight > 0) {
+        float fit = std::min(static_cast<float>(previewWidth) / settings.width, static_cast<float>(previewHeight) / settings.height);
+        int width = static_cast<int>(settings.width * fit);
+        int height = static_cast<int>(settings.height * fit);
+        int x = (previewWidth - width) / 2;
+        int y = (previewHeight - height) / 2;
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+        glViewport(0, 0, previewWidth, previewHeight);
+        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        glBlitFramebuffer(0, 0, settings.width, settings.height, x, y, x + width, y + height, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (previewWidth > 0 && previewHeight > 0) {
+        glViewport(0, 0, previewWidth, previewHeight);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stats.writtenFrames = encodedFrames;
+    }
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    if (stats.seconds > 0.0) {
+        stats.framesPerSecond = stats.writtenFrames / stats.seconds;
+        stats.readbackMBps = bytesRead / (1024.0 * 1024.0) / stats.seconds;
+    }
+
+    if (frameIndex >= stats.totalFrames) {
+        Finish();
+    }
+}
+
+void TourCapture::HarvestReady(bool wait) {
+    // en eski yuvadan başlayarak, sırayla
+    for (int offset = 0; offset < READBACK_SLOTS; ++offset) {
+        ReadbackSlot& slot = slots[(slotIndex + offset) % READBACK_SLOTS];
+        if (!slot.fence) {
+            continue;
+        }
+        if (!wait) {
+            GLenum status = glClientWaitSync(slot.fence, 0, 0);
+            if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+                break;
+            }
+        }
+        Harvest(slot);
+    }
+}
+
+void TourCapture::Harvest(ReadbackSlot& slot) {
+    // flush: fence sürücü kuyruğunda kalmasın
+    GLenum status;
+    do {
+        status = glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 100000000); // 100 ms
+    } while (status == GL_TIMEOUT_EXPIRED);
+    glDeleteSync(slot.fence);
+    slot.fence = nullptr;
+    if (status == GL_WAIT_FAILED) {
+        std::cerr << "Tur kaydi: fence beklenemedi, frame " << slot.frameIndex << " atlandi" << std::endl;
+        return;
+    }
+
+    EncodeJob job;
+    job.frameIndex = slot.frameIndex;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (queue.size() >= maxQueued) {
+            stats.encoderStalls++;
+            spaceCondition.wait(lock, [this] { return queue.size() < maxQueued; });
+        }
+        if (!freeBuffers.empty()) {
+            job.pixels = std::move(freeBuffers.back());
+            freeBuffers.pop_back();
+        }
+    }
+    job.pixels.resize(frameBytes);
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+    const void* mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, frameBytes, GL_MAP_READ_BIT);
+    if (mapped) {
+        std::memcpy(job.pixels.data(), mapped, frameBytes);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    if (!mapped) {
+        std::cerr << "Tur kaydi: PBO map edilemedi, frame " << slot.frameIndex << " atlandi" << std::endl;
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back(std::move(job));
+    }
+    workCondition.notify_one();
+}
+
+void TourCapture::Finish() {
+    HarvestReady(true);
+    StopEncoders();
+    DestroyTargets();
+
+    stats.writtenFrames = encodedFrames;
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    if (stats.seconds > 0.0) {
+        stats.framesPerSecond = stats.writtenFrames / stats.seconds;
+        stats.readbackMBps = bytesRead / (1024.0 * 1024.0) / stats.seconds;
+    }
+    stats.active = false;
+
+    std::cout << "\nTur kaydi bitti: " << stats.writtenFrames << "/" << stats.totalFrames << " frame, "
+        << std::fixed << std::setprecision(2) << stats.seconds << " s, " << stats.framesPerSecond << " frame/s, geri okuma "
+        << stats.readbackMBps << " MB/s, fence beklemesi " << stats.fenceStalls << ", kodlayici beklemesi "
+        << stats.encoderStalls << std::defaultfloat << std::endl;
+}
+
+void TourCapture::Cancel() {
+    if (!stats.active) {
+        return;
+    }
+    // okunmuş frame'ler yine de yazılıyor, GPU'daki okumalar bırakılıyor
+    StopEncoders();
+    DestroyTargets();
+    stats.active = false;
+    std::cout << "\nTur kaydi iptal edildi (" << encodedFrames << " frame yazildi)" << std::endl;
+}
+
+void TourCapture::StartEncoders() {
+    size_t threadCount = settings.encoderThreads > 0 ? static_cast<size_t>(settings.encoderThreads) :
+        std::max<size_t>(1, std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() - 1 : 1);
+    // kuyrukta en fazla thread başına iki frame, bellek sınırlı kalsın
+    maxQueued = threadCount * 2;
+    encodedFrames = 0;
+    stopping = false;
+    queue.clear();
+    for (size_t i = 0; i < threadCount; ++i) {
+        encoders.emplace_back(&TourCapture::EncoderLoop, this);
+    }
+}
+
+void TourCapture::StopEncoders() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    workCondition.notify_all();
+    for (auto& encoder : encoders) {
+        encoder.join();
+    }
+    encoders.clear();
+    freeBuffers.clear();
+}
+
+void TourCapture::EncoderLoop() {
+    while (true) {
+        EncodeJob job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            workCondition.wait(lock, [this] { return stopping || !queue.empty(); });
+            // durdurulurken kuyruk boşaltılıyor
+            if (queue.empty()) {
+                return;
+            }
+            job = std::move(queue.front());
+            queue.pop_front();
+        }
+        spaceCondition.notify_one();
+
+        Encode(job);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        freeBuffers.push_back(std::move(job.pixels));
+        encodedFrames++;
+    }
+}
+
+std::string TourCapture::GetFramePath(size_t index) const {
+    std::filesystem::path directory(settings.outputDirectory);
+    if (settings.format == Format::YUV420) {
+        std::ostringstream name;
+        name << "tur_" << settings.width << "x" << settings.height << ".yuv";
+        return (directory / name.str()).string();
+    }
+    if (!shots.empty()) {
+        return (directory / (shots[index].name + ".png")).string();
+    }
+    std::ostringstream name;
+    name << "tur_" << std::setw(6) << std::setfill('0') << index << ".png";
+    return (directory / name.str()).string();
+}
+
+void TourCapture::Encode(const EncodeJob& job) {
+    std::string path = GetFramePath(job.frameIndex);
+    if (settings.format == Format::PNG) {
+        if (!WritePng(path, job.pixels, settings.width, settings.height)) {
+            std::cerr << "Tur kaydi yazilamadi: " << path << std::endl;
+        }
+        return;
+    }
+
+    thread_local std::vector<unsigned char> yuv;
+    ConvertToYuv420(job.pixels, settings.width, settings.height, yuv);
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(static_cast<std::streamoff>(job.frameIndex * yuv.size()));
+    file.write(reinterpret_cast<const char*>(yuv.data()), yuv.size());
+    if (!file) {
+        std::cerr << "Tur kaydi yazilamadi: " << path << " frame " << job.frameIndex << std::endl;
+    }
+}
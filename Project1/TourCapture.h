@@ -0,0 +1,145 @@
+#pragma once
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Camera.h"
+#include "MuseumObject.h"
+
+// Tur kaydı: senaryolu kamera yolu (ya da her eser için bir kare) ekran dışı hedefe istenen çözünürlükte, frame hızı
+// beklemeden çiziliyor. Geri okuma PBO halkasıyla: frame glReadPixels ile PBO'ya (GPU'da asenkron), fence konuyor,
+// halka birkaç frame sonra dolduğunda fence'i geçmiş PBO map edilip kodlayıcı threadlere veriliyor; glReadPixels
+// böylece pipeline'ı boşaltmıyor. PNG (sıkıştırmasız deflate, ağaçta zlib yok) ya da tek dosya ham YUV 4:2:0
+// (BT.709 sınırlı aralık, ffmpeg -f rawvideo -pix_fmt yuv420p ile okunuyor).
+// Kullanım (main döngüsü, kayıt sürerken): ApplyCamera -> BeginFrame -> sahne -> EndFrame
+class TourCapture {
+public:
+    enum class Format {
+        PNG,
+        YUV420
+    };
+
+    struct Settings {
+        int width = 1920;
+        int height = 1080;
+        float fps = 30.0f;          // yol zamanı frame başına 1/fps ilerliyor (duvar saatinden bağımsız)
+        Format format = Format::PNG;
+        std::string outputDirectory = "capture";
+        int encoderThreads = 0;     // 0 ise donanım thread sayısı - 1
+    };
+
+    struct Stats {
+        size_t totalFrames = 0;
+        size_t renderedFrames = 0;
+        size_t writtenFrames = 0;
+        double seconds = 0.0;           // başlangıçtan bu yana (bitince toplam)
+        double framesPerSecond = 0.0;   // yazılan frame / süre
+        double readbackMBps = 0.0;      // geri okunan bayt / süre
+        size_t fenceStalls = 0;         // halka dolu, fence'i beklemek gerekti
+        size_t encoderStalls = 0;       // kodlayıcı kuyruğu dolu, beklemek gerekti
+        bool active = false;
+    };
+
+    TourCapture();
+    ~TourCapture();
+
+    // her satır: zaman(s) x y z yaw pitch, # yorum. Pozisyon Catmull-Rom, açılar doğrusal. Eser karelerini siliyor
+    bool LoadPath(const std::string& path);
+    // her eser (artifact bilgisi olan obje) için bir kare, kamera eserlerin ortasına doğru taraftan bakıyor. Yolu siliyor.
+    // panoramas ise aynı bakış noktalarından 360 derece (main SceneManager::DrawPanorama ile çiziyor, genişlik 2 x yükseklik)
+    void SetArtifactShots(const std::vector<std::shared_ptr<MuseumObject>>& objects, bool panoramas = false);
+
+    bool Start(const Settings& newSettings);
+    void Cancel();
+    bool IsActive() const { return stats.active; }
+    bool IsPanorama() const { return panoramaShots; }
+
+    // bu frame'in kamerası (girdiden sonra, SceneManager::Update'ten önce)
+    void ApplyCamera(Camera& camera) const;
+    glm::mat4 GetProjection() const;
+    // ekran dışı hedef bağlanıyor, viewport kayıt çözünürlüğünde
+    void BeginFrame();
+    // PBO'ya okuma + fence, hazır olanlar kodlayıcıya. preview boyu 0 değilse pencereye küçültülmüş kopya.
+    // Son frame'de her şey boşaltılıp dosyalar kapanıyor, rapor yazılıyor
+    void EndFrame(int previewWidth, int previewHeight);
+
+    const Settings& GetSettings() const { return settings; }
+    const Stats& GetStats() const { return stats; }
+    size_t GetPathKeyframeCount() const { return keyframes.size(); }
+
+private:
+    struct Keyframe {
+        float time = 0.0f;
+        glm::vec3 position = glm::vec3(0.0f);
+        float yaw = 0.0f;
+        float pitch = 0.0f;
+    };
+
+    struct Shot {
+        std::string name;  // dosya adı (uzantısız)
+        glm::vec3 position = glm::vec3(0.0f);
+        float yaw = 0.0f;
+        float pitch = 0.0f;
+    };
+
+    struct ReadbackSlot {
+        GLuint buffer = 0;
+        GLsync fence = nullptr;
+        size_t frameIndex = 0;
+    };
+
+    struct EncodeJob {
+        size_t frameIndex = 0;
+        std::vector<unsigned char> pixels; // RGBA, alttan üste satırlar
+    };
+
+    static constexpr int READBACK_SLOTS = 3;
+
+    bool CreateTargets();
+    void DestroyTargets();
+    void Harvest(ReadbackSlot& slot);
+    void HarvestReady(bool wait);
+    void Finish();
+
+    void StartEncoders();
+    void StopEncoders();
+    void EncoderLoop();
+    void Encode(const EncodeJob& job);
+
+    Keyframe SamplePath(float time) const;
+    std::string GetFramePath(size_t frameIndex) const;
+
+    Settings settings;
+    Stats stats;
+    std::vector<Keyframe> keyframes;
+    std::vector<Shot> shots;
+    bool panoramaShots = false;
+    size_t frameIndex = 0;
+    std::chrono::steady_clock::time_point startTime;
+    size_t bytesRead = 0;
+
+    GLuint framebuffer = 0;
+    GLuint colorRenderbuffer = 0;
+    GLuint depthRenderbuffer = 0;
+    ReadbackSlot slots[READBACK_SLOTS];
+    int slotIndex = 0;
+    size_t frameBytes = 0;
+
+    // kodlayıcılar, kuyruk ve boş piksel tamponları mutex altında
+    std::vector<std::thread> encoders;
+    std::mutex mutex;
+    std::condition_variable workCondition;
+    std::condition_variable spaceCondition;
+    std::deque<EncodeJob> queue;
+    std::vector<std::vector<unsigned char>> freeBuffers;
+    size_t maxQueued = 0;
+    size_t encodedFrames = 0;
+    bool stopping = false;
+};
@@ -0,0 +1,274 @@
+#include "TriangleBVH.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include "SimdCullerKernels.h"
+
+#if SIMD_CULLER_X86
+#include <emmintrin.h>
+#endif
+
+void TriangleBVH::Build(std::vector<Triangle>&& newTriangles) {
+    triangles = std::move(newTriangles);
+    nodes.clear();
+    packets.clear();
+    if (!triangles.empty()) {
+        nodes.reserve(triangles.size() / 2 + 1);
+        nodes.push_back(Node());
+        BuildRecursive(0, 0, static_cast<uint32_t>(triangles.size()));
+    }
+}
+
+bool TriangleBVH::IsSegmentBlocked(const glm::vec3& origin, const glm::vec3& end, uint32_t ignoreId) const {
+    if (nodes.empty()) {
+        return false;
+    }
+    glm::vec3 direction = end - origin;
+    glm::vec3 invDirection(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+    // uçtaki yüzeye (ve komşu coplanar chunklara) çarpmamak için biraz kısa
+    const float minT = 1e-4f;
+    const float maxT = 1.0f - 1e-3f;
+
+    uint32_t stack[STACK_SIZE];
+    int stackSize = 0;
+    stack[stackSize++] = 0;
+    while (stackSize > 0) {
+        const Node& node = nodes[stack[--stackSize]];
+        float enter;
+        if (!IntersectsBox(node, origin, invDirection, minT, maxT, enter)) {
+            continue;
+        }
+        if (node.count > 0) {
+            for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                float t, u, v;
+                if (triangles[i].id != ignoreId && IntersectsTriangle(triangles[i], origin, direction, minT, maxT, t, u, v)) {
+                    return true;
+                }
+            }
+        }
+        else if (stackSize + 2 <= STACK_SIZE) {
+            stack[stackSize++] = node.first;
+            stack[stackSize++] = node.first + 1;
+        }
+    }
+    return false;
+}
+
+bool TriangleBVH::Intersect(const glm::vec3& origin, const glm::vec3& direction, float minT, float maxT, Hit& hit) const {
+    if (nodes.empty()) {
+        return false;
+    }
+    glm::vec3 invDirection(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+    bool found = false;
+
+    uint32_t stack[STACK_SIZE];
+    int stackSize = 0;
+    stack[stackSize++] = 0;
+    while (stackSize > 0) {
+        const Node& node = nodes[stack[--stackSize]];
+        float enter;
+        // bulunan kesişimden uzaktaki kutular atlanıyor
+        if (!IntersectsBox(node, origin, invDirection, minT, maxT, enter)) {
+            continue;
+        }
+        if (node.count > 0) {
+            for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                float t, u, v;
+                if (IntersectsTriangle(triangles[i], origin, direction, minT, maxT, t, u, v)) {
+                    maxT = t;
+                    hit.t = t;
+                    hit.id = triangles[i].id;
+                    hit.u = u;
+                    hit.v = v;
+                    found = true;
+                }
+            }
+        }
+        else if (stackSize + 2 <= STACK_SIZE) {
+            // yakın çocuk önce açılsın diye en son itiliyor
+            float leftEnter, rightEnter;
+            bool left = IntersectsBox(nodes[node.first], origin, invDirection, minT, maxT, leftEnter);
+            bool right = IntersectsBox(nodes[node.first + 1], origin, invDirection, minT, maxT, rightEnter);
+            if (left && right) {
+                bool leftFirst = leftEnter <= rightEnter;
+                stack[stackSize++] = leftFirst ? node.first + 1 : node.first;
+                stack[stackSize++] = leftFirst ? node.first : node.first + 1;
+            }
+            else if (left) {
+                stack[stackSize++] = node.first;
+            }
+            else if (right) {
+                stack[stackSize++] = node.first + 1;
+            }
+        }
+    }
+    return found;
+}
+
+bool TriangleBVH::IsOccluded(const glm::vec3& origin, const glm::vec3& direction, float minT, float maxT) const {
+    if (nodes.empty()) {
+        return false;
+    }
+    glm::vec3 invDirection(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+
+#if SIMD_CULLER_X86
+    // ışın sabit, dört şeride bir kere yayılıyor
+    const __m128 ox = _mm_set1_ps(origin.x), oy = _mm_set1_ps(origin.y), oz = _mm_set1_ps(origin.z);
+    const __m128 dx = _mm_set1_ps(direction.x), dy = _mm_set1_ps(direction.y), dz = _mm_set1_ps(direction.z);
+    const __m128 tMin = _mm_set1_ps(minT), tMax = _mm_set1_ps(maxT);
+    const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f);
+    const __m128 epsilon = _mm_set1_ps(1e-12f);
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+#endif
+
+    uint32_t stack[STACK_SIZE];
+    int stackSize = 0;
+    stack[stackSize++] = 0;
+    while (stackSize > 0) {
+        const Node& node = nodes[stack[--stackSize]];
+        float enter;
+        if (!IntersectsBox(node, origin, invDirection, minT, maxT, enter)) {
+            continue;
+        }
+        if (node.count == 0) {
+            if (stackSize + 2 <= STACK_SIZE) {
+                stack[stackSize++] = node.first;
+                stack[stackSize++] = node.first + 1;
+            }
+            continue;
+        }
+
+#if SIMD_CULLER_X86
+        // IntersectsTriangle'ın dört üçgenlik hali (Möller-Trumbore)
+        const TrianglePacket& packet = packets[node.packet];
+        __m128 e1x = _mm_loadu_ps(packet.e1[0]), e1y = _mm_loadu_ps(packet.e1[1]), e1z = _mm_loadu_ps(packet.e1[2]);
+        __m128 e2x = _mm_loadu_ps(packet.e2[0]), e2y = _mm_loadu_ps(packet.e2[1]), e2z = _mm_loadu_ps(packet.e2[2]);
+
+        __m128 px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+        __m128 py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+        __m128 pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+        __m128 determinant = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+        __m128 hit = _mm_cmpge_ps(_mm_andnot_ps(signMask, determinant), epsilon);
+        if (_mm_movemask_ps(hit) == 0) {
+            continue;
+        }
+        // determinantı ~0 olan (boş ya da ışına paralel) şeritlerde 1'e bölünüyor, sonuçları zaten maskeli
+        __m128 invDeterminant = _mm_div_ps(one, _mm_or_ps(_mm_and_ps(hit, determinant), _mm_andnot_ps(hit, one)));
+
+        __m128 sx = _mm_sub_ps(ox, _mm_loadu_ps(packet.v0[0]));
+        __m128 sy = _mm_sub_ps(oy, _mm_loadu_ps(packet.v0[1]));
+        __m128 sz = _mm_sub_ps(oz, _mm_loadu_ps(packet.v0[2]));
+        __m128 u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, px), _mm_mul_ps(sy, py)), _mm_mul_ps(sz, pz)),
+            invDeterminant);
+        hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmpge_ps(u, zero), _mm_cmple_ps(u, one)));
+
+        __m128 qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+        __m128 qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+        __m128 qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+        __m128 v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)),
+            invDeterminant);
+        hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmpge_ps(v, zero), _mm_cmple_ps(_mm_add_ps(u, v), one)));
+
+        __m128 t = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)),
+            invDeterminant);
+        hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmpgt_ps(t, tMin), _mm_cmplt_ps(t, tMax)));
+        if (_mm_movemask_ps(hit) != 0) {
+            return true;
+        }
+#else
+        // SSE yoksa paketin şeritleri (yaprağın üçgenleri) tek tek
+        for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+            float t, u, v;
+            if (IntersectsTriangle(triangles[i], origin, direction, minT, maxT, t, u, v)) {
+                return true;
+            }
+        }
+#endif
+    }
+    return false;
+}
+
+void TriangleBVH::BuildRecursive(uint32_t nodeIndex, uint32_t first, uint32_t count) {
+    glm::vec3 boundsMin(FLT_MAX), boundsMax(-FLT_MAX);
+    glm::vec3 centroidMin(FLT_MAX), centroidMax(-FLT_MAX);
+    for (uint32_t i = first; i < first + count; ++i) {
+        const Triangle& t = triangles[i];
+        glm::vec3 v1 = t.v0 + t.e1, v2 = t.v0 + t.e2;
+        boundsMin = glm::min(boundsMin, glm::min(t.v0, glm::min(v1, v2)));
+        boundsMax = glm::max(boundsMax, glm::max(t.v0, glm::max(v1, v2)));
+        glm::vec3 centroid = Centroid(t);
+        centroidMin = glm::min(centroidMin, centroid);
+        centroidMax = glm::max(centroidMax, centroid);
+    }
+    nodes[nodeIndex].min = boundsMin;
+    nodes[nodeIndex].max = boundsMax;
+
+    if (count <= MAX_LEAF_TRIANGLES) {
+        nodes[nodeIndex].first = first;
+        nodes[nodeIndex].count = count;
+        nodes[nodeIndex].packet = static_cast<uint32_t>(packets.size());
+        TrianglePacket packet;
+        std::memset(&packet, 0, sizeof(packet));
+        for (uint32_t i = 0; i < count; ++i) {
+            const Triangle& t = triangles[first + i];
+            for (int axis = 0; axis < 3; ++axis) {
+                packet.v0[axis][i] = t.v0[axis];
+                packet.e1[axis][i] = t.e1[axis];
+                packet.e2[axis][i] = t.e2[axis];
+            }
+        }
+        packets.push_back(packet);
+        return;
+    }
+
+    glm::vec3 extent = centroidMax - centroidMin;
+    int axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+    uint32_t half = count / 2;
+    std::nth_element(triangles.begin() + first, triangles.begin() + first + half, triangles.begin() + first + count,
+        [axis](const Triangle& a, const Triangle& b) { return Centroid(a)[axis] < Centroid(b)[axis]; });
+
+    // iki çocuk yan yana duruyor, traversal sağ çocuğu first + 1 ile buluyor
+    uint32_t left = static_cast<uint32_t>(nodes.size());
+    nodes[nodeIndex].first = left;
+    nodes[nodeIndex].count = 0;
+    nodes.push_back(Node());
+    nodes.push_back(Node());
+    BuildRecursive(left, first, half);
+    BuildRecursive(left + 1, first + half, count - half);
+}
+
+bool TriangleBVH::IntersectsBox(const Node& node, const glm::vec3& origin, const glm::vec3& invDirection,
+    float minT, float maxT, float& enter) {
+    glm::vec3 t0 = (node.min - origin) * invDirection;
+    glm::vec3 t1 = (node.max - origin) * invDirection;
+    glm::vec3 tNear = glm::min(t0, t1);
+    glm::vec3 tFar = glm::max(t0, t1);
+    enter = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, minT));
+    float exit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, maxT));
+    return enter <= exit;
+}
+
+bool TriangleBVH::IntersectsTriangle(const Triangle& t, const glm::vec3& origin, const glm::vec3& direction,
+    float minT, float maxT, float& hitT, float& hitU, float& hitV) {
+    glm::vec3 p = glm::cross(direction, t.e2);
+    float determinant = glm::dot(t.e1, p);
+    if (std::abs(determinant) < 1e-12f) {
+        return false;
+    }
+    float invDeterminant = 1.0f / determinant;
+    glm::vec3 s = origin - t.v0;
+    float u = glm::dot(s, p) * invDeterminant;
+    if (u < 0.0f || u > 1.0f) {
+        return false;
+    }
+    glm::vec3 q = glm::cross(s, t.e1);
+    float v = glm::dot(direction, q) * invDeterminant;
+    if (v < 0.0f || u + v > 1.0f) {
+        return false;
+    }
+    hitT = glm::dot(t.e2, q) * invDeterminant;
+    hitU = u;
+    hitV = v;
+    return hitT > minT && hitT < maxT;
+}
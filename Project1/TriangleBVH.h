@@ -0,0 +1,67 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+
+// Işın testleri için basit üçgen BVH'si (en uzun eksende medyan bölme)
+// PVS bake'i engel testi (IsSegmentBlocked), lightmap bake'i en yakın kesişim (Intersect),
+// vertex AO bake'i herhangi bir kesişim (IsOccluded, yaprak başına SSE ile 4 üçgen birden) için kullanıyor.
+// Kurulduktan sonra sadece okunuyor, worker threadlerden aynı anda sorgulanabilir
+class TriangleBVH {
+public:
+    struct Triangle {
+        glm::vec3 v0, e1, e2; // köşe + iki kenar (Möller-Trumbore için)
+        uint32_t id;          // çağıranın verdiği numara (PVS hedefi, lightmap üçgeni)
+    };
+
+    struct Hit {
+        float t = 0.0f;     // direction uzunluğu cinsinden
+        uint32_t id = 0;
+        float u = 0.0f;     // v0 + e1 * u + e2 * v
+        float v = 0.0f;
+    };
+
+    // üçgenler BVH sırasına göre yeniden diziliyor
+    void Build(std::vector<Triangle>&& newTriangles);
+    bool IsEmpty() const { return nodes.empty(); }
+    size_t GetTriangleCount() const { return triangles.size(); }
+
+    // origin'den end'e giden doğru parçasını ignoreId dışında bir üçgen kesiyor mu
+    bool IsSegmentBlocked(const glm::vec3& origin, const glm::vec3& end, uint32_t ignoreId) const;
+    // origin + direction * t (minT < t < maxT) için en yakın kesişim
+    bool Intersect(const glm::vec3& origin, const glm::vec3& direction, float minT, float maxT, Hit& hit) const;
+    // origin + direction * t (minT < t < maxT) herhangi bir üçgene çarpıyor mu, ilk çarpmada dönüyor
+    bool IsOccluded(const glm::vec3& origin, const glm::vec3& direction, float minT, float maxT) const;
+
+private:
+    struct Node {
+        glm::vec3 min, max;
+        uint32_t first; // yaprakta üçgen başı, iç düğümde sol çocuk (sağ = first + 1)
+        uint32_t count; // 0 = iç düğüm
+        uint32_t packet; // yaprakta packets indexi
+    };
+
+    // yapraktaki üçgenler SoA düzeninde, boş kalan şeritler sıfır (determinant 0, hiç çarpmıyor)
+    struct TrianglePacket {
+        float v0[3][4];
+        float e1[3][4];
+        float e2[3][4];
+    };
+
+    static constexpr uint32_t MAX_LEAF_TRIANGLES = 4; // bir SSE paketi
+    static constexpr int STACK_SIZE = 64;
+
+    void BuildRecursive(uint32_t nodeIndex, uint32_t first, uint32_t count);
+    static glm::vec3 Centroid(const Triangle& t) {
+        return t.v0 + (t.e1 + t.e2) / 3.0f;
+    }
+    // kutuya giriş mesafesi, kesişmiyorsa false
+    static bool IntersectsBox(const Node& node, const glm::vec3& origin, const glm::vec3& invDirection,
+        float minT, float maxT, float& enter);
+    static bool IntersectsTriangle(const Triangle& t, const glm::vec3& origin, const glm::vec3& direction,
+        float minT, float maxT, float& hitT, float& hitU, float& hitV);
+
+    std::vector<Triangle> triangles;
+    std::vector<Node> nodes;
+    std::vector<TrianglePacket> packets;
+};
@@ -0,0 +1,244 @@
+#include "VertexOcclusion.h"
+#include "ResourceManager.h"
+#include "GeometryPool.h"
+#include "TriangleBVH.h"
+#include "JobSystem.h"
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace {
+    const char OCCLUSION_MAGIC[4] = { 'V', 'O', 'C', '1' };
+    const float MIN_TRIANGLE_AREA = 1e-12f;
+
+    void HashValue(uint64_t& hash, uint64_t value) {
+        // FNV-1a
+        for (int i = 0; i < 8; ++i) {
+            hash ^= (value >> (i * 8)) & 0xFF;
+            hash *= 1099511628211ull;
+        }
+    }
+
+    void HashBytes(uint64_t& hash, const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+    }
+
+    // normal +Z kabul edilen yerel uzayda kosinüs ağırlıklı, eşit dağılmış yönler (altın açı spirali)
+    // her vertex aynı yönleri kullanıyor, dikişte ikiye bölünmüş vertexler aynı sonucu veriyor
+    std::vector<glm::vec3> HemisphereDirections(int count) {
+        const float goldenAngle = 2.39996323f;
+        std::vector<glm::vec3> directions;
+        directions.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            float radius = std::sqrt((i + 0.5f) / count);
+            float phi = i * goldenAngle;
+            directions.emplace_back(radius * std::cos(phi), radius * std::sin(phi),
+                std::sqrt(std::max(0.0f, 1.0f - radius * radius)));
+        }
+        return directions;
+    }
+
+    template <typename T>
+    void WriteValue(std::ofstream& file, const T& value) {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    bool ReadValue(std::ifstream& file, T& value) {
+        return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+    }
+}
+
+void VertexOcclusion::LoadOrBake(const std::string& modelPath, ModelData& model, const Settings& settings) {
+    std::string cachePath = modelPath + ".ao";
+    uint64_t hash = ComputeHash(model, settings);
+    if (Load(cachePath, model, hash)) {
+        return;
+    }
+
+    Stats stats = Bake(model, settings);
+    std::cout << "Vertex AO bake (" << modelPath << "): " << stats.vertices << " vertex, " << stats.triangles
+        << " ucgen, " << stats.raysCast << " isin, " << stats.bakeMs << " ms (" << stats.threads << " thread)" << std::endl;
+    // kaydedilemezse de bu oturumda kullanılıyor
+    Save(cachePath, model, hash);
+}
+
+VertexOcclusion::Stats VertexOcclusion::Bake(ModelData& model, const Settings& settings) {
+    auto start = std::chrono::high_resolution_clock::now();
+    const int stride = GeometryPool::VERTEX_FLOATS;
+    Stats stats;
+
+    // modelin tüm meshleri tek BVH'de, bir meshin oyukları diğerinin parçalarıyla da kararabiliyor
+    std::vector<TriangleBVH::Triangle> triangles;
+    glm::vec3 boundsMin(FLT_MAX), boundsMax(-FLT_MAX);
+    for (const auto& mesh : model.meshes) {
+        size_t vertexCount = mesh.vertices.size() / stride;
+        for (size_t v = 0; v < vertexCount; ++v) {
+            glm::vec3 position(mesh.vertices[v * stride], mesh.vertices[v * stride + 1], mesh.vertices[v * stride + 2]);
+            boundsMin = glm::min(boundsMin, position);
+            boundsMax = glm::max(boundsMax, position);
+        }
+        for (size_t t = 0; t + 2 < mesh.indices.size(); t += 3) {
+            if (mesh.indices[t] >= vertexCount || mesh.indices[t + 1] >= vertexCount || mesh.indices[t + 2] >= vertexCount) {
+                continue;
+            }
+            const float* a = &mesh.vertices[mesh.indices[t] * stride];
+            const float* b = &mesh.vertices[mesh.indices[t + 1] * stride];
+            const float* c = &mesh.vertices[mesh.indices[t + 2] * stride];
+            glm::vec3 v0(a[0], a[1], a[2]);
+            glm::vec3 e1 = glm::vec3(b[0], b[1], b[2]) - v0;
+            glm::vec3 e2 = glm::vec3(c[0], c[1], c[2]) - v0;
+            if (0.5f * glm::length(glm::cross(e1, e2)) < MIN_TRIANGLE_AREA) {
+                continue;
+            }
+            triangles.push_back({ v0, e1, e2, static_cast<uint32_t>(triangles.size()) });
+        }
+    }
+    stats.triangles = triangles.size();
+
+    TriangleBVH bvh;
+    bvh.Build(std::move(triangles));
+
+    float diagonal = bvh.IsEmpty() ? 0.0f : glm::length(boundsMax - boundsMin);
+    float maxDistance = diagonal * settings.maxDistanceRatio;
+    float offset = diagonal * settings.surfaceOffset;
+    int rayCount = std::max(settings.rayCount, 1);
+    std::vector<glm::vec3> directions = HemisphereDirections(rayCount);
+
+    std::atomic<size_t> raysCast(0);
+    for (auto& mesh : model.meshes) {
+        size_t vertexCount = mesh.vertices.size() / stride;
+        mesh.occlusion.assign(vertexCount, 255);
+        stats.vertices += vertexCount;
+        if (maxDistance <= 0.0f) {
+            continue;
+        }
+
+        JobSystem::GetInstance().ParallelFor(vertexCount, 256, [&](size_t begin, size_t end) {
+            size_t rays = 0;
+            for (size_t v = begin; v < end; ++v) {
+                const float* vertex = &mesh.vertices[v * stride];
+                glm::vec3 normal(vertex[3], vertex[4], vertex[5]);
+                float length = glm::length(normal);
+                if (!(length > 0.0f)) {
+                    continue;
+                }
+                normal /= length;
+
+                // normalden dik taban (Duff ve ark.), yerel yönler buna çevriliyor
+                float sign = normal.z >= 0.0f ? 1.0f : -1.0f;
+                float a = -1.0f / (sign + normal.z);
+                float b = normal.x * normal.y * a;
+                glm::vec3 tangent(1.0f + sign * normal.x * normal.x * a, sign * b, -sign * normal.x);
+                glm::vec3 bitangent(b, sign + normal.y * normal.y * a, -normal.y);
+
+                glm::vec3 origin = glm::vec3(vertex[0], vertex[1], vertex[2]) + normal * offset;
+                int occluded = 0;
+                for (const glm::vec3& local : directions) {
+                    glm::vec3 direction = (tangent * local.x + bitangent * local.y + normal * local.z) * maxDistance;
+                    if (bvh.IsOccluded(origin, direction, 0.0f, 1.0f)) {
+                        occluded++;
+                    }
+                }
+                rays += directions.size();
+
+                float visibility = 1.0f - static_cast<float>(occluded) / rayCount;
+                mesh.occlusion[v] = static_cast<unsigned char>(std::lround(visibility * 255.0f));
+            }
+            raysCast += rays;
+        });
+    }
+
+    stats.raysCast = raysCast;
+    stats.threads = JobSystem::GetInstance().GetWorkerCount() + 1;
+    stats.bakeMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    return stats;
+}
+
+uint64_t VertexOcclusion::ComputeHash(const ModelData& model, const Settings& settings) {
+    uint64_t hash = 1469598103934665603ull;
+    HashValue(hash, static_cast<uint64_t>(settings.rayCount));
+    HashBytes(hash, &settings.maxDistanceRatio, sizeof(settings.maxDistanceRatio));
+    HashBytes(hash, &settings.surfaceOffset, sizeof(settings.surfaceOffset));
+    HashValue(hash, model.meshes.size());
+    for (const auto& mesh : model.meshes) {
+        HashValue(hash, mesh.vertices.size());
+        HashValue(hash, mesh.indices.size());
+        HashBytes(hash, mesh.vertices.data(), mesh.vertices.size() * sizeof(float));
+        HashBytes(hash, mesh.indices.data(), mesh.indices.size() * sizeof(unsigned int));
+    }
+    return hash;
+}
+
+bool VertexOcclusion::Save(const std::string& path, const ModelData& model, uint64_t hash) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Vertex AO dosyasi acilamadi: " << path << std::endl;
+        return false;
+    }
+
+    file.write(OCCLUSION_MAGIC, sizeof(OCCLUSION_MAGIC));
+    WriteValue(file, hash);
+    WriteValue(file, static_cast<uint32_t>(model.meshes.size()));
+    for (const auto& mesh : model.meshes) {
+        uint32_t vertexCount = static_cast<uint32_t>(mesh.occlusion.size());
+        WriteValue(file, vertexCount);
+        file.write(reinterpret_cast<const char*>(mesh.occlusion.data()), vertexCount);
+    }
+
+    if (!file) {
+        std::cerr << "Vertex AO dosyasi yazilamadi: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool VertexOcclusion::Load(const std::string& path, ModelData& model, uint64_t hash) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false; // henüz bake edilmemiş
+    }
+
+    char magic[4];
+    uint64_t fileHash = 0;
+    uint32_t meshCount = 0;
+    if (!file.read(magic, sizeof(magic)) || !std::equal(magic, magic + 4, OCCLUSION_MAGIC) ||
+        !ReadValue(file, fileHash) || !ReadValue(file, meshCount)) {
+        std::cerr << "Vertex AO dosyasi gecersiz: " << path << std::endl;
+        return false;
+    }
+    // model ya da ayarlar değişmiş, yeniden bake ediliyor
+    if (fileHash != hash || meshCount != model.meshes.size()) {
+        return false;
+    }
+
+    std::vector<std::vector<unsigned char>> occlusion(meshCount);
+    for (uint32_t m = 0; m < meshCount; ++m) {
+        uint32_t vertexCount = 0;
+        if (!ReadValue(file, vertexCount) ||
+            vertexCount != model.meshes[m].vertices.size() / GeometryPool::VERTEX_FLOATS) {
+            std::cerr << "Vertex AO dosyasi gecersiz: " << path << std::endl;
+            return false;
+        }
+        occlusion[m].resize(vertexCount);
+        if (!file.read(reinterpret_cast<char*>(occlusion[m].data()), vertexCount)) {
+            std::cerr << "Vertex AO dosyasi eksik: " << path << std::endl;
+            return false;
+        }
+    }
+
+    for (uint32_t m = 0; m < meshCount; ++m) {
+        model.meshes[m].occlusion = std::move(occlusion[m]);
+    }
+    return true;
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+struct ModelData;
+
+// Model yüklenirken vertex başına ortam örtülmesi (AO) hesaplanıyor:
+// her vertexten normal etrafındaki yarım küreye kısa ışınlar modelin kendi üçgen BVH'sine atılıyor
+// (vertexler JobSystem worker threadlerine bölünüyor, BVH yaprakları SSE ile 4 üçgen birden test ediliyor).
+// Yakında bir yüzeye çarpan ışın oranı kabartma oyuklarını ve temas noktalarını karartıyor,
+// ekran uzayı bir geçişe gerek kalmıyor. Sonuç vertex başına 1 byte, havuzun location 5 akışıyla shadera gidiyor.
+// Hesap modelin yanına .ao dosyası olarak kaydediliyor, model değişmedikçe tekrar bake edilmiyor
+class VertexOcclusion {
+public:
+    struct Settings {
+        int rayCount = 32;              // vertex başına
+        float maxDistanceRatio = 0.03f; // model köşegeninin oranı, uzaktaki duvarlar karartmasın
+        float surfaceOffset = 1e-4f;    // köşegen oranı, ışın yüzeyin biraz üstünden başlıyor
+    };
+
+    struct Stats {
+        size_t vertices = 0;
+        size_t triangles = 0;
+        size_t raysCast = 0;
+        double bakeMs = 0.0;
+        size_t threads = 0;
+    };
+
+    // önce modelPath + ".ao" dosyasını deniyor, yoksa ya da model değiştiyse bake edip kaydediyor
+    static void LoadOrBake(const std::string& modelPath, ModelData& model, const Settings& settings);
+    // model.meshes[*].occlusion dolduruluyor
+    static Stats Bake(ModelData& model, const Settings& settings);
+
+private:
+    // vertexler, indexler ve ayarlar değişince cache geçersiz
+    static uint64_t ComputeHash(const ModelData& model, const Settings& settings);
+    static bool Save(const std::string& path, const ModelData& model, uint64_t hash);
+    static bool Load(const std::string& path, ModelData& model, uint64_t hash);
+};
@@ -1,4 +1,5 @@
 #include "WindowManager.h"
+#include "GLExtensions.h"
 #include <iostream> 
 
 // Singleton instance genelte tek kullndmiz icin bu yapiyi sectim
@@ -91,6 +92,9 @@ bool WindowManager::InitializeOpenGL() {
 		return false;
 	}
 
+	// glad 3.3 disindaki fonksiyonlari yukle (multi-draw indirect vs)
+	GLExtensions::Load((GLADloadproc)glfwGetProcAddress);
+
 	// OpenGL ayarlari
 	glEnable(GL_DEPTH_TEST);
 	
@@ -7,6 +7,8 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include <iostream>
+#include <cstdio>
+#include <cstdlib>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
@@ -15,7 +17,11 @@
 //#include "Crosshair.h"
 #include "InputManager.h"
 #include "SceneManager.h"
+#include "GeometryPool.h"
 #include "WindowManager.h"
+#include "DynamicResolution.h"
+#include "FramePacer.h"
+#include "TourCapture.h"
 
 // Global değişkenler
 Camera camera(glm::vec3(17.0f, 5.0f, 0.0f));
@@ -38,6 +44,18 @@ Shader* crosshairShader = nullptr;
 //Robot için variable
 std::unique_ptr<Robot> robot;
 
+// sahne ekran dışı hedefe değişken çözünürlükte, ImGui pencereye doğal çözünürlükte
+std::unique_ptr<DynamicResolution> dynamicResolution;
+
+// değişiklik yokken çizmeden bekleme ve aktifken frame sınırı
+std::unique_ptr<FramePacer> framePacer;
+std::vector<float> watchedState;
+GLFWkeyfun previousKeyCallback = nullptr;
+GLFWcharfun previousCharCallback = nullptr;
+
+// tur videosu / eser küçük resimleri, komut satırından başlatılırsa pencere gizli ve bitince çıkılıyor
+std::unique_ptr<TourCapture> tourCapture;
+
 // konum göstergesi için değişkenler
 std::string positionText;
 std::string FpsText;
@@ -112,6 +130,7 @@ void updateFPS(const float& fps) {
 
 // Callback fonksiyonları
 void mouseCallback(GLFWwindow* window, double xpos, double ypos) {
+	if (framePacer) framePacer->NotifyInput();
 	ImGuiIO& io = ImGui::GetIO();
 	io.MousePos = ImVec2((float)xpos, (float)ypos);
 
@@ -121,6 +140,7 @@ void mouseCallback(GLFWwindow* window, double xpos, double ypos) {
 }
 
 void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods) {
+	if (framePacer) framePacer->NotifyInput();
 	ImGuiIO& io = ImGui::GetIO();
 	if (button >= 0 && button < ImGuiMouseButton_COUNT) {
 		io.MouseDown[button] = (action == GLFW_PRESS);
@@ -132,6 +152,7 @@ void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods) {
 }
 
 void scrollCallback(GLFWwindow* window, double xoffset, double yoffset) {
+	if (framePacer) framePacer->NotifyInput();
 	ImGuiIO& io = ImGui::GetIO();
 	io.MouseWheelH += (float)xoffset;
 	io.MouseWheel += (float)yoffset;
@@ -141,7 +162,82 @@ void scrollCallback(GLFWwindow* window, double xoffset, double yoffset) {
 	}
 }
 
-int main() {
+// klavye callback'leri ImGui'nin (o da WindowManager'ınkini çağırıyor), sadece uyandırıp zincire devrediyor
+void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods) {
+	if (framePacer) framePacer->NotifyInput();
+	if (previousKeyCallback) previousKeyCallback(window, key, scancode, action, mods);
+}
+
+void charCallback(GLFWwindow* window, unsigned int codepoint) {
+	if (framePacer) framePacer->NotifyInput();
+	if (previousCharCallback) previousCharCallback(window, codepoint);
+}
+
+// pencere açığa çıktı/boyutu değişti, içerik yeniden çizilmeli
+void windowRefreshCallback(GLFWwindow* /*window*/) {
+	if (framePacer) framePacer->RequestRedraw();
+}
+
+// kamera, robot ve ışıklar, değişince frame çiziliyor
+void collectWatchedState(const InputManager& inputManager, int framebufferWidth, int framebufferHeight) {
+	watchedState.clear();
+	watchedState.insert(watchedState.end(), { camera.Position.x, camera.Position.y, camera.Position.z,
+		camera.Yaw, camera.Pitch, camera.Zoom, inputManager.IsMouseLocked() ? 1.0f : 0.0f,
+		static_cast<float>(framebufferWidth), static_cast<float>(framebufferHeight) });
+	if (robot) {
+		glm::vec3 robotPosition = robot->GetPosition();
+		watchedState.insert(watchedState.end(), { robotPosition.x, robotPosition.y, robotPosition.z,
+			robot->GetRobotRotation(), robot->GetArmAngle() });
+	}
+	for (int i = 0; i < sceneManager.GetLightCount(); ++i) {
+		const Light* light = sceneManager.GetLight(i);
+		const glm::vec3& lightPosition = light->GetPosition();
+		const glm::vec3& lightColor = light->GetColor();
+		watchedState.insert(watchedState.end(), { lightPosition.x, lightPosition.y, lightPosition.z,
+			lightColor.r, lightColor.g, lightColor.b, light->GetIntensity() });
+	}
+}
+
+int main(int argc, char** argv) {
+	// başsız kayıt: --tour <yol dosyası>, --thumbnails ya da --panoramas, isteğe bağlı --size GxY, --fps N, --yuv, --out <klasör>
+	// (panoramada genişlik yüksekliğin iki katı)
+	std::string captureTourPath;
+	bool captureThumbnails = false;
+	bool capturePanoramas = false;
+	TourCapture::Settings captureSettings;
+	for (int i = 1; i < argc; ++i) {
+		std::string argument = argv[i];
+		if (argument == "--tour" && i + 1 < argc) {
+			captureTourPath = argv[++i];
+		}
+		else if (argument == "--thumbnails") {
+			captureThumbnails = true;
+		}
+		else if (argument == "--panoramas") {
+			capturePanoramas = true;
+		}
+		else if (argument == "--size" && i + 1 < argc) {
+			if (sscanf(argv[++i], "%dx%d", &captureSettings.width, &captureSettings.height) != 2) {
+				std::cerr << "Gecersiz --size: " << argv[i] << std::endl;
+				return -1;
+			}
+		}
+		else if (argument == "--fps" && i + 1 < argc) {
+			captureSettings.fps = static_cast<float>(atof(argv[++i]));
+		}
+		else if (argument == "--yuv") {
+			captureSettings.format = TourCapture::Format::YUV420;
+		}
+		else if (argument == "--out" && i + 1 < argc) {
+			captureSettings.outputDirectory = argv[++i];
+		}
+		else {
+			std::cerr << "Bilinmeyen arguman: " << argument << std::endl;
+			return -1;
+		}
+	}
+	bool headlessCapture = !captureTourPath.empty() || captureThumbnails || capturePanoramas;
+
 	// wm başlat
 	if (!windowManager.Initialize("Virtual Adana Museum")) {
 		std::cerr << "WindowManager başlatılamadı!" << std::endl;
@@ -157,6 +253,12 @@ int main() {
 	// ImGui başlat - pencere oluşturulduktan sonra
 	GLFWwindow* window = windowManager.GetWindow();
 	imguiManager.Initialize(window);
+	dynamicResolution = std::make_unique<DynamicResolution>();
+	imguiManager.SetDynamicResolution(dynamicResolution.get());
+	framePacer = std::make_unique<FramePacer>();
+	imguiManager.SetFramePacer(framePacer.get());
+	tourCapture = std::make_unique<TourCapture>();
+	imguiManager.SetTourCapture(tourCapture.get());
 
 	// girdileri kur
 	InputManager& inputManager = InputManager::GetInstance();
@@ -167,6 +269,9 @@ int main() {
 	glfwSetCursorPosCallback(window, mouseCallback);
 	glfwSetMouseButtonCallback(window, mouseButtonCallback);
 	glfwSetScrollCallback(window, scrollCallback);
+	previousKeyCallback = glfwSetKeyCallback(window, keyCallback);
+	previousCharCallback = glfwSetCharCallback(window, charCallback);
+	glfwSetWindowRefreshCallback(window, windowRefreshCallback);
 
 	// Mouse görünürlüğünü ayarla
 	glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
@@ -179,6 +284,10 @@ int main() {
 	try {
 		robot = std::make_unique<Robot>("models/robot/sonrobot.obj", "models/robot/sonkol.obj",
 			glm::vec3(-5.0f, 0.0f, 0.0f));
+		// robot hareket ediyor, BVH'de kutusu her frame güncelleniyor
+		sceneManager.RegisterDynamicObject(robot.get());
+		// robotun lambası müzeyi de aydınlatıyor, gövdesi lambanın gölgesine girmiyor
+		sceneManager.RegisterDynamicLight(&robot->GetLight(), robot.get());
 		std::cout << "Robot başarıyla yüklendi!" << std::endl;
 	}
 	catch (const std::exception& e) {
@@ -188,6 +297,22 @@ int main() {
 	// Window bilgilerini yazdır
 	windowManager.PrintWindowInfo();
 
+	// başsız kayıt aynı döngüyle, pencere gösterilmiyor
+	if (headlessCapture) {
+		glfwHideWindow(window);
+		bool ready = true;
+		if (captureThumbnails || capturePanoramas) {
+			tourCapture->SetArtifactShots(sceneManager.GetMuseumObjects(), capturePanoramas);
+		}
+		else {
+			ready = tourCapture->LoadPath(captureTourPath);
+		}
+		if (!ready || !tourCapture->Start(captureSettings)) {
+			glfwSetWindowShouldClose(window, true);
+		}
+	}
+	bool vsyncOffForCapture = false;
+
 	// crossair başlat
    /* setupCrosshair();
 	std::cout << "Crosshair baslatildi" << std::endl;
@@ -211,7 +336,6 @@ int main() {
 		lastFrame = currentFrame;
 
 		// fps hesaplama
-		frameCount++;
 		if (currentFrame - lastTime >= 1.0) {
 			fps = frameCount / (currentFrame - lastTime);
 			frameCount = 0;
@@ -241,6 +365,33 @@ int main() {
 			glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
 		}
 
+		// tur kaydı sürerken kamera yoldan; vsync, frame sınırı ve bekleme yok
+		bool capturing = tourCapture->IsActive();
+		if (capturing != vsyncOffForCapture) {
+			windowManager.SetVSync(!capturing);
+			vsyncOffForCapture = capturing;
+		}
+		if (capturing) {
+			tourCapture->ApplyCamera(camera);
+			framePacer->RequestRedraw();
+		}
+
+		// Sahneyi guncelle
+		sceneManager.Update(camera.Position, deltaTime);
+
+		// hiçbir şey değişmediyse çizmeden olay bekle, uzun beklemeden sonra deltaTime sıçramasın
+		int framebufferWidth, framebufferHeight;
+		glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+		collectWatchedState(inputManager, framebufferWidth, framebufferHeight);
+		framePacer->WatchValues(watchedState);
+		if (!framePacer->ShouldRender()) {
+			if (framePacer->WaitForNextFrame()) {
+				lastFrame = glfwGetTime();
+			}
+			continue;
+		}
+		frameCount++;
+
 		// ImGui frame başlat
 		imguiManager.BeginFrame();
 
@@ -250,13 +401,6 @@ int main() {
 		glfwGetCursorPos(window, &mouseX, &mouseY);
 		io.MousePos = ImVec2((float)mouseX, (float)mouseY);
 
-		// Sahneyi guncelle
-		sceneManager.Update(camera.Position, deltaTime);
-
-		// dereinlik testi renk ayarı vs 
-		glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
 		// monitore uygun pencere boyutu ile ilgili ayarlar 
 		int screenWidth, screenHeight;
 		windowManager.GetWindowSize(screenWidth, screenHeight);
@@ -288,18 +432,53 @@ int main() {
 			std::cerr << "Perspektif matrisi oluşturulurken hata: " << e.what() << std::endl;
 			continue; // Bu frame atla
 		}
+		if (capturing) {
+			projection = tourCapture->GetProjection();
+		}
 
-		// sahhney çizme 
-		sceneManager.Draw(camera.GetViewMatrix(), projection, camera.Position);
+		// sahne hedefi: ölçek 1'in altındaysa ekran dışı, viewport render çözünürlüğünde
+		// kayıtta kayıt çözünürlüğünde kendi hedefine
+		framePacer->BeginFrame();
+		if (capturing) {
+			tourCapture->BeginFrame();
+		}
+		else {
+			dynamicResolution->BeginFrame(framebufferWidth, framebufferHeight);
+		}
+
+		// dereinlik testi renk ayarı vs 
+		glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+		// sahhney çizme (panorama kaydında eserin bakış noktasından küp harita + equirectangular)
+		bool panorama = capturing && tourCapture->IsPanorama();
+		if (panorama) {
+			sceneManager.DrawPanorama(camera.Position);
+		}
+		else {
+			sceneManager.Draw(camera.GetViewMatrix(), projection, camera.Position);
+		}
 
 		// Robot'u çiz
-		if (robot) {
+		if (robot && !panorama && sceneManager.IsDynamicObjectVisible(robot.get())) {
 			robot->Draw(camera.GetViewMatrix(), projection, sceneManager.GetLight(0)->GetPosition(), camera.Position);
 		}
 
+		// pencereye büyütme + keskinleştirme, ImGui bunun üstüne (kayıtta PBO'ya okuma + önizleme)
+		if (capturing) {
+			tourCapture->EndFrame(headlessCapture ? 0 : framebufferWidth, headlessCapture ? 0 : framebufferHeight);
+		}
+		else {
+			dynamicResolution->EndFrame();
+		}
+
 		// imgui render
 		imguiManager.UpdateDebugInfo(fps, camera.Position, inputManager.IsMouseLocked());
 		imguiManager.Render(sceneManager);
+		// sürüklenen slider ya da yazı girişi varken girdi olmasa da (tuş basılı tutma, imleç yanıp sönme) çizmeye devam
+		if (ImGui::IsAnyItemActive() || io.WantTextInput) {
+			framePacer->RequestRedraw();
+		}
 
 		// imgui robot bilgileri ayarı
 		if (robot) {
@@ -323,15 +502,38 @@ int main() {
 		}
 		std::cout << std::flush;
 
+		framePacer->EndFrame();
 		windowManager.SwapBuffers();
-		windowManager.PollEvents();
+		// aktifken frame sınırı, boştaysa olay gelene kadar; kayıt GPU'nun izin verdiği hızda
+		if (capturing) {
+			windowManager.PollEvents();
+			if (headlessCapture && !tourCapture->IsActive()) {
+				glfwSetWindowShouldClose(window, true);
+			}
+		}
+		else if (framePacer->WaitForNextFrame()) {
+			lastFrame = glfwGetTime();
+		}
 	}
 
 	// Temizlik işlemleri
 	try {
 		// Önce robot'u temizle
+		if (robot) {
+			sceneManager.UnregisterDynamicLight(&robot->GetLight());
+		}
+		sceneManager.UnregisterDynamicObject(robot.get());
 		robot.reset();
 
+		// GL kaynakları pencere kapanmadan
+		imguiManager.SetDynamicResolution(nullptr);
+		dynamicResolution.reset();
+		imguiManager.SetFramePacer(nullptr);
+		framePacer.reset();
+		imguiManager.SetTourCapture(nullptr);
+		tourCapture.reset();
+		GeometryPool::GetInstance().Release();
+
 		// Crosshair kaynaklarını temizle
 		/*
 		if (crosshairShader != nullptr) {
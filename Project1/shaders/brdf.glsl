@@ -0,0 +1,198 @@
+// forward (fragmentShader.glsl) ve deferred (deferredLightFragment.glsl) yolun ortak
+// ışık ve PBR fonksiyonları, Shader #include ile ekliyor
+
+// Işık yapısı 3 farklı tür için yazdım 
+struct Light {
+    vec3 position;
+    vec3 direction;
+    vec3 color;
+    float ambientStrength;
+    float specularStrength;
+    float intensity;
+    float range;
+    int type; // 0: Point, 1: Spot, 2: Directional
+    float cutOff;
+    float outerCutOff;
+};
+
+// LightBuffer'daki paketlenmiş ışık (std140, 4 x vec4), LightBuffer::MAX_LIGHTS ile aynı
+#define MAX_LIGHTS 128
+// robot lambası gibi bake edilmeyen ışıklar, LightBuffer::MAX_DYNAMIC_LIGHTS ile aynı
+#define MAX_DYNAMIC_LIGHTS 4
+struct PackedLight {
+    vec4 positionRange;
+    vec4 directionType;
+    vec4 colorIntensity;
+    vec4 params; // x: ambient, y: specular, z: cutOff, w: outerCutOff (cos)
+};
+
+Light UnpackLight(PackedLight packedLight) {
+    Light result;
+    result.position = packedLight.positionRange.xyz;
+    result.range = packedLight.positionRange.w;
+    result.direction = packedLight.directionType.xyz;
+    result.type = int(packedLight.directionType.w);
+    result.color = packedLight.colorIntensity.rgb;
+    result.intensity = packedLight.colorIntensity.w;
+    result.ambientStrength = packedLight.params.x;
+    result.specularStrength = packedLight.params.y;
+    result.cutOff = packedLight.params.z;
+    result.outerCutOff = packedLight.params.w;
+    return result;
+}
+
+// PBR fonksiyonları
+const float PI = 3.14159265359;
+
+float DistributionGGX(vec3 N, vec3 H, float roughness) {
+    float a = roughness * roughness;
+    float a2 = a * a;
+    float NdotH = max(dot(N, H), 0.0);
+    float NdotH2 = NdotH * NdotH;
+
+    float nom = a2;
+    float denom = (NdotH2 * (a2 - 1.0) + 1.0);
+    denom = PI * denom * denom;
+
+    return nom / denom;
+}
+
+float GeometrySchlickGGX(float NdotV, float roughness) {
+    float r = (roughness + 1.0);
+    float k = (r * r) / 8.0;
+
+    float nom = NdotV;
+    float denom = NdotV * (1.0 - k) + k;
+
+    return nom / denom;
+}
+
+float GeometrySmith(vec3 N, vec3 V, vec3 L, float roughness) {
+    float NdotV = max(dot(N, V), 0.0);
+    float NdotL = max(dot(N, L), 0.0);
+    float ggx2 = GeometrySchlickGGX(NdotV, roughness);
+    float ggx1 = GeometrySchlickGGX(NdotL, roughness);
+
+    return ggx1 * ggx2;
+}
+
+vec3 fresnelSchlick(float cosTheta, vec3 F0) {
+    return F0 + (1.0 - F0) * pow(clamp(1.0 - cosTheta, 0.0, 1.0), 5.0);
+}
+
+// ışığın yönü (L) ve uzaklık/spot zayıflaması, menzil dışındaysa false
+bool lightDirection(Light light, vec3 fragPos, out vec3 L, out float falloff) {
+    falloff = 1.0;
+
+    // Işık türüne göre hesaplama
+    if (light.type == 0) { // Point light
+        L = normalize(light.position - fragPos);
+        float distance = length(light.position - fragPos);
+        if (distance > light.range) return false;
+        falloff = 1.0 / (1.0 + 0.09 * distance + 0.032 * distance * distance);//bu değerleri kullanmamı ai söyledi
+    }
+    else if (light.type == 1) { // Spot light
+        L = normalize(light.position - fragPos);
+        float distance = length(light.position - fragPos);
+        if (distance > light.range) return false;
+        
+        // Spot ışık açısı kontrolü
+        float theta = dot(L, normalize(-light.direction));
+        float epsilon = light.cutOff - light.outerCutOff;
+        float spotEffect = clamp((theta - light.outerCutOff) / epsilon, 0.0, 1.0);
+        
+        falloff = spotEffect / (1.0 + 0.09 * distance + 0.032 * distance * distance);
+    }
+    else { // Directional light
+        L = normalize(-light.direction);
+    }
+    return true;
+}
+
+// shading LOD varyantları (ShadingLod): SHADING_BLINN_PHONG ve SHADING_DIFFUSE tanımlı değilse tam GGX
+vec3 specularTerm(Light light, vec3 L, vec3 normal, vec3 viewDir, vec3 albedo, float roughness, float metallic) {
+#if defined(SHADING_DIFFUSE)
+    return vec3(0.0);
+#elif defined(SHADING_BLINN_PHONG)
+    // GGX lobunun yerine normalize Blinn-Phong, üs roughness'tan (a = roughness^2, n = 2 / a^2 - 2)
+    // Smith yerine Kelemen görünürlüğü 1 / (4 * LdotH^2), Fresnel'de pow yerine üstel yaklaşım
+    float NdotL = dot(normal, L);
+    if (NdotL <= 0.0) return vec3(0.0);
+    vec3 H = normalize(viewDir + L);
+    float a = roughness * roughness;
+    float exponent = max(2.0 / max(a * a, 1e-4) - 2.0, 1.0);
+    float NdotH = max(dot(normal, H), 0.0);
+    float LdotH = max(dot(L, H), 0.05);
+    float VdotH = max(dot(viewDir, H), 0.0);
+    vec3 F0 = mix(vec3(0.04), albedo, metallic);
+    vec3 F = F0 + (1.0 - F0) * exp2((-5.55473 * VdotH - 6.98316) * VdotH);
+    float D = (exponent + 2.0) / (2.0 * PI) * pow(NdotH, exponent);
+    return D * F / (4.0 * LdotH * LdotH) * light.specularStrength * light.color;
+#else
+    vec3 F0 = vec3(0.04);
+    F0 = mix(F0, albedo, metallic);
+    vec3 H = normalize(viewDir + L);
+
+    vec3 F = fresnelSchlick(max(dot(H, viewDir), 0.0), F0);
+    float NDF = DistributionGGX(normal, H, roughness);
+    float G = GeometrySmith(normal, viewDir, L, roughness);
+    vec3 numerator = NDF * G * F;
+    float denominator = 4.0 * max(dot(normal, viewDir), 0.0) * max(dot(normal, L), 0.0) + 0.0001;
+    return numerator / denominator * light.specularStrength * light.color;
+#endif
+}
+
+// ambientScale: irradiance probları ortam ışığını zaten içeriyorsa 0
+// shadow: gölge haritasından görünürlük, ambient'e etki etmiyor
+vec3 calculateLight(Light light, vec3 fragPos, vec3 normal, vec3 viewDir, vec3 albedo, float roughness, float metallic,
+    float ambientScale, float shadow) {
+    vec3 L;
+    float falloff;
+    if (!lightDirection(light, fragPos, L, falloff)) return vec3(0.0);
+
+    // Ambient
+    vec3 ambient = ambientScale * light.ambientStrength * albedo * light.color;
+
+    // Diffuse
+    float diff = max(dot(normal, L), 0.0);
+    vec3 diffuse = diff * albedo * light.color;
+
+    // Specular
+    vec3 specular = specularTerm(light, L, normal, viewDir, albedo, roughness, metallic);
+
+    // Toplam
+    vec3 result = (ambient + (diffuse + specular) * falloff * light.intensity * shadow);
+    return result;
+}
+
+vec3 calculateLight(Light light, vec3 fragPos, vec3 normal, vec3 viewDir, vec3 albedo, float roughness, float metallic) {
+    return calculateLight(light, fragPos, normal, viewDir, albedo, roughness, metallic, 1.0, 1.0);
+}
+
+// lightmap'li yüzeyler için: ambient ve diffuse bake edildi, sadece yansıma
+vec3 calculateSpecular(Light light, vec3 fragPos, vec3 normal, vec3 viewDir, vec3 albedo, float roughness, float metallic) {
+    vec3 L;
+    float falloff;
+    if (!lightDirection(light, fragPos, L, falloff)) return vec3(0.0);
+    return specularTerm(light, L, normal, viewDir, albedo, roughness, metallic) * falloff * light.intensity;
+}
+
+// G-buffer normali: birim küre oktahedrona açılıp 2 kanala sığdırılıyor
+vec2 OctWrap(vec2 v) {
+    return (1.0 - abs(v.yx)) * vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+}
+
+vec2 OctEncode(vec3 n) {
+    n /= abs(n.x) + abs(n.y) + abs(n.z);
+    n.xy = n.z >= 0.0 ? n.xy : OctWrap(n.xy);
+    return n.xy * 0.5 + 0.5;
+}
+
+vec3 OctDecode(vec2 encoded) {
+    vec2 f = encoded * 2.0 - 1.0;
+    vec3 n = vec3(f.x, f.y, 1.0 - abs(f.x) - abs(f.y));
+    float t = clamp(-n.z, 0.0, 1.0);
+    n.x += n.x >= 0.0 ? -t : t;
+    n.y += n.y >= 0.0 ? -t : t;
+    return normalize(n);
+}
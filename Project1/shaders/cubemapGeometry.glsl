@@ -0,0 +1,59 @@
+#version 330 core
+// küp harita yakalama (PanoramaCapture): sahne tek çizimde altı yüze birden, üçgen her yüz için gl_Layer ile
+// tekrar yayınlanıyor. Yüzün frustum'unun tamamen dışında kalan üçgen o yüze hiç gönderilmiyor
+layout (triangles) in;
+layout (triangle_strip, max_vertices = 18) out;
+
+in vec3 FragPosVS[];
+in vec3 NormalVS[];
+in vec2 TexCoordsVS[];
+in mat3 TBNVS[];
+in float VertexOcclusionVS[];
+in vec2 LightmapUVVS[];
+
+out vec3 FragPos;
+out vec3 Normal;
+out vec2 TexCoords;
+out mat3 TBN;
+out float VertexOcclusion;
+out vec2 LightmapUV;
+
+// +X, -X, +Y, -Y, +Z, -Z (küp texture katman sırası)
+uniform mat4 faceViewProjection[6];
+
+// üç köşe de aynı kırpma düzleminin dışında
+bool outsideFace(vec4 a, vec4 b, vec4 c)
+{
+    vec3 x = vec3(a.x, b.x, c.x);
+    vec3 y = vec3(a.y, b.y, c.y);
+    vec3 z = vec3(a.z, b.z, c.z);
+    vec3 w = vec3(a.w, b.w, c.w);
+    return all(lessThan(x, -w)) || all(greaterThan(x, w)) ||
+           all(lessThan(y, -w)) || all(greaterThan(y, w)) ||
+           all(lessThan(z, -w)) || all(greaterThan(z, w));
+}
+
+void main()
+{
+    for (int face = 0; face < 6; ++face) {
+        vec4 clip[3];
+        for (int i = 0; i < 3; ++i) {
+            clip[i] = faceViewProjection[face] * vec4(FragPosVS[i], 1.0);
+        }
+        if (outsideFace(clip[0], clip[1], clip[2])) {
+            continue;
+        }
+        for (int i = 0; i < 3; ++i) {
+            gl_Layer = face;
+            gl_Position = clip[i];
+            FragPos = FragPosVS[i];
+            Normal = NormalVS[i];
+            TexCoords = TexCoordsVS[i];
+            TBN = TBNVS[i];
+            VertexOcclusion = VertexOcclusionVS[i];
+            LightmapUV = LightmapUVVS[i];
+            EmitVertex();
+        }
+        EndPrimitive();
+    }
+}
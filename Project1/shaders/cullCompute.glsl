@@ -0,0 +1,61 @@
+#version 430 core
+// GPU frustum culling: her thread bir çizim komutunu test ediyor
+// görünenler bucketının bölgesine atomik sayaçla sıkıştırılarak yazılıyor
+layout (local_size_x = 64) in;
+
+// DrawElementsIndirectCommand ile aynı (20 byte)
+struct DrawCommand {
+    uint count;
+    uint instanceCount;
+    uint firstIndex;
+    int baseVertex;
+    uint baseInstance;
+};
+
+struct CullInput {
+    vec4 sphere;  // xyz: dünya merkezi, w: yarıçap
+    uvec4 bucket; // x: bucket indexi
+};
+
+layout (std430, binding = 2) readonly buffer InputCommands {
+    DrawCommand inputCommands[];
+};
+
+layout (std430, binding = 3) readonly buffer CullInputs {
+    CullInput cullInputs[];
+};
+
+layout (std430, binding = 4) readonly buffer BucketOffsets {
+    uint bucketOffsets[];
+};
+
+layout (std430, binding = 5) writeonly buffer OutputCommands {
+    DrawCommand outputCommands[];
+};
+
+// parameter buffer olarak da kullanılıyor (indirect count)
+layout (std430, binding = 6) buffer BucketCounts {
+    uint bucketCounts[];
+};
+
+uniform vec4 frustumPlanes[6];
+uniform uint drawCount;
+
+void main()
+{
+    uint id = gl_GlobalInvocationID.x;
+    if (id >= drawCount) {
+        return;
+    }
+
+    vec4 sphere = cullInputs[id].sphere;
+    for (int i = 0; i < 6; ++i) {
+        if (dot(frustumPlanes[i].xyz, sphere.xyz) + frustumPlanes[i].w < -sphere.w) {
+            return;
+        }
+    }
+
+    uint bucket = cullInputs[id].bucket.x;
+    uint slot = atomicAdd(bucketCounts[bucket], 1u);
+    outputCommands[bucketOffsets[bucket] + slot] = inputCommands[id];
+}
@@ -0,0 +1,34 @@
+#version 330 core
+// deferred ışık geçişi: G-buffer'dan yüzey okunup tek ışık hesaplanıyor,
+// sonuç HDR bufferına toplanarak (additive blend) yazılıyor
+out vec4 FragColor;
+
+#include "brdf.glsl"
+
+uniform sampler2D gAlbedo;
+uniform sampler2D gNormal;
+uniform sampler2D gDepth;
+uniform mat4 inverseViewProjection;
+uniform vec3 viewPos;
+uniform Light light;
+uniform ivec2 viewportOrigin; // G-buffer'a göre, ışık hedefi de (0, 0)'dan başladığı için şimdilik hep sıfır
+
+void main() {
+    ivec2 pixel = ivec2(gl_FragCoord.xy) - viewportOrigin;
+    float depth = texelFetch(gDepth, pixel, 0).r;
+    if (depth >= 1.0) {
+        discard; // arka plan
+    }
+
+    // dünya konumu derinlikten geri hesaplanıyor
+    vec2 uv = (vec2(pixel) + 0.5) / vec2(textureSize(gDepth, 0));
+    vec4 worldPos = inverseViewProjection * vec4(vec3(uv, depth) * 2.0 - 1.0, 1.0);
+    vec3 fragPos = worldPos.xyz / worldPos.w;
+
+    vec3 albedo = texelFetch(gAlbedo, pixel, 0).rgb;
+    vec4 surface = texelFetch(gNormal, pixel, 0);
+    vec3 normal = OctDecode(surface.xy);
+    vec3 viewDir = normalize(viewPos - fragPos);
+
+    FragColor = vec4(calculateLight(light, fragPos, normal, viewDir, albedo, surface.z, surface.w), 1.0);
+}
@@ -0,0 +1,20 @@
+#version 330 core
+// deferred ışık geçişi: nokta/spot ışıklar için menzil küresi, yönlü ışık ve
+// resolve için tam ekran üçgen (vertex bufferı okunmuyor, gl_VertexID'den üretiliyor)
+layout (location = 0) in vec3 aPos;
+
+uniform bool fullscreen;
+uniform mat4 viewProjection;
+uniform vec3 volumeCenter;
+uniform float volumeRadius;
+
+void main()
+{
+    if (fullscreen) {
+        vec2 corner = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+        gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);
+    }
+    else {
+        gl_Position = viewProjection * vec4(volumeCenter + aPos * volumeRadius, 1.0);
+    }
+}
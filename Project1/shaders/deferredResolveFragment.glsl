@@ -0,0 +1,27 @@
+#version 330 core
+// deferred resolve: toplanan ışık parlaklık çarpanıyla çarpılıp forward yoldaki gibi
+// tonemap + gamma uygulanıyor, G-buffer derinliği hedefin derinliğine yazılıyor
+// (sonradan forward çizilen instanced objeler ve robot için)
+out vec4 FragColor;
+
+uniform sampler2D gAlbedo;
+uniform sampler2D gDepth;
+uniform sampler2D lightAccumulation;
+uniform ivec2 viewportOrigin; // hedefin viewport köşesi, G-buffer (0, 0)'dan başlıyor
+
+void main() {
+    ivec2 pixel = ivec2(gl_FragCoord.xy) - viewportOrigin;
+    float depth = texelFetch(gDepth, pixel, 0).r;
+    if (depth >= 1.0) {
+        discard;
+    }
+
+    vec3 result = texelFetch(lightAccumulation, pixel, 0).rgb;
+    result *= texelFetch(gAlbedo, pixel, 0).a;
+
+    result = result / (result + vec3(1.0));
+    result = pow(result, vec3(1.0/2.2));
+
+    FragColor = vec4(result, 1.0);
+    gl_FragDepth = depth;
+}
@@ -0,0 +1,8 @@
+#version 330 core
+// renk yazılmıyor (glColorMask kapalı), sadece derinlik
+out vec4 FragColor;
+
+void main()
+{
+    FragColor = vec4(1.0);
+}
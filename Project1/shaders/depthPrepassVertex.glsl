@@ -0,0 +1,17 @@
+#version 330 core
+// derinlik ön geçişi: sadece konum akışı okunuyor
+// renk geçişi GL_EQUAL ile test ettiği için konum vertexShader.glsl ile birebir aynı
+// ifadeyle hesaplanıyor (invariant)
+layout (location = 0) in vec3 aPos;
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+
+invariant gl_Position;
+
+void main()
+{
+    vec3 worldPos = vec3(model * vec4(aPos, 1.0));
+    gl_Position = projection * view * vec4(worldPos, 1.0);
+}
@@ -0,0 +1,16 @@
+#version 330 core
+// küp haritadan equirectangular panorama (PanoramaCapture): u boylam (-pi..pi, ortası -z), v enlem (alt -pi/2)
+in vec2 OutputUV;
+out vec4 FragColor;
+
+uniform samplerCube environment;
+
+const float PI = 3.14159265359;
+
+void main()
+{
+    float longitude = (OutputUV.x * 2.0 - 1.0) * PI;
+    float latitude = (OutputUV.y - 0.5) * PI;
+    vec3 direction = vec3(cos(latitude) * sin(longitude), sin(latitude), -cos(latitude) * cos(longitude));
+    FragColor = vec4(texture(environment, direction).rgb, 1.0);
+}
@@ -1,13 +1,43 @@
 #version 330 core
+#ifdef GBUFFER
+// deferred yolun G-buffer geçişi: ışık hesabı yok, yüzey bilgisi yazılıyor
+layout (location = 0) out vec4 GAlbedo; // rgb: albedo, a: parlaklık çarpanı
+layout (location = 1) out vec4 GNormal; // xy: oktahedral normal, z: roughness, w: metallic
+#else
 out vec4 FragColor;
-
-#define NUM_LIGHTS 4
-
+#endif
+
+#ifdef IMPOSTOR
+// uzak kopya (Impostor): yüzey mesh yerine oktahedral görünüş atlasından geliyor, ışık hesabı aynı
+// mesh yolunun girdileri SampleImpostor'da dolduruluyor
+in vec2 ImpostorUV[3];
+flat in vec2 ImpostorFrame[3];
+flat in vec3 ImpostorWeights;
+flat in mat4 ImpostorModel;
+flat in mat3 ImpostorNormalMatrix;
+
+uniform sampler2D impostorAlbedo; // G-buffer çıktısı: rgb albedo (parlaklık ve AO dahil), a parlaklık çarpanı
+uniform sampler2D impostorNormal; // xy: oktahedral normal, z: roughness, w: metallic
+uniform sampler2D impostorDepth;  // ortografik yakalama derinliği, 1 boş
+uniform vec4 impostorSphere;      // yakalama uzayında merkez + yarıçap
+uniform int impostorGrid;         // eksen başına frame
+uniform mat4 view;
+uniform mat4 projection;
+
+vec3 FragPos;
+vec3 Normal;
+vec2 TexCoords;
+mat3 TBN;
+float VertexOcclusion;
+vec2 LightmapUV;
+#else
 in vec3 FragPos;
 in vec3 Normal;
 in vec2 TexCoords;
 in mat3 TBN;
-in vec3 VertexColor; // vertex shaderdan gelen renk bilgisi
+in float VertexOcclusion; // vertex AO'su, oyuk ve temas noktalarında karanlık
+in vec2 LightmapUV;  // < 0 ise lightmap yok
+#endif
 
 uniform bool specialTextureMode;
 uniform sampler2D specialTexture;
@@ -26,132 +56,263 @@ struct Material {
     bool hasNormalMap;
     bool hasRoughnessMap;
     bool hasMetallicMap;
-    bool useVertexColors;
 };
 
-// Işık yapısı 3 farklı tür için yazdım 
-struct Light {
-    vec3 position;
-    vec3 direction;
-    vec3 color;
-    float ambientStrength;
-    float specularStrength;
-    float intensity;
-    float range;
-    int type; // 0: Point, 1: Spot, 2: Directional
-    float cutOff;
-    float outerCutOff;
-};
+#include "brdf.glsl"
 
-uniform Material material;
-uniform Light light;
-uniform vec3 viewPos;
+#ifdef INDIRECT_DRAW
+// indirect yolda materyal uniform değil, SSBO'dan main başında dolduruluyor
+struct PackedMaterial {
+    vec4 ambient;   // w: opacity
+    vec4 diffuse;   // w: brightness
+    vec4 specular;  // w: shininess
+};
 
-// Texture 
-uniform sampler2D diffuseMap;
-uniform sampler2D normalMap;
-uniform sampler2D roughnessMap;
-uniform sampler2D metallicMap;
+layout (std430, binding = 1) readonly buffer MaterialBuffer {
+    PackedMaterial materials[];
+};
 
-// PBR fonksiyonları
-const float PI = 3.14159265359;
+flat in uint MaterialIndex;
+uniform bool bucketHasDiffuseMap; // texture her bucket için ayrı bind ediliyor
 
-float DistributionGGX(vec3 N, vec3 H, float roughness) {
-    float a = roughness * roughness;
-    float a2 = a * a;
-    float NdotH = max(dot(N, H), 0.0);
-    float NdotH2 = NdotH * NdotH;
+Material material;
+#else
+uniform Material material;
+#endif
 
-    float nom = a2;
-    float denom = (NdotH2 * (a2 - 1.0) + 1.0);
-    denom = PI * denom * denom;
+#ifdef INSTANCED
+in vec4 InstanceTint; // kopya başına renk tonu, a: LOD geçişinde meshin payı
 
-    return nom / denom;
+// mesh ile impostor arasındaki geçişte ikisi tamamlayıcı piksellerde (sıralama ve blending gerekmiyor)
+float LodDither() {
+    return fract(52.9829189 * fract(dot(gl_FragCoord.xy, vec2(0.06711056, 0.00583715))));
 }
-
-float GeometrySchlickGGX(float NdotV, float roughness) {
-    float r = (roughness + 1.0);
-    float k = (r * r) / 8.0;
-
-    float nom = NdotV;
-    float denom = NdotV * (1.0 - k) + k;
-
-    return nom / denom;
+#endif
+
+#ifdef IMPOSTOR
+#include "impostor.glsl"
+
+// üç görünüşün ağırlıklı ortalaması, boş texele düşen görünüş ağırlıktan çıkıyor
+// konum ışının görünüş düzlemindeki noktası + derinlik, gl_FragDepth ona göre yazılıyor
+vec4 SampleImpostor(out vec2 roughnessMetallic) {
+    float cells = float(impostorGrid - 1);
+    float frameScale = 1.0 / float(impostorGrid);
+    vec2 halfTexel = 0.5 / vec2(textureSize(impostorDepth, 0));
+    float radius = impostorSphere.w;
+
+    vec4 albedo = vec4(0.0);
+    vec3 normal = vec3(0.0);
+    vec3 position = vec3(0.0);
+    vec2 surface = vec2(0.0);
+    float coverage = 0.0;
+    for (int k = 0; k < 3; ++k) {
+        float weight = ImpostorWeights[k];
+        vec2 uv = ImpostorUV[k];
+        if (weight <= 0.0 || any(lessThan(uv, vec2(0.0))) || any(greaterThan(uv, vec2(1.0)))) continue;
+        // komşu frame'e taşmasın
+        vec2 frameMin = ImpostorFrame[k] * frameScale;
+        vec2 atlasUV = clamp(frameMin + uv * frameScale, frameMin + halfTexel, frameMin + frameScale - halfTexel);
+        float depth = texture(impostorDepth, atlasUV).r;
+        if (depth >= 1.0) continue;
+
+        vec3 direction = ImpostorFrameDirection(ImpostorFrame[k] / cells);
+        vec3 right, up;
+        ImpostorFrameBasis(direction, right, up);
+        position += weight * (impostorSphere.xyz + (right * (uv.x - 0.5) + up * (uv.y - 0.5)) * 2.0 * radius +
+            direction * (radius - 2.0 * radius * depth));
+        albedo += weight * texture(impostorAlbedo, atlasUV);
+        vec4 packedSurface = texture(impostorNormal, atlasUV);
+        normal += weight * OctDecode(packedSurface.xy);
+        surface += weight * packedSurface.zw;
+        coverage += weight;
+    }
+    if (coverage < 0.5) discard;
+
+    vec4 world = ImpostorModel * vec4(position / coverage, 1.0);
+    FragPos = world.xyz;
+    Normal = normalize(ImpostorNormalMatrix * normal);
+    TexCoords = vec2(0.0);
+    VertexOcclusion = 1.0;
+    LightmapUV = vec2(-1.0);
+    vec4 clip = projection * view * world;
+    gl_FragDepth = clip.z / clip.w * 0.5 + 0.5;
+    roughnessMetallic = surface / coverage;
+    return albedo / coverage;
 }
+#endif
+#ifndef GBUFFER
+uniform Light light;
 
-float GeometrySmith(vec3 N, vec3 V, vec3 L, float roughness) {
-    float NdotV = max(dot(N, V), 0.0);
-    float NdotL = max(dot(N, L), 0.0);
-    float ggx2 = GeometrySchlickGGX(NdotV, roughness);
-    float ggx1 = GeometrySchlickGGX(NdotL, roughness);
+// sahnedeki diğer ışıklar (LightBuffer): kümeler kapalıyken her piksel düz listeyi dolaşıyor,
+// açıkken sadece kendi kümesine atanmış ışıkları (ClusteredLighting texture bufferları)
+layout (std140) uniform LightBlock {
+    PackedLight extraLights[MAX_LIGHTS];
+    int extraLightCount;
+    int clusteredLights;
+    int lightmapEnabled;  // statik kabuğun dağınık ışığı bake edildi (Lightmap)
+    int probesEnabled;    // hareketli objeler için irradiance probları (IrradianceVolume)
+    vec4 clusterDepth;    // near, far, dilim ölçeği, dilim kayması
+    vec4 clusterViewport; // x, y, karo genişliği, karo yüksekliği
+    vec4 probeVolumeMin;
+    vec4 probeVolumeInvSize;
+    // lightmap'e ve problara girmeyen, her fragmentte canlı hesaplanan ışıklar
+    PackedLight dynamicLights[MAX_DYNAMIC_LIGHTS];
+    int dynamicLightCount;
+};
 
-    return ggx1 * ggx2;
-}
+// ShadowAtlas: ışık başına bir (spot) ya da altı (nokta ışık, küp yüzleri) tile
+#define MAX_SHADOW_TILES 16
+layout (std140) uniform ShadowBlock {
+    mat4 shadowMatrices[MAX_SHADOW_TILES];   // dünya -> atlas uv + derinlik
+    vec4 shadowTileBounds[MAX_SHADOW_TILES]; // PCF'in taşmaması için tile'ın uv sınırı
+    vec4 shadowTileParams[MAX_SHADOW_TILES]; // x: birim uzaklıktaki texel boyu
+    ivec4 lightShadowTiles[(MAX_LIGHTS + 4) / 4]; // sahne ışığı i -> ilk tile, -1 gölgesiz
+    ivec4 dynamicShadowTiles;
+    int shadowsEnabled;
+    int shadowFilter;       // 0: sert, 1: donanım 2x2, 2: 3x3, 3: 5x5
+    float shadowTexelSize;  // 1 / atlas boyu
+    float shadowNormalBias; // texel cinsinden
+};
 
-vec3 fresnelSchlick(float cosTheta, vec3 F0) {
-    return F0 + (1.0 - F0) * pow(clamp(1.0 - cosTheta, 0.0, 1.0), 5.0);
+#ifdef CUBEMAP_LAYERED
+// küp yüzlerinde gl_FragCoord ana kameranın kümelerine denk gelmiyor, ışıklar düz listeden
+#define USE_LIGHT_CLUSTERS false
+#else
+#define USE_LIGHT_CLUSTERS (clusteredLights != 0)
+#endif
+
+#define CLUSTERS_X 16
+#define CLUSTERS_Y 9
+#define CLUSTERS_Z 24
+uniform samplerBuffer clusterLightData;     // ışık başına 4 texel (PackedLight)
+uniform usamplerBuffer clusterGrid;         // küme başına offset, sayı
+uniform usamplerBuffer clusterLightIndices;
+uniform sampler2D lightmap; // RGB9_E5, doğrudan + dolaylı dağınık ışık
+uniform sampler3D probeIrradiance; // RGB16F, 9 SH katsayısı z ekseninde art arda bloklar
+uniform sampler2DShadow shadowAtlas; // gölge haritaları (statik katman + her frame dinamik casterlar)
+
+Light FetchClusterLight(int index) {
+    PackedLight packedLight;
+    packedLight.positionRange = texelFetch(clusterLightData, index * 4);
+    packedLight.directionType = texelFetch(clusterLightData, index * 4 + 1);
+    packedLight.colorIntensity = texelFetch(clusterLightData, index * 4 + 2);
+    packedLight.params = texelFetch(clusterLightData, index * 4 + 3);
+    return UnpackLight(packedLight);
 }
 
-vec3 calculateLight(vec3 normal, vec3 viewDir, vec3 albedo, float roughness, float metallic) {
-    vec3 F0 = vec3(0.04);
-    F0 = mix(F0, albedo, metallic);
-
-    vec3 L;
-    float attenuation = 1.0;
-    float spotEffect = 1.0;
-
-    // Işık türüne göre hesaplama
-    if (light.type == 0) { // Point light
-        L = normalize(light.position - FragPos);
-        float distance = length(light.position - FragPos);
-        if (distance > light.range) return vec3(0.0);
-        attenuation = 1.0 / (1.0 + 0.09 * distance + 0.032 * distance * distance);//bu değerleri kullanmamı ai söyledi
-    }
-    else if (light.type == 1) { // Spot light
-        L = normalize(light.position - FragPos);
-        float distance = length(light.position - FragPos);
-        if (distance > light.range) return vec3(0.0);
-        
-        // Spot ışık açısı kontrolü
-        float theta = dot(L, normalize(-light.direction));
-        float epsilon = light.cutOff - light.outerCutOff;
-        spotEffect = clamp((theta - light.outerCutOff) / epsilon, 0.0, 1.0);
-        
-        attenuation = 1.0 / (1.0 + 0.09 * distance + 0.032 * distance * distance);
+// prob ızgarasında trilineer: her katsayı bloğu kendi içinde örnekleniyor, z blok sınırında sıkıştırılıyor
+// katsayılar kosinüsle konvolüe edildi, normal yönündeki irradiance doğrudan taban fonksiyonlarıyla çıkıyor
+vec3 sampleProbeIrradiance(vec3 position, vec3 n) {
+    vec3 size = vec3(textureSize(probeIrradiance, 0));
+    size.z /= 9.0;
+    vec3 cell = clamp((position - probeVolumeMin.xyz) * probeVolumeInvSize.xyz, 0.0, 1.0) * (size - 1.0) + 0.5;
+    vec2 uv = cell.xy / size.xy;
+    float basis[9] = float[9](
+        0.282095,
+        0.488603 * n.y, 0.488603 * n.z, 0.488603 * n.x,
+        1.092548 * n.x * n.y, 1.092548 * n.y * n.z, 0.315392 * (3.0 * n.z * n.z - 1.0),
+        1.092548 * n.x * n.z, 0.546274 * (n.x * n.x - n.y * n.y));
+    vec3 irradiance = vec3(0.0);
+    for (int k = 0; k < 9; ++k) {
+        float w = (cell.z + float(k) * size.z) / (size.z * 9.0);
+        irradiance += texture(probeIrradiance, vec3(uv, w)).rgb * basis[k];
     }
-    else if (light.type == 2) { // Directional light
-        L = normalize(-light.direction);
-    }
-
-    vec3 H = normalize(viewDir + L);
+    return max(irradiance, vec3(0.0));
+}
 
-    // Ambient
-    vec3 ambient = light.ambientStrength * albedo * light.color;
+// ışığın gölge haritasından görünürlük (1: aydınlık), nokta ışıkta küp yüzü fragmentin yönünden seçiliyor
+float lightShadow(int firstTile, Light light, vec3 fragPos, vec3 normal) {
+    if (shadowsEnabled == 0 || firstTile < 0) return 1.0;
+    vec3 toFragment = fragPos - light.position;
+    int tile = firstTile;
+    if (light.type == 0) {
+        vec3 axis = abs(toFragment);
+        if (axis.x >= axis.y && axis.x >= axis.z) tile += toFragment.x > 0.0 ? 0 : 1;
+        else if (axis.y >= axis.z) tile += toFragment.y > 0.0 ? 2 : 3;
+        else tile += toFragment.z > 0.0 ? 4 : 5;
+    }
 
-    // Diffuse
-    float diff = max(dot(normal, L), 0.0);
-    vec3 diffuse = diff * albedo * light.color;
+    // normal yönünde kaydırma texel boyuyla büyüyor, uzak yüzeylerde akne olmasın
+    vec3 offsetPos = fragPos + normal * (shadowNormalBias * length(toFragment) * shadowTileParams[tile].x);
+    vec4 clip = shadowMatrices[tile] * vec4(offsetPos, 1.0);
+    if (clip.w <= 0.0) return 1.0;
+    vec3 coords = clip.xyz / clip.w;
+    vec4 bounds = shadowTileBounds[tile];
+    if (coords.z >= 1.0 || any(lessThan(coords.xy, bounds.xy)) || any(greaterThan(coords.xy, bounds.zw))) return 1.0;
+
+    int radius = max(shadowFilter - 1, 0);
+    float visibility = 0.0;
+    for (int y = -radius; y <= radius; ++y) {
+        for (int x = -radius; x <= radius; ++x) {
+            vec2 uv = clamp(coords.xy + vec2(x, y) * shadowTexelSize, bounds.xy, bounds.zw);
+            visibility += texture(shadowAtlas, vec3(uv, coords.z));
+        }
+    }
+    return visibility / float((2 * radius + 1) * (2 * radius + 1));
+}
 
-    // Specular
-    vec3 F = fresnelSchlick(max(dot(H, viewDir), 0.0), F0);
-    float NDF = DistributionGGX(normal, H, roughness);
-    float G = GeometrySmith(normal, viewDir, L, roughness);
-    vec3 numerator = NDF * G * F;
-    float denominator = 4.0 * max(dot(normal, viewDir), 0.0) * max(dot(normal, L), 0.0) + 0.0001;
-    vec3 specular = numerator / denominator;
-    specular *= light.specularStrength * light.color;
+// sahne ışığı index'i: 0 ana ışık (light uniformu), i > 0 LightBuffer'daki i - 1
+// kümeli yolda ışık sayısı sınırsız, tablo ShadowAtlas::MAX_SCENE_LIGHTS kadar, ötesi gölgesiz
+int sceneShadowTile(int index) {
+    if (index > MAX_LIGHTS) return -1;
+    return lightShadowTiles[index / 4][index % 4];
+}
 
-    // Toplam
-    vec3 result = (ambient + (diffuse + specular) * attenuation * spotEffect * light.intensity);
-    return result;
+int FindCluster() {
+    // pencere derinliğinden pozitif view derinliği, dilim logaritmik
+    float nearPlane = clusterDepth.x;
+    float farPlane = clusterDepth.y;
+    float ndcDepth = gl_FragCoord.z * 2.0 - 1.0;
+    float viewDepth = 2.0 * nearPlane * farPlane / (farPlane + nearPlane - ndcDepth * (farPlane - nearPlane));
+    int slice = clamp(int(floor(log(viewDepth) * clusterDepth.z + clusterDepth.w)), 0, CLUSTERS_Z - 1);
+    ivec2 tile = clamp(ivec2((gl_FragCoord.xy - clusterViewport.xy) / clusterViewport.zw),
+        ivec2(0), ivec2(CLUSTERS_X - 1, CLUSTERS_Y - 1));
+    return tile.x + tile.y * CLUSTERS_X + slice * CLUSTERS_X * CLUSTERS_Y;
 }
+#endif
+uniform vec3 viewPos;
+
+// Texture 
+uniform sampler2D diffuseMap;
+uniform sampler2D normalMap;
+uniform sampler2D roughnessMap;
+uniform sampler2D metallicMap;
 
 void main() {
+#ifdef INDIRECT_DRAW
+    PackedMaterial packedMaterial = materials[MaterialIndex];
+    material.ambient = packedMaterial.ambient.rgb;
+    material.diffuse = packedMaterial.diffuse.rgb;
+    material.specular = packedMaterial.specular.rgb;
+    material.brightness = packedMaterial.diffuse.w;
+    material.shininess = packedMaterial.specular.w;
+    material.opacity = packedMaterial.ambient.w;
+    material.hasDiffuseMap = bucketHasDiffuseMap;
+    material.hasNormalMap = false;
+    material.hasRoughnessMap = false;
+    material.hasMetallicMap = false;
+#endif
+
+#ifdef IMPOSTOR
+    if (LodDither() < InstanceTint.a) discard;
+    vec2 impostorSurface;
+    vec4 impostorAlbedo = SampleImpostor(impostorSurface);
+    vec4 diffuseColor = vec4(impostorAlbedo.rgb, 1.0);
+    float brightness = impostorAlbedo.a;
+#else
+#ifdef LOD_FADE
+    if (LodDither() >= InstanceTint.a) discard;
+#endif
     // Texture değerlerini al
     vec4 diffuseColor = material.hasDiffuseMap ? texture(diffuseMap, TexCoords) : vec4(material.diffuse, 1.0);
     if (specialTextureMode) {
         diffuseColor = texture(specialTexture, TexCoords);
     }
+    float brightness = material.brightness;
+#endif
+#ifdef INSTANCED
+    diffuseColor.rgb *= InstanceTint.rgb;
+#endif
     
     // Normal map'ten normal vektörü al - Vertex shader'dan gelen TBN matrisini kullan
     vec3 normal = normalize(Normal);
@@ -164,29 +325,81 @@ void main() {
     // BU kısım normalde obkjelerin textıre olmadan dahai yüklemesi için eklndi
     float roughness = 0.5;
     float metallic = 0.0;
+#ifndef SHADING_DIFFUSE
+    // sadece dağınık seviyede yansıma yok, bu texturelar okunmuyor
     if (material.hasRoughnessMap) {
         roughness = texture(roughnessMap, TexCoords).r;
     }
     if (material.hasMetallicMap) {
         metallic = texture(metallicMap, TexCoords).r;
     }
+#endif
+#ifdef IMPOSTOR
+    roughness = impostorSurface.x;
+    metallic = impostorSurface.y;
+#endif
 
     // View vektörü
     vec3 viewDir = normalize(viewPos - FragPos);
 
     // Temel renk
+#ifdef IMPOSTOR
+    // yakalanırken parlaklık ve AO albedoya girdi
+    vec3 albedo = diffuseColor.rgb;
+#else
     vec3 albedo = diffuseColor.rgb * material.brightness;
     
-    // Vertex renkleri kullanılıyorsa - Vertex shader'dan gelen VertexColor'ı kullan
-    if (material.useVertexColors) {
-        albedo = VertexColor * material.brightness;
-    }
+    // vertex AO'su dağınık rengi kısıyor, bu yüzden ışıkların hepsine ve lightmap'e de etki ediyor
+    albedo *= VertexOcclusion;
+#endif
     
+#ifdef GBUFFER
+    // parlaklık çarpanı ışıklar toplandıktan sonra resolve geçişinde uygulanıyor
+    GAlbedo = vec4(albedo, min(brightness, 5.0));
+    GNormal = vec4(OctEncode(normal), roughness, metallic);
+#else
     // Işık hesaplaması
-    vec3 result = calculateLight(normal, viewDir, albedo, roughness, metallic);
+    vec3 result;
+    if (lightmapEnabled != 0 && LightmapUV.x >= 0.0) {
+        // statik kabuk: tüm ışıkların dağınık kısmı bake edildi, sadece ana ışığın yansıması canlı
+        result = albedo * texture(lightmap, LightmapUV).rgb +
+            calculateSpecular(light, FragPos, normal, viewDir, albedo, roughness, metallic) *
+            lightShadow(sceneShadowTile(0), light, FragPos, normal);
+    }
+    else {
+        // problar açıksa ışıkların sabit ambient'i yerine probların yönlü ortam ışığı (+ bir sekme)
+        float ambientScale = 1.0;
+        result = vec3(0.0);
+        if (probesEnabled != 0) {
+            ambientScale = 0.0;
+            result = albedo * sampleProbeIrradiance(FragPos, normal);
+        }
+        result += calculateLight(light, FragPos, normal, viewDir, albedo, roughness, metallic, ambientScale,
+            lightShadow(sceneShadowTile(0), light, FragPos, normal));
+        for (int i = 0; i < extraLightCount; ++i) {
+            Light extraLight = UnpackLight(extraLights[i]);
+            result += calculateLight(extraLight, FragPos, normal, viewDir, albedo, roughness, metallic, ambientScale,
+                lightShadow(sceneShadowTile(i + 1), extraLight, FragPos, normal));
+        }
+        if (USE_LIGHT_CLUSTERS) {
+            uvec2 cluster = texelFetch(clusterGrid, FindCluster()).rg;
+            for (uint i = 0u; i < cluster.y; ++i) {
+                int lightIndex = int(texelFetch(clusterLightIndices, int(cluster.x + i)).r);
+                Light clusterLight = FetchClusterLight(lightIndex);
+                result += calculateLight(clusterLight, FragPos, normal, viewDir, albedo, roughness, metallic, ambientScale,
+                    lightShadow(sceneShadowTile(lightIndex + 1), clusterLight, FragPos, normal));
+            }
+        }
+    }
+    // hareketli ışıklar lightmap'li yüzeylerde de canlı, ambient'leri sahneye eklenmiyor
+    for (int i = 0; i < dynamicLightCount; ++i) {
+        Light dynamicLight = UnpackLight(dynamicLights[i]);
+        result += calculateLight(dynamicLight, FragPos, normal, viewDir, albedo, roughness, metallic, 0.0,
+            lightShadow(dynamicShadowTiles[i], dynamicLight, FragPos, normal));
+    }
 
     // Parlaklık kontrolü 
-    result *= min(material.brightness, 5.0); // Maksimum 5x parlaklık
+    result *= min(brightness, 5.0); // Maksimum 5x parlaklık
 
     
     result = result / (result + vec3(1.0));
@@ -194,4 +407,5 @@ void main() {
 
     float finalOpacity = material.opacity * diffuseColor.a;
     FragColor = vec4(result, finalOpacity);
+#endif
 }
\ No newline at end of file
@@ -0,0 +1,28 @@
+// impostorVertex.glsl ve fragmentShader.glsl (IMPOSTOR) ortak oktahedral görünüş fonksiyonları, Impostor.cpp ile aynı
+// atlasın ortası tepeden bakış (+Y), köşeleri alttan; ızgaranın kenar frame'leri oktahedronun kenarına denk geliyor
+
+// [0, 1]^2 ızgara konumundan bakış yönü (kameradan objeye değil, objeden kameraya)
+vec3 ImpostorFrameDirection(vec2 grid) {
+    vec2 f = grid * 2.0 - 1.0;
+    vec3 n = vec3(f.x, 1.0 - abs(f.x) - abs(f.y), f.y);
+    float t = clamp(-n.y, 0.0, 1.0);
+    n.x += n.x >= 0.0 ? -t : t;
+    n.z += n.z >= 0.0 ? -t : t;
+    return normalize(n);
+}
+
+vec2 ImpostorDirectionToGrid(vec3 d) {
+    d /= abs(d.x) + abs(d.y) + abs(d.z);
+    vec2 f = d.xz;
+    if (d.y < 0.0) {
+        f = (1.0 - abs(d.zx)) * vec2(d.x >= 0.0 ? 1.0 : -1.0, d.z >= 0.0 ? 1.0 : -1.0);
+    }
+    return f * 0.5 + 0.5;
+}
+
+// yakalama kamerasının sağ ve yukarı eksenleri (glm::lookAt ile aynı)
+void ImpostorFrameBasis(vec3 direction, out vec3 right, out vec3 up) {
+    vec3 reference = abs(direction.y) > 0.999 ? vec3(0.0, 0.0, 1.0) : vec3(0.0, 1.0, 0.0);
+    right = normalize(cross(-direction, reference));
+    up = cross(right, -direction);
+}
@@ -0,0 +1,74 @@
+#version 330 core
+// Impostor: uzak kopya kameraya bakan tek bir quad. Köşeler gl_VertexID'den (vertex bufferı yok),
+// kopyanın matrisi ve renk tonu InstancedObject'in instance attributelarında (vertexShader.glsl INSTANCED ile aynı)
+// kamera yönünün düştüğü ızgara hücresinin üçgenindeki üç görünüş barisentrik ağırlıklarla karışıyor,
+// yüzey bilgisi fragmentShader.glsl IMPOSTOR varyantında okunuyor
+layout (location = 7) in mat4 aInstanceModel; // 7, 8, 9, 10
+layout (location = 11) in vec4 aInstanceTint;
+
+out vec4 InstanceTint;
+out vec2 ImpostorUV[3];         // görünüşün kendi frame'i içinde, [0, 1] dışı boş
+flat out vec2 ImpostorFrame[3]; // frame'in ızgaradaki yeri
+flat out vec3 ImpostorWeights;
+flat out mat4 ImpostorModel;
+flat out mat3 ImpostorNormalMatrix;
+
+uniform mat4 view;
+uniform mat4 projection;
+uniform vec3 viewPos;
+uniform vec4 impostorSphere; // yakalama uzayında merkez + yarıçap
+uniform int impostorGrid;    // eksen başına frame
+
+#include "impostor.glsl"
+
+void main()
+{
+    vec3 center = impostorSphere.xyz;
+    float radius = impostorSphere.w;
+    vec3 cameraLocal = vec3(inverse(aInstanceModel) * vec4(viewPos, 1.0));
+    vec3 toCamera = cameraLocal - center;
+    float distance = length(toCamera);
+    vec3 viewDirection = distance > 0.0 ? toCamera / distance : vec3(0.0, 1.0, 0.0);
+
+    // hücrenin köşegeniyle ayrılan üçgen: sol alt, sağ üst ve yöne göre sağ alt ya da sol üst
+    float cells = float(impostorGrid - 1);
+    vec2 grid = ImpostorDirectionToGrid(viewDirection) * cells;
+    vec2 base = clamp(floor(grid), vec2(0.0), vec2(cells - 1.0));
+    vec2 f = grid - base;
+    vec2 frames[3];
+    frames[0] = base;
+    frames[2] = base + vec2(1.0);
+    if (f.x > f.y) {
+        frames[1] = base + vec2(1.0, 0.0);
+        ImpostorWeights = vec3(1.0 - f.x, f.x - f.y, f.y);
+    }
+    else {
+        frames[1] = base + vec2(0.0, 1.0);
+        ImpostorWeights = vec3(1.0 - f.y, f.y - f.x, f.x);
+    }
+
+    // perspektifte kürenin silueti merkezden geçen düzlemde yarıçaptan büyük kalıyor
+    float expand = min(distance / sqrt(max(distance * distance - radius * radius, 1e-6)), 4.0);
+    vec3 right, up;
+    ImpostorFrameBasis(viewDirection, right, up);
+    vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1)) * 2.0 - 1.0;
+    vec3 localPos = center + (right * corner.x + up * corner.y) * radius * expand;
+
+    // quad noktasından geçen kamera ışını her görünüşün düzlemine (ortografik yakalama) izdüşürülüyor
+    vec3 ray = localPos - cameraLocal;
+    for (int k = 0; k < 3; ++k) {
+        vec3 direction = ImpostorFrameDirection(frames[k] / cells);
+        vec3 frameRight, frameUp;
+        ImpostorFrameBasis(direction, frameRight, frameUp);
+        float denominator = dot(ray, direction);
+        float t = dot(center - cameraLocal, direction) / (abs(denominator) > 1e-6 ? denominator : -1e-6);
+        vec3 hit = cameraLocal + ray * t - center;
+        ImpostorUV[k] = vec2(dot(hit, frameRight), dot(hit, frameUp)) / (2.0 * radius) + 0.5;
+        ImpostorFrame[k] = frames[k];
+    }
+
+    ImpostorModel = aInstanceModel;
+    ImpostorNormalMatrix = transpose(inverse(mat3(aInstanceModel)));
+    InstanceTint = aInstanceTint;
+    gl_Position = projection * view * aInstanceModel * vec4(localPos, 1.0);
+}
@@ -0,0 +1,12 @@
+#version 330 core
+// occlusion query kutusu: birim küp dünya uzayındaki AABB'ye geriliyor
+layout (location = 0) in vec3 aPos;
+
+uniform mat4 viewProjection;
+uniform vec3 boxMin;
+uniform vec3 boxMax;
+
+void main()
+{
+    gl_Position = viewProjection * vec4(mix(boxMin, boxMax, aPos), 1.0);
+}
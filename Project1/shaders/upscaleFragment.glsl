@@ -0,0 +1,38 @@
+#version 330 core
+// dinamik çözünürlük: ekran dışı hedefin kullanılan sol alt bölgesi pencereye bilineer büyütülüp
+// kontrasta uyarlanan keskinleştirmeyle (AMD CAS'ın basit hali) çiziliyor. Ağırlık komşuluğun
+// min/max'ından, kenarlarda düşük tutuluyor, sonuç komşuluk aralığı dışına taşmıyor (halka yok)
+in vec2 OutputUV;
+out vec4 FragColor;
+
+uniform sampler2D sceneColor;
+uniform vec2 sourceScale; // kullanılan bölge, texture koordinatında
+uniform vec2 sourceTexel; // 1 / hedef boyu
+uniform float sharpness;  // 0-1
+
+vec3 SampleScene(vec2 uv) {
+    // bölgenin dışındaki (önceki büyük ölçekten kalan) texeller okunmasın
+    return texture(sceneColor, clamp(uv, sourceTexel * 0.5, sourceScale - sourceTexel * 0.5)).rgb;
+}
+
+void main() {
+    vec2 uv = OutputUV * sourceScale;
+    vec3 center = SampleScene(uv);
+    if (sharpness <= 0.0) {
+        FragColor = vec4(center, 1.0);
+        return;
+    }
+
+    vec3 north = SampleScene(uv + vec2(0.0, sourceTexel.y));
+    vec3 south = SampleScene(uv - vec2(0.0, sourceTexel.y));
+    vec3 east = SampleScene(uv + vec2(sourceTexel.x, 0.0));
+    vec3 west = SampleScene(uv - vec2(sourceTexel.x, 0.0));
+
+    vec3 minimum = min(center, min(min(north, south), min(east, west)));
+    vec3 maximum = max(center, max(max(north, south), max(east, west)));
+    vec3 amount = sqrt(clamp(min(minimum, 1.0 - maximum) / max(maximum, vec3(1e-4)), 0.0, 1.0));
+    vec3 weight = -amount / mix(8.0, 5.0, clamp(sharpness, 0.0, 1.0));
+
+    vec3 result = (center + (north + south + east + west) * weight) / (1.0 + 4.0 * weight);
+    FragColor = vec4(clamp(result, 0.0, 1.0), 1.0);
+}
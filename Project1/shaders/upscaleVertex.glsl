@@ -0,0 +1,10 @@
+#version 330 core
+// dinamik çözünürlük büyütmesi: tam ekran üçgen (vertex bufferı okunmuyor, gl_VertexID'den üretiliyor)
+out vec2 OutputUV;
+
+void main()
+{
+    vec2 corner = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+    OutputUV = corner;
+    gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);
+}
@@ -4,29 +4,85 @@ layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aTexCoords;
 layout (location = 3) in vec3 aTangent;
 layout (location = 4) in vec3 aBitangent;
-layout (location = 5) in vec3 aColor; // vertex color desteği
+layout (location = 5) in float aOcclusion; // model yüklenirken bake edilen vertex AO'su (VertexOcclusion), 1 = açık
+// statik kabuğun lightmap UV'si (GeometryPool'un ayrı akışı), lightmap'i olmayan vertexlerde -1
+layout (location = 12) in vec2 aLightmapUV;
+
+#ifdef INDIRECT_DRAW
+// multi-draw indirect yolu: her çizimin verisi SSBO'da
+// draw id base instance hilesi ile geliyor (divisor 1 olan attribute)
+layout (location = 6) in uint aDrawID;
+
+struct DrawData {
+    mat4 model;
+    mat4 normalMatrix;
+    uvec4 indices; // x: materyal indexi
+};
+
+layout (std430, binding = 0) readonly buffer DrawBuffer {
+    DrawData draws[];
+};
+
+flat out uint MaterialIndex;
+#endif
+
+#ifdef INSTANCED
+// hardware instancing: her kopyanın matrisi ve renk tonu divisor 1 olan attributelarda
+layout (location = 7) in mat4 aInstanceModel; // 7, 8, 9, 10
+layout (location = 11) in vec4 aInstanceTint;
+
+out vec4 InstanceTint;
+#endif
+
+#ifdef CUBEMAP_LAYERED
+// küp harita yakalama (PanoramaCapture): çıktılar cubemapGeometry.glsl'e gidiyor, yüzlere o dağıtıyor
+#define FragPos FragPosVS
+#define Normal NormalVS
+#define TexCoords TexCoordsVS
+#define TBN TBNVS
+#define VertexOcclusion VertexOcclusionVS
+#define LightmapUV LightmapUVVS
+#endif
 
 out vec3 FragPos;
 out vec3 Normal;
 out vec2 TexCoords;
 out mat3 TBN;
-out vec3 VertexColor; // fragment shadera renk bilgisi
+out float VertexOcclusion;
+out vec2 LightmapUV;
 
 uniform mat4 model;
 uniform mat4 view;
 uniform mat4 projection;
 uniform mat3 normalMatrix; 
 
+// derinlik ön geçişi açıkken GL_EQUAL testi için depthPrepassVertex.glsl ile aynı konum
+invariant gl_Position;
+
 void main()
 {
-    FragPos = vec3(model * vec4(aPos, 1.0));
-    Normal = normalMatrix * aNormal; // normal hesabı yapma
+#ifdef INDIRECT_DRAW
+    mat4 modelMatrix = draws[aDrawID].model;
+    mat3 normalMat = mat3(draws[aDrawID].normalMatrix);
+    MaterialIndex = draws[aDrawID].indices.x;
+#elif defined(INSTANCED)
+    mat4 modelMatrix = aInstanceModel;
+    mat3 normalMat = transpose(inverse(mat3(aInstanceModel)));
+    InstanceTint = aInstanceTint;
+#else
+    mat4 modelMatrix = model;
+    mat3 normalMat = normalMatrix;
+#endif
+
+    FragPos = vec3(modelMatrix * vec4(aPos, 1.0));
+    Normal = normalMat * aNormal; // normal hesabı yapma
     TexCoords = aTexCoords;
-    VertexColor = aColor;
+    VertexOcclusion = aOcclusion;
+    LightmapUV = aLightmapUV;
 
     // TBN matrisi hesaplama 
-    vec3 T = normalize(normalMatrix * aTangent);
-    vec3 B = normalize(normalMatrix * aBitangent);
+    vec3 T = normalize(normalMat * aTangent);
+    vec3 B = normalize(normalMat * aBitangent);
     vec3 N = normalize(Normal);
     
     // yeniden ortogonalizasyon
@@ -36,5 +92,10 @@ void main()
     
     TBN = mat3(T, B, N);
 
+#ifdef CUBEMAP_LAYERED
+    // yüzlerin view-projection'ı geometry shader'da, burada dünya konumu
+    gl_Position = vec4(FragPos, 1.0);
+#else
     gl_Position = projection * view * vec4(FragPos, 1.0);
+#endif
 }
\ No newline at end of file